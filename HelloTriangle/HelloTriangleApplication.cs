@@ -5,13 +5,25 @@ namespace HelloTriangle;
 
 public class HelloTriangleApplication
 {
-    public void Run()
+    /// <summary>
+    /// 大于 0 时为自检模式：预热后运行这么多帧，检查主循环不产生托管分配，然后退出.
+    /// </summary>
+    public int AllocationCheckFrames { get; init; }
+
+    /// <summary>
+    /// 开启追踪（也可由环境变量 <c>NATIVELIB_TRACE=1</c> 开启），开启后可按 F12 导出最近的时间线.
+    /// </summary>
+    public bool Tracing { get; init; }
+
+    /// <returns>进程退出码，自检失败时为 1</returns>
+    public int Run()
     {
         try
         {
             InitializeWindow();
             InitializeRenderer();
-            MainLoop();
+
+            return MainLoop() ? 0 : 1;
         }
         finally
         {
@@ -21,7 +33,17 @@ public class HelloTriangleApplication
 
     private void InitializeWindow()
     {
-        Windowing.InitializeWindow(800, 600, "Vulkan");
+        if (!Windowing.Initialize())
+            throw new InvalidOperationException("Failed to initialize windowing.");
+
+        // 在预初始化之前开启，时间线中包含上下文的构建
+        if (Tracing)
+            Renderer.Tracing = true;
+
+        // 渲染器的实例创建与窗口创建互不依赖，让其在后台与窗口创建重叠
+        Renderer.Preinitialize();
+
+        Windowing.CreateWindow(800, 600, "Vulkan");
         
         if (Windowing.Handle.IsInvalid)
             throw new InvalidOperationException("Failed to create a window.");
@@ -33,12 +55,93 @@ public class HelloTriangleApplication
             throw new InvalidOperationException("Failed to initialize renderer!");
     }
 
-    private void MainLoop()
+    /// <returns>自检模式下是否通过，否则总为 <c>true</c></returns>
+    private bool MainLoop()
+    {
+        // 失去焦点时降低帧率，最小化时不渲染，避免空闲的实例占用 CPU 与 GPU
+        Windowing.BackgroundFrameRate = 10;
+
+        // 每帧的调用都经过原生入口表，循环体内不产生托管分配
+        FrameApi.Load(Windowing.Handle);
+
+        bool tracing = Renderer.Tracing;
+
+        while (!FrameApi.WindowShouldClose())
+        {
+            long allocatedBefore = GC.GetAllocatedBytesForCurrentThread();
+
+            if (!FrameApi.WaitEventsForFrame())
+                continue;
+
+            // 事件在本帧内处理完，span 指向的原生内存在下一次取出前有效
+            bool capturedTrace = false;
+            foreach (ref readonly InputEvent input in FrameApi.DrainInputEvents())
+            {
+                if (tracing && input.Type == InputEventType.Key && input.Code == CaptureTraceKey
+                    && input.KeyAction == InputAction.Press)
+                {
+                    Renderer.CaptureTrace(TraceFilePath, TraceCaptureSeconds);
+                    capturedTrace = true;
+                }
+            }
+
+            if (FrameApi.BeginFrame())
+            {
+                FrameApi.DrawTriangle();
+                FrameApi.EndFrame();
+            }
+
+            // 导出追踪的帧会分配（路径的封送与文件写入），不计入检查
+            if (AllocationCheckFrames > 0 && !capturedTrace
+                && CheckFrameAllocations(GC.GetAllocatedBytesForCurrentThread() - allocatedBefore))
+                return ReportAllocationCheck();
+        }
+
+        return AllocationCheckFrames <= 0 || ReportAllocationCheck();
+    }
+
+    private const int CaptureTraceKey = Keys.F12;
+    private const string TraceFilePath = "trace.json";
+    private const double TraceCaptureSeconds = 10.0;
+
+    private const int AllocationCheckWarmupFrames = 120;
+    private int _warmupFrames;
+    private int _checkedFrames;
+    private int _allocatingFrames;
+    private long _maxFrameAllocation;
+
+    /// <summary>
+    /// 记录一帧的托管分配，预热期间的帧（JIT 分层编译与首次调用的静态初始化）不计入.
+    /// </summary>
+    /// <returns><c>true</c> 如果已检查完 <see cref="AllocationCheckFrames"/> 帧</returns>
+    private bool CheckFrameAllocations(long allocated)
     {
-        while (!Windowing.WindowShouldClose())
+        if (_warmupFrames < AllocationCheckWarmupFrames)
         {
-            Windowing.PollEvents();
+            _warmupFrames++;
+            return false;
         }
+
+        if (allocated != 0)
+        {
+            _allocatingFrames++;
+            _maxFrameAllocation = Math.Max(_maxFrameAllocation, allocated);
+        }
+
+        return ++_checkedFrames >= AllocationCheckFrames;
+    }
+
+    /// <returns><c>true</c> 如果检查完了全部帧且每帧都没有分配</returns>
+    private bool ReportAllocationCheck()
+    {
+        bool passed = _checkedFrames >= AllocationCheckFrames && _allocatingFrames == 0;
+
+        Console.WriteLine(passed
+            ? $"Allocation check passed: {_checkedFrames} frames without managed allocations."
+            : $"Allocation check failed: {_allocatingFrames} of {_checkedFrames}/{AllocationCheckFrames} frames allocated "
+              + $"(at most {_maxFrameAllocation} bytes).");
+
+        return passed;
     }
 
     private void CleanUp()
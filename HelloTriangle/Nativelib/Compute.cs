@@ -0,0 +1,90 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>RendererComputeWait</c> 一致：图形工作中首个读取计算结果的阶段.
+/// </summary>
+[Flags]
+public enum ComputeWait : uint
+{
+    /// <summary>图形工作整体等待计算完成.</summary>
+    All = 0,
+    DrawIndirect = 1u << 0,
+    VertexInput = 1u << 1,
+    VertexShader = 1u << 2,
+    FragmentShader = 1u << 3,
+}
+
+/// <summary>
+/// 每帧一次的计算通道：在 <see cref="Renderer.BeginFrame"/> 之后、本帧的任何绘制之前录制.
+/// <para>计算管线没有描述符集，缓冲以 <see cref="Resources.GetBufferAddress"/> 的设备地址经推送常量传入.
+/// 设备有专用的计算队列族时，计算与上一帧的渲染并行执行，被计算写入的缓冲应按在途帧各备一份.</para>
+/// </summary>
+public static unsafe partial class Compute
+{
+    const string library = "nativelib_renderer";
+
+    /// <summary>
+    /// 推送常量的最大字节数，与原生 <c>COMPUTE_PUSH_CONSTANT_SIZE</c> 一致.
+    /// </summary>
+    public const int MaxPushConstantSize = 128;
+
+    [LibraryImport(library)]
+    private static partial ulong rendererCreateComputePipeline(byte* code, ulong codeSize);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererBeginComputePass();
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererDispatch(ulong pipeline, void* constants, uint constantSize,
+        uint groupCountX, uint groupCountY, uint groupCountZ);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererEndComputePass(uint waitStages);
+
+    /// <summary>
+    /// 由 SPIR-V 字节码创建计算管线（入口为 main），用 <see cref="Resources.Destroy"/> 销毁.
+    /// </summary>
+    /// <returns>管线的句柄，失败时为 <see cref="ResourceHandle.Invalid"/></returns>
+    public static ResourceHandle CreatePipeline(ReadOnlySpan<byte> spirv)
+    {
+        fixed (byte* pCode = spirv)
+        {
+            return new ResourceHandle(rendererCreateComputePipeline(pCode, (ulong)spirv.Length));
+        }
+    }
+
+    /// <summary>
+    /// 开始本帧的计算通道.
+    /// </summary>
+    /// <returns>成功开始时为 <c>true</c></returns>
+    public static bool BeginPass()
+    {
+        return rendererBeginComputePass();
+    }
+
+    /// <summary>
+    /// 录制一次调度，相邻的调度之间插入屏障（后者可以读取前者的写入）.
+    /// </summary>
+    /// <param name="constants">推送常量，不超过 <see cref="MaxPushConstantSize"/> 字节</param>
+    public static bool Dispatch<T>(ResourceHandle pipeline, in T constants, uint groupCountX, uint groupCountY = 1, uint groupCountZ = 1)
+        where T : unmanaged
+    {
+        fixed (T* pConstants = &constants)
+        {
+            return rendererDispatch(pipeline.Value, pConstants, (uint)sizeof(T), groupCountX, groupCountY, groupCountZ);
+        }
+    }
+
+    /// <summary>
+    /// 结束计算通道，本帧的图形工作在 <paramref name="waitStages"/> 之前等待计算完成.
+    /// </summary>
+    public static bool EndPass(ComputeWait waitStages)
+    {
+        return rendererEndComputePass((uint)waitStages);
+    }
+}
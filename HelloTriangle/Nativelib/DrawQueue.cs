@@ -0,0 +1,79 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>DrawCommand</c> 布局一致的绘制命令，用 <see cref="Renderer.SubmitDraws"/> 以任意顺序提交.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct DrawCommand
+{
+    /// <summary>
+    /// 不绑定 uniform 数据时 <see cref="UniformOffset"/> 的取值（着色器读取默认的 <see cref="ObjectUniforms"/>）.
+    /// </summary>
+    public const uint NoUniform = uint.MaxValue;
+
+    /// <summary>
+    /// 网格，为 <see cref="ResourceHandle.Invalid"/> 时以 <see cref="VertexCount"/> 用内置的三角形管线做非索引绘制.
+    /// 拉取网格使用内置的顶点拉取管线，其余网格使用内置的顶点输入管线.
+    /// </summary>
+    public ResourceHandle Mesh;
+
+    /// <summary>
+    /// <see cref="Renderer.TryPushUniform{T}"/> 输出的动态偏移，为 <see cref="NoUniform"/> 时使用默认的 <see cref="ObjectUniforms"/>.
+    /// </summary>
+    public uint UniformOffset;
+
+    /// <summary>
+    /// 顶点数，仅在没有网格时使用.
+    /// </summary>
+    public uint VertexCount;
+
+    /// <summary>
+    /// 实例数，为 0 时视为 1.
+    /// </summary>
+    public uint InstanceCount;
+
+    /// <summary>
+    /// 表面编号，见 <see cref="Renderer.AddWindow"/>.
+    /// </summary>
+    public int Surface;
+
+    /// <summary>
+    /// [0, 1] 的深度，相同状态的绘制由近及远录制.
+    /// </summary>
+    public float Depth;
+}
+
+/// <summary>
+/// 与原生 <c>DrawQueueStats</c> 布局一致的绘制队列统计信息（上一次录制）.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct DrawQueueStats
+{
+    /// <summary>
+    /// 录制的绘制数.
+    /// </summary>
+    public uint DrawCount;
+
+    /// <summary>
+    /// 因句柄过期、资源被驱逐或表面不可绘制而跳过的绘制数.
+    /// </summary>
+    public uint SkippedCount;
+
+    /// <summary>
+    /// 与前一条绘制合并（索引区间相邻的拉取网格）的绘制数.
+    /// </summary>
+    public uint MergedDraws;
+
+    public uint PipelineBinds;
+
+    public uint UniformBinds;
+
+    public uint MeshBinds;
+
+    /// <summary>
+    /// 实际执行的基数排序趟数.
+    /// </summary>
+    public uint SortPasses;
+}
@@ -0,0 +1,192 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>RendererFrameApi</c> 布局一致的每帧入口表，各入口为非托管函数指针（原生的 <c>bool</c> 返回值为 1 字节）.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct RendererFrameApi
+{
+    public uint Size;
+    public delegate* unmanaged<byte> BeginFrame;
+    public delegate* unmanaged<int, void> DrawTriangle;
+    public delegate* unmanaged<int, void> DrawStatic;
+    public delegate* unmanaged<uint, uint*, void*> AllocateUniform;
+    public delegate* unmanaged<uint, void> BindUniform;
+    public delegate* unmanaged<DrawCommand*, uint, uint> SubmitDraws;
+    public delegate* unmanaged<void> FlushDraws;
+    public delegate* unmanaged<void> EndFrame;
+    public delegate* unmanaged<DrawQueueStats*, byte> GetDrawQueueStats;
+    public delegate* unmanaged<FrameLimiterStats*, byte> GetFrameLimiterStats;
+}
+
+/// <summary>
+/// 与原生 <c>WindowingFrameApi</c> 布局一致的每帧窗口入口表，窗口参数为原始的 GLFWwindow 指针.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct WindowingFrameApi
+{
+    public uint Size;
+    public delegate* unmanaged<nint, byte> WaitEventsForFrame;
+    public delegate* unmanaged<nint, int> WindowShouldClose;
+    public delegate* unmanaged<nint, int> GetWindowState;
+    public delegate* unmanaged<InputEvent**, uint> DrainInputEvents;
+}
+
+/// <summary>
+/// 主循环使用的无分配入口：通过原生入口表以 <c>delegate* unmanaged</c> 调用，不经过 P/Invoke 的封送存根，
+/// 窗口以原始指针传递（不对 <see cref="Window"/> 做 SafeHandle 的引用计数），所有参数都是可按位传递的类型.
+/// <para>需在 <see cref="Renderer.Initialize"/> 之后调用 <see cref="Load"/>；窗口销毁后不能再使用.</para>
+/// </summary>
+public static unsafe partial class FrameApi
+{
+    [LibraryImport("nativelib_renderer")]
+    private static partial RendererFrameApi* rendererGetFrameApi();
+
+    [LibraryImport("nativelib_windowing")]
+    private static partial WindowingFrameApi* getWindowingFrameApi();
+
+
+    private static RendererFrameApi* _renderer;
+    private static WindowingFrameApi* _windowing;
+    private static nint _window;
+
+
+    /// <summary>
+    /// 获取原生入口表并记下窗口的原始指针.
+    /// </summary>
+    /// <param name="window">主循环所在的窗口（通常为 <see cref="Windowing.Handle"/>），需在使用期间保持存活</param>
+    public static void Load(Window window)
+    {
+        RendererFrameApi* renderer = rendererGetFrameApi();
+        WindowingFrameApi* windowing = getWindowingFrameApi();
+
+        // 入口表的大小不符说明托管与原生的版本不一致
+        if (renderer == null || renderer->Size != (uint)sizeof(RendererFrameApi))
+            throw new InvalidOperationException("Renderer frame API layout mismatch.");
+        if (windowing == null || windowing->Size != (uint)sizeof(WindowingFrameApi))
+            throw new InvalidOperationException("Windowing frame API layout mismatch.");
+
+        _renderer = renderer;
+        _windowing = windowing;
+        _window = window.DangerousGetHandle();
+    }
+
+    /// <summary>
+    /// 见 <see cref="Windowing.WindowShouldClose()"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool WindowShouldClose() => _windowing->WindowShouldClose(_window) == 1;
+
+    /// <summary>
+    /// 见 <see cref="Windowing.WaitEventsForFrame"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool WaitEventsForFrame() => _windowing->WaitEventsForFrame(_window) != 0;
+
+    /// <summary>
+    /// 见 <see cref="Windowing.State"/>.
+    /// </summary>
+    public static WindowState State
+    {
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        get => (WindowState)_windowing->GetWindowState(_window);
+    }
+
+    /// <summary>
+    /// 见 <see cref="Windowing.DrainInputEvents"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static ReadOnlySpan<InputEvent> DrainInputEvents()
+    {
+        InputEvent* events = null;
+        uint count = _windowing->DrainInputEvents(&events);
+
+        return new ReadOnlySpan<InputEvent>(events, (int)count);
+    }
+
+    /// <summary>
+    /// 见 <see cref="Renderer.BeginFrame"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static bool BeginFrame() => _renderer->BeginFrame() != 0;
+
+    /// <summary>
+    /// 见 <see cref="Renderer.DrawTriangle"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void DrawTriangle(int surface = 0) => _renderer->DrawTriangle(surface);
+
+    /// <summary>
+    /// 见 <see cref="Renderer.DrawStatic"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void DrawStatic(int surface = 0) => _renderer->DrawStatic(surface);
+
+    /// <summary>
+    /// 在当前帧的 uniform 环形缓冲中分配 <paramref name="size"/> 字节，见 <see cref="Renderer.TryPushUniform{T}"/>.
+    /// </summary>
+    /// <returns>映射内存的地址，分配失败时为 <c>null</c></returns>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void* AllocateUniform(uint size, out uint offset)
+    {
+        uint result = 0;
+        void* data = _renderer->AllocateUniform(size, &result);
+        offset = result;
+
+        return data;
+    }
+
+    /// <summary>
+    /// 见 <see cref="Renderer.BindUniform"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void BindUniform(uint offset) => _renderer->BindUniform(offset);
+
+    /// <summary>
+    /// 见 <see cref="Renderer.SubmitDraws"/>.
+    /// </summary>
+    /// <returns>加入的命令数</returns>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static int SubmitDraws(ReadOnlySpan<DrawCommand> commands)
+    {
+        fixed (DrawCommand* pCommands = commands)
+            return (int)_renderer->SubmitDraws(pCommands, (uint)commands.Length);
+    }
+
+    /// <summary>
+    /// 见 <see cref="Renderer.FlushDraws"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void FlushDraws() => _renderer->FlushDraws();
+
+    /// <summary>
+    /// 见 <see cref="Renderer.EndFrame"/>.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void EndFrame() => _renderer->EndFrame();
+
+    /// <summary>
+    /// 获取绘制队列上一次录制的统计信息.
+    /// </summary>
+    /// <returns><c>true</c> 如果渲染器已初始化</returns>
+    public static bool TryGetDrawQueueStats(out DrawQueueStats stats)
+    {
+        stats = default;
+        fixed (DrawQueueStats* pStats = &stats)
+            return _renderer->GetDrawQueueStats(pStats) != 0;
+    }
+
+    /// <summary>
+    /// 获取帧率限制器测得的帧间隔与抖动.
+    /// </summary>
+    /// <returns><c>true</c> 如果渲染器已初始化</returns>
+    public static bool TryGetFrameLimiterStats(out FrameLimiterStats stats)
+    {
+        stats = default;
+        fixed (FrameLimiterStats* pStats = &stats)
+            return _renderer->GetFrameLimiterStats(pStats) != 0;
+    }
+}
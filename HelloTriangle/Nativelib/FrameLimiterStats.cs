@@ -0,0 +1,35 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>FrameLimiterStats</c> 布局一致的帧率限制器统计信息（毫秒）.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct FrameLimiterStats
+{
+    /// <summary>
+    /// 目标帧间隔，为 0 时未限制.
+    /// </summary>
+    public double TargetFrameTime;
+
+    /// <summary>
+    /// 平均帧间隔.
+    /// </summary>
+    public double AverageFrameTime;
+
+    /// <summary>
+    /// 实际帧间隔与目标帧间隔之差的平均绝对值.
+    /// </summary>
+    public double AverageJitter;
+
+    /// <summary>
+    /// 晚于截止时刻的最大值（自上次设置帧率起）.
+    /// </summary>
+    public double MaxLateness;
+
+    /// <summary>
+    /// 当前的尾部自旋时长.
+    /// </summary>
+    public double SpinTime;
+}
@@ -0,0 +1,89 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>InputEventType</c> 一致的输入事件种类.
+/// </summary>
+public enum InputEventType : uint
+{
+    /// <summary><see cref="InputEvent.Code"/> 为 GLFW 键码，<see cref="InputEvent.Action"/> 为按下 / 松开 / 重复.</summary>
+    Key = 1,
+    /// <summary><see cref="InputEvent.Code"/> 为鼠标按键，(<see cref="InputEvent.X"/>, <see cref="InputEvent.Y"/>) 为按下时的光标位置.</summary>
+    MouseButton = 2,
+    /// <summary>(<see cref="InputEvent.X"/>, <see cref="InputEvent.Y"/>) 为光标位置.</summary>
+    CursorMove = 3,
+    /// <summary>(<see cref="InputEvent.X"/>, <see cref="InputEvent.Y"/>) 为滚动偏移.</summary>
+    Scroll = 4,
+    /// <summary>(<see cref="InputEvent.X"/>, <see cref="InputEvent.Y"/>) 为新的帧缓冲大小（像素）.</summary>
+    Resize = 5,
+    /// <summary><see cref="InputEvent.Action"/> 为 1 时获得焦点，为 0 时失去焦点.</summary>
+    Focus = 6,
+}
+
+/// <summary>
+/// 与 GLFW 一致的按键动作.
+/// </summary>
+public enum InputAction
+{
+    Release = 0,
+    Press = 1,
+    Repeat = 2,
+}
+
+/// <summary>
+/// 常用的 GLFW 键码（与 <c>GLFW_KEY_*</c> 一致）.
+/// </summary>
+public static class Keys
+{
+    public const int Escape = 256;
+    public const int F1 = 290;
+    public const int F12 = 301;
+}
+
+/// <summary>
+/// 与原生 <c>InputEvent</c> 布局一致的输入事件，由 <see cref="Windowing.DrainInputEvents"/> 每帧取出.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct InputEvent
+{
+    public InputEventType Type;
+
+    /// <summary>
+    /// 键码（GLFW_KEY_*）或鼠标按键（GLFW_MOUSE_BUTTON_*）.
+    /// </summary>
+    public int Code;
+
+    /// <summary>
+    /// 平台相关的扫描码，仅键盘事件.
+    /// </summary>
+    public int Scancode;
+
+    public int Action;
+
+    /// <summary>
+    /// 修饰键（GLFW_MOD_*）.
+    /// </summary>
+    public int Mods;
+
+    /// <summary>
+    /// 保留，用于对齐.
+    /// </summary>
+    public uint Reserved;
+
+    public double X;
+
+    public double Y;
+
+    /// <summary>
+    /// 事件发生时的 glfwGetTime（秒）.
+    /// </summary>
+    public double Time;
+
+    /// <summary>
+    /// 事件所属窗口的 GLFWwindow 句柄.
+    /// </summary>
+    public nint Window;
+
+    public readonly InputAction KeyAction => (InputAction)Action;
+}
@@ -0,0 +1,73 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>JobCounter</c> 布局一致的依赖计数器，需清零后使用，且在 <see cref="Jobs.Wait"/> 返回前地址不能改变
+/// （放在栈上或原生内存中）.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct JobCounter
+{
+    private int _value;
+
+    public bool IsDone => Volatile.Read(ref _value) <= 0;
+}
+
+/// <summary>
+/// 原生任务系统（与渲染器共用工作线程），任务为 <see cref="UnmanagedCallersOnlyAttribute"/> 函数指针，
+/// 在原生工作线程上执行.
+/// <para>需在 <see cref="Renderer.Preinitialize"/> 或 <see cref="Renderer.Initialize"/> 之后使用.</para>
+/// </summary>
+public static unsafe partial class Jobs
+{
+    const string library = "nativelib_renderer";
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererRunJob(delegate* unmanaged<void*, void> func, void* arg, JobCounter* counter);
+
+    [LibraryImport(library)]
+    private static partial void rendererWaitJobs(JobCounter* counter);
+
+    [LibraryImport(library)]
+    private static partial void rendererParallelFor(uint count, uint grain, delegate* unmanaged<void*, uint, uint, void> func, void* arg);
+
+    [LibraryImport(library)]
+    private static partial uint rendererGetJobThreadCount();
+
+
+    /// <summary>
+    /// 任务系统的线程数（含创建渲染器的线程），渲染器尚未创建时为 0.
+    /// </summary>
+    public static int ThreadCount => (int)rendererGetJobThreadCount();
+
+    /// <summary>
+    /// 提交一个任务.
+    /// </summary>
+    /// <param name="func">任务入口</param>
+    /// <param name="arg">传给任务的参数（需在任务完成前保持有效）</param>
+    /// <param name="counter">可为 <c>null</c>；否则任务完成时减一，用 <see cref="Wait"/> 等待</param>
+    /// <returns><c>true</c> 如果任务已提交</returns>
+    public static bool Run(delegate* unmanaged<void*, void> func, void* arg, JobCounter* counter = null)
+    {
+        return rendererRunJob(func, arg, counter);
+    }
+
+    /// <summary>
+    /// 等待计数器归零，期间在调用线程上执行其他任务（不会阻塞地休眠）.
+    /// </summary>
+    public static void Wait(JobCounter* counter)
+    {
+        rendererWaitJobs(counter);
+    }
+
+    /// <summary>
+    /// 把下标 [0, <paramref name="count"/>) 拆分为不小于 <paramref name="grain"/> 的区间并行执行，返回时全部完成.
+    /// </summary>
+    /// <param name="func">区间入口，参数为 (<paramref name="arg"/>, begin, end)</param>
+    public static void ParallelFor(uint count, uint grain, delegate* unmanaged<void*, uint, uint, void> func, void* arg)
+    {
+        rendererParallelFor(count, grain, func, arg);
+    }
+}
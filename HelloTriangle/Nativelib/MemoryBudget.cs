@@ -0,0 +1,65 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>MemoryCategory</c> 一致的设备内存用途分类.
+/// </summary>
+public enum MemoryCategory
+{
+    Texture = 0,
+    Mesh = 1,
+    Staging = 2,
+    RenderTarget = 3,
+    /// <summary>其他缓冲（uniform 环形缓冲、场景数据等）.</summary>
+    Buffer = 4,
+}
+
+/// <summary>
+/// 与原生 <c>MemoryBudgetReport</c> 布局一致的设备内存预算与用量报告（字节）.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct MemoryBudgetReport
+{
+    public const int MaxHeaps = 16;
+    public const int CategoryCount = 5;
+
+    public uint HeapCount;
+    private uint _budgetExtension;
+    private fixed ulong _heapSize[MaxHeaps];
+    private fixed ulong _heapBudget[MaxHeaps];
+    private fixed ulong _heapUsage[MaxHeaps];
+    private fixed ulong _heapTracked[MaxHeaps];
+    private fixed uint _heapFlags[MaxHeaps];
+    private fixed ulong _categoryBytes[CategoryCount];
+    private fixed uint _categoryAllocations[CategoryCount];
+    public uint StreamableCount;
+    public uint EvictionCount;
+    public ulong StreamableBytes;
+    public ulong EvictedBytes;
+
+    /// <summary>
+    /// 预算是否来自 VK_EXT_memory_budget（否则为按堆大小的估算值）.
+    /// </summary>
+    public readonly bool BudgetExtension => _budgetExtension != 0;
+
+    public readonly ulong HeapSize(int heap) => _heapSize[heap];
+
+    /// <summary>
+    /// 本进程在该堆上可用而不引起换页的估计值.
+    /// </summary>
+    public readonly ulong HeapBudget(int heap) => _heapBudget[heap];
+
+    public readonly ulong HeapUsage(int heap) => _heapUsage[heap];
+
+    /// <summary>
+    /// 经由渲染器分配的用量.
+    /// </summary>
+    public readonly ulong HeapTracked(int heap) => _heapTracked[heap];
+
+    public readonly bool IsDeviceLocal(int heap) => (_heapFlags[heap] & 1) != 0;
+
+    public readonly ulong CategoryBytes(MemoryCategory category) => _categoryBytes[(int)category];
+
+    public readonly uint CategoryAllocations(MemoryCategory category) => _categoryAllocations[(int)category];
+}
@@ -0,0 +1,45 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>MeshDefragStats</c> 布局一致的网格池整理统计信息.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct MeshDefragStats
+{
+    /// <summary>
+    /// 每帧最多搬移的字节数，为 0 时整理已关闭.
+    /// </summary>
+    public ulong FrameBudget;
+
+    /// <summary>
+    /// 累计搬移的网格数.
+    /// </summary>
+    public ulong MovedMeshes;
+
+    /// <summary>
+    /// 累计搬移的字节数（顶点 + 索引）.
+    /// </summary>
+    public ulong MovedBytes;
+
+    /// <summary>
+    /// 累计释放的块数.
+    /// </summary>
+    public uint ReleasedBlocks;
+
+    /// <summary>
+    /// 上一次整理步骤搬移的网格数.
+    /// </summary>
+    public uint LastFrameMoves;
+
+    /// <summary>
+    /// 当前已创建的顶点块数.
+    /// </summary>
+    public uint VertexBlockCount;
+
+    /// <summary>
+    /// 当前已创建的索引块数.
+    /// </summary>
+    public uint IndexBlockCount;
+}
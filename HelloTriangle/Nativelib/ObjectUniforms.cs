@@ -0,0 +1,33 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>ObjectUniforms</c> 布局一致的每个对象的 uniform 数据，内置的三个顶点着色器都从 set 0，binding 0 读取它.
+/// <para>用 <see cref="Renderer.TryPushUniform{T}"/> 写入；自定义的 uniform 结构体需以它开头.
+/// 没有绑定时着色器读取默认值（<see cref="Default"/>）.</para>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct ObjectUniforms
+{
+    /// <summary>
+    /// 裁剪空间中的平移（W 未使用）.
+    /// </summary>
+    public float OffsetX, OffsetY, OffsetZ, OffsetW;
+
+    /// <summary>
+    /// 与顶点颜色相乘的颜色（A 未使用）.
+    /// </summary>
+    public float R, G, B, A;
+
+    /// <summary>
+    /// 不平移、颜色不变.
+    /// </summary>
+    public static ObjectUniforms Default => new(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+
+    public ObjectUniforms(float offsetX, float offsetY, float offsetZ, float r, float g, float b)
+    {
+        OffsetX = offsetX; OffsetY = offsetY; OffsetZ = offsetZ; OffsetW = 0.0f;
+        R = r; G = g; B = b; A = 1.0f;
+    }
+}
@@ -0,0 +1,49 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>ReadbackInfo</c> 结构体布局一致的回读结果描述.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal struct ReadbackInfo
+{
+    public nint Data;
+    public ulong Size;
+    public uint Width;
+    public uint Height;
+    public uint RowPitch;
+    public uint Format;
+}
+
+/// <summary>
+/// 一帧回读结果，像素数据直接引用原生层常驻映射的主机可见内存（不发生拷贝）.
+/// <para>数据仅在调用 <see cref="Renderer.ReleaseReadback"/> 之前有效！</para>
+/// </summary>
+public readonly ref struct ReadbackFrame
+{
+    /// <summary>
+    /// 紧密排列的像素数据，每行 <see cref="RowPitch"/> 字节.
+    /// </summary>
+    public ReadOnlySpan<byte> Pixels { get; }
+
+    public int Width { get; }
+
+    public int Height { get; }
+
+    public int RowPitch { get; }
+
+    /// <summary>
+    /// 像素格式（VkFormat 的数值）.
+    /// </summary>
+    public uint Format { get; }
+
+    internal unsafe ReadbackFrame(ReadbackInfo info)
+    {
+        Pixels = new ReadOnlySpan<byte>((void*)info.Data, checked((int)info.Size));
+        Width = (int)info.Width;
+        Height = (int)info.Height;
+        RowPitch = (int)info.RowPitch;
+        Format = info.Format;
+    }
+}
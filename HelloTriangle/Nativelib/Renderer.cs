@@ -9,6 +9,10 @@ public static partial class Renderer
 {
     const string library = "nativelib_renderer";
 
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererPreinitialize();
+
     [LibraryImport(library)]
     [return: MarshalAs(UnmanagedType.I1)]
     private static partial bool rendererInitialize(Window window);
@@ -17,15 +21,96 @@ public static partial class Renderer
     private static partial void rendererReady();
 
     [LibraryImport(library)]
-    private static partial void rendererBeginFrame();
+    private static partial int rendererAddWindow(Window window);
+
+    [LibraryImport(library)]
+    private static partial void rendererRemoveWindow(int surface);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererBeginFrame();
+
+    [LibraryImport(library)]
+    private static partial void rendererDrawTriangle(int surface);
+
+    [LibraryImport(library)]
+    private static partial void rendererSetStaticPass(int surface, uint triangleCount);
+
+    [LibraryImport(library)]
+    private static partial void rendererDrawStatic(int surface);
+
+    [LibraryImport(library)]
+    private static unsafe partial void* rendererAllocateUniform(uint size, out uint offset);
+
+    [LibraryImport(library)]
+    private static partial void rendererBindUniform(uint offset);
 
     [LibraryImport(library)]
     private static partial void rendererEndFrame();
 
+    [LibraryImport(library)]
+    private static partial ulong rendererRequestReadback();
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererMapReadback(ulong ticket, out ReadbackInfo info);
+
+    [LibraryImport(library)]
+    private static partial void rendererReleaseReadback(ulong ticket);
+
+    [LibraryImport(library)]
+    private static partial void rendererSetFrameRateLimit(double framesPerSecond);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererGetFrameLimiterStats(out FrameLimiterStats stats);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererGetMemoryBudget(out MemoryBudgetReport report);
+
+    [LibraryImport(library)]
+    private static unsafe partial uint rendererSubmitDraws(DrawCommand* commands, uint count);
+
+    [LibraryImport(library)]
+    private static partial void rendererFlushDraws();
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererGetDrawQueueStats(out DrawQueueStats stats);
+
+    [LibraryImport(library)]
+    private static partial void rendererSetMeshDefragBudget(ulong bytesPerFrame);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererGetMeshDefragStats(out MeshDefragStats stats);
+
+    [LibraryImport(library)]
+    private static partial void rendererSetTracing([MarshalAs(UnmanagedType.I1)] bool enabled);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererIsTracing();
+
+    [LibraryImport(library, StringMarshalling = StringMarshalling.Utf8)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererCaptureTrace(string path, double seconds);
+
     [LibraryImport(library)]
     private static partial void rendererRelease();
 
 
+    /// <summary>
+    /// 在后台开始渲染器的预初始化，使其与窗口创建重叠（可选）.
+    /// 需在 <see cref="Windowing.Initialize"/> 之后、<see cref="Initialize"/> 之前调用.
+    /// </summary>
+    /// <returns><c>true</c> 如果成功开始预初始化</returns>
+    public static bool Preinitialize()
+    {
+        return rendererPreinitialize();
+    }
+
     public static bool Initialize(Window window)
     {
         return rendererInitialize(window);
@@ -36,9 +121,87 @@ public static partial class Renderer
         rendererReady();
     }
 
-    public static void BegineFrame()
+    /// <summary>
+    /// 为另一个窗口创建交换链，与 <see cref="Initialize"/> 的窗口共享同一个设备.
+    /// </summary>
+    /// <param name="window">要渲染到的窗口</param>
+    /// <returns>表面编号（<see cref="Initialize"/> 的窗口为 0），失败时返回 -1</returns>
+    public static int AddWindow(Window window)
     {
-        rendererBeginFrame();
+        return rendererAddWindow(window);
+    }
+
+    /// <summary>
+    /// 销毁由 <see cref="AddWindow"/> 创建的表面，需在销毁窗口之前调用.
+    /// </summary>
+    /// <param name="surface">表面编号</param>
+    public static void RemoveWindow(int surface)
+    {
+        rendererRemoveWindow(surface);
+    }
+
+    /// <summary>
+    /// 开始一帧.
+    /// </summary>
+    /// <returns><c>false</c> 时本次循环应跳过渲染，且不调用 <see cref="EndFrame"/></returns>
+    public static bool BeginFrame()
+    {
+        return rendererBeginFrame();
+    }
+
+    /// <summary>
+    /// 在当前帧中向给定表面绘制内置的三角形，需在 <see cref="BeginFrame"/> 与 <see cref="EndFrame"/> 之间调用.
+    /// <para>同一帧中对各表面的绘制需按表面分组.</para>
+    /// </summary>
+    /// <param name="surface">表面编号，见 <see cref="AddWindow"/></param>
+    public static void DrawTriangle(int surface = 0)
+    {
+        rendererDrawTriangle(surface);
+    }
+
+    /// <summary>
+    /// 设置给定表面静态通道绘制的三角形数量（0 表示不使用静态通道），需在帧外调用.
+    /// </summary>
+    /// <param name="surface">表面编号，见 <see cref="AddWindow"/></param>
+    public static void SetStaticPass(int surface, uint triangleCount)
+    {
+        rendererSetStaticPass(surface, triangleCount);
+    }
+
+    /// <summary>
+    /// 在当前帧中以缓存的命令缓冲绘制给定表面的静态通道，需在 <see cref="BeginFrame"/> 与 <see cref="EndFrame"/> 之间调用.
+    /// <para>命令缓冲只在场景结构、管线或交换链变化后重新录制；该表面本帧不能再有其他绘制.</para>
+    /// </summary>
+    /// <param name="surface">表面编号，见 <see cref="AddWindow"/></param>
+    public static void DrawStatic(int surface = 0)
+    {
+        rendererDrawStatic(surface);
+    }
+
+    /// <summary>
+    /// 将结构体直接写入当前帧的 uniform 环形缓冲（一次拷贝，不分配托管内存、不写描述符）.
+    /// </summary>
+    /// <typeparam name="T"><see cref="ObjectUniforms"/>，或以它开头的 blittable 结构体</typeparam>
+    /// <param name="data">要写入的数据</param>
+    /// <param name="offset">写入成功时接收其动态偏移，传给 <see cref="BindUniform"/></param>
+    /// <returns><c>true</c> 如果写入成功；结构体过大或当前帧的分区已满时为 <c>false</c></returns>
+    public static unsafe bool TryPushUniform<T>(in T data, out uint offset) where T : unmanaged
+    {
+        void* destination = rendererAllocateUniform((uint)sizeof(T), out offset);
+        if (destination == null)
+            return false;
+
+        *(T*)destination = data;
+        return true;
+    }
+
+    /// <summary>
+    /// 绑定 uniform 数据，之后的绘制从 <paramref name="offset"/> 处读取，需在 <see cref="BeginFrame"/> 与 <see cref="EndFrame"/> 之间调用.
+    /// </summary>
+    /// <param name="offset"><see cref="TryPushUniform"/> 输出的动态偏移</param>
+    public static void BindUniform(uint offset)
+    {
+        rendererBindUniform(offset);
     }
 
     public static void EndFrame()
@@ -46,8 +209,151 @@ public static partial class Renderer
         rendererEndFrame();
     }
 
+    /// <summary>
+    /// 请求回读下一次 <see cref="EndFrame"/> 所呈现的主窗口（表面 0）的帧，不会阻塞渲染循环.
+    /// </summary>
+    /// <returns>请求编号，回读槽位已满或主窗口的交换链图像不支持回读时返回 0</returns>
+    public static ulong RequestReadback()
+    {
+        return rendererRequestReadback();
+    }
+
+    /// <summary>
+    /// 非阻塞地查询回读结果.
+    /// </summary>
+    /// <param name="ticket"><see cref="RequestReadback"/> 返回的请求编号</param>
+    /// <param name="frame">数据就绪时接收回读结果</param>
+    /// <returns><c>true</c> 如果数据已就绪</returns>
+    public static bool TryGetReadback(ulong ticket, out ReadbackFrame frame)
+    {
+        if (!rendererMapReadback(ticket, out ReadbackInfo info))
+        {
+            frame = default;
+            return false;
+        }
+
+        frame = new ReadbackFrame(info);
+        return true;
+    }
+
+    /// <summary>
+    /// 释放回读请求所占用的槽位，之后其 <see cref="ReadbackFrame.Pixels"/> 不可再被访问.
+    /// </summary>
+    /// <param name="ticket">要释放的请求编号</param>
+    public static void ReleaseReadback(ulong ticket)
+    {
+        rendererReleaseReadback(ticket);
+    }
+
+    /// <summary>
+    /// 帧率上限（<see cref="EndFrame"/> 在呈现之前等待），为 0 时不限制. 需在 <see cref="Initialize"/> 之后设置.
+    /// </summary>
+    public static double FrameRateLimit
+    {
+        get => _frameRateLimit;
+        set
+        {
+            _frameRateLimit = value;
+            rendererSetFrameRateLimit(value);
+        }
+    }
+    private static double _frameRateLimit;
+
+    /// <summary>
+    /// 获取帧率限制器测得的帧间隔与抖动.
+    /// </summary>
+    /// <returns><c>true</c> 如果渲染器已初始化</returns>
+    public static bool TryGetFrameLimiterStats(out FrameLimiterStats stats)
+    {
+        return rendererGetFrameLimiterStats(out stats);
+    }
+
+    /// <summary>
+    /// 把绘制命令加入本帧的绘制队列，需在 <see cref="BeginFrame"/> 与 <see cref="EndFrame"/> 之间调用.
+    /// <para>命令可以任意顺序提交，录制前按表面、管线、uniform 偏移、网格与深度排序，并消除冗余绑定.</para>
+    /// </summary>
+    /// <returns>加入的命令数，队列已满时少于 <paramref name="commands"/> 的长度</returns>
+    public static unsafe int SubmitDraws(ReadOnlySpan<DrawCommand> commands)
+    {
+        fixed (DrawCommand* pCommands = commands)
+        {
+            return (int)rendererSubmitDraws(pCommands, (uint)commands.Length);
+        }
+    }
+
+    /// <summary>
+    /// 立即排序并录制已提交的绘制（可选，<see cref="EndFrame"/> 会自动录制）.
+    /// </summary>
+    public static void FlushDraws()
+    {
+        rendererFlushDraws();
+    }
+
+    /// <summary>
+    /// 获取绘制队列上一次录制的统计信息.
+    /// </summary>
+    /// <returns><c>true</c> 如果渲染器已初始化</returns>
+    public static bool TryGetDrawQueueStats(out DrawQueueStats stats)
+    {
+        return rendererGetDrawQueueStats(out stats);
+    }
+
+    /// <summary>
+    /// 获取设备内存的预算与用量报告.
+    /// </summary>
+    /// <returns><c>true</c> 如果渲染器已初始化</returns>
+    public static bool TryGetMemoryBudget(out MemoryBudgetReport report)
+    {
+        return rendererGetMemoryBudget(out report);
+    }
+
+    /// <summary>
+    /// 网格池整理每帧最多搬移的字节数（默认 1 MiB），为 0 时关闭整理. 需在 <see cref="Initialize"/> 之后设置.
+    /// </summary>
+    public static ulong MeshDefragBudget
+    {
+        get => _meshDefragBudget;
+        set
+        {
+            _meshDefragBudget = value;
+            rendererSetMeshDefragBudget(value);
+        }
+    }
+    private static ulong _meshDefragBudget = 1024 * 1024;
+
+    /// <summary>
+    /// 获取网格池整理的统计信息.
+    /// </summary>
+    /// <returns><c>true</c> 如果渲染器已初始化</returns>
+    public static bool TryGetMeshDefragStats(out MeshDefragStats stats)
+    {
+        return rendererGetMeshDefragStats(out stats);
+    }
+
+    /// <summary>
+    /// 是否记录各阶段的 CPU 区间与 GPU 时间戳区间（也可由环境变量 <c>NATIVELIB_TRACE=1</c> 开启）.
+    /// <para>可在 <see cref="Preinitialize"/> 之前设置，以便记录上下文的构建过程.</para>
+    /// </summary>
+    public static bool Tracing
+    {
+        get => rendererIsTracing();
+        set => rendererSetTracing(value);
+    }
+
+    /// <summary>
+    /// 把最近 <paramref name="seconds"/> 秒的追踪事件写为 Chrome Trace Event JSON，可由 Perfetto（ui.perfetto.dev）打开.
+    /// <para>CPU 区间按线程显示，GPU 区间换算到 CPU 时钟后显示在单独的 GPU 轨道上.</para>
+    /// </summary>
+    /// <param name="seconds">不大于 0 时写出环中的全部事件</param>
+    /// <returns><c>true</c> 如果成功写出</returns>
+    public static bool CaptureTrace(string path, double seconds = 10.0)
+    {
+        return rendererCaptureTrace(path, seconds);
+    }
+
     public static void Release()
     {
         rendererRelease();
+        Scene.Reset();
     }
 }
\ No newline at end of file
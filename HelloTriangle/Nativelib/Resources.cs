@@ -0,0 +1,189 @@
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 原生资源表中的句柄（索引 + 代数），资源被销毁后旧句柄即失效，不会误指向新资源.
+/// </summary>
+public readonly record struct ResourceHandle(ulong Value)
+{
+    public static readonly ResourceHandle Invalid = new(0);
+
+    public bool IsValid => Value != 0;
+}
+
+/// <summary>
+/// 与原生 <c>RendererBufferUsage</c> 一致的缓冲用途标志.
+/// </summary>
+[Flags]
+public enum BufferUsage : uint
+{
+    Vertex = 1u << 0,
+    Index = 1u << 1,
+    /// <summary>计算着色器可以经 <see cref="Resources.GetBufferAddress"/> 读写，使用异步计算时在队列间共享.</summary>
+    Storage = 1u << 2,
+    Uniform = 1u << 3,
+    /// <summary>主机可见并常驻映射，可用 <see cref="Resources.GetBufferData"/> 直接写入.</summary>
+    HostVisible = 1u << 4,
+    /// <summary>
+    /// 每帧由 CPU 就地写入的动态数据：常驻映射，<see cref="Resources.SupportsDirectWrite"/> 时位于显存中
+    /// （只应顺序写入、不应读取），否则同 <see cref="HostVisible"/>.
+    /// </summary>
+    Dynamic = 1u << 5,
+}
+
+/// <summary>
+/// 与原生 <c>PulledVertex</c> 布局一致的顶点拉取网格顶点.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct PulledVertex
+{
+    public float X, Y, Z;
+
+    public float R, G, B;
+
+    public PulledVertex(float x, float y, float z, float r, float g, float b)
+    {
+        X = x; Y = y; Z = z;
+        R = r; G = g; B = b;
+    }
+}
+
+/// <summary>
+/// 以句柄管理的 GPU 资源，销毁会被推迟到 GPU 不再使用之后.
+/// <para>需在 <see cref="Renderer.Initialize"/> 之后使用.</para>
+/// </summary>
+public static unsafe partial class Resources
+{
+    const string library = "nativelib_renderer";
+
+    [LibraryImport(library)]
+    private static partial ulong rendererCreateBuffer(ulong size, uint usage);
+
+    [LibraryImport(library)]
+    private static partial void* rendererGetBufferData(ulong buffer, out ulong size);
+
+    [LibraryImport(library)]
+    private static partial ulong rendererGetBufferAddress(ulong buffer);
+
+    [LibraryImport(library)]
+    private static partial ulong rendererCreateMesh(ulong vertexBuffer, ulong indexBuffer, uint vertexCount, uint indexCount);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererSupportsVertexPulling();
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererSupportsDirectWrite();
+
+    [LibraryImport(library)]
+    private static partial ulong rendererCreatePulledMesh(PulledVertex* vertices, uint vertexCount, uint* indices, uint indexCount);
+
+    [LibraryImport(library)]
+    private static partial void rendererDestroyResource(ulong resource);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererIsResourceAlive(ulong resource);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererIsResourceResident(ulong resource);
+
+
+    /// <summary>
+    /// 创建一个缓冲.
+    /// </summary>
+    /// <returns>缓冲的句柄，失败时为 <see cref="ResourceHandle.Invalid"/></returns>
+    public static ResourceHandle CreateBuffer(ulong size, BufferUsage usage)
+    {
+        return new ResourceHandle(rendererCreateBuffer(size, (uint)usage));
+    }
+
+    /// <summary>
+    /// 主机可见缓冲的映射内存，句柄过期或缓冲不可映射时为空.
+    /// </summary>
+    /// <param name="size">需要的字节数，超出缓冲大小的部分被截去</param>
+    public static Span<byte> GetBufferData(ResourceHandle buffer, int size)
+    {
+        void* data = rendererGetBufferData(buffer.Value, out ulong bufferSize);
+        if (data == null || size <= 0)
+            return Span<byte>.Empty;
+
+        return new Span<byte>(data, (int)Math.Min((ulong)size, bufferSize));
+    }
+
+    /// <summary>
+    /// <see cref="BufferUsage.Storage"/> 缓冲的设备地址，作为推送常量传给计算着色器（GLSL 的 buffer_reference）.
+    /// </summary>
+    /// <returns>句柄过期、不是存储缓冲或设备不支持时为 0</returns>
+    public static ulong GetBufferAddress(ResourceHandle buffer)
+    {
+        return rendererGetBufferAddress(buffer.Value);
+    }
+
+    /// <summary>
+    /// 由顶点缓冲与（可选的）索引缓冲创建网格，网格接管两者的所有权.
+    /// 顶点布局与 <see cref="PulledVertex"/> 相同，索引为 32 位.
+    /// <para>不可映射的设备本地缓冲（存储缓冲除外）超出内存预算时可能被驱逐，使用它们的绘制被跳过，
+    /// 由 <see cref="IsResident"/> 检查后重新创建；主机可见的缓冲不会被驱逐.</para>
+    /// </summary>
+    public static ResourceHandle CreateMesh(ResourceHandle vertexBuffer, ResourceHandle indexBuffer, uint vertexCount, uint indexCount)
+    {
+        return new ResourceHandle(rendererCreateMesh(vertexBuffer.Value, indexBuffer.Value, vertexCount, indexCount));
+    }
+
+    /// <summary>
+    /// 设备是否支持顶点拉取网格（<see cref="CreatePulledMesh"/>）.
+    /// </summary>
+    public static bool SupportsVertexPulling => rendererSupportsVertexPulling();
+
+    /// <summary>
+    /// <see cref="BufferUsage.Dynamic"/> 缓冲是否位于可主机写入的显存中（ReBAR、集成显卡或 lavapipe），
+    /// 此时每帧的动态数据只需一次 memcpy，不经过暂存缓冲.
+    /// </summary>
+    public static bool SupportsDirectWrite => rendererSupportsDirectWrite();
+
+    /// <summary>
+    /// 在共享的网格池中创建一个顶点拉取网格（数据被拷贝，调用返回后即可释放）.
+    /// <para>不需要顶点输入布局，所有拉取网格共用一个管线，相邻的绘制会被合并.</para>
+    /// </summary>
+    /// <param name="indices">为空时按顶点顺序绘制</param>
+    /// <returns>网格的句柄，设备不支持或网格池已满时为 <see cref="ResourceHandle.Invalid"/></returns>
+    public static ResourceHandle CreatePulledMesh(ReadOnlySpan<PulledVertex> vertices, ReadOnlySpan<uint> indices = default)
+    {
+        fixed (PulledVertex* pVertices = vertices)
+        fixed (uint* pIndices = indices)
+        {
+            uint indexCount = indices.IsEmpty ? (uint)vertices.Length : (uint)indices.Length;
+
+            return new ResourceHandle(rendererCreatePulledMesh(pVertices, (uint)vertices.Length,
+                indices.IsEmpty ? null : pIndices, indexCount));
+        }
+    }
+
+    /// <summary>
+    /// 销毁资源，句柄立即失效.
+    /// </summary>
+    public static void Destroy(ResourceHandle resource)
+    {
+        rendererDestroyResource(resource.Value);
+    }
+
+    /// <summary>
+    /// 句柄是否仍指向一个存活的资源.
+    /// </summary>
+    public static bool IsAlive(ResourceHandle resource)
+    {
+        return rendererIsResourceAlive(resource.Value);
+    }
+
+    /// <summary>
+    /// 资源是否存活且未因超出内存预算被驱逐.
+    /// </summary>
+    public static bool IsResident(ResourceHandle resource)
+    {
+        return rendererIsResourceResident(resource.Value);
+    }
+}
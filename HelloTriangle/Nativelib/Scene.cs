@@ -0,0 +1,239 @@
+using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace HelloTriangle.Nativelib;
+
+/// <summary>
+/// 与原生 <c>SceneView</c> 结构体布局一致的场景数组描述.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal struct SceneView
+{
+    public nint Transforms;
+    public nint Bounds;
+    public nint Positions;
+    public nint Rotations;
+    public nint Scales;
+    public nint LocalBounds;
+    public nint Parents;
+    public nint MeshIds;
+    public nint MaterialIds;
+    public nint Flags;
+    public uint Capacity;
+    public uint Count;
+}
+
+/// <summary>
+/// 与原生 <c>SceneObjectFlags</c> 一致的对象标志.
+/// </summary>
+[Flags]
+public enum SceneObjectFlags : uint
+{
+    None    = 0,
+    Alive   = 1 << 0,
+    Visible = 1 << 1,
+}
+
+/// <summary>
+/// 原生层的结构数组（SoA）场景存储，各数组以 <see cref="Span{T}"/> 直接访问原生内存（不发生拷贝、不封送）.
+/// <para>修改后用 <see cref="MarkDirty(int)"/> 记录范围，并在 <see cref="Renderer.BeginFrame"/> 之前调用一次 <see cref="Commit"/>.</para>
+/// </summary>
+public static unsafe partial class Scene
+{
+    const string library = "nativelib_renderer";
+
+    /// <summary>
+    /// 句柄低位存放数组下标，高位存放代数（与原生 <c>SCENE_HANDLE_INDEX_BITS</c> 一致）.
+    /// </summary>
+    public const int HandleIndexBits = 20;
+
+    public const uint InvalidHandle = 0;
+
+    [LibraryImport(library)]
+    private static partial uint rendererCreateObject();
+
+    [LibraryImport(library)]
+    private static partial void rendererDestroyObject(uint handle);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererGetScene(out SceneView view);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool rendererSetParent(uint child, uint parent);
+
+    [LibraryImport(library)]
+    private static partial void rendererUpdateScene(uint begin, uint end);
+
+    [LibraryImport(library)]
+    private static partial void rendererMarkSceneDirty(uint begin, uint end);
+
+
+    private static SceneView _view;
+
+    private static int _dirtyBegin = int.MaxValue;
+    private static int _dirtyEnd;
+
+    /// <summary>
+    /// 数组的容量（各 Span 的长度）.
+    /// </summary>
+    public static int Capacity => (int)View.Capacity;
+
+    /// <summary>
+    /// 曾使用过的最大下标 + 1，线性遍历只需覆盖 [0, Count).
+    /// </summary>
+    public static int Count { get; private set; }
+
+    /// <summary>
+    /// 列主序的模型矩阵（与 GLSL 的 <c>mat4</c> 布局一致）.
+    /// </summary>
+    public static Span<Matrix4x4> Transforms => new((void*)View.Transforms, Capacity);
+
+    /// <summary>
+    /// 包围球：xyz 为中心，w 为半径.
+    /// </summary>
+    public static Span<Vector4> Bounds => new((void*)View.Bounds, Capacity);
+
+    /// <summary>
+    /// 局部平移（w 不使用），由 <see cref="UpdateTransforms()"/> 合成为 <see cref="Transforms"/>.
+    /// </summary>
+    public static Span<Vector4> Positions => new((void*)View.Positions, Capacity);
+
+    /// <summary>
+    /// 局部旋转（单位四元数）.
+    /// </summary>
+    public static Span<Quaternion> Rotations => new((void*)View.Rotations, Capacity);
+
+    /// <summary>
+    /// 局部缩放（w 不使用）.
+    /// </summary>
+    public static Span<Vector4> Scales => new((void*)View.Scales, Capacity);
+
+    /// <summary>
+    /// 局部包围球，由 <see cref="UpdateTransforms()"/> 变换为 <see cref="Bounds"/>.
+    /// </summary>
+    public static Span<Vector4> LocalBounds => new((void*)View.LocalBounds, Capacity);
+
+    /// <summary>
+    /// 父对象的下标，没有父对象时为 <see cref="uint.MaxValue"/>（用 <see cref="SetParent"/> 修改）.
+    /// </summary>
+    public static ReadOnlySpan<uint> Parents => new((void*)View.Parents, Capacity);
+
+    public static Span<uint> MeshIds => new((void*)View.MeshIds, Capacity);
+
+    public static Span<uint> MaterialIds => new((void*)View.MaterialIds, Capacity);
+
+    public static Span<SceneObjectFlags> Flags => new((void*)View.Flags, Capacity);
+
+    private static ref readonly SceneView View
+    {
+        get
+        {
+            // 数组地址在渲染器的生命周期内不变，只需获取一次
+            if (_view.Capacity == 0 && rendererGetScene(out _view))
+                Count = (int)_view.Count;
+
+            return ref _view;
+        }
+    }
+
+    /// <summary>
+    /// 渲染器释放后原生数组不再有效，丢弃缓存的地址.
+    /// </summary>
+    internal static void Reset()
+    {
+        _view       = default;
+        Count       = 0;
+        _dirtyBegin = int.MaxValue;
+        _dirtyEnd   = 0;
+    }
+
+    /// <summary>
+    /// 创建一个对象（变换为单位矩阵，可见），需在 <see cref="Renderer.Initialize"/> 之后调用.
+    /// </summary>
+    /// <returns>对象句柄，场景已满时返回 <see cref="InvalidHandle"/></returns>
+    public static uint CreateObject()
+    {
+        uint handle = rendererCreateObject();
+        if (handle != InvalidHandle)
+            Count = Math.Max(Count, IndexOf(handle) + 1);
+
+        return handle;
+    }
+
+    /// <summary>
+    /// 销毁对象，其句柄随即失效，下标之后可能被新对象复用.
+    /// </summary>
+    public static void DestroyObject(uint handle)
+    {
+        rendererDestroyObject(handle);
+    }
+
+    /// <summary>
+    /// 设置对象的父对象，父对象需先于子对象创建（其下标更小）.
+    /// </summary>
+    /// <param name="parent">父对象句柄，<see cref="InvalidHandle"/> 表示解除父子关系</param>
+    /// <returns><c>true</c> 如果设置成功</returns>
+    public static bool SetParent(uint child, uint parent)
+    {
+        return rendererSetParent(child, parent);
+    }
+
+    /// <summary>
+    /// 由局部平移 / 旋转 / 缩放批量计算所有对象的世界矩阵与世界包围球（原生 SIMD 实现），
+    /// 并在下一次 <see cref="Renderer.BeginFrame"/> 时上传，无需再调用 <see cref="MarkDirty(int)"/>.
+    /// </summary>
+    public static void UpdateTransforms()
+    {
+        UpdateTransforms(0, Count);
+    }
+
+    /// <summary>
+    /// 同 <see cref="UpdateTransforms()"/>，只处理下标范围 [<paramref name="begin"/>, <paramref name="end"/>)，
+    /// 范围内对象的父对象需已是最新的.
+    /// </summary>
+    public static void UpdateTransforms(int begin, int end)
+    {
+        rendererUpdateScene((uint)begin, (uint)end);
+    }
+
+    /// <summary>
+    /// 由句柄得到其在各数组中的下标（不校验句柄是否仍然有效）.
+    /// </summary>
+    public static int IndexOf(uint handle)
+    {
+        return (int)(handle & ((1u << HandleIndexBits) - 1));
+    }
+
+    /// <summary>
+    /// 记录下标 <paramref name="index"/> 处的数据已被修改（仅在托管侧合并范围，不调用原生层）.
+    /// </summary>
+    public static void MarkDirty(int index)
+    {
+        MarkDirty(index, index + 1);
+    }
+
+    /// <summary>
+    /// 记录下标范围 [<paramref name="begin"/>, <paramref name="end"/>) 的数据已被修改.
+    /// </summary>
+    public static void MarkDirty(int begin, int end)
+    {
+        _dirtyBegin = Math.Min(_dirtyBegin, begin);
+        _dirtyEnd   = Math.Max(_dirtyEnd, end);
+    }
+
+    /// <summary>
+    /// 将本帧记录的修改范围一次性提交给原生层，在下一次 <see cref="Renderer.BeginFrame"/> 时上传到 GPU.
+    /// </summary>
+    public static void Commit()
+    {
+        if (_dirtyBegin >= _dirtyEnd)
+            return;
+
+        rendererMarkSceneDirty((uint)_dirtyBegin, (uint)_dirtyEnd);
+
+        _dirtyBegin = int.MaxValue;
+        _dirtyEnd   = 0;
+    }
+}
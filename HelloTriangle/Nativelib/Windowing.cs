@@ -10,6 +10,13 @@ public static partial class Windowing
     const string library = "nativelib_windowing";
     
 
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool initializeWindowing();
+
+    [LibraryImport(library, StringMarshalling = StringMarshalling.Utf8)]
+    private static partial Window createWindow(int width, int height, string title);
+
     [LibraryImport(library, StringMarshalling = StringMarshalling.Utf8)]
     private static partial Window initializeWindow(int width, int height, string title);
 
@@ -25,10 +32,74 @@ public static partial class Windowing
     [LibraryImport(library)]
     private static partial void terminate();
 
+    [LibraryImport(library)]
+    private static partial int getWindowState(Window window);
+
+    [LibraryImport(library)]
+    private static partial void setBackgroundFrameRate(double framesPerSecond);
+
+    [LibraryImport(library)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    private static partial bool waitEventsForFrame(Window window);
+
+    [LibraryImport(library)]
+    private static unsafe partial uint drainInputEvents(InputEvent** events);
+
+    [LibraryImport(library)]
+    private static partial uint getDroppedInputEventCount();
+
 
     public static Window Handle {get; private set;} = null!;
 
 
+    /// <summary>
+    /// 初始化 GLFW 库（不创建窗口），之后使用 <see cref="CreateWindow"/> 创建窗口.
+    /// </summary>
+    /// <returns><c>true</c> 如果初始化成功</returns>
+    public static bool Initialize()
+    {
+        return initializeWindowing();
+    }
+
+    /// <summary>
+    /// 创建一个窗口，需先调用 <see cref="Initialize"/>.
+    /// </summary>
+    /// <param name="width"></param>
+    /// <param name="height"></param>
+    /// <param name="title"></param>
+    public static void CreateWindow(int width, int height, string title)
+    {
+        Handle = createWindow(width, height, title);
+    }
+
+    /// <summary>
+    /// 另外创建一个窗口（不会替换 <see cref="Handle"/>），需先调用 <see cref="Initialize"/>.
+    /// </summary>
+    /// <returns>一个创建好的 <see cref="Window"/> 对象，使用 <see cref="Window.IsInvalid"/> 来检查其是否有效</returns>
+    public static Window OpenWindow(int width, int height, string title)
+    {
+        return createWindow(width, height, title);
+    }
+
+    /// <summary>
+    /// 销毁由 <see cref="OpenWindow"/> 创建的窗口.
+    /// </summary>
+    /// <param name="window">要销毁的窗口</param>
+    public static void DestroyWindow(Window window)
+    {
+        destroyWindow(window);
+    }
+
+    /// <summary>
+    /// 检查给定窗口是否 Close 标志位为 1.
+    /// </summary>
+    /// <param name="window">给定窗口</param>
+    /// <returns><c>true</c> 如果窗口的 Close 标志位为 1.</returns>
+    public static bool WindowShouldClose(Window window)
+    {
+        return windowShouldClose(window) == 1;
+    }
+
     /// <summary>
     /// 初始化 GLFW 库并创建一个窗口.
     /// </summary>
@@ -71,6 +142,53 @@ public static partial class Windowing
         pollEvents();
     }
 
+    /// <summary>
+    /// 查询 <see cref="Handle"/> 的活动状态.
+    /// </summary>
+    public static WindowState State => (WindowState)getWindowState(Handle);
+
+    /// <summary>
+    /// 窗口失去焦点时的帧率上限，为 0 时不限制.
+    /// </summary>
+    public static double BackgroundFrameRate
+    {
+        get => _backgroundFrameRate;
+        set
+        {
+            _backgroundFrameRate = value;
+            setBackgroundFrameRate(value);
+        }
+    }
+    private static double _backgroundFrameRate;
+
+    /// <summary>
+    /// 处理窗口事件，并在 <see cref="Handle"/> 最小化或处于后台时等待，代替 <see cref="PollEvents"/> 使用.
+    /// </summary>
+    /// <returns><c>true</c> 如果本帧应当渲染</returns>
+    public static bool WaitEventsForFrame()
+    {
+        return waitEventsForFrame(Handle);
+    }
+
+    /// <summary>
+    /// 取出自上一次调用以来的所有输入事件（键盘、鼠标、滚轮、帧缓冲大小与焦点），
+    /// 每帧在 <see cref="WaitEventsForFrame"/> 之后调用一次.
+    /// <para>事件由原生回调写入一个固定容量的环，整批取出只需一次互操作调用且不分配托管内存.
+    /// 返回的 span 指向原生内存，在下一次调用前有效.</para>
+    /// </summary>
+    public static unsafe ReadOnlySpan<InputEvent> DrainInputEvents()
+    {
+        InputEvent* events = null;
+        uint count = drainInputEvents(&events);
+
+        return new ReadOnlySpan<InputEvent>(events, (int)count);
+    }
+
+    /// <summary>
+    /// 因长时间没有调用 <see cref="DrainInputEvents"/>、事件环已满而被丢弃的输入事件总数.
+    /// </summary>
+    public static uint DroppedInputEvents => getDroppedInputEventCount();
+
     /// <summary>
     /// 终止 GLFW 库.
     /// </summary>
@@ -79,4 +197,18 @@ public static partial class Windowing
         terminate();
     }
 
+}
+
+
+/// <summary>
+/// 与原生 <c>WindowState</c> 一致的窗口活动状态.
+/// </summary>
+public enum WindowState
+{
+    /// <summary>拥有焦点，全速渲染.</summary>
+    Active = 0,
+    /// <summary>失去焦点但可见，受 <see cref="Windowing.BackgroundFrameRate"/> 约束.</summary>
+    Background = 1,
+    /// <summary>最小化或帧缓冲大小为 0，不应渲染.</summary>
+    Minimized = 2,
 }
\ No newline at end of file
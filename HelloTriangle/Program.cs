@@ -2,9 +2,33 @@
 
 internal class Program
 {
-    private static void Main(string[] args)
+    /// <summary>
+    /// 参数：<c>--trace</c> 开启追踪（F12 导出）；<c>--check-allocations [帧数]</c> 以自检模式运行，
+    /// 检查主循环不产生托管分配.
+    /// </summary>
+    private static int Main(string[] args)
     {
-        HelloTriangleApplication app = new();
-        app.Run();
+        int allocationCheckFrames = 0;
+        bool tracing = false;
+        for (int i = 0; i < args.Length; i++)
+        {
+            if (args[i] == "--trace")
+                tracing = true;
+            else if (args[i] == "--check-allocations")
+            {
+                allocationCheckFrames = DefaultAllocationCheckFrames;
+                if (i + 1 < args.Length && int.TryParse(args[i + 1], out int frames) && frames > 0)
+                    allocationCheckFrames = frames;
+            }
+        }
+
+        HelloTriangleApplication app = new()
+        {
+            AllocationCheckFrames = allocationCheckFrames,
+            Tracing = tracing,
+        };
+        return app.Run();
     }
+
+    private const int DefaultAllocationCheckFrames = 600;
 }
\ No newline at end of file
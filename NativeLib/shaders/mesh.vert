@@ -0,0 +1,22 @@
+#version 450
+
+// 经典网格：顶点由顶点缓冲（绑定 0）输入，布局与 PulledVertex 相同（见 src/renderer/mesh_arena.h）
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+
+// 每个对象的 uniform 数据（与 src/renderer/uniform_ring.h 的 ObjectUniforms 一致），
+// 未绑定时为环形缓冲中常驻的默认值（不平移、颜色不变）
+layout(set = 0, binding = 0) uniform ObjectUniforms
+{
+    vec4 offset;        // 裁剪空间中的平移（xyz）
+    vec4 color;         // 与顶点颜色相乘（rgb）
+} object;
+
+layout(location = 0) out vec3 fragColor;
+
+void main()
+{
+    gl_Position = vec4(inPosition + object.offset.xyz, 1.0);
+    fragColor = inColor * object.color.rgb;
+}
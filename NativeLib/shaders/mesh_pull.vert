@@ -0,0 +1,43 @@
+#version 450
+#extension GL_EXT_buffer_reference : require
+
+// 顶点拉取：没有顶点输入，顶点与索引由推送常量中的设备地址直接读取（见 src/renderer/mesh_arena.h）
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer Vertices
+{
+    float values[];     // 每个顶点 6 个 float：位置 xyz，颜色 rgb
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer Indices
+{
+    uint values[];      // 顶点块内的绝对下标
+};
+
+layout(push_constant) uniform MeshPushConstants
+{
+    Vertices vertices;
+    Indices indices;
+} mesh;
+
+// 每个对象的 uniform 数据（与 src/renderer/uniform_ring.h 的 ObjectUniforms 一致），
+// 未绑定时为环形缓冲中常驻的默认值（不平移、颜色不变）
+layout(set = 0, binding = 0) uniform ObjectUniforms
+{
+    vec4 offset;        // 裁剪空间中的平移（xyz）
+    vec4 color;         // 与顶点颜色相乘（rgb）
+} object;
+
+layout(location = 0) out vec3 fragColor;
+
+void main()
+{
+    // vkCmdDraw 的 firstVertex 即网格在索引块中的起点，gl_VertexIndex 直接是索引的下标
+    uint base = mesh.indices.values[gl_VertexIndex] * 6;
+
+    gl_Position = vec4(mesh.vertices.values[base + 0],
+                       mesh.vertices.values[base + 1],
+                       mesh.vertices.values[base + 2], 1.0) + vec4(object.offset.xyz, 0.0);
+    fragColor = vec3(mesh.vertices.values[base + 3],
+                     mesh.vertices.values[base + 4],
+                     mesh.vertices.values[base + 5]) * object.color.rgb;
+}
@@ -0,0 +1,38 @@
+#version 450
+
+// 顶点数据直接写在着色器中，不需要顶点缓冲
+
+vec2 positions[3] = vec2[](
+    vec2( 0.0, -0.5),
+    vec2( 0.5,  0.5),
+    vec2(-0.5,  0.5)
+);
+
+vec3 colors[3] = vec3[](
+    vec3(1.0, 0.0, 0.0),
+    vec3(0.0, 1.0, 0.0),
+    vec3(0.0, 0.0, 1.0)
+);
+
+// 每个对象的 uniform 数据（与 src/renderer/uniform_ring.h 的 ObjectUniforms 一致），
+// 未绑定时为环形缓冲中常驻的默认值（不平移、颜色不变）
+layout(set = 0, binding = 0) uniform ObjectUniforms
+{
+    vec4 offset;        // 裁剪空间中的平移（xyz）
+    vec4 color;         // 与顶点颜色相乘（rgb）
+} object;
+
+layout(location = 0) out vec3 fragColor;
+
+// 一次绘制多个三角形（或多个实例）时，第 n 个三角形在 16x16 的网格中错开 n 格，使其彼此可见
+const float TRIANGLE_STEP = 0.02;
+
+void main()
+{
+    uint corner     = uint(gl_VertexIndex) % 3u;
+    uint triangle   = uint(gl_VertexIndex) / 3u + uint(gl_InstanceIndex);
+    vec2 offset     = vec2(float(triangle % 16u), float((triangle / 16u) % 16u)) * TRIANGLE_STEP;
+
+    gl_Position = vec4(positions[corner] + offset, 0.0, 1.0) + vec4(object.offset.xyz, 0.0);
+    fragColor = colors[corner] * object.color.rgb;
+}
@@ -0,0 +1,661 @@
+// 渲染器基准测试：以无头模式驱动渲染器执行固定的工作负载，并把各项 CPU / GPU 耗时的
+// min / median / p99 以 JSON 输出，可在 lavapipe 等软件实现上运行.
+//
+// 用法：nativelib_benchmark [--iterations N] [--frames N] [--draws N] [--upload-mb M]
+//                           [--objects N] [--width W] [--height H] [--output PATH|-]
+//
+// 注意：驱动自身可能带有着色器磁盘缓存（如 Mesa 的 MESA_SHADER_CACHE_DISABLE），
+// 测量 "冷" 管线创建时应将其关闭.
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "../common/ansi_esc.h"
+#include "../renderer/render_context.h"
+#include "../renderer/upload_context.h"
+#include "../renderer/scene_store.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/// @brief 基准测试的参数.
+typedef struct BenchmarkOptions {
+    uint32_t        iterations;             // 上下文创建、渲染目标重建、上传与管线创建的重复次数
+    uint32_t        frames;                 // 帧工作负载的帧数
+    uint32_t        draws;                  // 每帧的绘制调用数
+    uint32_t        uploadMegabytes;        // 每次上传的数据量（MB）
+    uint32_t        objects;                // 场景更新工作负载的对象数
+    VkExtent2D      extent;                 // 离屏图像的大小
+    const char*     outputPath;             // 结果输出路径，"-" 表示标准输出
+} BenchmarkOptions;
+
+/// @brief 一组耗时样本（毫秒）.
+typedef struct Samples {
+    double*         values;
+    uint32_t        count;
+    uint32_t        capacity;
+} Samples;
+
+/// @brief 一项工作负载的测量结果.
+typedef struct WorkloadResult {
+    const char*     name;
+    Samples         cpu;
+    Samples         gpu;                    // 不支持时间戳或不适用时为空
+    int64_t         vulkanAllocations;      // 测量期间驱动经由分配回调的分配次数，< 0 表未统计
+} WorkloadResult;
+
+enum {
+    WORKLOAD_CONTEXT_CREATE,
+    WORKLOAD_RENDER_TARGET_REBUILD,
+    WORKLOAD_FRAMES,
+    WORKLOAD_UPLOAD,
+    WORKLOAD_PIPELINE_COLD,
+    WORKLOAD_PIPELINE_WARM,
+    WORKLOAD_SCENE_UPDATE,
+    WORKLOAD_COUNT
+};
+
+static double now_ms(void);
+static bool parse_options(int argc, char** argv, BenchmarkOptions* pOptions);
+static bool samples_reserve(Samples* pSamples, uint32_t capacity);
+static void samples_push(Samples* pSamples, double value);
+static void samples_free(Samples* pSamples);
+static void write_samples_json(FILE* file, const char* key, Samples* pSamples);
+static bool write_results_json(
+    const BenchmarkOptions* pOptions,
+    const char*             deviceName,
+    WorkloadResult*         pResults
+);
+
+static bool run_context_create(const BenchmarkOptions* pOptions, WorkloadResult* pResult);
+static bool run_render_target_rebuild(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pResult
+);
+static bool run_frames(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pResult
+);
+static bool run_upload(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pResult
+);
+static bool run_scene_update(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pResult
+);
+static bool run_pipeline_creation(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pColdResult,
+    WorkloadResult*         pWarmResult
+);
+
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options = {
+        .iterations         = 10,
+        .frames             = 300,
+        .draws              = 100,
+        .uploadMegabytes    = 64,
+        .objects            = 50000,
+        .extent             = { 1280, 720 },
+        .outputPath         = "benchmark_result.json"
+    };
+
+    if (!parse_options(argc, argv, &options))
+        return 2;
+
+    WorkloadResult results[WORKLOAD_COUNT] = {
+        [WORKLOAD_CONTEXT_CREATE]           = { .name = "context_create" },
+        [WORKLOAD_RENDER_TARGET_REBUILD]    = { .name = "render_target_rebuild" },
+        [WORKLOAD_FRAMES]                   = { .name = "frames" },
+        [WORKLOAD_UPLOAD]                   = { .name = "upload" },
+        [WORKLOAD_PIPELINE_COLD]            = { .name = "pipeline_create_cold" },
+        [WORKLOAD_PIPELINE_WARM]            = { .name = "pipeline_create_warm" },
+        [WORKLOAD_SCENE_UPDATE]             = { .name = "scene_update" },
+    };
+
+    for (uint32_t i = 0; i < WORKLOAD_COUNT; i++)
+        results[i].vulkanAllocations = -1;
+
+    bool succeeded = run_context_create(&options, &results[WORKLOAD_CONTEXT_CREATE]);
+
+    // 其余工作负载共用同一个无头渲染上下文
+    RenderContext* pContext = new_render_context();
+    if (!pContext || !create_headless_render_context(options.extent, pContext))
+    {
+        fprintf(stderr, "%s : 无法创建无头渲染上下文！\n", __func__);
+        if (pContext)
+            destroy_render_context(pContext);
+        return 1;
+    }
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(pContext->physicalDevice, &properties);
+
+    succeeded = succeeded
+        && run_render_target_rebuild(&options, pContext,
+               &results[WORKLOAD_RENDER_TARGET_REBUILD])
+        && run_frames(&options, pContext, &results[WORKLOAD_FRAMES])
+        && run_upload(&options, pContext, &results[WORKLOAD_UPLOAD])
+        && run_pipeline_creation(&options, pContext,
+               &results[WORKLOAD_PIPELINE_COLD],
+               &results[WORKLOAD_PIPELINE_WARM])
+        && run_scene_update(&options, pContext, &results[WORKLOAD_SCENE_UPDATE]);
+
+    if (succeeded)
+        succeeded = write_results_json(&options, properties.deviceName, results);
+
+    destroy_render_context(pContext);
+
+    for (uint32_t i = 0; i < WORKLOAD_COUNT; i++)
+    {
+        samples_free(&results[i].cpu);
+        samples_free(&results[i].gpu);
+    }
+
+    return succeeded ? 0 : 1;
+}
+
+
+/// @brief 单调时钟的当前时间（毫秒）.
+static double now_ms(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec * 1e-6;
+#endif
+}
+
+
+/// @brief 解析命令行参数，未给出的参数保持默认值.
+static bool parse_options(int argc, char** argv, BenchmarkOptions* pOptions)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (value == NULL)
+        {
+            fprintf(stderr, "%s : 参数 %s 缺少值！\n", __func__, arg);
+            return false;
+        }
+
+        if (strcmp(arg, "--output") == 0)
+        {
+            pOptions->outputPath = value;
+            i++;
+            continue;
+        }
+
+        long number = strtol(value, NULL, 10);
+        if (number <= 0)
+        {
+            fprintf(stderr, "%s : 参数 %s 的值无效：%s\n", __func__, arg, value);
+            return false;
+        }
+
+        if (strcmp(arg, "--iterations") == 0)
+            pOptions->iterations = (uint32_t)number;
+        else if (strcmp(arg, "--frames") == 0)
+            pOptions->frames = (uint32_t)number;
+        else if (strcmp(arg, "--draws") == 0)
+            pOptions->draws = (uint32_t)number;
+        else if (strcmp(arg, "--upload-mb") == 0)
+            pOptions->uploadMegabytes = (uint32_t)number;
+        else if (strcmp(arg, "--objects") == 0)
+            pOptions->objects = (uint32_t)number;
+        else if (strcmp(arg, "--width") == 0)
+            pOptions->extent.width = (uint32_t)number;
+        else if (strcmp(arg, "--height") == 0)
+            pOptions->extent.height = (uint32_t)number;
+        else
+        {
+            fprintf(stderr, "%s : 未知参数 %s\n", __func__, arg);
+            return false;
+        }
+
+        i++;
+    }
+
+    return true;
+}
+
+
+/// @brief 工作负载：创建并销毁无头渲染上下文，只计创建耗时.
+static bool run_context_create(const BenchmarkOptions* pOptions, WorkloadResult* pResult)
+{
+    if (!samples_reserve(&pResult->cpu, pOptions->iterations))
+        return false;
+
+    for (uint32_t i = 0; i < pOptions->iterations; i++)
+    {
+        double start = now_ms();
+
+        RenderContext* pContext = new_render_context();
+        bool created = pContext && create_headless_render_context(pOptions->extent, pContext);
+
+        double end = now_ms();
+
+        if (pContext)
+            destroy_render_context(pContext);
+        if (!created)
+            return false;
+
+        samples_push(&pResult->cpu, end - start);
+    }
+
+    return true;
+}
+
+
+/// @brief 工作负载：重建渲染目标（离屏图像、渲染通道、帧缓冲与管线）.
+static bool run_render_target_rebuild(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pResult
+)
+{
+    if (!samples_reserve(&pResult->cpu, pOptions->iterations))
+        return false;
+
+    for (uint32_t i = 0; i < pOptions->iterations; i++)
+    {
+        double start = now_ms();
+
+        if (!recreate_surface_render_target(pContext, &pContext->surfaces[0]))
+            return false;
+
+        samples_push(&pResult->cpu, now_ms() - start);
+    }
+
+    return true;
+}
+
+
+/// @brief 工作负载：每帧 `draws` 次绘制调用，CPU 耗时为 begin_frame 到 end_frame 返回，
+/// GPU 耗时为该帧命令缓冲首尾时间戳之差.
+static bool run_frames(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pResult
+)
+{
+    if (!samples_reserve(&pResult->cpu, pOptions->frames)
+        || !samples_reserve(&pResult->gpu, pOptions->frames))
+        return false;
+
+    FrameContext* pFrameContext = &pContext->frameContext;
+
+    // 预热：填满在途帧，使之后每次 begin_frame 都能读到一帧的 GPU 耗时
+    uint32_t warmupFrames = MAX_FRAMES_IN_FLIGHT;
+
+    VulkanAllocationStats statsBefore;
+
+    for (uint32_t i = 0; i < warmupFrames + pOptions->frames; i++)
+    {
+        if (i == warmupFrames)
+            get_vulkan_allocation_stats(&statsBefore);
+
+        double start = now_ms();
+
+        if (!begin_frame(pContext))
+            return false;
+
+        bool measured = i >= warmupFrames;
+        if (measured && pFrameContext->lastGpuFrameTimeMs >= 0.0)
+            samples_push(&pResult->gpu, pFrameContext->lastGpuFrameTimeMs);
+
+        for (uint32_t d = 0; d < pOptions->draws; d++)
+            draw_triangles(pContext, 0, 1);
+
+        end_frame(pContext);
+
+        if (measured)
+            samples_push(&pResult->cpu, now_ms() - start);
+    }
+
+    // 热路径不应有任何驱动分配
+    VulkanAllocationStats statsAfter;
+    get_vulkan_allocation_stats(&statsAfter);
+
+    pResult->vulkanAllocations = (int64_t)(
+        statsAfter.allocationCount + statsAfter.reallocationCount
+        - statsBefore.allocationCount - statsBefore.reallocationCount);
+
+    vkDeviceWaitIdle(pContext->device);
+
+    return true;
+}
+
+
+/// @brief 工作负载：经由暂存缓冲向设备本地缓冲上传 `uploadMegabytes` MB 数据.
+static bool run_upload(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pResult
+)
+{
+    VkDeviceSize size = (VkDeviceSize)pOptions->uploadMegabytes * 1024 * 1024;
+
+    unsigned char* pData = (unsigned char*)malloc((size_t)size);
+    if (!pData)
+        return false;
+
+    for (VkDeviceSize i = 0; i < size; i++)
+        pData[i] = (unsigned char)i;
+
+    UploadContext uploadContext;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+
+    bool succeeded = samples_reserve(&pResult->cpu, pOptions->iterations)
+        && samples_reserve(&pResult->gpu, pOptions->iterations)
+        && create_upload_context(pContext->physicalDevice, pContext->device,
+               pContext->graphicsQueueFamilyIndex, &uploadContext);
+    if (!succeeded)
+    {
+        free(pData);
+        return false;
+    }
+
+    succeeded = createBuffer(pContext->physicalDevice, pContext->device, size,
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    MEMORY_CATEGORY_MESH,
+                    0, NULL,
+                    &buffer, &memory);
+
+    for (uint32_t i = 0; succeeded && i < pOptions->iterations; i++)
+    {
+        double start = now_ms();
+
+        succeeded = upload_to_buffer(pContext->device, pContext->graphicsQueue,
+                        &uploadContext, buffer, 0, pData, size);
+
+        double end = now_ms();
+
+        if (succeeded)
+        {
+            samples_push(&pResult->cpu, end - start);
+            if (uploadContext.lastGpuTimeMs >= 0.0)
+                samples_push(&pResult->gpu, uploadContext.lastGpuTimeMs);
+        }
+    }
+
+    destroyBuffer(pContext->device, buffer, memory);
+    destroy_upload_context(pContext->device, &uploadContext);
+    free(pData);
+
+    return succeeded;
+}
+
+
+/// @brief 工作负载：`objects` 个对象（三分之一挂在更早的对象下）的局部变换合成、层级传递
+/// 与包围球更新（在上下文的任务系统上并行），每次迭代前修改全部局部平移使其与真实的每帧
+/// 更新一致.
+static bool run_scene_update(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pResult
+)
+{
+    if (pOptions->objects > SCENE_HANDLE_INDEX_MASK)
+    {
+        fprintf(stderr, "%s : 对象数不能超过 %u！\n", __func__, SCENE_HANDLE_INDEX_MASK);
+        return false;
+    }
+
+    SceneStore scene;
+    if (!samples_reserve(&pResult->cpu, pOptions->frames)
+        || !create_scene_store(pContext->physicalDevice, pContext->device,
+               pOptions->objects, &scene))
+        return false;
+
+    uint32_t* pHandles = (uint32_t*)malloc(pOptions->objects * sizeof(uint32_t));
+    if (!pHandles)
+    {
+        destroy_scene_store(pContext->device, &scene);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < pOptions->objects; i++)
+    {
+        pHandles[i] = scene_create_object(&scene);
+        scene.pLocalBounds[i * 4 + 3] = 1.0f;
+
+        if (i > 0 && i % 3 == 0)
+            scene_set_parent(&scene, pHandles[i], pHandles[i / 2]);
+    }
+
+    for (uint32_t frame = 0; frame < pOptions->frames; frame++)
+    {
+        for (uint32_t i = 0; i < pOptions->objects; i++)
+            scene.pPositions[i * 4] = (float)frame;
+
+        double start = now_ms();
+
+        scene_update_transforms(&scene, &pContext->jobs, 0, scene.count);
+
+        samples_push(&pResult->cpu, now_ms() - start);
+    }
+
+    free(pHandles);
+    destroy_scene_store(pContext->device, &scene);
+
+    return true;
+}
+
+
+/// @brief 工作负载：创建三角形管线，冷（每次使用新的空管线缓存）与热（使用已填充的管线缓存）.
+static bool run_pipeline_creation(
+    const BenchmarkOptions* pOptions,
+    RenderContext*          pContext,
+    WorkloadResult*         pColdResult,
+    WorkloadResult*         pWarmResult
+)
+{
+    if (!samples_reserve(&pColdResult->cpu, pOptions->iterations)
+        || !samples_reserve(&pWarmResult->cpu, pOptions->iterations))
+        return false;
+
+    VkDevice device = pContext->device;
+
+    ShaderCode vertexCode   = get_triangle_vertex_shader_code();
+    ShaderCode fragmentCode = get_triangle_fragment_shader_code();
+
+    VkShaderModule vertexShader   = createShaderModule(device, vertexCode.pCode, vertexCode.size);
+    VkShaderModule fragmentShader = createShaderModule(device, fragmentCode.pCode, fragmentCode.size);
+
+    bool succeeded = vertexShader != VK_NULL_HANDLE && fragmentShader != VK_NULL_HANDLE;
+
+    VkPipelineCache warmCache = VK_NULL_HANDLE;
+
+    for (uint32_t pass = 0; succeeded && pass < 2; pass++)
+    {
+        bool warm = pass == 1;
+        WorkloadResult* pResult = warm ? pWarmResult : pColdResult;
+
+        // 热：先用一次创建填充缓存，之后的创建均命中该缓存
+        if (warm)
+        {
+            warmCache = load_pipeline_cache(pContext->physicalDevice, device, NULL);
+            VkPipeline pipeline = warmCache == VK_NULL_HANDLE ? VK_NULL_HANDLE :
+                createGraphicsPipeline(device, warmCache, pContext->pipelineLayout,
+                    pContext->surfaces[0].renderPass, vertexShader, fragmentShader, false);
+            if (pipeline == VK_NULL_HANDLE)
+            {
+                succeeded = false;
+                break;
+            }
+            destroyPipeline(device, pipeline);
+        }
+
+        for (uint32_t i = 0; succeeded && i < pOptions->iterations; i++)
+        {
+            VkPipelineCache cache = warm ? warmCache
+                : load_pipeline_cache(pContext->physicalDevice, device, NULL);
+            if (cache == VK_NULL_HANDLE)
+            {
+                succeeded = false;
+                break;
+            }
+
+            double start = now_ms();
+
+            VkPipeline pipeline = createGraphicsPipeline(device, cache,
+                                      pContext->pipelineLayout,
+                                      pContext->surfaces[0].renderPass,
+                                      vertexShader,
+                                      fragmentShader,
+                                      false);
+
+            double end = now_ms();
+
+            if (pipeline != VK_NULL_HANDLE)
+            {
+                samples_push(&pResult->cpu, end - start);
+                destroyPipeline(device, pipeline);
+            }
+            else
+                succeeded = false;
+
+            if (!warm)
+                vkDestroyPipelineCache(device, cache, NULL);
+        }
+    }
+
+    if (warmCache != VK_NULL_HANDLE)
+        vkDestroyPipelineCache(device, warmCache, NULL);
+    if (vertexShader != VK_NULL_HANDLE)
+        destroyShaderModule(device, vertexShader);
+    if (fragmentShader != VK_NULL_HANDLE)
+        destroyShaderModule(device, fragmentShader);
+
+    return succeeded;
+}
+
+
+static bool samples_reserve(Samples* pSamples, uint32_t capacity)
+{
+    pSamples->values = (double*)calloc(capacity, sizeof(double));
+    pSamples->count = 0;
+    pSamples->capacity = pSamples->values ? capacity : 0;
+
+    return pSamples->values != NULL;
+}
+
+static void samples_push(Samples* pSamples, double value)
+{
+    if (pSamples->count < pSamples->capacity)
+        pSamples->values[pSamples->count++] = value;
+}
+
+static void samples_free(Samples* pSamples)
+{
+    free(pSamples->values);
+    pSamples->values = NULL;
+    pSamples->count = pSamples->capacity = 0;
+}
+
+static int compare_doubles(const void* pA, const void* pB)
+{
+    double a = *(const double*)pA, b = *(const double*)pB;
+
+    return (a > b) - (a < b);
+}
+
+
+/// @brief 输出一组样本的统计值（会对样本排序），没有样本时输出 `null`.
+static void write_samples_json(FILE* file, const char* key, Samples* pSamples)
+{
+    if (pSamples->count == 0)
+    {
+        fprintf(file, "\"%s\": null", key);
+        return;
+    }
+
+    qsort(pSamples->values, pSamples->count, sizeof(double), compare_doubles);
+
+    // p99 取最近秩（nearest-rank）
+    uint32_t count = pSamples->count;
+    uint32_t p99Rank = (uint32_t)((99ull * count + 99) / 100);
+    double median = count % 2 == 1 ? pSamples->values[count / 2]
+        : 0.5 * (pSamples->values[count / 2 - 1] + pSamples->values[count / 2]);
+
+    fprintf(file, "\"%s\": { \"samples\": %u, \"min\": %.4f, \"median\": %.4f, \"p99\": %.4f }",
+        key, count, pSamples->values[0], median, pSamples->values[p99Rank - 1]);
+}
+
+
+static bool write_results_json(
+    const BenchmarkOptions* pOptions,
+    const char*             deviceName,
+    WorkloadResult*         pResults
+)
+{
+    bool toStdout = strcmp(pOptions->outputPath, "-") == 0;
+
+    FILE* file = toStdout ? stdout : fopen(pOptions->outputPath, "w");
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s : 无法写入结果文件 %s！\n", __func__, pOptions->outputPath);
+        return false;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"device\": \"%s\",\n", deviceName);
+    fprintf(file, "  \"config\": { \"iterations\": %u, \"frames\": %u, \"draws\": %u, "
+        "\"upload_mb\": %u, \"objects\": %u, \"width\": %u, \"height\": %u, \"simd\": \"%s\" },\n",
+        pOptions->iterations, pOptions->frames, pOptions->draws,
+        pOptions->uploadMegabytes, pOptions->objects, pOptions->extent.width, pOptions->extent.height,
+        simd_level_name(get_simd_level()));
+    fprintf(file, "  \"workloads\": {\n");
+
+    for (uint32_t i = 0; i < WORKLOAD_COUNT; i++)
+    {
+        fprintf(file, "    \"%s\": { ", pResults[i].name);
+        write_samples_json(file, "cpu_ms", &pResults[i].cpu);
+        fprintf(file, ", ");
+        write_samples_json(file, "gpu_ms", &pResults[i].gpu);
+        if (pResults[i].vulkanAllocations >= 0)
+            fprintf(file, ", \"vulkan_allocations\": %lld",
+                (long long)pResults[i].vulkanAllocations);
+        fprintf(file, " }%s\n", i + 1 < WORKLOAD_COUNT ? "," : "");
+    }
+
+    fprintf(file, "  }\n}\n");
+
+    if (!toStdout)
+    {
+        fclose(file);
+        fprintf(stdout,
+            ESC_LTALIC "%s %s " ESC_RESET "基准测试结果已写入 %s.\n",
+            __DATE__, __TIME__, pOptions->outputPath);
+    }
+
+    return true;
+}
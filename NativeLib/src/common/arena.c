@@ -0,0 +1,94 @@
+#include "arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+
+bool arena_init(Arena* pArena, size_t capacity)
+{
+    memset(pArena, 0, sizeof(Arena));
+
+    pArena->pBase = (unsigned char*)malloc(capacity);
+    if (pArena->pBase == NULL)
+    {
+        fprintf(stderr, "%s : 无法为 Arena 分配 %zu 字节！\n", __func__, capacity);
+        return false;
+    }
+
+    pArena->capacity    = capacity;
+    pArena->ownsMemory  = true;
+
+    return true;
+}
+
+
+void arena_init_from(Arena* pArena, void* pMemory, size_t capacity)
+{
+    memset(pArena, 0, sizeof(Arena));
+
+    pArena->pBase       = (unsigned char*)pMemory;
+    pArena->capacity    = pMemory != NULL ? capacity : 0;
+    pArena->ownsMemory  = false;
+}
+
+
+void arena_release(Arena* pArena)
+{
+    if (pArena == NULL)
+        return;
+
+    if (pArena->ownsMemory)
+        free(pArena->pBase);
+
+    memset(pArena, 0, sizeof(Arena));
+}
+
+
+void* arena_alloc(Arena* pArena, size_t size, size_t alignment)
+{
+    // 对齐的是实际地址而不是偏移，子 Arena 的起始地址不一定满足 alignment
+    uintptr_t base    = (uintptr_t)pArena->pBase;
+    uintptr_t current = base + pArena->offset;
+    uintptr_t aligned = (current + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+
+    size_t offset = (size_t)(aligned - base);
+    if (pArena->pBase == NULL || offset > pArena->capacity
+        || size > pArena->capacity - offset)
+    {
+        fprintf(stderr,
+            "%s : Arena 容量不足（已用 %zu / %zu 字节，请求 %zu 字节）！\n",
+            __func__, pArena->offset, pArena->capacity, size);
+
+        return NULL;
+    }
+
+    pArena->offset = offset + size;
+    if (pArena->offset > pArena->peak)
+        pArena->peak = pArena->offset;
+
+    return pArena->pBase + offset;
+}
+
+
+void* arena_calloc(Arena* pArena, size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size)
+        return NULL;
+
+    void* pMemory = arena_alloc(pArena, count * size, ARENA_DEFAULT_ALIGNMENT);
+    if (pMemory != NULL)
+        memset(pMemory, 0, count * size);
+
+    return pMemory;
+}
+
+
+bool arena_alloc_child(Arena* pParent, Arena* pChild, size_t capacity)
+{
+    void* pMemory = arena_alloc(pParent, capacity, ARENA_DEFAULT_ALIGNMENT);
+
+    arena_init_from(pChild, pMemory, capacity);
+
+    return pMemory != NULL;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// @brief 线性（bump）分配器：从一块连续内存中按顺序分配，不能单独释放，只能整体或
+/// 回退到某个标记处重置.
+///
+/// 由 arena_init 创建的 Arena 拥有其内存（需调用 arena_release）；由 arena_init_from
+/// 在其他内存（如父 Arena）上创建的子 Arena 不拥有其内存，无需释放.
+typedef struct Arena {
+    unsigned char*  pBase;
+    size_t          capacity;
+    size_t          offset;                 // 下一次分配的起始偏移
+    size_t          peak;                   // 历史最大 offset，用于调整容量
+    bool            ownsMemory;
+} Arena;
+
+/// @brief 分配时默认的对齐（满足任意标量类型）.
+#define ARENA_DEFAULT_ALIGNMENT _Alignof(max_align_t)
+
+
+/// @brief 分配一块 `capacity` 字节的堆内存并以此初始化 Arena.
+///
+/// @return 成功时返回 `true`
+bool arena_init(Arena* pArena, size_t capacity);
+
+/// @brief 以给定内存初始化一个不拥有其内存的 Arena.
+void arena_init_from(Arena* pArena, void* pMemory, size_t capacity);
+
+/// @brief 释放 Arena 拥有的内存（不拥有内存的 Arena 只会被清空）.
+void arena_release(Arena* pArena);
+
+/// @brief 从 Arena 中分配 `size` 字节，起始地址按 `alignment`（2 的幂）对齐.
+///
+/// @return 分配到的内存（内容未初始化），容量不足时返回 `NULL`
+void* arena_alloc(Arena* pArena, size_t size, size_t alignment);
+
+/// @brief 从 Arena 中分配 `count` 个 `size` 字节的元素并清零（按默认对齐）.
+///
+/// @return 分配到的内存，容量不足或溢出时返回 `NULL`
+void* arena_calloc(Arena* pArena, size_t count, size_t size);
+
+/// @brief 从 Arena 中分配一个子 Arena，子 Arena 的生命周期不能长于父 Arena.
+///
+/// @return 成功时返回 `true`
+bool arena_alloc_child(Arena* pParent, Arena* pChild, size_t capacity);
+
+/// @brief 获取当前的分配位置，之后可用 arena_reset_to 回退到该处.
+static inline size_t arena_mark(const Arena* pArena)
+{
+    return pArena->offset;
+}
+
+/// @brief 回退到 arena_mark 返回的位置，其后分配的内存全部失效.
+static inline void arena_reset_to(Arena* pArena, size_t mark)
+{
+    if (mark <= pArena->offset)
+        pArena->offset = mark;
+}
+
+/// @brief 重置 Arena，之前分配的内存全部失效.
+static inline void arena_reset(Arena* pArena)
+{
+    pArena->offset = 0;
+}
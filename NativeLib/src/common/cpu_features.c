@@ -0,0 +1,57 @@
+#include "cpu_features.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief 检测结果，-1 表示尚未检测
+static int simdLevel = -1;
+
+static SimdLevel detect_simd_level(void);
+
+
+SimdLevel get_simd_level(void)
+{
+    // 与 log_get_level 相同，多个线程同时首次调用只会重复得到相同结果
+    if (simdLevel < 0)
+    {
+        SimdLevel level = detect_simd_level();
+
+        const char* value = getenv("NATIVELIB_SIMD");
+        for (int i = SIMD_LEVEL_SCALAR; value != NULL && i < (int)level; i++)
+        {
+            if (strcmp(value, simd_level_name((SimdLevel)i)) == 0)
+                level = (SimdLevel)i;
+        }
+
+        simdLevel = (int)level;
+    }
+
+    return (SimdLevel)simdLevel;
+}
+
+
+const char* simd_level_name(SimdLevel level)
+{
+    switch (level)
+    {
+        case SIMD_LEVEL_SSE2:   return "sse2";
+        case SIMD_LEVEL_AVX2:   return "avx2";
+        default:                return "scalar";
+    }
+}
+
+
+static SimdLevel detect_simd_level(void)
+{
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+
+    // AVX2 路径同时使用 FMA，两者需同时支持（操作系统对 YMM 状态的支持已包含在检测中）
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SIMD_LEVEL_AVX2;
+
+    return SIMD_LEVEL_SSE2;
+#else
+    return SIMD_LEVEL_SCALAR;
+#endif
+}
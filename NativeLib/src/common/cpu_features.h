@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdbool.h>
+
+/// @brief 可用于运行时分派的 SIMD 指令集级别，数值越大越新.
+typedef enum SimdLevel {
+    SIMD_LEVEL_SCALAR = 0,      // 纯标量实现（非 x86-64 或被强制时）
+    SIMD_LEVEL_SSE2,            // x86-64 的基线
+    SIMD_LEVEL_AVX2             // AVX2 + FMA
+} SimdLevel;
+
+/// @brief 获取当前 CPU 支持的最高 SIMD 级别.
+///
+/// 首次调用时检测 CPU，并可由环境变量 `NATIVELIB_SIMD`（scalar / sse2 / avx2）
+/// 向下限制，便于对比各实现.
+SimdLevel get_simd_level(void);
+
+/// @brief SIMD 级别的名称（用于日志与基准测试输出）.
+const char* simd_level_name(SimdLevel level);
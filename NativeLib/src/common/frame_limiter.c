@@ -0,0 +1,197 @@
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L             // clock_gettime / clock_nanosleep
+#endif
+
+#include "frame_limiter.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define cpu_relax() _mm_pause()
+#else
+#define cpu_relax() ((void)0)
+#endif
+
+static void sleep_until(FrameLimiter* pLimiter, uint64_t wakeNs);
+static double ns_to_ms(uint64_t ns);
+static double average(double average, double sample);
+
+
+void frame_limiter_init(FrameLimiter* pLimiter)
+{
+    memset(pLimiter, 0, sizeof(FrameLimiter));
+    pLimiter->spinNs = FRAME_LIMITER_MIN_SPIN_NS;
+
+#ifdef _WIN32
+    // 高精度计时器需要 Windows 10 1803 及以上，否则退回到普通计时器（精度受系统时钟分辨率限制）
+    pLimiter->timer = CreateWaitableTimerExW(NULL, NULL,
+                          CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (pLimiter->timer == NULL)
+        pLimiter->timer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+#endif
+
+    pLimiter->stats.spinTime = ns_to_ms(pLimiter->spinNs);
+}
+
+
+void frame_limiter_destroy(FrameLimiter* pLimiter)
+{
+#ifdef _WIN32
+    if (pLimiter->timer != NULL)
+        CloseHandle((HANDLE)pLimiter->timer);
+#endif
+    pLimiter->timer = NULL;
+}
+
+
+void frame_limiter_set_rate(FrameLimiter* pLimiter, double framesPerSecond)
+{
+    pLimiter->intervalNs    = framesPerSecond > 0.0 ? (uint64_t)(1e9 / framesPerSecond) : 0;
+    pLimiter->deadlineNs    = 0;
+    pLimiter->lastFrameNs   = 0;
+
+    FrameLimiterStats* pStats = &pLimiter->stats;
+    pStats->targetFrameTime     = ns_to_ms(pLimiter->intervalNs);
+    pStats->averageFrameTime    = pStats->targetFrameTime;
+    pStats->averageJitter       = 0.0;
+    pStats->maxLateness         = 0.0;
+}
+
+
+void frame_limiter_wait(FrameLimiter* pLimiter)
+{
+    uint64_t now = frame_limiter_now_ns();
+
+    if (pLimiter->intervalNs != 0)
+    {
+        // 1.推进截止时刻，首帧或落后超过一帧时从当前时刻重新开始
+        if (pLimiter->deadlineNs == 0 || now > pLimiter->deadlineNs + pLimiter->intervalNs)
+            pLimiter->deadlineNs = now;
+        else
+            pLimiter->deadlineNs += pLimiter->intervalNs;
+
+        uint64_t deadline = pLimiter->deadlineNs;
+
+        // 2.距截止时刻较远时睡眠，并用唤醒时刻的超时调整自旋时长：超时变大时立即放宽，
+        //   变小时缓慢收紧
+        if (now + pLimiter->spinNs < deadline)
+        {
+            uint64_t wakeTarget = deadline - pLimiter->spinNs;
+            sleep_until(pLimiter, wakeTarget);
+
+            now = frame_limiter_now_ns();
+            uint64_t overshoot = now > wakeTarget ? now - wakeTarget : 0;
+            uint64_t wanted = overshoot + overshoot / 2;
+
+            if (wanted > pLimiter->spinNs)
+                pLimiter->spinNs = wanted;
+            else
+                pLimiter->spinNs -= (pLimiter->spinNs - wanted) / FRAME_LIMITER_AVERAGE_WEIGHT;
+
+            if (pLimiter->spinNs < FRAME_LIMITER_MIN_SPIN_NS)
+                pLimiter->spinNs = FRAME_LIMITER_MIN_SPIN_NS;
+            if (pLimiter->spinNs > FRAME_LIMITER_MAX_SPIN_NS)
+                pLimiter->spinNs = FRAME_LIMITER_MAX_SPIN_NS;
+        }
+
+        // 3.自旋到截止时刻
+        while (now < deadline)
+        {
+            cpu_relax();
+            now = frame_limiter_now_ns();
+        }
+
+        double lateness = ns_to_ms(now - deadline);
+        if (lateness > pLimiter->stats.maxLateness)
+            pLimiter->stats.maxLateness = lateness;
+    }
+
+    // 4.统计帧间隔与抖动
+    FrameLimiterStats* pStats = &pLimiter->stats;
+    if (pLimiter->lastFrameNs != 0)
+    {
+        double frameTime = ns_to_ms(now - pLimiter->lastFrameNs);
+        double jitter = pLimiter->intervalNs != 0 ? frameTime - pStats->targetFrameTime : 0.0;
+
+        pStats->averageFrameTime    = average(pStats->averageFrameTime, frameTime);
+        pStats->averageJitter       = average(pStats->averageJitter, jitter < 0.0 ? -jitter : jitter);
+    }
+    pStats->spinTime = ns_to_ms(pLimiter->spinNs);
+
+    pLimiter->lastFrameNs = now;
+}
+
+
+uint64_t frame_limiter_now_ns(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    // 先拆分为秒与余数，避免乘以 1e9 时溢出
+    uint64_t seconds = (uint64_t)(counter.QuadPart / frequency.QuadPart);
+    uint64_t rest    = (uint64_t)(counter.QuadPart % frequency.QuadPart);
+
+    return seconds * 1000000000ull + rest * 1000000000ull / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+
+/// @brief 睡眠到单调时钟的 `wakeNs` 时刻（可能略晚）.
+static void sleep_until(FrameLimiter* pLimiter, uint64_t wakeNs)
+{
+#ifdef _WIN32
+    uint64_t now = frame_limiter_now_ns();
+    if (wakeNs <= now)
+        return;
+
+    // 可等待计时器的单位为 100 纳秒，负值表示相对时间
+    LARGE_INTEGER dueTime;
+    dueTime.QuadPart = -(LONGLONG)((wakeNs - now) / 100);
+
+    if (pLimiter->timer != NULL
+        && SetWaitableTimer((HANDLE)pLimiter->timer, &dueTime, 0, NULL, NULL, FALSE))
+        WaitForSingleObject((HANDLE)pLimiter->timer, INFINITE);
+    else
+        Sleep((DWORD)((wakeNs - now) / 1000000));
+#else
+    (void)pLimiter;
+
+    struct timespec ts;
+    ts.tv_sec   = (time_t)(wakeNs / 1000000000ull);
+    ts.tv_nsec  = (long)(wakeNs % 1000000000ull);
+
+    // 使用绝对时刻，被信号中断后重新等待同一时刻
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+#endif
+}
+
+
+static double ns_to_ms(uint64_t ns)
+{
+    return (double)ns * 1e-6;
+}
+
+
+static double average(double average, double sample)
+{
+    return average + (sample - average) / FRAME_LIMITER_AVERAGE_WEIGHT;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// @brief 尾部自旋时长的下限与上限（纳秒），实际值根据测得的睡眠超时自适应.
+#define FRAME_LIMITER_MIN_SPIN_NS       200000ull
+#define FRAME_LIMITER_MAX_SPIN_NS       4000000ull
+/// @brief 统计量指数滑动平均的权重（1 / N）.
+#define FRAME_LIMITER_AVERAGE_WEIGHT    16
+
+/// @brief 帧率限制器的统计信息（毫秒）.
+typedef struct FrameLimiterStats {
+    double      targetFrameTime;        // 目标帧间隔，为 0 时未限制
+    double      averageFrameTime;       // 相邻两次 frame_limiter_wait 返回之间的平均间隔
+    double      averageJitter;          // 实际帧间隔与目标帧间隔之差的平均绝对值
+    double      maxLateness;            // 返回时刻晚于截止时刻的最大值（自上次设置帧率起）
+    double      spinTime;               // 当前的尾部自旋时长
+} FrameLimiterStats;
+
+/// @brief 睡眠 + 自旋混合的帧率限制器.
+///
+/// 每帧的截止时刻按目标间隔递增：距截止时刻较远时用高精度睡眠（clock_nanosleep /
+/// 高精度可等待计时器）让出 CPU，最后一小段自旋等待，以免睡眠的唤醒误差造成帧间隔抖动.
+/// 自旋时长随测得的睡眠超时自适应，既不会整帧占满一个核心，也不会因唤醒过晚而错过截止时刻.
+typedef struct FrameLimiter {
+    uint64_t    intervalNs;             // 目标帧间隔，为 0 时不限制
+    uint64_t    deadlineNs;             // 下一帧的截止时刻，为 0 时尚未开始计时
+    uint64_t    lastFrameNs;            // 上一次 frame_limiter_wait 返回的时刻
+    uint64_t    spinNs;                 // 当前的尾部自旋时长
+    void*       timer;                  // Windows 上的高精度可等待计时器
+    FrameLimiterStats stats;
+} FrameLimiter;
+
+
+/// @brief 初始化帧率限制器（初始不限制帧率）.
+void frame_limiter_init(FrameLimiter* pLimiter);
+
+/// @brief 释放帧率限制器的系统资源.
+void frame_limiter_destroy(FrameLimiter* pLimiter);
+
+/// @brief 设置目标帧率并重新开始计时与统计.
+///
+/// @param framesPerSecond 每秒帧数，为 0 时不限制
+void frame_limiter_set_rate(FrameLimiter* pLimiter, double framesPerSecond);
+
+/// @brief 等待到当前帧的截止时刻（未限制帧率时只更新统计）.
+///
+/// 落后超过一帧时（如窗口被拖动）重新从当前时刻开始计时，而不是连续快速地追赶.
+void frame_limiter_wait(FrameLimiter* pLimiter);
+
+/// @brief 单调时钟的当前时间（纳秒）.
+uint64_t frame_limiter_now_ns(void);
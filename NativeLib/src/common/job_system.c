@@ -0,0 +1,508 @@
+#include "job_system.h"
+#include "ansi_esc.h"
+#include "trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief 工作线程找不到任务时，休眠前自旋尝试的次数
+#define JOB_SPIN_COUNT 64
+
+/// @brief 当前线程在哪个任务系统中拥有队列（外部线程为 `NULL`）
+static _Thread_local JobWorker* tlsWorker = NULL;
+
+static uint32_t resolve_worker_count(uint32_t workerCount);
+static int worker_main(void* pArg);
+static JobWorker* current_worker(JobSystem* pJobs);
+static Job* allocate_job(JobWorker* pWorker);
+static bool queue_push(JobQueue* pQueue, Job* pJob);
+static Job* queue_pop(JobQueue* pQueue);
+static Job* queue_steal(JobQueue* pQueue);
+static bool external_push(JobSystem* pJobs, JobFunc func, void* pArg, JobCounter* pCounter);
+static bool external_pop(JobSystem* pJobs, Job* pJob);
+static bool try_run_one(JobSystem* pJobs, JobWorker* pWorker);
+static void execute_job(JobFunc func, void* pArg, JobCounter* pCounter);
+static void notify_workers(JobSystem* pJobs);
+
+
+bool create_job_system(uint32_t workerCount, JobSystem* pJobs)
+{
+    memset(pJobs, 0, sizeof(JobSystem));
+
+    // 槽位 0 为调用线程
+    uint32_t threadCount = resolve_worker_count(workerCount) + 1;
+
+    if (!arena_init(&pJobs->arena, threadCount * sizeof(JobWorker) + 64))
+        return false;
+
+    pJobs->pWorkers = (JobWorker*)arena_alloc(&pJobs->arena, threadCount * sizeof(JobWorker), 64);
+    if (pJobs->pWorkers == NULL)
+    {
+        fprintf(stderr, "%s : 分配工作线程数组失败！\n", __func__);
+        arena_release(&pJobs->arena);
+        return false;
+    }
+    memset(pJobs->pWorkers, 0, threadCount * sizeof(JobWorker));
+
+    mutex_init(&pJobs->sleepMutex);
+    mutex_init(&pJobs->externalMutex);
+    condvar_init(&pJobs->wakeCondition);
+    atomic_store(&pJobs->running, true);
+
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        pJobs->pWorkers[i].index    = i;
+        pJobs->pWorkers[i].random   = 0x9E3779B9u * (i + 1);
+        pJobs->pWorkers[i].pSystem  = pJobs;
+    }
+
+    pJobs->workerCount  = threadCount;
+    tlsWorker           = &pJobs->pWorkers[0];
+
+    // 启动失败的线程的队列始终为空，只是以更少的线程运行
+    uint32_t startedCount = 0;
+    for (uint32_t i = 1; i < threadCount; i++)
+    {
+        if (thread_start(&pJobs->pWorkers[i].thread, worker_main, &pJobs->pWorkers[i]))
+            startedCount++;
+    }
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "成功创建了任务系统（%u 个工作线程）！\n",
+        __DATE__, __TIME__, startedCount);
+
+    return true;
+}
+
+
+void destroy_job_system(JobSystem* pJobs)
+{
+    if (pJobs == NULL || pJobs->pWorkers == NULL)
+        return;
+
+    mutex_lock(&pJobs->sleepMutex);
+    atomic_store(&pJobs->running, false);
+    condvar_broadcast(&pJobs->wakeCondition);
+    mutex_unlock(&pJobs->sleepMutex);
+
+    for (uint32_t i = 1; i < pJobs->workerCount; i++)
+        thread_join(&pJobs->pWorkers[i].thread);
+
+    if (tlsWorker != NULL && tlsWorker->pSystem == pJobs)
+        tlsWorker = NULL;
+
+    condvar_destroy(&pJobs->wakeCondition);
+    mutex_destroy(&pJobs->externalMutex);
+    mutex_destroy(&pJobs->sleepMutex);
+    arena_release(&pJobs->arena);
+
+    memset(pJobs, 0, sizeof(JobSystem));
+}
+
+
+void job_system_run(JobSystem* pJobs, JobFunc func, void* pArg, JobCounter* pCounter)
+{
+    if (pCounter != NULL)
+        atomic_fetch_add_explicit(&pCounter->value, 1, memory_order_relaxed);
+
+    // 工作线程与创建者线程压入自己的队列，其他线程进入外部队列
+    JobWorker* pWorker = current_worker(pJobs);
+    bool queued;
+    if (pWorker != NULL)
+    {
+        Job* pJob = allocate_job(pWorker);
+        queued = pJob != NULL;
+        if (queued)
+        {
+            pJob->func      = func;
+            pJob->pArg      = pArg;
+            pJob->pCounter  = pCounter;
+
+            queued = queue_push(&pWorker->queue, pJob);
+            if (!queued)
+                atomic_store_explicit(&pJob->inUse, false, memory_order_relaxed);
+        }
+    }
+    else
+        queued = external_push(pJobs, func, pArg, pCounter);
+
+    // 队列已满时就地执行，结果等价（只是失去并行）
+    if (!queued)
+    {
+        execute_job(func, pArg, pCounter);
+        return;
+    }
+
+    atomic_fetch_add(&pJobs->queuedJobs, 1);
+    notify_workers(pJobs);
+}
+
+
+void job_system_run_batch(JobSystem* pJobs, const JobDecl* pDecls, uint32_t count, JobCounter* pCounter)
+{
+    for (uint32_t i = 0; i < count; i++)
+        job_system_run(pJobs, pDecls[i].func, pDecls[i].pArg, pCounter);
+}
+
+
+void job_system_run_batch_ordered(JobSystem* pJobs, const JobDecl* pDecls, uint32_t count, JobCounter* pCounter)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (pCounter != NULL)
+            atomic_fetch_add_explicit(&pCounter->value, 1, memory_order_relaxed);
+
+        if (!external_push(pJobs, pDecls[i].func, pDecls[i].pArg, pCounter))
+        {
+            execute_job(pDecls[i].func, pDecls[i].pArg, pCounter);
+            continue;
+        }
+
+        atomic_fetch_add(&pJobs->queuedJobs, 1);
+        notify_workers(pJobs);
+    }
+}
+
+
+void job_system_wait(JobSystem* pJobs, JobCounter* pCounter)
+{
+    JobWorker* pWorker = current_worker(pJobs);
+
+    while (!job_counter_done(pCounter))
+    {
+        if (!try_run_one(pJobs, pWorker))
+            thread_yield();
+    }
+}
+
+
+/// @brief job_system_parallel_for 的一个区间任务.
+typedef struct ParallelForChunk {
+    JobRangeFunc    func;
+    void*           pArg;
+    uint32_t        begin;
+    uint32_t        end;
+} ParallelForChunk;
+
+static void parallel_for_job(void* pArg)
+{
+    ParallelForChunk* pChunk = (ParallelForChunk*)pArg;
+    pChunk->func(pChunk->pArg, pChunk->begin, pChunk->end);
+}
+
+void job_system_parallel_for(
+    JobSystem*      pJobs,
+    uint32_t        count,
+    uint32_t        grain,
+    JobRangeFunc    func,
+    void*           pArg
+)
+{
+    if (count == 0)
+        return;
+    if (grain == 0)
+        grain = 1;
+
+    // 每个线程约 4 个区间，既能平衡负载又不至于让调度开销占主导
+    uint32_t chunkCount = (count + grain - 1) / grain;
+    uint32_t maxChunks  = pJobs->workerCount * 4;
+    if (chunkCount > maxChunks)
+        chunkCount = maxChunks;
+    if (chunkCount > JOB_PARALLEL_FOR_MAX_CHUNKS)
+        chunkCount = JOB_PARALLEL_FOR_MAX_CHUNKS;
+
+    if (chunkCount <= 1)
+    {
+        func(pArg, 0, count);
+        return;
+    }
+
+    ParallelForChunk chunks[JOB_PARALLEL_FOR_MAX_CHUNKS];
+    JobCounter counter = {0};
+
+    uint32_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    for (uint32_t i = 0; i < chunkCount; i++)
+    {
+        chunks[i].func  = func;
+        chunks[i].pArg  = pArg;
+        chunks[i].begin = i * chunkSize;
+        chunks[i].end   = chunks[i].begin + chunkSize < count ? chunks[i].begin + chunkSize : count;
+
+        if (chunks[i].begin < chunks[i].end)
+            job_system_run(pJobs, parallel_for_job, &chunks[i], &counter);
+    }
+
+    job_system_wait(pJobs, &counter);
+}
+
+
+/// @brief 解析工作线程数：`JOB_SYSTEM_AUTO_WORKERS` 时优先使用环境变量 `NATIVELIB_JOB_THREADS`
+/// （总线程数，含调用线程），否则为核心数 - 1.
+static uint32_t resolve_worker_count(uint32_t workerCount)
+{
+    if (workerCount == JOB_SYSTEM_AUTO_WORKERS)
+    {
+        const char* value = getenv("NATIVELIB_JOB_THREADS");
+        long threads = value != NULL ? strtol(value, NULL, 10) : 0;
+
+        workerCount = threads > 0 ? (uint32_t)threads - 1 : get_processor_count() - 1;
+    }
+
+    return workerCount < JOB_SYSTEM_MAX_WORKERS ? workerCount : JOB_SYSTEM_MAX_WORKERS;
+}
+
+
+/// @brief 工作线程的入口：执行任务，持续找不到任务时休眠直到有新任务提交.
+static int worker_main(void* pArg)
+{
+    JobWorker* pWorker = (JobWorker*)pArg;
+    JobSystem* pJobs = pWorker->pSystem;
+
+    tlsWorker = pWorker;
+    trace_set_thread_name("job worker");
+
+    while (atomic_load_explicit(&pJobs->running, memory_order_relaxed))
+    {
+        bool found = false;
+        for (uint32_t spin = 0; spin < JOB_SPIN_COUNT && !found; spin++)
+            found = try_run_one(pJobs, pWorker);
+
+        if (found)
+            continue;
+
+        // 先登记为休眠再检查任务数，与 notify_workers 的先增加任务数再检查休眠数配对，
+        // 保证不会错过唤醒
+        mutex_lock(&pJobs->sleepMutex);
+        atomic_fetch_add(&pJobs->sleepingWorkers, 1);
+
+        while (atomic_load(&pJobs->queuedJobs) <= 0
+            && atomic_load_explicit(&pJobs->running, memory_order_relaxed))
+            condvar_wait(&pJobs->wakeCondition, &pJobs->sleepMutex);
+
+        atomic_fetch_sub(&pJobs->sleepingWorkers, 1);
+        mutex_unlock(&pJobs->sleepMutex);
+    }
+
+    tlsWorker = NULL;
+
+    return 0;
+}
+
+
+static JobWorker* current_worker(JobSystem* pJobs)
+{
+    return tlsWorker != NULL && tlsWorker->pSystem == pJobs ? tlsWorker : NULL;
+}
+
+
+/// @brief 从线程自己的任务池中取一个空闲槽位（只有所有者线程会调用）.
+///
+/// @return 任务池已满（所有任务都在途）时返回 `NULL`
+static Job* allocate_job(JobWorker* pWorker)
+{
+    for (uint32_t i = 0; i < JOB_QUEUE_CAPACITY; i++)
+    {
+        Job* pJob = &pWorker->jobs[(pWorker->nextJob + i) & (JOB_QUEUE_CAPACITY - 1)];
+        if (!atomic_load_explicit(&pJob->inUse, memory_order_acquire))
+        {
+            atomic_store_explicit(&pJob->inUse, true, memory_order_relaxed);
+            pWorker->nextJob += i + 1;
+            return pJob;
+        }
+    }
+
+    return NULL;
+}
+
+
+static bool queue_push(JobQueue* pQueue, Job* pJob)
+{
+    long long bottom = atomic_load_explicit(&pQueue->bottom, memory_order_relaxed);
+    long long top    = atomic_load_explicit(&pQueue->top, memory_order_acquire);
+
+    if (bottom - top >= JOB_QUEUE_CAPACITY)
+        return false;
+
+    atomic_store_explicit(&pQueue->slots[bottom & (JOB_QUEUE_CAPACITY - 1)], pJob,
+        memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&pQueue->bottom, bottom + 1, memory_order_relaxed);
+
+    return true;
+}
+
+
+static Job* queue_pop(JobQueue* pQueue)
+{
+    long long bottom = atomic_load_explicit(&pQueue->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&pQueue->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long top = atomic_load_explicit(&pQueue->top, memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        atomic_store_explicit(&pQueue->bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    Job* pJob = atomic_load_explicit(&pQueue->slots[bottom & (JOB_QUEUE_CAPACITY - 1)],
+                    memory_order_relaxed);
+
+    // 只剩最后一个任务时与窃取者竞争
+    if (top == bottom)
+    {
+        if (!atomic_compare_exchange_strong_explicit(&pQueue->top, &top, top + 1,
+                memory_order_seq_cst, memory_order_relaxed))
+            pJob = NULL;
+
+        atomic_store_explicit(&pQueue->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+    return pJob;
+}
+
+
+static Job* queue_steal(JobQueue* pQueue)
+{
+    long long top = atomic_load_explicit(&pQueue->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long bottom = atomic_load_explicit(&pQueue->bottom, memory_order_acquire);
+
+    if (top >= bottom)
+        return NULL;
+
+    Job* pJob = atomic_load_explicit(&pQueue->slots[top & (JOB_QUEUE_CAPACITY - 1)],
+                    memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(&pQueue->top, &top, top + 1,
+            memory_order_seq_cst, memory_order_relaxed))
+        return NULL;
+
+    return pJob;
+}
+
+
+static bool external_push(JobSystem* pJobs, JobFunc func, void* pArg, JobCounter* pCounter)
+{
+    mutex_lock(&pJobs->externalMutex);
+
+    bool pushed = pJobs->externalCount < JOB_EXTERNAL_QUEUE_CAPACITY;
+    if (pushed)
+    {
+        uint32_t slot = (pJobs->externalHead + pJobs->externalCount) % JOB_EXTERNAL_QUEUE_CAPACITY;
+        pJobs->externalJobs[slot].func      = func;
+        pJobs->externalJobs[slot].pArg      = pArg;
+        pJobs->externalJobs[slot].pCounter  = pCounter;
+        pJobs->externalCount++;
+    }
+
+    mutex_unlock(&pJobs->externalMutex);
+
+    return pushed;
+}
+
+
+/// @brief 从外部队列取出一个任务（按值拷贝，取出后其槽位即可复用）.
+static bool external_pop(JobSystem* pJobs, Job* pJob)
+{
+    // 无锁地预先检查，外部队列通常为空
+    if (atomic_load_explicit(&pJobs->queuedJobs, memory_order_relaxed) <= 0)
+        return false;
+
+    mutex_lock(&pJobs->externalMutex);
+
+    bool popped = pJobs->externalCount > 0;
+    if (popped)
+    {
+        Job* pSource = &pJobs->externalJobs[pJobs->externalHead];
+        pJob->func      = pSource->func;
+        pJob->pArg      = pSource->pArg;
+        pJob->pCounter  = pSource->pCounter;
+
+        pJobs->externalHead = (pJobs->externalHead + 1) % JOB_EXTERNAL_QUEUE_CAPACITY;
+        pJobs->externalCount--;
+    }
+
+    mutex_unlock(&pJobs->externalMutex);
+
+    return popped;
+}
+
+
+/// @brief 依次尝试：自己的队列（后进先出，缓存友好）-> 外部队列 -> 从其他线程窃取，
+/// 找到任务就执行它.
+///
+/// @param pWorker 当前线程的 JobWorker，外部线程为 `NULL`（只能取外部队列或窃取）
+///
+/// @return 执行了一个任务时返回 `true`
+static bool try_run_one(JobSystem* pJobs, JobWorker* pWorker)
+{
+    Job* pJob = pWorker != NULL ? queue_pop(&pWorker->queue) : NULL;
+
+    Job external;
+    if (pJob == NULL && external_pop(pJobs, &external))
+    {
+        atomic_fetch_sub(&pJobs->queuedJobs, 1);
+        execute_job(external.func, external.pArg, external.pCounter);
+        return true;
+    }
+
+    if (pJob == NULL)
+    {
+        // 从随机位置开始轮询，避免所有线程同时窃取同一个队列
+        uint32_t start = 0;
+        if (pWorker != NULL)
+        {
+            pWorker->random ^= pWorker->random << 13;
+            pWorker->random ^= pWorker->random >> 17;
+            pWorker->random ^= pWorker->random << 5;
+            start = pWorker->random;
+        }
+
+        uint32_t workerCount = pJobs->workerCount;
+        for (uint32_t i = 0; i < workerCount && pJob == NULL; i++)
+        {
+            JobWorker* pVictim = &pJobs->pWorkers[(start + i) % workerCount];
+            if (pVictim != pWorker)
+                pJob = queue_steal(&pVictim->queue);
+        }
+    }
+
+    if (pJob == NULL)
+        return false;
+
+    atomic_fetch_sub(&pJobs->queuedJobs, 1);
+
+    // 先取出内容再归还槽位，之后所有者即可复用它
+    JobFunc     func        = pJob->func;
+    void*       pArg        = pJob->pArg;
+    JobCounter* pCounter    = pJob->pCounter;
+    atomic_store_explicit(&pJob->inUse, false, memory_order_release);
+
+    execute_job(func, pArg, pCounter);
+
+    return true;
+}
+
+
+static void execute_job(JobFunc func, void* pArg, JobCounter* pCounter)
+{
+    func(pArg);
+
+    // release：任务的写入对观察到计数器归零的线程可见
+    if (pCounter != NULL)
+        atomic_fetch_sub_explicit(&pCounter->value, 1, memory_order_release);
+}
+
+
+/// @brief 有线程在休眠时唤醒其中一个.
+static void notify_workers(JobSystem* pJobs)
+{
+    if (atomic_load(&pJobs->sleepingWorkers) == 0)
+        return;
+
+    mutex_lock(&pJobs->sleepMutex);
+    condvar_signal(&pJobs->wakeCondition);
+    mutex_unlock(&pJobs->sleepMutex);
+}
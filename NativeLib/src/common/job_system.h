@@ -0,0 +1,132 @@
+#pragma once
+
+#include "arena.h"
+#include "thread.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/// @brief 工作线程数的上限.
+#define JOB_SYSTEM_MAX_WORKERS          31
+/// @brief 由 CPU 核心数决定工作线程数（核心数 - 1，调用线程也会在等待时执行任务）.
+#define JOB_SYSTEM_AUTO_WORKERS         UINT32_MAX
+/// @brief 每个线程的任务队列（及任务池）容量，需为 2 的幂.
+#define JOB_QUEUE_CAPACITY              1024
+/// @brief 外部线程（非工作线程、非创建者线程）提交任务的共享队列容量.
+#define JOB_EXTERNAL_QUEUE_CAPACITY     256
+/// @brief job_system_parallel_for 最多拆分出的任务数.
+#define JOB_PARALLEL_FOR_MAX_CHUNKS     64
+
+/// @brief 任务入口.
+typedef void (*JobFunc)(void* pArg);
+
+/// @brief job_system_parallel_for 的区间入口，处理下标 [begin, end).
+typedef void (*JobRangeFunc)(void* pArg, uint32_t begin, uint32_t end);
+
+/// @brief 依赖计数器：提交时加一，任务完成时减一，归零即表示其关联的任务全部完成.
+///
+/// 需由调用者分配并清零（`JobCounter counter = {0};`），在 job_system_wait 返回前不能释放.
+typedef struct JobCounter {
+    atomic_int          value;
+} JobCounter;
+
+/// @brief 任务描述，用于批量提交.
+typedef struct JobDecl {
+    JobFunc             func;
+    void*               pArg;
+} JobDecl;
+
+/// @brief 任务池中的一个任务.
+typedef struct Job {
+    JobFunc             func;
+    void*               pArg;
+    JobCounter*         pCounter;
+    atomic_bool         inUse;              // 从提交到执行完毕，期间其槽位不会被复用
+} Job;
+
+/// @brief Chase-Lev 工作窃取双端队列：所有者在底部压入 / 弹出，其他线程从顶部窃取.
+typedef struct JobQueue {
+    _Alignas(64) atomic_llong   top;
+    _Alignas(64) atomic_llong   bottom;     // 与 top 分处不同缓存行，避免伪共享
+    _Atomic(Job*)               slots[JOB_QUEUE_CAPACITY];
+} JobQueue;
+
+typedef struct JobSystem JobSystem;
+
+/// @brief 拥有一个队列的线程：槽位 0 为创建任务系统的线程，其余为工作线程.
+typedef struct JobWorker {
+    JobQueue            queue;
+    Job                 jobs[JOB_QUEUE_CAPACITY];
+    uint32_t            nextJob;            // 任务池中下一个尝试的槽位
+    uint32_t            random;             // 选择窃取目标的伪随机状态
+    uint32_t            index;
+    JobSystem*          pSystem;
+    Thread              thread;
+} JobWorker;
+
+/// @brief 工作窃取任务系统.
+///
+/// 每个线程（工作线程与创建者线程）各有一个无锁双端队列，空闲的线程从其他队列窃取任务；
+/// 其他线程提交的任务进入一个加锁的共享队列. 没有任务时工作线程在条件变量上休眠.
+///
+/// 等待计数器的线程不会阻塞，而是在等待期间执行其他任务，因此任务内部也可以提交子任务并等待.
+struct JobSystem {
+    Arena               arena;              // JobWorker 数组
+    JobWorker*          pWorkers;
+    uint32_t            workerCount;        // 含槽位 0 的创建者线程
+    atomic_bool         running;
+
+    atomic_int          queuedJobs;         // 已提交、尚未被取出的任务数（休眠线程据此判断是否有任务）
+    atomic_int          sleepingWorkers;
+    Mutex               sleepMutex;
+    CondVar             wakeCondition;
+
+    Mutex               externalMutex;      // 保护外部队列
+    Job                 externalJobs[JOB_EXTERNAL_QUEUE_CAPACITY];
+    uint32_t            externalHead;
+    uint32_t            externalCount;
+};
+
+
+/// @brief 创建任务系统并启动工作线程，调用线程成为其创建者线程.
+///
+/// @param workerCount 工作线程数（不含调用线程），`JOB_SYSTEM_AUTO_WORKERS` 时由 CPU 核心数
+/// 与环境变量 `NATIVELIB_JOB_THREADS` 决定；为 0 时任务都在等待它们的线程上执行
+///
+/// @return 成功时返回 `true`（部分工作线程无法启动时也会成功，只是线程更少）
+bool create_job_system(uint32_t workerCount, JobSystem* pJobs);
+
+/// @brief 停止并等待所有工作线程，释放任务系统的内存（调用前需等待所有已提交的任务）.
+void destroy_job_system(JobSystem* pJobs);
+
+/// @brief 提交一个任务.
+///
+/// @param pCounter 可为 `NULL`；否则提交时加一，任务完成时减一
+void job_system_run(JobSystem* pJobs, JobFunc func, void* pArg, JobCounter* pCounter);
+
+/// @brief 批量提交 `count` 个任务，共用一个计数器.
+void job_system_run_batch(JobSystem* pJobs, const JobDecl* pDecls, uint32_t count, JobCounter* pCounter);
+
+/// @brief 按顺序批量提交任务：经由外部队列（先进先出），所有线程都按提交顺序取出.
+///
+/// 用于先提交的任务更紧迫的场合（本线程队列是后进先出的）；外部队列已满时余下的任务就地执行.
+void job_system_run_batch_ordered(JobSystem* pJobs, const JobDecl* pDecls, uint32_t count, JobCounter* pCounter);
+
+/// @brief 等待计数器归零，期间在当前线程上执行其他任务.
+void job_system_wait(JobSystem* pJobs, JobCounter* pCounter);
+
+/// @brief 把下标 [0, count) 按不小于 `grain` 的粒度拆分为任务并行执行，返回时全部完成.
+void job_system_parallel_for(
+    JobSystem*      pJobs,
+    uint32_t        count,
+    uint32_t        grain,
+    JobRangeFunc    func,
+    void*           pArg
+);
+
+/// @brief 计数器关联的任务是否已全部完成.
+static inline bool job_counter_done(JobCounter* pCounter)
+{
+    return atomic_load_explicit(&pCounter->value, memory_order_acquire) <= 0;
+}
@@ -0,0 +1,50 @@
+#include "log.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief 当前详细程度，-1 表示尚未从环境变量读取
+static int logLevel = -1;
+
+static LogLevel parse_log_level(const char* value);
+
+
+LogLevel log_get_level(void)
+{
+    // 多个线程同时首次调用时只会重复解析同一个环境变量，结果相同
+    if (logLevel < 0)
+        logLevel = (int)parse_log_level(getenv("NATIVELIB_LOG_LEVEL"));
+
+    return (LogLevel)logLevel;
+}
+
+
+void log_set_level(LogLevel level)
+{
+    if (level < LOG_LEVEL_QUIET)
+        level = LOG_LEVEL_QUIET;
+    if (level > LOG_LEVEL_VERBOSE)
+        level = LOG_LEVEL_VERBOSE;
+
+    logLevel = (int)level;
+}
+
+
+static LogLevel parse_log_level(const char* value)
+{
+    if (value == NULL || value[0] == '\0')
+        return LOG_LEVEL_INFO;
+
+    static const char* const names[] = { "quiet", "error", "warning", "info", "verbose" };
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++)
+    {
+        if (strcmp(value, names[i]) == 0)
+            return (LogLevel)i;
+    }
+
+    long number = strtol(value, NULL, 10);
+    if (number < LOG_LEVEL_QUIET || number > LOG_LEVEL_VERBOSE)
+        return LOG_LEVEL_INFO;
+
+    return (LogLevel)number;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/// @brief 日志详细程度，数值越大输出越多.
+typedef enum LogLevel {
+    LOG_LEVEL_QUIET = 0,        // 不输出任何日志
+    LOG_LEVEL_ERROR,            // 只输出错误
+    LOG_LEVEL_WARNING,          // 错误与警告
+    LOG_LEVEL_INFO,             // 对象创建 / 销毁等常规信息（默认）
+    LOG_LEVEL_VERBOSE           // 额外输出层、扩展、设备属性等枚举信息
+} LogLevel;
+
+/// @brief 获取当前的日志详细程度.
+///
+/// 首次调用时从环境变量 `NATIVELIB_LOG_LEVEL`（0 ~ 4，或 quiet / error / warning /
+/// info / verbose）读取，未设置时为 `LOG_LEVEL_INFO`.
+LogLevel log_get_level(void);
+
+/// @brief 设置日志详细程度（覆盖环境变量）.
+void log_set_level(LogLevel level);
+
+/// @brief 给定详细程度的日志当前是否会被输出.
+///
+/// 枚举类的诊断输出应整体包在该判断内，这样在未开启时连枚举本身都不会执行.
+static inline bool log_enabled(LogLevel level)
+{
+    return level <= log_get_level();
+}
+
+/// @brief 仅当详细程度为 VERBOSE 时输出到 stdout.
+#define LOG_VERBOSE(...)                                \
+    do {                                                \
+        if (log_enabled(LOG_LEVEL_VERBOSE))             \
+            fprintf(stdout, __VA_ARGS__);               \
+    } while (0)
@@ -0,0 +1,139 @@
+#include "thread.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+
+static DWORD WINAPI thread_entry(LPVOID pArg);
+#else
+#include <sched.h>
+#include <unistd.h>
+
+static void* thread_entry(void* pArg);
+#endif
+
+
+bool thread_start(Thread* pThread, ThreadFunc func, void* pArg)
+{
+    memset(pThread, 0, sizeof(Thread));
+    pThread->func = func;
+    pThread->pArg = pArg;
+
+#ifdef _WIN32
+    pThread->handle = CreateThread(NULL, 0, thread_entry, pThread, 0, NULL);
+    if (pThread->handle == NULL)
+    {
+        fprintf(stderr, "%s : 无法创建线程！Error Code: %lu\n", __func__, GetLastError());
+        return false;
+    }
+#else
+    int error = pthread_create(&pThread->handle, NULL, thread_entry, pThread);
+    if (error != 0)
+    {
+        fprintf(stderr, "%s : 无法创建线程！Error Code: %d\n", __func__, error);
+        return false;
+    }
+#endif
+
+    pThread->started = true;
+
+    return true;
+}
+
+
+int thread_join(Thread* pThread)
+{
+    if (!pThread->started)
+        return -1;
+
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)pThread->handle, INFINITE);
+    CloseHandle((HANDLE)pThread->handle);
+#else
+    pthread_join(pThread->handle, NULL);
+#endif
+    pThread->started = false;
+
+    return pThread->result;
+}
+
+
+#ifdef _WIN32
+
+void mutex_init(Mutex* pMutex)              { InitializeSRWLock((PSRWLOCK)&pMutex->handle); }
+void mutex_destroy(Mutex* pMutex)           { (void)pMutex; }
+void mutex_lock(Mutex* pMutex)              { AcquireSRWLockExclusive((PSRWLOCK)&pMutex->handle); }
+void mutex_unlock(Mutex* pMutex)            { ReleaseSRWLockExclusive((PSRWLOCK)&pMutex->handle); }
+
+void condvar_init(CondVar* pCondVar)        { InitializeConditionVariable((PCONDITION_VARIABLE)&pCondVar->handle); }
+void condvar_destroy(CondVar* pCondVar)     { (void)pCondVar; }
+void condvar_signal(CondVar* pCondVar)      { WakeConditionVariable((PCONDITION_VARIABLE)&pCondVar->handle); }
+void condvar_broadcast(CondVar* pCondVar)   { WakeAllConditionVariable((PCONDITION_VARIABLE)&pCondVar->handle); }
+
+void condvar_wait(CondVar* pCondVar, Mutex* pMutex)
+{
+    SleepConditionVariableSRW((PCONDITION_VARIABLE)&pCondVar->handle, (PSRWLOCK)&pMutex->handle,
+        INFINITE, 0);
+}
+
+void thread_yield(void)
+{
+    SwitchToThread();
+}
+
+uint32_t get_processor_count(void)
+{
+    DWORD count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+#else
+
+void mutex_init(Mutex* pMutex)              { pthread_mutex_init(&pMutex->handle, NULL); }
+void mutex_destroy(Mutex* pMutex)           { pthread_mutex_destroy(&pMutex->handle); }
+void mutex_lock(Mutex* pMutex)              { pthread_mutex_lock(&pMutex->handle); }
+void mutex_unlock(Mutex* pMutex)            { pthread_mutex_unlock(&pMutex->handle); }
+
+void condvar_init(CondVar* pCondVar)        { pthread_cond_init(&pCondVar->handle, NULL); }
+void condvar_destroy(CondVar* pCondVar)     { pthread_cond_destroy(&pCondVar->handle); }
+void condvar_signal(CondVar* pCondVar)      { pthread_cond_signal(&pCondVar->handle); }
+void condvar_broadcast(CondVar* pCondVar)   { pthread_cond_broadcast(&pCondVar->handle); }
+
+void condvar_wait(CondVar* pCondVar, Mutex* pMutex)
+{
+    pthread_cond_wait(&pCondVar->handle, &pMutex->handle);
+}
+
+void thread_yield(void)
+{
+    sched_yield();
+}
+
+uint32_t get_processor_count(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+#endif
+
+
+#ifdef _WIN32
+static DWORD WINAPI thread_entry(LPVOID pArg)
+#else
+static void* thread_entry(void* pArg)
+#endif
+{
+    Thread* pThread = (Thread*)pArg;
+    pThread->result = pThread->func(pThread->pArg);
+
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+/// @brief 线程入口函数，返回值由 thread_join 取回.
+typedef int (*ThreadFunc)(void* pArg);
+
+/// @brief 对平台线程（Win32 线程 / pthread）的简单封装，供任务系统的工作线程使用.
+typedef struct Thread {
+#ifdef _WIN32
+    void*           handle;
+#else
+    pthread_t       handle;
+#endif
+    ThreadFunc      func;
+    void*           pArg;
+    int             result;
+    bool            started;
+} Thread;
+
+
+/// @brief 启动一个线程执行 `func(pArg)`.
+///
+/// @return 线程启动成功时返回 `true`；失败时调用者应在当前线程上直接执行该工作
+bool thread_start(Thread* pThread, ThreadFunc func, void* pArg);
+
+/// @brief 等待线程结束并取回其返回值.
+///
+/// @return 线程入口函数的返回值，线程未启动时返回 -1
+int thread_join(Thread* pThread);
+
+
+/// @brief 互斥锁（Win32 SRW 锁 / pthread 互斥锁）.
+typedef struct Mutex {
+#ifdef _WIN32
+    void*           handle;                 // SRWLOCK（只有一个指针大小）
+#else
+    pthread_mutex_t handle;
+#endif
+} Mutex;
+
+/// @brief 条件变量（Win32 CONDITION_VARIABLE / pthread 条件变量）.
+typedef struct CondVar {
+#ifdef _WIN32
+    void*           handle;                 // CONDITION_VARIABLE（只有一个指针大小）
+#else
+    pthread_cond_t  handle;
+#endif
+} CondVar;
+
+
+void mutex_init(Mutex* pMutex);
+
+void mutex_destroy(Mutex* pMutex);
+
+void mutex_lock(Mutex* pMutex);
+
+void mutex_unlock(Mutex* pMutex);
+
+void condvar_init(CondVar* pCondVar);
+
+void condvar_destroy(CondVar* pCondVar);
+
+/// @brief 原子地释放 `pMutex` 并等待，被唤醒后重新持有 `pMutex`（可能虚假唤醒，调用者需重新检查条件）.
+void condvar_wait(CondVar* pCondVar, Mutex* pMutex);
+
+void condvar_signal(CondVar* pCondVar);
+
+void condvar_broadcast(CondVar* pCondVar);
+
+/// @brief 让出当前线程的剩余时间片.
+void thread_yield(void);
+
+/// @brief 获取逻辑处理器的数量（至少为 1）.
+uint32_t get_processor_count(void);
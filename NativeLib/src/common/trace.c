@@ -0,0 +1,201 @@
+#include "trace.h"
+#include "frame_limiter.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief 环中的一个槽位.
+///
+/// 写入方先把序号置 0 再写事件，写完后发布为写入位置 + 1；读取方在拷贝前后各读一次序号，
+/// 两次一致且等于期望的位置才采用（seqlock），因此写入方无需加锁，也不会等待读取方.
+typedef struct TraceSlot {
+    atomic_uint_fast64_t    sequence;
+    TraceEvent              event;
+} TraceSlot;
+
+static TraceSlot traceRing[TRACE_RING_CAPACITY];
+
+/// @brief 下一个写入位置（单调递增，取模后为槽位）
+static atomic_uint_fast64_t traceHead;
+
+/// @brief 追踪是否开启，-1 表示尚未从环境变量读取
+static atomic_int traceEnabled = -1;
+
+static atomic_uint nextThreadId;
+static _Thread_local uint32_t tlsThreadId = 0;
+static _Atomic(const char*) threadNames[TRACE_MAX_NAMED_THREADS];
+
+static uint32_t current_thread_id(void);
+static void write_metadata(FILE* pFile, uint32_t threadId, const char* name);
+
+
+bool trace_is_enabled(void)
+{
+    int enabled = atomic_load_explicit(&traceEnabled, memory_order_relaxed);
+    if (enabled < 0)
+    {
+        // 多个线程同时首次调用时只会重复解析同一个环境变量，结果相同
+        const char* value = getenv("NATIVELIB_TRACE");
+        enabled = value != NULL && value[0] != '\0' && strtol(value, NULL, 10) != 0;
+        atomic_store_explicit(&traceEnabled, enabled, memory_order_relaxed);
+    }
+
+    return enabled != 0;
+}
+
+
+void trace_set_enabled(bool enabled)
+{
+    atomic_store_explicit(&traceEnabled, enabled ? 1 : 0, memory_order_relaxed);
+}
+
+
+void trace_set_thread_name(const char* name)
+{
+    uint32_t threadId = current_thread_id();
+    if (threadId < TRACE_MAX_NAMED_THREADS)
+        atomic_store_explicit(&threadNames[threadId], name, memory_order_relaxed);
+}
+
+
+uint64_t trace_begin(void)
+{
+    return trace_is_enabled() ? frame_limiter_now_ns() : 0;
+}
+
+
+void trace_end(const char* name, uint64_t startNs)
+{
+    if (startNs == 0)
+        return;
+
+    trace_record(name, current_thread_id(), startNs, frame_limiter_now_ns() - startNs);
+}
+
+
+void trace_record(const char* name, uint32_t threadId, uint64_t startNs, uint64_t durationNs)
+{
+    uint64_t position = atomic_fetch_add_explicit(&traceHead, 1, memory_order_relaxed);
+    TraceSlot* pSlot = &traceRing[position & (TRACE_RING_CAPACITY - 1)];
+
+    // 先让读取方看到槽位正在写入，再覆盖事件
+    atomic_store_explicit(&pSlot->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    pSlot->event.name       = name;
+    pSlot->event.startNs    = startNs;
+    pSlot->event.durationNs = durationNs;
+    pSlot->event.threadId   = threadId;
+
+    atomic_store_explicit(&pSlot->sequence, position + 1, memory_order_release);
+}
+
+
+bool trace_capture(const char* path, double seconds)
+{
+    TraceEvent* pEvents = (TraceEvent*)malloc(sizeof(TraceEvent) * TRACE_RING_CAPACITY);
+    if (pEvents == NULL)
+    {
+        fprintf(stderr, "%s : 分配追踪事件的缓冲失败！\n", __func__);
+        return false;
+    }
+
+    // 1.从环中拷贝最近结束的事件，跳过正在写入或已被覆盖的槽位
+    uint64_t nowNs  = frame_limiter_now_ns();
+    uint64_t spanNs = seconds > 0.0 ? (uint64_t)(seconds * 1e9) : UINT64_MAX;
+    uint64_t cutoff = spanNs < nowNs ? nowNs - spanNs : 0;
+
+    uint64_t head   = atomic_load_explicit(&traceHead, memory_order_acquire);
+    uint64_t first  = head > TRACE_RING_CAPACITY ? head - TRACE_RING_CAPACITY : 0;
+    uint64_t baseNs = UINT64_MAX;
+    uint32_t count  = 0;
+
+    for (uint64_t position = first; position < head; position++)
+    {
+        TraceSlot* pSlot = &traceRing[position & (TRACE_RING_CAPACITY - 1)];
+
+        uint64_t sequence = atomic_load_explicit(&pSlot->sequence, memory_order_acquire);
+        if (sequence != position + 1)
+            continue;
+
+        TraceEvent event = pSlot->event;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&pSlot->sequence, memory_order_relaxed) != sequence)
+            continue;
+
+        if (event.startNs + event.durationNs < cutoff)
+            continue;
+
+        pEvents[count++] = event;
+        if (event.startNs < baseNs)
+            baseNs = event.startNs;
+    }
+
+    // 2.写为 Chrome Trace Event JSON，时刻以最早的事件为零点（微秒）
+    FILE* pFile = fopen(path, "wb");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "%s : 无法创建追踪文件 %s！\n", __func__, path);
+        free(pEvents);
+        return false;
+    }
+
+    fprintf(pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    fprintf(pFile, "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"nativelib_renderer\"}}");
+
+    for (uint32_t i = 0; i < TRACE_MAX_NAMED_THREADS; i++)
+    {
+        const char* name = atomic_load_explicit(&threadNames[i], memory_order_relaxed);
+        if (name != NULL)
+            write_metadata(pFile, i, name);
+    }
+    write_metadata(pFile, TRACE_GPU_THREAD_ID, "GPU");
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const TraceEvent* pEvent = &pEvents[i];
+
+        fprintf(pFile, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            pEvent->name,
+            pEvent->threadId == TRACE_GPU_THREAD_ID ? "gpu" : "cpu",
+            pEvent->threadId,
+            (double)(pEvent->startNs - baseNs) / 1000.0,
+            (double)pEvent->durationNs / 1000.0);
+    }
+
+    fprintf(pFile, "\n]}\n");
+
+    bool succeeded = ferror(pFile) == 0;
+    if (fclose(pFile) != 0)
+        succeeded = false;
+    free(pEvents);
+
+    if (!succeeded)
+    {
+        fprintf(stderr, "%s : 写入追踪文件 %s 失败！\n", __func__, path);
+        return false;
+    }
+
+    fprintf(stdout, "已写出 %u 个追踪事件到 %s\n", count, path);
+
+    return true;
+}
+
+
+/// @brief 调用线程的追踪编号（从 1 开始，首次调用时分配）.
+static uint32_t current_thread_id(void)
+{
+    if (tlsThreadId == 0)
+        tlsThreadId = atomic_fetch_add_explicit(&nextThreadId, 1, memory_order_relaxed) + 1;
+
+    return tlsThreadId;
+}
+
+
+/// @brief 写出一条线程名的元数据事件.
+static void write_metadata(FILE* pFile, uint32_t threadId, const char* name)
+{
+    fprintf(pFile, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+        threadId, name);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// @brief 事件环的槽位数（2 的幂），写满后覆盖最旧的事件.
+#define TRACE_RING_CAPACITY     (1u << 17)
+
+/// @brief 可命名的线程数，超出的线程只以编号显示.
+#define TRACE_MAX_NAMED_THREADS 64
+
+/// @brief GPU 时间线使用的线程编号，与 CPU 线程的编号（从 1 开始递增）区分.
+#define TRACE_GPU_THREAD_ID     1000u
+
+/// @brief 一个完整的追踪区间（Chrome Trace Event 的 "X" 事件）.
+typedef struct TraceEvent {
+    const char* name;                   // 区间名，需为静态存储期的字符串
+    uint64_t    startNs;                // 开始时刻（frame_limiter_now_ns 的时钟）
+    uint64_t    durationNs;
+    uint32_t    threadId;
+} TraceEvent;
+
+
+/// @brief 追踪当前是否开启.
+///
+/// 首次调用时从环境变量 `NATIVELIB_TRACE`（非 0 即开启）读取，未设置时关闭.
+bool trace_is_enabled(void);
+
+/// @brief 开启或关闭追踪（覆盖环境变量），关闭时已记录的事件保留在环中.
+void trace_set_enabled(bool enabled);
+
+/// @brief 为调用线程命名（显示在时间线上），名字需为静态存储期的字符串.
+void trace_set_thread_name(const char* name);
+
+/// @brief 开始一个 CPU 区间.
+///
+/// @return 追踪开启时为当前时刻（纳秒），否则为 0（之后的 trace_end 什么也不做）
+uint64_t trace_begin(void);
+
+/// @brief 结束由 trace_begin 开始的区间，记录到调用线程的时间线上.
+void trace_end(const char* name, uint64_t startNs);
+
+/// @brief 记录一个已知起止时刻的区间（如换算到 CPU 时钟的 GPU 时间戳）.
+void trace_record(const char* name, uint32_t threadId, uint64_t startNs, uint64_t durationNs);
+
+/// @brief 把最近 seconds 秒内结束的事件写为 Chrome Trace Event JSON（可由 Perfetto / chrome://tracing 打开）.
+///
+/// 可在任意线程调用，写入期间其他线程继续记录；seconds 不大于 0 时写出环中的全部事件.
+///
+/// @return 是否成功写出
+bool trace_capture(const char* path, double seconds);
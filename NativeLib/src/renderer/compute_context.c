@@ -0,0 +1,85 @@
+#include "compute_context.h"
+
+
+bool create_compute_context(
+    VkDevice            device,
+    uint32_t            computeQueueFamilyIndex,
+    uint32_t            graphicsQueueFamilyIndex,
+    ComputeContext*     pComputeContext
+)
+{
+    memset(pComputeContext, 0, sizeof(ComputeContext));
+
+    pComputeContext->async = computeQueueFamilyIndex != graphicsQueueFamilyIndex;
+    if (!pComputeContext->async)
+    {
+        fprintf(stdout, "%s : 没有专用的计算队列族，计算通道将录制在图形命令缓冲中.\n", __func__);
+        return true;
+    }
+
+    // 1.compute 队列族上的命令池与每帧的命令缓冲
+    pComputeContext->commandPool = createCommandPool(device, computeQueueFamilyIndex);
+    if (pComputeContext->commandPool == VK_NULL_HANDLE)
+        return false;
+
+    VkCommandBufferAllocateInfo allocateInfo = {};
+    allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocateInfo.commandPool        = pComputeContext->commandPool;
+    allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = MAX_FRAMES_IN_FLIGHT;
+
+    VkResult result = 
+        vkAllocateCommandBuffers(device, &allocateInfo, pComputeContext->commandBuffers);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to allocate VkCommandBuffers! Error Code(VkResult): %d\n", result);
+
+        destroy_compute_context(device, pComputeContext);
+        return false;
+    }
+
+    // 2.计算完成 -> 图形提交的跨队列信号量
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        if (vkCreateSemaphore(device, &semaphoreInfo, get_vulkan_allocator(),
+                &pComputeContext->finishedSemaphores[i]) != VK_SUCCESS)
+        {
+            fprintf(stderr, "%s : 为帧（%u）创建信号量失败！\n", __func__, i);
+
+            destroy_compute_context(device, pComputeContext);
+            return false;
+        }
+    }
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "成功创建了计算上下文（异步计算队列族 %u）！\n",
+        __DATE__, __TIME__, computeQueueFamilyIndex);
+
+    return true;
+}
+
+
+void destroy_compute_context(VkDevice device, ComputeContext* pComputeContext)
+{
+    if (device == VK_NULL_HANDLE || pComputeContext == NULL)
+        return;
+
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        if (pComputeContext->finishedSemaphores[i] != VK_NULL_HANDLE)
+            vkDestroySemaphore(device, pComputeContext->finishedSemaphores[i],
+                get_vulkan_allocator());
+
+        pComputeContext->finishedSemaphores[i]  = VK_NULL_HANDLE;
+        pComputeContext->commandBuffers[i]      = VK_NULL_HANDLE;
+    }
+
+    // 命令缓冲随命令池一并释放
+    if (pComputeContext->commandPool != VK_NULL_HANDLE)
+        destroyCommandPool(device, pComputeContext->commandPool);
+    pComputeContext->commandPool = VK_NULL_HANDLE;
+}
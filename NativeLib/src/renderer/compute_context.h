@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../common/ansi_esc.h"
+#include "vulkan_wrapper.h"
+#include "frame_context.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 计算管线推送常量的字节数（maxPushConstantsSize 保证的下限），缓冲以设备地址传入.
+#define COMPUTE_PUSH_CONSTANT_SIZE      128
+
+/// @brief 计算上下文，管理每个在途帧的计算命令缓冲与跨队列信号量.
+///
+/// 设备有专用的计算队列族时（`async` 为 `true`），计算通道录制到独立的命令缓冲，结束时立即
+/// 提交到 compute 队列并触发 `finishedSemaphores`，同一帧的图形提交只在消费其结果的阶段
+/// 等待该信号量，因此计算与之前的光栅化工作可以在 GPU 上并行执行.
+///
+/// 没有专用队列族时退回到 graphics 队列：计算命令直接录制到该帧的图形命令缓冲中，
+/// 以管线屏障代替信号量.
+///
+/// 被计算写入、被图形读取的资源在两个队列族之间共享，创建时应使用
+/// `VK_SHARING_MODE_CONCURRENT` 并列出两者的队列族索引（退回时两者相同，无需如此），
+/// 见 get_shared_queue_families.
+///
+/// 异步时计算只与同一帧的图形提交同步，可能与上一帧仍在执行的渲染重叠，
+/// 被计算写入的资源应按在途帧各备一份.
+typedef struct ComputeContext {
+    bool                async;                      // 是否使用独立的 compute 队列
+    VkCommandPool       commandPool;                // 仅 async 时创建
+    VkCommandBuffer     commandBuffers[MAX_FRAMES_IN_FLIGHT];
+    VkSemaphore         finishedSemaphores[MAX_FRAMES_IN_FLIGHT];
+
+    bool                recording;                  // 是否处于 begin_compute_pass 与 end_compute_pass 之间
+    VkCommandBuffer     commandBuffer;              // recording 时为录制计算命令的命令缓冲
+    uint32_t            dispatchCount;              // 本次计算通道中已录制的调度数
+    bool                submitted;                  // 本帧是否提交了计算（图形提交需等待）
+    VkPipelineStageFlags waitStage;                 // 图形提交等待计算结果的阶段
+} ComputeContext;
+
+
+/// @brief 创建计算上下文（compute 与 graphics 为同一队列族时不创建任何对象）.
+///
+/// @param computeQueueFamilyIndex compute 队列所属的队列族索引
+/// @param graphicsQueueFamilyIndex graphics 队列所属的队列族索引
+///
+/// @return 成功时返回 `true`，失败时已创建的对象会被销毁并返回 `false`
+bool create_compute_context(
+    VkDevice            device,
+    uint32_t            computeQueueFamilyIndex,
+    uint32_t            graphicsQueueFamilyIndex,
+    ComputeContext*     pComputeContext
+);
+
+/// @brief 销毁计算上下文中的所有对象（调用前需确保 GPU 已空闲）.
+void destroy_compute_context(VkDevice device, ComputeContext* pComputeContext);
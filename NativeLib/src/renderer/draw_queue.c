@@ -0,0 +1,218 @@
+#include "draw_queue.h"
+
+#include <string.h>
+
+#define RADIX_BITS      8
+#define RADIX_SIZE      (1u << RADIX_BITS)
+
+/// @brief 一趟基数排序的参数，由各块的任务共享.
+typedef struct RadixPass {
+    uint32_t*           pHistograms;            // 块 c 的直方图位于 [c * RADIX_SIZE, (c + 1) * RADIX_SIZE)
+    const uint64_t*     pSrcKeys;
+    const uint32_t*     pSrcOrder;
+    uint64_t*           pDstKeys;
+    uint32_t*           pDstOrder;
+    uint32_t            count;
+    uint32_t            chunkSize;
+    uint32_t            shift;
+} RadixPass;
+
+static void radix_histogram_range(void* pArg, uint32_t beginChunk, uint32_t endChunk);
+static void radix_scatter_range(void* pArg, uint32_t beginChunk, uint32_t endChunk);
+
+
+bool create_draw_queue(uint32_t capacity, DrawQueue* pQueue)
+{
+    memset(pQueue, 0, sizeof(DrawQueue));
+
+    if (capacity == 0)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！容量不能为 0.\n", __func__);
+        return false;
+    }
+
+    size_t arenaSize = capacity * (sizeof(DrawCommand) + 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t))
+                     + JOB_PARALLEL_FOR_MAX_CHUNKS * RADIX_SIZE * sizeof(uint32_t)
+                     + 6 * 64;
+    if (!arena_init(&pQueue->arena, arenaSize))
+        return false;
+
+    pQueue->capacity        = capacity;
+    pQueue->pCommands       = (DrawCommand*)arena_alloc(&pQueue->arena, capacity * sizeof(DrawCommand), 64);
+    pQueue->pKeys           = (uint64_t*)arena_alloc(&pQueue->arena, capacity * sizeof(uint64_t), 64);
+    pQueue->pOrder          = (uint32_t*)arena_alloc(&pQueue->arena, capacity * sizeof(uint32_t), 64);
+    pQueue->pScratchKeys    = (uint64_t*)arena_alloc(&pQueue->arena, capacity * sizeof(uint64_t), 64);
+    pQueue->pScratchOrder   = (uint32_t*)arena_alloc(&pQueue->arena, capacity * sizeof(uint32_t), 64);
+    pQueue->pHistograms     = (uint32_t*)arena_alloc(&pQueue->arena,
+                                  JOB_PARALLEL_FOR_MAX_CHUNKS * RADIX_SIZE * sizeof(uint32_t), 64);
+    if (pQueue->pCommands == NULL || pQueue->pKeys == NULL || pQueue->pOrder == NULL
+        || pQueue->pScratchKeys == NULL || pQueue->pScratchOrder == NULL || pQueue->pHistograms == NULL)
+    {
+        arena_release(&pQueue->arena);
+        return false;
+    }
+
+    return true;
+}
+
+
+void destroy_draw_queue(DrawQueue* pQueue)
+{
+    arena_release(&pQueue->arena);
+    memset(pQueue, 0, sizeof(DrawQueue));
+}
+
+
+uint32_t draw_queue_push(DrawQueue* pQueue, const DrawCommand* pCommands, uint32_t count)
+{
+    uint32_t available = pQueue->capacity - pQueue->count;
+    if (count > available)
+        count = available;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t index = pQueue->count + i;
+
+        pQueue->pCommands[index]    = pCommands[i];
+        pQueue->pKeys[index]        = draw_queue_make_key(&pCommands[i]);
+        pQueue->pOrder[index]       = index;
+    }
+    pQueue->count += count;
+
+    return count;
+}
+
+
+void draw_queue_sort(DrawQueue* pQueue, JobSystem* pJobs)
+{
+    pQueue->stats.sortPasses = 0;
+
+    uint32_t count = pQueue->count;
+    if (count < 2)
+        return;
+
+    // 1.绘制数较多时拆分为若干块并行，否则整体作为一块在当前线程上处理
+    bool parallel = pJobs != NULL && pJobs->workerCount > 1 && count >= DRAW_QUEUE_PARALLEL_THRESHOLD;
+    uint32_t chunkCount = 1;
+    if (parallel)
+    {
+        chunkCount = 2 * pJobs->workerCount;
+        if (chunkCount > JOB_PARALLEL_FOR_MAX_CHUNKS)
+            chunkCount = JOB_PARALLEL_FOR_MAX_CHUNKS;
+    }
+
+    RadixPass pass = {};
+    pass.pHistograms    = pQueue->pHistograms;
+    pass.count          = count;
+    pass.chunkSize      = (count + chunkCount - 1) / chunkCount;
+
+    uint64_t* pSrcKeys  = pQueue->pKeys;
+    uint32_t* pSrcOrder = pQueue->pOrder;
+    uint64_t* pDstKeys  = pQueue->pScratchKeys;
+    uint32_t* pDstOrder = pQueue->pScratchOrder;
+
+    for (uint32_t shift = 0; shift < 64; shift += RADIX_BITS)
+    {
+        pass.pSrcKeys   = pSrcKeys;
+        pass.pSrcOrder  = pSrcOrder;
+        pass.pDstKeys   = pDstKeys;
+        pass.pDstOrder  = pDstOrder;
+        pass.shift      = shift;
+
+        // 2.统计各块的直方图
+        if (parallel)
+            job_system_parallel_for(pJobs, chunkCount, 1, radix_histogram_range, &pass);
+        else
+            radix_histogram_range(&pass, 0, 1);
+
+        // 3.所有键在该字节上都相同时（如未使用的字段、单一通道）跳过这一趟
+        bool uniform = false;
+        for (uint32_t digit = 0; digit < RADIX_SIZE && !uniform; digit++)
+        {
+            uint32_t total = 0;
+            for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+                total += pass.pHistograms[chunk * RADIX_SIZE + digit];
+
+            uniform = total == count;
+        }
+        if (uniform)
+            continue;
+
+        // 4.把直方图就地换算为各块、各数字的起始位置（数字优先，同一数字内块按顺序，保持稳定）
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < RADIX_SIZE; digit++)
+        {
+            for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+            {
+                uint32_t* pBucket = &pass.pHistograms[chunk * RADIX_SIZE + digit];
+                uint32_t bucketCount = *pBucket;
+
+                *pBucket = offset;
+                offset += bucketCount;
+            }
+        }
+
+        // 5.分发到双缓冲的另一侧
+        if (parallel)
+            job_system_parallel_for(pJobs, chunkCount, 1, radix_scatter_range, &pass);
+        else
+            radix_scatter_range(&pass, 0, 1);
+
+        uint64_t* pKeys = pSrcKeys;
+        pSrcKeys = pDstKeys;
+        pDstKeys = pKeys;
+
+        uint32_t* pOrder = pSrcOrder;
+        pSrcOrder = pDstOrder;
+        pDstOrder = pOrder;
+
+        pQueue->stats.sortPasses++;
+    }
+
+    // 6.结果总是通过 pKeys / pOrder 访问（交换的只是指针）
+    pQueue->pKeys           = pSrcKeys;
+    pQueue->pOrder          = pSrcOrder;
+    pQueue->pScratchKeys    = pDstKeys;
+    pQueue->pScratchOrder   = pDstOrder;
+}
+
+
+/// @brief 统计块 [beginChunk, endChunk) 在当前字节上的直方图.
+static void radix_histogram_range(void* pArg, uint32_t beginChunk, uint32_t endChunk)
+{
+    RadixPass* pPass = (RadixPass*)pArg;
+
+    for (uint32_t chunk = beginChunk; chunk < endChunk; chunk++)
+    {
+        uint32_t* pHistogram = &pPass->pHistograms[chunk * RADIX_SIZE];
+        memset(pHistogram, 0, RADIX_SIZE * sizeof(uint32_t));
+
+        uint32_t begin  = chunk * pPass->chunkSize;
+        uint32_t end    = begin + pPass->chunkSize < pPass->count ? begin + pPass->chunkSize : pPass->count;
+        for (uint32_t i = begin; i < end; i++)
+            pHistogram[(pPass->pSrcKeys[i] >> pPass->shift) & (RADIX_SIZE - 1)]++;
+    }
+}
+
+
+/// @brief 按各块的起始位置把块 [beginChunk, endChunk) 中的（键, 下标）分发到目标缓冲.
+static void radix_scatter_range(void* pArg, uint32_t beginChunk, uint32_t endChunk)
+{
+    RadixPass* pPass = (RadixPass*)pArg;
+
+    for (uint32_t chunk = beginChunk; chunk < endChunk; chunk++)
+    {
+        uint32_t* pOffsets = &pPass->pHistograms[chunk * RADIX_SIZE];
+
+        uint32_t begin  = chunk * pPass->chunkSize;
+        uint32_t end    = begin + pPass->chunkSize < pPass->count ? begin + pPass->chunkSize : pPass->count;
+        for (uint32_t i = begin; i < end; i++)
+        {
+            uint64_t key = pPass->pSrcKeys[i];
+            uint32_t destination = pOffsets[(key >> pPass->shift) & (RADIX_SIZE - 1)]++;
+
+            pPass->pDstKeys[destination]    = key;
+            pPass->pDstOrder[destination]   = pPass->pSrcOrder[i];
+        }
+    }
+}
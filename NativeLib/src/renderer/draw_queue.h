@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../common/arena.h"
+#include "../common/job_system.h"
+#include "resource_table.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 渲染上下文中绘制队列的默认容量（每帧的绘制命令数）.
+#define DRAW_QUEUE_CAPACITY                 65536
+/// @brief 绘制数不少于该值时并行排序（更少时拆分任务的开销大于收益）.
+#define DRAW_QUEUE_PARALLEL_THRESHOLD       16384
+
+/// @brief 排序键各字段的位置与宽度（从高位到低位：通道、材质、网格、深度）.
+///
+/// 按键升序排列即先按通道（表面）分组，组内按材质、网格依次分组，最后由近及远；
+/// 管线由网格的种类决定，按网格分组即按管线分组.
+#define DRAW_KEY_PASS_SHIFT                 56
+#define DRAW_KEY_PASS_BITS                  8
+#define DRAW_KEY_MATERIAL_SHIFT             40
+#define DRAW_KEY_MATERIAL_BITS              16
+#define DRAW_KEY_MESH_SHIFT                 16
+#define DRAW_KEY_MESH_BITS                  24
+#define DRAW_KEY_DEPTH_BITS                 16
+
+/// @brief 一条绘制命令，与 C# 的 DrawCommand 布局一致.
+typedef struct DrawCommand {
+    ResourceHandle      mesh;                   // 为 RESOURCE_INVALID_HANDLE 时以 vertexCount 用三角形管线做非索引绘制
+    uint32_t            uniformOffset;          // uniform 环形缓冲的动态偏移，UNIFORM_RING_INVALID_OFFSET 时使用默认的 ObjectUniforms
+    uint32_t            vertexCount;            // 仅在没有网格时使用
+    uint32_t            instanceCount;          // 为 0 时视为 1
+    int32_t             surface;                // 表面编号，即排序键中的通道
+    float               depth;                  // [0, 1]，同一状态下由近及远绘制
+} DrawCommand;
+
+/// @brief 绘制队列上一次提交的统计信息.
+typedef struct DrawQueueStats {
+    uint32_t            drawCount;              // 录制的绘制数
+    uint32_t            skippedCount;           // 因句柄过期、资源被驱逐或表面不可绘制而跳过的绘制数
+    uint32_t            mergedDraws;            // 与前一条绘制合并（索引区间相邻的拉取网格）的绘制数
+    uint32_t            pipelineBinds;
+    uint32_t            uniformBinds;
+    uint32_t            meshBinds;
+    uint32_t            sortPasses;             // 实际执行的基数排序趟数（全部相同的字节被跳过）
+} DrawQueueStats;
+
+/// @brief 每帧的绘制队列：命令以任意顺序加入，提交前按 64 位状态键排序.
+///
+/// 排序为 LSD 基数排序（每趟 8 位，最多 8 趟），对（键, 命令下标）成对排序，命令本身不移动.
+/// 绘制数较多时每趟拆分为若干块：各块并行统计直方图，串行求前缀和后再并行分发，
+/// 块内保持原有顺序，因此排序仍然稳定.
+typedef struct DrawQueue {
+    Arena               arena;                  // 命令、键与排序缓冲的唯一一次分配
+    uint32_t            capacity;
+    uint32_t            count;
+
+    DrawCommand*        pCommands;
+    uint64_t*           pKeys;                  // 排序后即为有序的键
+    uint32_t*           pOrder;                 // 排序后为按键升序的命令下标
+    uint64_t*           pScratchKeys;           // 排序的双缓冲
+    uint32_t*           pScratchOrder;
+    uint32_t*           pHistograms;            // JOB_PARALLEL_FOR_MAX_CHUNKS 个 256 项的直方图
+
+    DrawQueueStats      stats;
+} DrawQueue;
+
+
+/// @brief 创建绘制队列.
+///
+/// @return 成功时返回 `true`
+bool create_draw_queue(uint32_t capacity, DrawQueue* pQueue);
+
+/// @brief 释放绘制队列的内存.
+void destroy_draw_queue(DrawQueue* pQueue);
+
+/// @brief 把 `count` 条命令加入队列，并计算其排序键.
+///
+/// @return 加入的命令数，队列已满时少于 `count`
+uint32_t draw_queue_push(DrawQueue* pQueue, const DrawCommand* pCommands, uint32_t count);
+
+/// @brief 按排序键对队列排序，之后按 pOrder 的顺序录制即可.
+///
+/// @param pJobs 绘制数不少于 `DRAW_QUEUE_PARALLEL_THRESHOLD` 时用于并行排序，可为 `NULL`
+void draw_queue_sort(DrawQueue* pQueue, JobSystem* pJobs);
+
+/// @brief 清空队列（提交后调用）.
+static inline void draw_queue_reset(DrawQueue* pQueue)
+{
+    pQueue->count = 0;
+}
+
+/// @brief 由各字段打包出排序键.
+///
+/// 网格取其句柄的槽位索引，材质取 uniform 偏移（以 256 字节，即
+/// minUniformBufferOffsetAlignment 的上限为单位）；截断造成的碰撞只影响分组，
+/// 录制时仍比较完整的句柄与偏移来消除冗余绑定.
+static inline uint64_t draw_queue_make_key(const DrawCommand* pCommand)
+{
+    uint64_t pass       = (uint64_t)(uint32_t)pCommand->surface & ((1u << DRAW_KEY_PASS_BITS) - 1);
+    uint64_t material   = (pCommand->uniformOffset >> 8) & ((1u << DRAW_KEY_MATERIAL_BITS) - 1);
+    uint64_t mesh       = pCommand->mesh == RESOURCE_INVALID_HANDLE ? 0
+                        : ((pCommand->mesh & RESOURCE_HANDLE_INDEX_MASK) + 1)
+                          & ((1u << DRAW_KEY_MESH_BITS) - 1);
+
+    float depth = pCommand->depth;
+    if (!(depth > 0.0f))                        // 同时处理 NaN
+        depth = 0.0f;
+    if (depth > 1.0f)
+        depth = 1.0f;
+    uint64_t quantizedDepth = (uint64_t)(depth * (float)((1u << DRAW_KEY_DEPTH_BITS) - 1));
+
+    return pass         << DRAW_KEY_PASS_SHIFT
+         | material     << DRAW_KEY_MATERIAL_SHIFT
+         | mesh         << DRAW_KEY_MESH_SHIFT
+         | quantizedDepth;
+}
@@ -0,0 +1,232 @@
+#include "frame_context.h"
+
+static bool create_timestamp_query_pool(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            queueFamilyIndex,
+    FrameContext*       pFrameContext
+);
+
+
+bool create_frame_context(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            queueFamilyIndex,
+    FrameContext*       pFrameContext
+)
+{
+    if (device == VK_NULL_HANDLE || pFrameContext == NULL)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！无法创建帧上下文.\n", __func__);
+
+        return false;
+    }
+
+    memset(pFrameContext, 0, sizeof(FrameContext));
+
+    // 1.命令池
+    pFrameContext->commandPool = createCommandPool(device, queueFamilyIndex);
+    if (pFrameContext->commandPool == VK_NULL_HANDLE)
+        return false;
+
+    // 2.每帧一个主命令缓冲
+    VkCommandBuffer commandBuffers[MAX_FRAMES_IN_FLIGHT];
+
+    VkCommandBufferAllocateInfo allocateInfo = {};
+    allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocateInfo.commandPool        = pFrameContext->commandPool;
+    allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = MAX_FRAMES_IN_FLIGHT;
+
+    VkResult result = vkAllocateCommandBuffers(device, &allocateInfo, commandBuffers);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to allocate VkCommandBuffers! Error Code(VkResult): %d\n", result);
+
+        destroy_frame_context(device, pFrameContext);
+        return false;
+    }
+
+    // 3.栅栏以已触发状态创建，避免第一帧永远等待
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        FrameData* pFrame = &pFrameContext->frames[i];
+        pFrame->commandBuffer = commandBuffers[i];
+
+        if (vkCreateFence(device, &fenceInfo, get_vulkan_allocator(),
+                &pFrame->inFlightFence) != VK_SUCCESS)
+        {
+            fprintf(stderr, "%s : 为帧（%u）创建栅栏失败！\n", __func__, i);
+
+            destroy_frame_context(device, pFrameContext);
+            return false;
+        }
+    }
+
+    // 4.时间戳查询池（可选）
+    pFrameContext->lastGpuFrameTimeMs = -1.0;
+    if (!create_timestamp_query_pool(physicalDevice, device, queueFamilyIndex, pFrameContext))
+    {
+        fprintf(stdout, "%s : 队列族不支持时间戳查询，将不测量 GPU 耗时.\n", __func__);
+    }
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "成功创建了帧上下文（%d 帧在途）！\n",
+        __DATE__, __TIME__, MAX_FRAMES_IN_FLIGHT);
+
+    return true;
+}
+
+
+void destroy_frame_context(VkDevice device, FrameContext* pFrameContext)
+{
+    if (device == VK_NULL_HANDLE || pFrameContext == NULL)
+        return;
+
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        FrameData* pFrame = &pFrameContext->frames[i];
+
+        if (pFrame->inFlightFence != VK_NULL_HANDLE)
+            vkDestroyFence(device, pFrame->inFlightFence, get_vulkan_allocator());
+
+        pFrame->inFlightFence           = VK_NULL_HANDLE;
+        pFrame->commandBuffer           = VK_NULL_HANDLE;
+    }
+
+    if (pFrameContext->timestampQueryPool != VK_NULL_HANDLE)
+        vkDestroyQueryPool(device, pFrameContext->timestampQueryPool, get_vulkan_allocator());
+    pFrameContext->timestampQueryPool = VK_NULL_HANDLE;
+
+    // 命令缓冲随命令池一并释放
+    if (pFrameContext->commandPool != VK_NULL_HANDLE)
+        destroyCommandPool(device, pFrameContext->commandPool);
+
+    pFrameContext->commandPool = VK_NULL_HANDLE;
+}
+
+
+uint64_t poll_completed_serial(VkDevice device, FrameContext* pFrameContext)
+{
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        FrameData* pFrame = &pFrameContext->frames[i];
+
+        // 序号不大于 completedSerial 的提交已确认完成，其栅栏可能已被重置，不能再查询
+        if (pFrame->serial <= pFrameContext->completedSerial)
+            continue;
+
+        if (vkGetFenceStatus(device, pFrame->inFlightFence) == VK_SUCCESS)
+            pFrameContext->completedSerial = pFrame->serial;
+    }
+
+    return pFrameContext->completedSerial;
+}
+
+
+void frame_write_begin_timestamp(FrameContext* pFrameContext)
+{
+    FrameData* pFrame = current_frame_data(pFrameContext);
+    pFrame->timestampsWritten = false;
+
+    if (pFrameContext->timestampQueryPool == VK_NULL_HANDLE)
+        return;
+
+    uint32_t firstQuery = pFrameContext->currentFrame * 2;
+    vkCmdResetQueryPool(pFrame->commandBuffer,
+        pFrameContext->timestampQueryPool, firstQuery, 2);
+    vkCmdWriteTimestamp(pFrame->commandBuffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        pFrameContext->timestampQueryPool, firstQuery);
+}
+
+
+void frame_write_end_timestamp(FrameContext* pFrameContext)
+{
+    FrameData* pFrame = current_frame_data(pFrameContext);
+
+    if (pFrameContext->timestampQueryPool == VK_NULL_HANDLE)
+        return;
+
+    vkCmdWriteTimestamp(pFrame->commandBuffer,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        pFrameContext->timestampQueryPool, pFrameContext->currentFrame * 2 + 1);
+
+    pFrame->timestampsWritten = true;
+}
+
+
+void frame_collect_gpu_time(VkDevice device, FrameContext* pFrameContext)
+{
+    FrameData* pFrame = current_frame_data(pFrameContext);
+
+    if (pFrameContext->timestampQueryPool == VK_NULL_HANDLE || !pFrame->timestampsWritten)
+        return;
+
+    uint64_t timestamps[2] = {0, 0};
+    VkResult result = vkGetQueryPoolResults(device,
+                          pFrameContext->timestampQueryPool,
+                          pFrameContext->currentFrame * 2, 2,
+                          sizeof(timestamps), timestamps, sizeof(uint64_t),
+                          VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS)
+        return;
+
+    uint64_t ticks = (timestamps[1] - timestamps[0]) & pFrameContext->timestampMask;
+    pFrameContext->lastGpuFrameTimeMs = 
+        (double)ticks * pFrameContext->timestampPeriod * 1e-6;
+    pFrame->timestampsWritten = false;
+}
+
+
+/// @brief 当队列族支持时间戳时创建 2 * MAX_FRAMES_IN_FLIGHT 个时间戳查询.
+///
+/// @return 队列族不支持时间戳或创建失败时返回 `false`（不视为错误）
+static bool create_timestamp_query_pool(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            queueFamilyIndex,
+    FrameContext*       pFrameContext
+)
+{
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, NULL);
+
+    VkQueueFamilyProperties queueFamilies[queueFamilyCount];
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice,
+        &queueFamilyCount,
+        queueFamilies);
+
+    if (queueFamilyIndex >= queueFamilyCount
+        || queueFamilies[queueFamilyIndex].timestampValidBits == 0
+        || properties.limits.timestampPeriod <= 0.0f)
+        return false;
+
+    VkQueryPoolCreateInfo createInfo = {};
+    createInfo.sType        = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType    = VK_QUERY_TYPE_TIMESTAMP;
+    createInfo.queryCount   = 2 * MAX_FRAMES_IN_FLIGHT;
+
+    VkResult result = vkCreateQueryPool(device, &createInfo, get_vulkan_allocator(),
+                          &pFrameContext->timestampQueryPool);
+    if (result != VK_SUCCESS)
+    {
+        pFrameContext->timestampQueryPool = VK_NULL_HANDLE;
+        return false;
+    }
+
+    uint32_t validBits = queueFamilies[queueFamilyIndex].timestampValidBits;
+
+    pFrameContext->timestampPeriod = properties.limits.timestampPeriod;
+    pFrameContext->timestampMask   = validBits >= 64 ? UINT64_MAX : (1ull << validBits) - 1;
+
+    return true;
+}
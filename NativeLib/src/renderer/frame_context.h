@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../common/ansi_esc.h"
+#include "vulkan_wrapper.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 同时处于 "在途" 状态（已提交但 GPU 尚未执行完毕）的最大帧数.
+#define MAX_FRAMES_IN_FLIGHT 2
+
+/// @brief 单帧所需的命令缓冲与同步对象（交换链相关的信号量属于各个 SurfaceContext）.
+typedef struct FrameData {
+    VkCommandBuffer     commandBuffer;
+    VkFence             inFlightFence;              // 该帧的命令缓冲执行完毕
+    uint64_t            serial;                     // 该帧最近一次提交的序号
+    bool                timestampsWritten;          // 该帧最近一次提交是否写入了时间戳
+} FrameData;
+
+/// @brief 帧上下文，管理所有在途帧的命令缓冲与同步对象.
+///
+/// 每次提交都会分配一个单调递增的序号（serial），GPU 完成某次提交后 `completedSerial`
+/// 会推进到该序号，其他模块（如帧回读）可以据此非阻塞地判断其工作是否完成.
+typedef struct FrameContext {
+    VkCommandPool       commandPool;
+    FrameData           frames[MAX_FRAMES_IN_FLIGHT];
+    uint32_t            currentFrame;               // 当前帧在 frames 中的索引
+    bool                frameBegun;                 // 是否处于 BeginFrame 与 EndFrame 之间
+
+    uint64_t            submittedSerial;            // 最近一次提交的序号
+    uint64_t            completedSerial;            // GPU 已确认完成的最大序号
+
+    VkQueryPool         timestampQueryPool;         // 每帧 2 个时间戳（开始 / 结束）
+    float               timestampPeriod;            // 每个时间戳单位的纳秒数，0 表不支持
+    uint64_t            timestampMask;              // 时间戳有效位掩码（timestampValidBits）
+    double              lastGpuFrameTimeMs;         // 最近一次完成的帧的 GPU 耗时，< 0 表未知
+} FrameContext;
+
+
+/// @brief 创建帧上下文：命令池、每帧的命令缓冲与栅栏（栅栏初始为已触发状态），
+/// 以及用于测量每帧 GPU 耗时的时间戳查询池（队列族不支持时间戳时不创建）.
+///
+/// @param queueFamilyIndex 命令池所属的队列族索引（一般为 graphics 队列族）
+/// @param pFrameContext 要初始化的帧上下文
+///
+/// @return 成功时返回 `true`，失败时已创建的对象会被销毁并返回 `false`
+bool create_frame_context(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            queueFamilyIndex,
+    FrameContext*       pFrameContext
+);
+
+/// @brief 销毁帧上下文中的所有对象（调用前需确保 GPU 已空闲）.
+void destroy_frame_context(VkDevice device, FrameContext* pFrameContext);
+
+/// @brief 获取当前帧的 FrameData.
+static inline FrameData* current_frame_data(FrameContext* pFrameContext)
+{
+    return &pFrameContext->frames[pFrameContext->currentFrame];
+}
+
+/// @brief 在当前帧命令缓冲的开头重置该帧的时间戳查询并写入开始时间戳（需在渲染通道外）.
+void frame_write_begin_timestamp(FrameContext* pFrameContext);
+
+/// @brief 在当前帧命令缓冲的末尾写入结束时间戳.
+void frame_write_end_timestamp(FrameContext* pFrameContext);
+
+/// @brief 读取当前帧上一次提交的时间戳并更新 `lastGpuFrameTimeMs`.
+///
+/// 只能在等待该帧的栅栏之后调用，因此读取结果不会阻塞.
+void frame_collect_gpu_time(VkDevice device, FrameContext* pFrameContext);
+
+/// @brief 非阻塞地查询所有在途帧的栅栏状态，并推进 `completedSerial`.
+///
+/// @return 推进后的 `completedSerial`
+uint64_t poll_completed_serial(VkDevice device, FrameContext* pFrameContext);
@@ -0,0 +1,173 @@
+#include "gpu_trace.h"
+#include "vulkan_allocator.h"
+#include "../common/trace.h"
+
+#include <string.h>
+
+static void update_calibration(GpuTrace* pTrace, int64_t candidateNs);
+
+
+bool create_gpu_trace(VkDevice device, const FrameContext* pFrameContext, GpuTrace* pTrace)
+{
+    memset(pTrace, 0, sizeof(GpuTrace));
+
+    if (pFrameContext->timestampQueryPool == VK_NULL_HANDLE)
+        return false;
+
+    VkQueryPoolCreateInfo createInfo = {};
+    createInfo.sType        = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType    = VK_QUERY_TYPE_TIMESTAMP;
+    createInfo.queryCount   = 2 * GPU_TRACE_MAX_SCOPES * MAX_FRAMES_IN_FLIGHT;
+
+    VkResult result = vkCreateQueryPool(device, &createInfo, get_vulkan_allocator(), &pTrace->queryPool);
+    if (result != VK_SUCCESS)
+    {
+        pTrace->queryPool = VK_NULL_HANDLE;
+        return false;
+    }
+
+    pTrace->timestampPeriod = pFrameContext->timestampPeriod;
+    pTrace->timestampMask   = pFrameContext->timestampMask;
+
+    return true;
+}
+
+
+void destroy_gpu_trace(VkDevice device, GpuTrace* pTrace)
+{
+    if (pTrace->queryPool != VK_NULL_HANDLE)
+        vkDestroyQueryPool(device, pTrace->queryPool, get_vulkan_allocator());
+    pTrace->queryPool = VK_NULL_HANDLE;
+}
+
+
+void gpu_trace_collect(VkDevice device, GpuTrace* pTrace, uint32_t frameIndex)
+{
+    GpuTraceFrame* pFrame = &pTrace->frames[frameIndex];
+
+    if (!pFrame->submitted || pFrame->scopeCount == 0)
+        return;
+    pFrame->submitted = false;
+
+    // 每个查询两个值：时间戳与可用性（提前返回的帧可能有未写入结束时间戳的区间）
+    uint64_t results[2 * GPU_TRACE_MAX_SCOPES][2];
+    uint32_t queryCount = 2 * pFrame->scopeCount;
+
+    VkResult result = vkGetQueryPoolResults(device,
+                          pTrace->queryPool,
+                          frameIndex * 2 * GPU_TRACE_MAX_SCOPES, queryCount,
+                          queryCount * sizeof(results[0]), results, sizeof(results[0]),
+                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if ((result != VK_SUCCESS && result != VK_NOT_READY) || results[0][1] == 0)
+        return;
+
+    // 1.以整帧区间的开始时刻校准 GPU 时钟
+    uint64_t frameTicks     = results[0][0] & pTrace->timestampMask;
+    int64_t  frameStartNs   = (int64_t)((double)frameTicks * pTrace->timestampPeriod);
+    update_calibration(pTrace, (int64_t)pFrame->submitNs - frameStartNs);
+
+    // 2.各区间相对整帧的开始时刻换算，时间戳在帧内回绕时也能得到正确的差值
+    uint64_t frameCpuNs = (uint64_t)(frameStartNs + pTrace->offsetNs);
+    for (uint32_t i = 0; i < pFrame->scopeCount; i++)
+    {
+        const uint64_t* pBegin  = results[2 * i];
+        const uint64_t* pEnd    = results[2 * i + 1];
+        if (pBegin[1] == 0 || pEnd[1] == 0)
+            continue;
+
+        uint64_t beginTicks     = (pBegin[0] - results[0][0]) & pTrace->timestampMask;
+        uint64_t durationTicks  = (pEnd[0] - pBegin[0]) & pTrace->timestampMask;
+
+        trace_record(pFrame->names[i], TRACE_GPU_THREAD_ID,
+            frameCpuNs + (uint64_t)((double)beginTicks * pTrace->timestampPeriod),
+            (uint64_t)((double)durationTicks * pTrace->timestampPeriod));
+    }
+}
+
+
+void gpu_trace_begin_frame(GpuTrace* pTrace, VkCommandBuffer commandBuffer, uint32_t frameIndex)
+{
+    GpuTraceFrame* pFrame = &pTrace->frames[frameIndex];
+
+    pTrace->currentFrame    = frameIndex;
+    pFrame->scopeCount      = 0;
+    pFrame->submitted       = false;
+    pFrame->active          = pTrace->queryPool != VK_NULL_HANDLE && trace_is_enabled();
+
+    if (!pFrame->active)
+        return;
+
+    vkCmdResetQueryPool(commandBuffer, pTrace->queryPool,
+        frameIndex * 2 * GPU_TRACE_MAX_SCOPES, 2 * GPU_TRACE_MAX_SCOPES);
+
+    // 整帧的区间固定为 0 号，用于校准
+    gpu_trace_begin(pTrace, commandBuffer, "GPU frame");
+}
+
+
+void gpu_trace_end_frame(GpuTrace* pTrace, VkCommandBuffer commandBuffer)
+{
+    if (pTrace->frames[pTrace->currentFrame].scopeCount > 0)
+        gpu_trace_end(pTrace, commandBuffer, 0);
+}
+
+
+void gpu_trace_submit(GpuTrace* pTrace, uint64_t submitNs)
+{
+    GpuTraceFrame* pFrame = &pTrace->frames[pTrace->currentFrame];
+
+    pFrame->submitted   = pFrame->active;
+    pFrame->submitNs    = submitNs;
+}
+
+
+uint32_t gpu_trace_begin(GpuTrace* pTrace, VkCommandBuffer commandBuffer, const char* name)
+{
+    GpuTraceFrame* pFrame = &pTrace->frames[pTrace->currentFrame];
+
+    if (!pFrame->active || pFrame->scopeCount >= GPU_TRACE_MAX_SCOPES)
+        return GPU_TRACE_INVALID_SCOPE;
+
+    uint32_t scope = pFrame->scopeCount++;
+    pFrame->names[scope] = name;
+
+    vkCmdWriteTimestamp(commandBuffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        pTrace->queryPool, pTrace->currentFrame * 2 * GPU_TRACE_MAX_SCOPES + 2 * scope);
+
+    return scope;
+}
+
+
+void gpu_trace_end(GpuTrace* pTrace, VkCommandBuffer commandBuffer, uint32_t scope)
+{
+    if (scope == GPU_TRACE_INVALID_SCOPE)
+        return;
+
+    vkCmdWriteTimestamp(commandBuffer,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        pTrace->queryPool, pTrace->currentFrame * 2 * GPU_TRACE_MAX_SCOPES + 2 * scope + 1);
+}
+
+
+/// @brief 用一帧测得的偏移下界更新 GPU 时钟的偏移.
+///
+/// 下界超过当前偏移时立即采用（含时间戳回绕）；每个校准窗口结束时改用窗口内的最大值，
+/// 使偏移也能随时钟漂移减小.
+static void update_calibration(GpuTrace* pTrace, int64_t candidateNs)
+{
+    if (!pTrace->calibrated || candidateNs > pTrace->offsetNs)
+    {
+        pTrace->offsetNs    = candidateNs;
+        pTrace->calibrated  = true;
+    }
+
+    if (pTrace->windowFrames == 0 || candidateNs > pTrace->windowOffsetNs)
+        pTrace->windowOffsetNs = candidateNs;
+
+    if (++pTrace->windowFrames >= GPU_TRACE_CALIBRATION_FRAMES)
+    {
+        pTrace->offsetNs        = pTrace->windowOffsetNs;
+        pTrace->windowFrames    = 0;
+    }
+}
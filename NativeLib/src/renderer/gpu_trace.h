@@ -0,0 +1,77 @@
+#pragma once
+
+#include "frame_context.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 每帧最多记录的 GPU 区间数，超出的区间被忽略.
+#define GPU_TRACE_MAX_SCOPES            32
+
+/// @brief 每隔多少帧用这段时间内测得的偏移重新校准 GPU 时钟（跟随时钟漂移）.
+#define GPU_TRACE_CALIBRATION_FRAMES    256
+
+/// @brief 无效的区间编号（追踪关闭或区间数已满）.
+#define GPU_TRACE_INVALID_SCOPE         UINT32_MAX
+
+/// @brief 单帧的 GPU 区间.
+typedef struct GpuTraceFrame {
+    const char*         names[GPU_TRACE_MAX_SCOPES];
+    uint32_t            scopeCount;
+    bool                active;                     // 该帧录制时追踪已开启
+    bool                submitted;                  // 该帧最近一次录制已提交，结果待读取
+    uint64_t            submitNs;                   // 该帧提交前的 CPU 时刻
+} GpuTraceFrame;
+
+/// @brief GPU 时间戳区间的追踪，结果换算到 CPU 时钟后记录到 trace 的 GPU 时间线上.
+///
+/// 每个在途帧有自己的一段查询，等待该帧的栅栏之后读取上一次提交的结果.
+/// 时间戳与 CPU 时钟的偏移由 "一帧的 GPU 开始时刻不早于其提交时刻" 估计：
+/// 取各帧 (提交时刻 - GPU 开始时刻) 的最大值，误差为驱动提交到 GPU 开始执行的最短延迟.
+typedef struct GpuTrace {
+    VkQueryPool         queryPool;                  // 每帧 2 * GPU_TRACE_MAX_SCOPES 个时间戳
+    float               timestampPeriod;
+    uint64_t            timestampMask;
+    GpuTraceFrame       frames[MAX_FRAMES_IN_FLIGHT];
+    uint32_t            currentFrame;
+
+    bool                calibrated;
+    int64_t             offsetNs;                   // GPU 时刻（纳秒）加上该值为 CPU 时刻
+    int64_t             windowOffsetNs;             // 本校准窗口内测得的最大偏移
+    uint32_t            windowFrames;
+} GpuTrace;
+
+
+/// @brief 创建 GPU 追踪的查询池，帧上下文不支持时间戳时不创建（之后的调用什么也不做）.
+///
+/// @return 创建失败时返回 `false`（不视为错误）
+bool create_gpu_trace(VkDevice device, const FrameContext* pFrameContext, GpuTrace* pTrace);
+
+/// @brief 销毁查询池（调用前需确保 GPU 已空闲）.
+void destroy_gpu_trace(VkDevice device, GpuTrace* pTrace);
+
+/// @brief 读取该帧上一次提交的区间并记录到追踪中.
+///
+/// 只能在等待该帧的栅栏之后调用，因此读取结果不会阻塞.
+void gpu_trace_collect(VkDevice device, GpuTrace* pTrace, uint32_t frameIndex);
+
+/// @brief 在命令缓冲开头重置该帧的查询，追踪开启时开始整帧的区间（需在渲染通道外）.
+void gpu_trace_begin_frame(GpuTrace* pTrace, VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+/// @brief 在命令缓冲末尾结束整帧的区间.
+void gpu_trace_end_frame(GpuTrace* pTrace, VkCommandBuffer commandBuffer);
+
+/// @brief 在提交之前调用，记下提交时刻作为校准 GPU 时钟的下界.
+void gpu_trace_submit(GpuTrace* pTrace, uint64_t submitNs);
+
+/// @brief 开始一个 GPU 区间（写入开始时间戳）.
+///
+/// @param name 区间名，需为静态存储期的字符串
+///
+/// @return 区间编号，追踪未开启时为 `GPU_TRACE_INVALID_SCOPE`
+uint32_t gpu_trace_begin(GpuTrace* pTrace, VkCommandBuffer commandBuffer, const char* name);
+
+/// @brief 结束由 gpu_trace_begin 开始的区间（写入结束时间戳）.
+void gpu_trace_end(GpuTrace* pTrace, VkCommandBuffer commandBuffer, uint32_t scope);
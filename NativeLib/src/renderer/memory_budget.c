@@ -0,0 +1,433 @@
+#include "memory_budget.h"
+
+#include "../common/ansi_esc.h"
+#include "../common/log.h"
+#include "vulkan_wrapper.h"
+
+#include <string.h>
+
+/// @brief 一块被跟踪的设备内存.
+typedef struct TrackedAllocation {
+    VkDeviceMemory  memory;
+    VkDeviceSize    size;
+    uint32_t        heapIndex;
+    MemoryCategory  category;
+    uint32_t        streamable;             // 注册为可驱逐资源时的句柄
+} TrackedAllocation;
+
+/// @brief 一个可驱逐资源.
+typedef struct Streamable {
+    VkDeviceMemory      memory;
+    VkDeviceSize        size;
+    uint32_t            heapIndex;
+    uint64_t            lastUsedSerial;     // 最后一次使用它的提交序号
+    StreamableEvictFunc evict;
+    void*               pUserData;
+    uint64_t            key;
+    bool                inUse;
+} Streamable;
+
+/// @brief 预算跟踪的全部状态（渲染器只有一个设备，与 vulkan_allocator 的统计一样为全局状态）.
+typedef struct MemoryBudget {
+    VkPhysicalDevice                    physicalDevice;
+    VkPhysicalDeviceMemoryProperties    memoryProperties;
+    bool                                budgetExtension;
+    uint64_t                            completedSerial;
+
+    uint64_t            heapBudget[VK_MAX_MEMORY_HEAPS];
+    uint64_t            heapUsage[VK_MAX_MEMORY_HEAPS];     // 扩展上报的用量（加上此后本进程的增减）
+    uint64_t            heapTracked[VK_MAX_MEMORY_HEAPS];
+    uint64_t            categoryBytes[MEMORY_CATEGORY_COUNT];
+    uint32_t            categoryAllocations[MEMORY_CATEGORY_COUNT];
+
+    TrackedAllocation   allocations[MEMORY_BUDGET_MAX_ALLOCATIONS];
+    uint32_t            allocationCount;
+
+    Streamable          streamables[MEMORY_BUDGET_MAX_STREAMABLES];
+    uint32_t            streamableCount;
+    uint64_t            streamableBytes;
+    uint32_t            evictionCount;
+    uint64_t            evictedBytes;
+} MemoryBudget;
+
+static MemoryBudget budget;
+
+static void refresh_heap_budgets(void);
+static uint64_t heap_usage(uint32_t heapIndex);
+static uint64_t heap_evict_limit(uint32_t heapIndex);
+static uint64_t evict_from_heap(uint32_t heapIndex, uint64_t bytesToFree);
+static void release_streamable(uint32_t handle);
+
+
+void init_memory_budget(VkPhysicalDevice physicalDevice)
+{
+    memset(&budget, 0, sizeof(MemoryBudget));
+
+    budget.physicalDevice   = physicalDevice;
+    budget.budgetExtension  = isDeviceExtensionSupported(physicalDevice,
+                                  VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &budget.memoryProperties);
+
+    refresh_heap_budgets();
+
+    if (log_enabled(LOG_LEVEL_VERBOSE))
+        print_memory_budget_report(stdout);
+}
+
+
+void memory_budget_track_allocation(
+    VkDeviceMemory  memory,
+    uint32_t        memoryTypeIndex,
+    VkDeviceSize    size,
+    MemoryCategory  category
+)
+{
+    if (budget.allocationCount >= MEMORY_BUDGET_MAX_ALLOCATIONS)
+    {
+        fprintf(stderr, "%s : 被跟踪的设备内存分配数已达上限（%u），该分配不计入预算！\n",
+            __func__, MEMORY_BUDGET_MAX_ALLOCATIONS);
+        return;
+    }
+
+    uint32_t heapIndex = budget.memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+
+    TrackedAllocation* pAllocation = &budget.allocations[budget.allocationCount++];
+    pAllocation->memory     = memory;
+    pAllocation->size       = size;
+    pAllocation->heapIndex  = heapIndex;
+    pAllocation->category   = category;
+    pAllocation->streamable = STREAMABLE_INVALID_HANDLE;
+
+    budget.heapTracked[heapIndex]       += size;
+    budget.heapUsage[heapIndex]         += size;     // 下一次刷新之前以此估计扩展上报的用量
+    budget.categoryBytes[category]      += size;
+    budget.categoryAllocations[category]++;
+}
+
+
+void memory_budget_track_free(VkDeviceMemory memory)
+{
+    for (uint32_t i = 0; i < budget.allocationCount; i++)
+    {
+        TrackedAllocation* pAllocation = &budget.allocations[i];
+        if (pAllocation->memory != memory)
+            continue;
+
+        if (pAllocation->streamable != STREAMABLE_INVALID_HANDLE)
+            release_streamable(pAllocation->streamable);
+
+        uint32_t heapIndex = pAllocation->heapIndex;
+        budget.heapTracked[heapIndex] -= pAllocation->size;
+        budget.heapUsage[heapIndex]   -= budget.heapUsage[heapIndex] > pAllocation->size ?
+                                         pAllocation->size : budget.heapUsage[heapIndex];
+        budget.categoryBytes[pAllocation->category] -= pAllocation->size;
+        budget.categoryAllocations[pAllocation->category]--;
+
+        *pAllocation = budget.allocations[--budget.allocationCount];   // 与末尾交换后删除
+        return;
+    }
+}
+
+
+bool memory_budget_make_room(uint32_t memoryTypeIndex, VkDeviceSize size)
+{
+    uint32_t heapIndex = budget.memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+    uint64_t usage = heap_usage(heapIndex);
+    uint64_t limit = heap_evict_limit(heapIndex);
+
+    if (usage + size > limit)
+    {
+        uint64_t freed = evict_from_heap(heapIndex, usage + size - limit);
+        usage = usage > freed ? usage - freed : 0;
+    }
+
+    bool fits = usage + size <= budget.heapBudget[heapIndex];
+    if (!fits)
+        fprintf(stderr, "%s : 堆 %u 将超出预算（%.1f + %.1f / %.1f MiB），且没有足够的可驱逐资源！\n",
+            __func__, heapIndex, usage / 1048576.0, size / 1048576.0,
+            budget.heapBudget[heapIndex] / 1048576.0);
+
+    return fits;
+}
+
+
+void memory_budget_update(uint64_t completedSerial)
+{
+    budget.completedSerial = completedSerial;
+
+    if (budget.budgetExtension)
+        refresh_heap_budgets();
+
+    for (uint32_t i = 0; i < budget.memoryProperties.memoryHeapCount; i++)
+    {
+        uint64_t usage = heap_usage(i);
+        uint64_t limit = heap_evict_limit(i);
+
+        if (usage > limit)
+            evict_from_heap(i, usage - limit);
+    }
+}
+
+
+uint32_t memory_budget_register_streamable(
+    VkDeviceMemory      memory,
+    StreamableEvictFunc evict,
+    void*               pUserData,
+    uint64_t            key
+)
+{
+    TrackedAllocation* pAllocation = NULL;
+    for (uint32_t i = 0; i < budget.allocationCount; i++)
+    {
+        if (budget.allocations[i].memory == memory)
+        {
+            pAllocation = &budget.allocations[i];
+            break;
+        }
+    }
+
+    if (pAllocation == NULL || evict == NULL
+        || pAllocation->streamable != STREAMABLE_INVALID_HANDLE)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！内存未被跟踪、已注册或没有驱逐回调.\n", __func__);
+        return STREAMABLE_INVALID_HANDLE;
+    }
+
+    for (uint32_t i = 0; i < MEMORY_BUDGET_MAX_STREAMABLES; i++)
+    {
+        Streamable* pStreamable = &budget.streamables[i];
+        if (pStreamable->inUse)
+            continue;
+
+        pStreamable->memory         = memory;
+        pStreamable->size           = pAllocation->size;
+        pStreamable->heapIndex      = pAllocation->heapIndex;
+        pStreamable->lastUsedSerial = budget.completedSerial;
+        pStreamable->evict          = evict;
+        pStreamable->pUserData      = pUserData;
+        pStreamable->key            = key;
+        pStreamable->inUse          = true;
+
+        budget.streamableCount++;
+        budget.streamableBytes += pStreamable->size;
+
+        pAllocation->streamable = i + 1;    // 句柄为槽位索引 + 1，0 表示无效
+        return pAllocation->streamable;
+    }
+
+    fprintf(stderr, "%s : 可驱逐资源表已满（%u）！\n", __func__, MEMORY_BUDGET_MAX_STREAMABLES);
+
+    return STREAMABLE_INVALID_HANDLE;
+}
+
+
+bool memory_budget_is_device_local(VkDeviceMemory memory)
+{
+    for (uint32_t i = 0; i < budget.allocationCount; i++)
+    {
+        if (budget.allocations[i].memory == memory)
+            return (budget.memoryProperties.memoryHeaps[budget.allocations[i].heapIndex].flags
+                    & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    }
+
+    return false;
+}
+
+
+void memory_budget_unregister_streamable(uint32_t handle)
+{
+    if (handle == STREAMABLE_INVALID_HANDLE || handle > MEMORY_BUDGET_MAX_STREAMABLES
+        || !budget.streamables[handle - 1].inUse)
+        return;
+
+    VkDeviceMemory memory = budget.streamables[handle - 1].memory;
+    for (uint32_t i = 0; i < budget.allocationCount; i++)
+    {
+        if (budget.allocations[i].memory == memory)
+            budget.allocations[i].streamable = STREAMABLE_INVALID_HANDLE;
+    }
+
+    release_streamable(handle);
+}
+
+
+void memory_budget_touch_streamable(uint32_t handle, uint64_t serial)
+{
+    if (handle == STREAMABLE_INVALID_HANDLE || handle > MEMORY_BUDGET_MAX_STREAMABLES)
+        return;
+
+    Streamable* pStreamable = &budget.streamables[handle - 1];
+    if (pStreamable->inUse && serial > pStreamable->lastUsedSerial)
+        pStreamable->lastUsedSerial = serial;
+}
+
+
+void get_memory_budget_report(MemoryBudgetReport* pReport)
+{
+    memset(pReport, 0, sizeof(MemoryBudgetReport));
+
+    pReport->heapCount          = budget.memoryProperties.memoryHeapCount;
+    pReport->budgetExtension    = budget.budgetExtension;
+
+    for (uint32_t i = 0; i < pReport->heapCount; i++)
+    {
+        pReport->heapSize[i]    = budget.memoryProperties.memoryHeaps[i].size;
+        pReport->heapBudget[i]  = budget.heapBudget[i];
+        pReport->heapUsage[i]   = heap_usage(i);
+        pReport->heapTracked[i] = budget.heapTracked[i];
+        pReport->heapFlags[i]   = budget.memoryProperties.memoryHeaps[i].flags;
+    }
+
+    for (uint32_t i = 0; i < MEMORY_CATEGORY_COUNT; i++)
+    {
+        pReport->categoryBytes[i]       = budget.categoryBytes[i];
+        pReport->categoryAllocations[i] = budget.categoryAllocations[i];
+    }
+
+    pReport->streamableCount    = budget.streamableCount;
+    pReport->streamableBytes    = budget.streamableBytes;
+    pReport->evictionCount      = budget.evictionCount;
+    pReport->evictedBytes       = budget.evictedBytes;
+}
+
+
+void print_memory_budget_report(FILE* stream)
+{
+    MemoryBudgetReport report;
+    get_memory_budget_report(&report);
+
+    fprintf(stream,
+        ESC_LTALIC "%s %s " ESC_RESET "设备内存预算（%s）：\n",
+        __DATE__, __TIME__, report.budgetExtension ? "VK_EXT_memory_budget" : "按堆大小估算");
+
+    for (uint32_t i = 0; i < report.heapCount; i++)
+    {
+        fprintf(stream,
+            "    堆 %u%s: 用量 %.1f / 预算 %.1f MiB（堆大小 %.1f MiB，渲染器分配 %.1f MiB）\n",
+            i, (report.heapFlags[i] & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? "（设备本地）" : "",
+            report.heapUsage[i] / 1048576.0, report.heapBudget[i] / 1048576.0,
+            report.heapSize[i] / 1048576.0, report.heapTracked[i] / 1048576.0);
+    }
+
+    for (uint32_t i = 0; i < MEMORY_CATEGORY_COUNT; i++)
+    {
+        fprintf(stream, "    %-14s %u 块，%.1f MiB\n",
+            memory_category_name((MemoryCategory)i),
+            report.categoryAllocations[i], report.categoryBytes[i] / 1048576.0);
+    }
+
+    fprintf(stream, "    可驱逐资源 %u 个（%.1f MiB），累计驱逐 %u 个（%.1f MiB）\n",
+        report.streamableCount, report.streamableBytes / 1048576.0,
+        report.evictionCount, report.evictedBytes / 1048576.0);
+}
+
+
+const char* memory_category_name(MemoryCategory category)
+{
+    switch (category)
+    {
+        case MEMORY_CATEGORY_TEXTURE:       return "texture";
+        case MEMORY_CATEGORY_MESH:          return "mesh";
+        case MEMORY_CATEGORY_STAGING:       return "staging";
+        case MEMORY_CATEGORY_RENDER_TARGET: return "render_target";
+        case MEMORY_CATEGORY_BUFFER:        return "buffer";
+        default:                            return "unknown";
+    }
+}
+
+
+/// @brief 重新获取各堆的预算：有扩展时查询驱动，否则按堆大小的固定比例估算.
+static void refresh_heap_budgets(void)
+{
+    uint32_t heapCount = budget.memoryProperties.memoryHeapCount;
+
+    if (budget.budgetExtension)
+    {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties = {};
+        budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+        VkPhysicalDeviceMemoryProperties2 properties = {};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        properties.pNext = &budgetProperties;
+
+        vkGetPhysicalDeviceMemoryProperties2(budget.physicalDevice, &properties);
+
+        for (uint32_t i = 0; i < heapCount; i++)
+        {
+            budget.heapBudget[i] = budgetProperties.heapBudget[i];
+            budget.heapUsage[i]  = budgetProperties.heapUsage[i];
+        }
+        return;
+    }
+
+    for (uint32_t i = 0; i < heapCount; i++)
+        budget.heapBudget[i] = budget.memoryProperties.memoryHeaps[i].size
+                             / 100 * MEMORY_BUDGET_FALLBACK_PERCENT;
+}
+
+
+static uint64_t heap_usage(uint32_t heapIndex)
+{
+    return budget.budgetExtension ? budget.heapUsage[heapIndex] : budget.heapTracked[heapIndex];
+}
+
+
+static uint64_t heap_evict_limit(uint32_t heapIndex)
+{
+    return budget.heapBudget[heapIndex] / 100 * MEMORY_BUDGET_EVICT_PERCENT;
+}
+
+
+/// @brief 按最近最少使用的顺序驱逐给定堆上的资源，直到释放了 `bytesToFree` 字节或没有可驱逐的资源.
+///
+/// 只驱逐最后使用不晚于 `completedSerial` 的资源，GPU 仍可能在使用的资源不会被释放.
+///
+/// @return 实际释放的字节数
+static uint64_t evict_from_heap(uint32_t heapIndex, uint64_t bytesToFree)
+{
+    uint64_t freed = 0;
+
+    while (freed < bytesToFree)
+    {
+        uint32_t victim = MEMORY_BUDGET_MAX_STREAMABLES;
+        for (uint32_t i = 0; i < MEMORY_BUDGET_MAX_STREAMABLES; i++)
+        {
+            Streamable* pStreamable = &budget.streamables[i];
+            if (!pStreamable->inUse || pStreamable->heapIndex != heapIndex
+                || pStreamable->lastUsedSerial > budget.completedSerial)
+                continue;
+
+            if (victim == MEMORY_BUDGET_MAX_STREAMABLES
+                || pStreamable->lastUsedSerial < budget.streamables[victim].lastUsedSerial)
+                victim = i;
+        }
+
+        if (victim == MEMORY_BUDGET_MAX_STREAMABLES)
+            break;
+
+        Streamable streamable = budget.streamables[victim];
+
+        // 回调释放内存时经由 memory_budget_track_free 注销；未释放时在此注销，避免再次选中
+        streamable.evict(streamable.pUserData, streamable.key);
+        memory_budget_unregister_streamable(victim + 1);
+
+        freed += streamable.size;
+        budget.evictionCount++;
+        budget.evictedBytes += streamable.size;
+    }
+
+    return freed;
+}
+
+
+/// @brief 释放可驱逐资源表中的槽位.
+static void release_streamable(uint32_t handle)
+{
+    Streamable* pStreamable = &budget.streamables[handle - 1];
+    if (!pStreamable->inUse)
+        return;
+
+    budget.streamableCount--;
+    budget.streamableBytes -= pStreamable->size;
+    pStreamable->inUse = false;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 可跟踪的设备内存分配数上限（每个 VkDeviceMemory 一项）.
+#define MEMORY_BUDGET_MAX_ALLOCATIONS       4096
+/// @brief 可驱逐资源表的容量.
+#define MEMORY_BUDGET_MAX_STREAMABLES       1024
+/// @brief 不支持 VK_EXT_memory_budget 时，以堆大小的该百分比作为预算（为其他进程留出余量）.
+#define MEMORY_BUDGET_FALLBACK_PERCENT      80
+/// @brief 堆的用量超过预算的该百分比时开始驱逐，驱逐到该百分比以下为止.
+#define MEMORY_BUDGET_EVICT_PERCENT         90
+/// @brief 可驱逐资源句柄的无效值.
+#define STREAMABLE_INVALID_HANDLE           0
+
+/// @brief 设备内存的用途分类，用于按类统计.
+typedef enum MemoryCategory {
+    MEMORY_CATEGORY_TEXTURE = 0,        // 纹理
+    MEMORY_CATEGORY_MESH,               // 顶点 / 索引缓冲
+    MEMORY_CATEGORY_STAGING,            // 上传 / 回读用的暂存缓冲
+    MEMORY_CATEGORY_RENDER_TARGET,      // 离屏图像等渲染目标
+    MEMORY_CATEGORY_BUFFER,             // 其他缓冲（uniform 环形缓冲、场景数据等）
+    MEMORY_CATEGORY_COUNT
+} MemoryCategory;
+
+/// @brief 驱逐回调：释放资源及其设备内存（其中的 destroyBuffer 等会自动停止跟踪该内存）.
+///
+/// 被驱逐的资源自动注销，回调中不需要再调用 memory_budget_unregister_streamable.
+///
+/// @param key 注册时传入的键（如资源句柄）
+typedef void (*StreamableEvictFunc)(void* pUserData, uint64_t key);
+
+/// @brief 设备内存的预算与用量报告（字节）.
+typedef struct MemoryBudgetReport {
+    uint32_t    heapCount;
+    uint32_t    budgetExtension;                        // 预算是否来自 VK_EXT_memory_budget（否则为估算值）
+    uint64_t    heapSize[VK_MAX_MEMORY_HEAPS];
+    uint64_t    heapBudget[VK_MAX_MEMORY_HEAPS];        // 本进程可用而不引起换页的估计值
+    uint64_t    heapUsage[VK_MAX_MEMORY_HEAPS];         // 本进程的用量（无扩展时即 heapTracked）
+    uint64_t    heapTracked[VK_MAX_MEMORY_HEAPS];       // 经由渲染器分配的用量
+    uint32_t    heapFlags[VK_MAX_MEMORY_HEAPS];         // VkMemoryHeapFlags
+    uint64_t    categoryBytes[MEMORY_CATEGORY_COUNT];
+    uint32_t    categoryAllocations[MEMORY_CATEGORY_COUNT];
+    uint32_t    streamableCount;                        // 当前注册的可驱逐资源数
+    uint32_t    evictionCount;                          // 累计驱逐的资源数
+    uint64_t    streamableBytes;
+    uint64_t    evictedBytes;                           // 累计驱逐的字节数
+} MemoryBudgetReport;
+
+
+/// @brief 在逻辑设备创建之后初始化预算跟踪（设备支持时使用 VK_EXT_memory_budget）.
+///
+/// 本模块的所有函数都只能在渲染线程上调用.
+void init_memory_budget(VkPhysicalDevice physicalDevice);
+
+/// @brief 记录一次设备内存分配（由 vulkan_wrapper 中的创建函数调用）.
+void memory_budget_track_allocation(
+    VkDeviceMemory  memory,
+    uint32_t        memoryTypeIndex,
+    VkDeviceSize    size,
+    MemoryCategory  category
+);
+
+/// @brief 记录一次设备内存释放，未被跟踪的内存会被忽略.
+void memory_budget_track_free(VkDeviceMemory memory);
+
+/// @brief 在给定内存类型上分配 `size` 字节之前调用：若会超出其堆的预算，先驱逐最久未使用的资源.
+///
+/// @return 分配后仍在预算之内时返回 `true`（超出时调用者仍可分配，只是可能引起驱动换页）
+bool memory_budget_make_room(uint32_t memoryTypeIndex, VkDeviceSize size);
+
+/// @brief 每帧调用：刷新各堆的预算与用量，并驱逐超出预算的堆上最久未使用的资源.
+///
+/// @param completedSerial GPU 已完成的最大提交序号，只有最后使用不晚于它的资源才会被驱逐
+void memory_budget_update(uint64_t completedSerial);
+
+/// @brief 将一块已跟踪的内存注册为可驱逐（可流式加载）资源.
+///
+/// 驱逐只选择最后使用不晚于已完成提交的资源，因此每次被 GPU 使用都需调用
+/// memory_budget_touch_streamable，回调中可以立即销毁资源.
+///
+/// @param pUserData 与 `key` 一同传给驱逐回调
+///
+/// @return 资源句柄，表已满或内存未被跟踪时返回 `STREAMABLE_INVALID_HANDLE`
+uint32_t memory_budget_register_streamable(
+    VkDeviceMemory      memory,
+    StreamableEvictFunc evict,
+    void*               pUserData,
+    uint64_t            key
+);
+
+/// @brief 已跟踪的内存是否位于 DEVICE_LOCAL 的堆中（驱逐系统内存中的资源不能缓解显存压力）.
+bool memory_budget_is_device_local(VkDeviceMemory memory);
+
+/// @brief 注销可驱逐资源（资源被主动销毁之前调用）.
+void memory_budget_unregister_streamable(uint32_t handle);
+
+/// @brief 记录资源被序号为 `serial` 的提交使用，用于最近最少使用（LRU）排序.
+void memory_budget_touch_streamable(uint32_t handle, uint64_t serial);
+
+/// @brief 获取当前的预算与用量报告.
+void get_memory_budget_report(MemoryBudgetReport* pReport);
+
+/// @brief 打印各堆的预算与用量以及各分类的用量.
+void print_memory_budget_report(FILE* stream);
+
+/// @brief 用途分类的名称.
+const char* memory_category_name(MemoryCategory category);
@@ -0,0 +1,451 @@
+#include "mesh_arena.h"
+
+#include <string.h>
+
+static bool pool_allocate(
+    MeshArena*      pArena,
+    MeshArenaPool*  pPool,
+    uint32_t        count,
+    uint32_t        excludeBlock,
+    bool            allowNewBlock,
+    uint32_t*       pBlock,
+    uint32_t*       pFirst
+);
+static bool block_allocate(MeshArenaPool* pPool, MeshArenaBlock* pBlock, uint32_t count, uint32_t* pFirst);
+static void pool_free(MeshArenaPool* pPool, uint32_t block, uint32_t first, uint32_t count);
+static bool create_block(MeshArena* pArena, MeshArenaPool* pPool, MeshArenaBlock* pBlock);
+
+
+void create_mesh_arena(VkPhysicalDevice physicalDevice, VkDevice device, bool enabled, MeshArena* pArena)
+{
+    memset(pArena, 0, sizeof(MeshArena));
+
+    pArena->physicalDevice  = physicalDevice;
+    pArena->device          = device;
+    pArena->enabled         = enabled;
+
+    pArena->vertices.elementSize    = sizeof(PulledVertex);
+    pArena->vertices.blockCapacity  = MESH_ARENA_VERTEX_BLOCK_CAPACITY;
+    pArena->indices.elementSize     = sizeof(uint32_t);
+    pArena->indices.blockCapacity   = MESH_ARENA_INDEX_BLOCK_CAPACITY;
+}
+
+
+void destroy_mesh_arena(MeshArena* pArena)
+{
+    MeshArenaPool* pools[] = { &pArena->vertices, &pArena->indices };
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        for (uint32_t j = 0; j < pools[i]->blockCount; j++)
+        {
+            MeshArenaBlock* pBlock = &pools[i]->blocks[j];
+            if (pBlock->buffer == VK_NULL_HANDLE)
+                continue;
+            if (pBlock->pMapped != NULL)
+                vkUnmapMemory(pArena->device, pBlock->memory);
+            destroyBuffer(pArena->device, pBlock->buffer, pBlock->memory);
+        }
+    }
+
+    memset(pArena, 0, sizeof(MeshArena));
+}
+
+
+bool mesh_arena_allocate(
+    MeshArena*          pArena,
+    const PulledVertex* pVertices,
+    uint32_t            vertexCount,
+    const uint32_t*     pIndices,
+    uint32_t            indexCount,
+    MeshAllocation*     pAllocation
+)
+{
+    if (!pArena->enabled)
+    {
+        fprintf(stderr, "%s : 设备不支持 bufferDeviceAddress，无法使用顶点拉取！\n", __func__);
+        return false;
+    }
+
+    if (pVertices == NULL || vertexCount == 0 || indexCount == 0
+        || (pIndices == NULL && indexCount != vertexCount))
+    {
+        fprintf(stderr, "%s : 传入了无效参数！\n", __func__);
+        return false;
+    }
+
+    // 着色器按索引直接读取顶点块，越界的索引会读到其他网格或块外的内存
+    for (uint32_t i = 0; pIndices != NULL && i < indexCount; i++)
+    {
+        if (pIndices[i] >= vertexCount)
+        {
+            fprintf(stderr, "%s : 传入了无效参数！索引 %u 超出了顶点数 %u.\n",
+                __func__, pIndices[i], vertexCount);
+            return false;
+        }
+    }
+
+    // 1.分别分配顶点区间与索引区间
+    MeshAllocation allocation = {};
+    if (!pool_allocate(pArena, &pArena->vertices, vertexCount, UINT32_MAX, true,
+            &allocation.vertexBlock, &allocation.firstVertex))
+        return false;
+
+    if (!pool_allocate(pArena, &pArena->indices, indexCount, UINT32_MAX, true,
+            &allocation.indexBlock, &allocation.firstIndex))
+    {
+        pool_free(&pArena->vertices, allocation.vertexBlock, allocation.firstVertex, vertexCount);
+        return false;
+    }
+
+    // 2.拷贝顶点，索引加上网格在块内的起点（越界的索引被钳制到网格的最后一个顶点）
+    MeshArenaBlock* pVertexBlock = &pArena->vertices.blocks[allocation.vertexBlock];
+    memcpy(pVertexBlock->pMapped + (size_t)allocation.firstVertex * sizeof(PulledVertex),
+        pVertices, (size_t)vertexCount * sizeof(PulledVertex));
+
+    MeshArenaBlock* pIndexBlock = &pArena->indices.blocks[allocation.indexBlock];
+    uint32_t* pDstIndices = (uint32_t*)pIndexBlock->pMapped + allocation.firstIndex;
+    for (uint32_t i = 0; i < indexCount; i++)
+    {
+        uint32_t index = pIndices != NULL ? pIndices[i] : i;
+        if (index >= vertexCount)
+            index = vertexCount - 1;
+
+        pDstIndices[i] = allocation.firstVertex + index;
+    }
+
+    *pAllocation = allocation;
+
+    return true;
+}
+
+
+void mesh_arena_free(
+    MeshArena*              pArena,
+    const MeshAllocation*   pAllocation,
+    uint32_t                vertexCount,
+    uint32_t                indexCount
+)
+{
+    pool_free(&pArena->vertices, pAllocation->vertexBlock, pAllocation->firstVertex, vertexCount);
+    pool_free(&pArena->indices, pAllocation->indexBlock, pAllocation->firstIndex, indexCount);
+
+    pArena->version++;
+}
+
+
+uint32_t mesh_arena_pick_source_block(const MeshArenaPool* pPool)
+{
+    uint32_t source     = UINT32_MAX;
+    uint32_t liveCount  = 0;
+    uint64_t freeCount  = 0;
+
+    for (uint32_t i = 0; i < pPool->blockCount; i++)
+    {
+        const MeshArenaBlock* pBlock = &pPool->blocks[i];
+        if (pBlock->buffer == VK_NULL_HANDLE || pBlock->allocationCount == 0)
+            continue;
+
+        liveCount++;
+        freeCount += pPool->blockCapacity - pBlock->usedCount;
+        if (source == UINT32_MAX || pBlock->usedCount < pPool->blocks[source].usedCount)
+            source = i;
+    }
+
+    if (liveCount < 2)
+        return UINT32_MAX;
+
+    // 其余块的空闲元素（不计源块自身的空闲部分）需能容纳源块的全部内容
+    const MeshArenaBlock* pSource = &pPool->blocks[source];
+    uint64_t freeElsewhere = freeCount - (pPool->blockCapacity - pSource->usedCount);
+
+    return freeElsewhere >= pSource->usedCount ? source : UINT32_MAX;
+}
+
+
+bool mesh_arena_relocate(
+    MeshArena*              pArena,
+    const MeshAllocation*   pSource,
+    uint32_t                vertexCount,
+    uint32_t                indexCount,
+    uint32_t                excludeVertexBlock,
+    uint32_t                excludeIndexBlock,
+    MeshAllocation*         pDestination
+)
+{
+    // 1.在其余已有的块中分配新区间（放不下时不创建新块，搬移本身不应增加占用）
+    MeshAllocation allocation = {};
+    if (!pool_allocate(pArena, &pArena->vertices, vertexCount, excludeVertexBlock, false,
+            &allocation.vertexBlock, &allocation.firstVertex))
+        return false;
+
+    if (!pool_allocate(pArena, &pArena->indices, indexCount, excludeIndexBlock, false,
+            &allocation.indexBlock, &allocation.firstIndex))
+    {
+        pool_free(&pArena->vertices, allocation.vertexBlock, allocation.firstVertex, vertexCount);
+        return false;
+    }
+
+    // 2.索引是块内的绝对顶点下标，不能按字节拷贝，在 CPU 上换算到新的顶点起点
+    const uint32_t* pSrcIndices =
+        (const uint32_t*)pArena->indices.blocks[pSource->indexBlock].pMapped + pSource->firstIndex;
+    uint32_t* pDstIndices =
+        (uint32_t*)pArena->indices.blocks[allocation.indexBlock].pMapped + allocation.firstIndex;
+
+    for (uint32_t i = 0; i < indexCount; i++)
+        pDstIndices[i] = pSrcIndices[i] - pSource->firstVertex + allocation.firstVertex;
+
+    *pDestination = allocation;
+
+    return true;
+}
+
+
+void mesh_arena_record_copy(
+    const MeshArena*        pArena,
+    VkCommandBuffer         commandBuffer,
+    const MeshAllocation*   pSource,
+    const MeshAllocation*   pDestination,
+    uint32_t                vertexCount
+)
+{
+    VkBufferCopy region = {};
+    region.srcOffset    = (VkDeviceSize)pSource->firstVertex * sizeof(PulledVertex);
+    region.dstOffset    = (VkDeviceSize)pDestination->firstVertex * sizeof(PulledVertex);
+    region.size         = (VkDeviceSize)vertexCount * sizeof(PulledVertex);
+
+    // 同一块内的两个区间都处于分配状态，不会重叠
+    vkCmdCopyBuffer(commandBuffer,
+        pArena->vertices.blocks[pSource->vertexBlock].buffer,
+        pArena->vertices.blocks[pDestination->vertexBlock].buffer,
+        1, &region);
+}
+
+
+uint32_t mesh_arena_release_empty_blocks(MeshArena* pArena)
+{
+    MeshArenaPool* pools[] = { &pArena->vertices, &pArena->indices };
+    uint32_t releasedCount = 0;
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        MeshArenaPool* pPool = pools[i];
+        for (uint32_t j = 0; j < pPool->blockCount; j++)
+        {
+            MeshArenaBlock* pBlock = &pPool->blocks[j];
+            if (pBlock->buffer == VK_NULL_HANDLE || pBlock->allocationCount > 0)
+                continue;
+
+            if (pBlock->pMapped != NULL)
+                vkUnmapMemory(pArena->device, pBlock->memory);
+            destroyBuffer(pArena->device, pBlock->buffer, pBlock->memory);
+            memset(pBlock, 0, sizeof(MeshArenaBlock));
+            releasedCount++;
+        }
+
+        // 末尾已释放的块不再计入块数，中间的空位在下一次需要新块时重新创建
+        while (pPool->blockCount > 0 && pPool->blocks[pPool->blockCount - 1].buffer == VK_NULL_HANDLE)
+            pPool->blockCount--;
+    }
+
+    return releasedCount;
+}
+
+
+/// @brief 在池中分配 `count` 个连续元素：按块的顺序先在空闲区间中首次适配，再从块的未分配部分
+/// 切出，已有的块都不满足时（若允许）在第一个空位上创建新块.
+static bool pool_allocate(
+    MeshArena*      pArena,
+    MeshArenaPool*  pPool,
+    uint32_t        count,
+    uint32_t        excludeBlock,
+    bool            allowNewBlock,
+    uint32_t*       pBlock,
+    uint32_t*       pFirst
+)
+{
+    if (count > pPool->blockCapacity)
+    {
+        fprintf(stderr, "%s : 网格过大！（%u 个元素，每块最多 %u 个）\n",
+            __func__, count, pPool->blockCapacity);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < pPool->blockCount; i++)
+    {
+        MeshArenaBlock* pCandidate = &pPool->blocks[i];
+        if (i == excludeBlock || pCandidate->buffer == VK_NULL_HANDLE)
+            continue;
+
+        if (block_allocate(pPool, pCandidate, count, pFirst))
+        {
+            *pBlock = i;
+            pArena->version++;
+            return true;
+        }
+    }
+
+    if (!allowNewBlock)
+        return false;
+
+    for (uint32_t i = 0; i < MESH_ARENA_MAX_BLOCKS; i++)
+    {
+        MeshArenaBlock* pCandidate = &pPool->blocks[i];
+        if (pCandidate->buffer != VK_NULL_HANDLE)
+            continue;
+
+        if (!create_block(pArena, pPool, pCandidate))
+            return false;
+        if (i >= pPool->blockCount)
+            pPool->blockCount = i + 1;
+
+        block_allocate(pPool, pCandidate, count, pFirst);
+        *pBlock = i;
+        pArena->version++;
+        return true;
+    }
+
+    fprintf(stderr, "%s : 网格池已满！\n", __func__);
+    return false;
+}
+
+
+/// @brief 在一个块中分配 `count` 个连续元素.
+static bool block_allocate(MeshArenaPool* pPool, MeshArenaBlock* pBlock, uint32_t count, uint32_t* pFirst)
+{
+    for (uint32_t j = 0; j < pBlock->freeRangeCount; j++)
+    {
+        MeshArenaRange* pRange = &pBlock->freeRanges[j];
+        if (pRange->count < count)
+            continue;
+
+        *pFirst = pRange->first;
+        pRange->first += count;
+        pRange->count -= count;
+        if (pRange->count == 0)
+        {
+            memmove(pRange, pRange + 1,
+                (pBlock->freeRangeCount - j - 1) * sizeof(MeshArenaRange));
+            pBlock->freeRangeCount--;
+        }
+
+        pBlock->allocationCount++;
+        pBlock->usedCount += count;
+        return true;
+    }
+
+    if (pPool->blockCapacity - pBlock->top >= count)
+    {
+        *pFirst = pBlock->top;
+        pBlock->top += count;
+
+        pBlock->allocationCount++;
+        pBlock->usedCount += count;
+        return true;
+    }
+
+    return false;
+}
+
+
+/// @brief 归还区间：与相邻的空闲区间合并，位于块末尾时直接退回未分配部分.
+static void pool_free(MeshArenaPool* pPool, uint32_t block, uint32_t first, uint32_t count)
+{
+    if (block >= pPool->blockCount || count == 0)
+        return;
+
+    MeshArenaBlock* pBlock = &pPool->blocks[block];
+    if (pBlock->allocationCount == 0)
+        return;
+
+    pBlock->usedCount -= count;
+    if (--pBlock->allocationCount == 0)
+    {
+        pBlock->top             = 0;
+        pBlock->freeRangeCount  = 0;
+        return;
+    }
+
+    // 找到插入位置（第一个起点大于 first 的区间）
+    uint32_t position = 0;
+    while (position < pBlock->freeRangeCount && pBlock->freeRanges[position].first < first)
+        position++;
+
+    MeshArenaRange* pPrevious   = position > 0 ? &pBlock->freeRanges[position - 1] : NULL;
+    MeshArenaRange* pNext       = position < pBlock->freeRangeCount ? &pBlock->freeRanges[position] : NULL;
+
+    bool mergePrevious  = pPrevious != NULL && pPrevious->first + pPrevious->count == first;
+    bool mergeNext      = pNext != NULL && first + count == pNext->first;
+
+    if (mergePrevious && mergeNext)
+    {
+        pPrevious->count += count + pNext->count;
+        memmove(pNext, pNext + 1, (pBlock->freeRangeCount - position - 1) * sizeof(MeshArenaRange));
+        pBlock->freeRangeCount--;
+    }
+    else if (mergePrevious)
+        pPrevious->count += count;
+    else if (mergeNext)
+    {
+        pNext->first = first;
+        pNext->count += count;
+    }
+    else if (first + count == pBlock->top)
+        pBlock->top = first;
+    else if (pBlock->freeRangeCount < MESH_ARENA_MAX_FREE_RANGES)
+    {
+        memmove(&pBlock->freeRanges[position + 1], &pBlock->freeRanges[position],
+            (pBlock->freeRangeCount - position) * sizeof(MeshArenaRange));
+        pBlock->freeRanges[position].first = first;
+        pBlock->freeRanges[position].count = count;
+        pBlock->freeRangeCount++;
+    }
+    // 否则该区间要等到块被清空时才回收
+
+    // 末尾的空闲区间退回未分配部分
+    if (pBlock->freeRangeCount > 0)
+    {
+        MeshArenaRange* pLast = &pBlock->freeRanges[pBlock->freeRangeCount - 1];
+        if (pLast->first + pLast->count == pBlock->top)
+        {
+            pBlock->top = pLast->first;
+            pBlock->freeRangeCount--;
+        }
+    }
+}
+
+
+/// @brief 创建块的缓冲（可取设备地址的存储缓冲，主机可见并常驻映射）.
+static bool create_block(MeshArena* pArena, MeshArenaPool* pPool, MeshArenaBlock* pBlock)
+{
+    memset(pBlock, 0, sizeof(MeshArenaBlock));
+
+    VkDeviceSize size = (VkDeviceSize)pPool->blockCapacity * pPool->elementSize;
+    if (!createBuffer(pArena->physicalDevice,
+            pArena->device,
+            size,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+                | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,     // 整理时在块间拷贝
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            MEMORY_CATEGORY_MESH,
+            0, NULL,
+            &pBlock->buffer,
+            &pBlock->memory))
+        return false;
+
+    VkResult result = vkMapMemory(pArena->device, pBlock->memory, 0, VK_WHOLE_SIZE, 0,
+                          (void**)&pBlock->pMapped);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr, "Failed to map VkDeviceMemory! Error Code(VkResult): %d\n", result);
+
+        destroyBuffer(pArena->device, pBlock->buffer, pBlock->memory);
+        memset(pBlock, 0, sizeof(MeshArenaBlock));
+        return false;
+    }
+
+    pBlock->address = getBufferDeviceAddress(pArena->device, pBlock->buffer);
+
+    return true;
+}
+
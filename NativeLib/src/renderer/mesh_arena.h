@@ -0,0 +1,167 @@
+#pragma once
+
+#include "vulkan_wrapper.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 顶点块的容量（顶点数）与索引块的容量（索引数）.
+#define MESH_ARENA_VERTEX_BLOCK_CAPACITY    (1u << 20)
+#define MESH_ARENA_INDEX_BLOCK_CAPACITY     (1u << 22)
+/// @brief 每个池最多的块数.
+#define MESH_ARENA_MAX_BLOCKS               4
+/// @brief 每个块记录的空闲区间数的上限（更多的空闲区间要等到块被清空时才能回收）.
+#define MESH_ARENA_MAX_FREE_RANGES          256
+
+/// @brief 顶点拉取着色器读取的顶点格式（shaders/mesh_pull.vert），与 C# 的 PulledVertex 布局一致.
+typedef struct PulledVertex {
+    float               position[3];
+    float               color[3];
+} PulledVertex;
+
+/// @brief 顶点拉取管线的推送常量：网格所在顶点块与索引块的设备地址.
+///
+/// 索引是块内的绝对顶点下标，因此同一对块中的所有网格推送常量相同，索引区间相邻的绘制可以合并.
+typedef struct MeshPushConstants {
+    VkDeviceAddress     vertices;
+    VkDeviceAddress     indices;
+} MeshPushConstants;
+
+/// @brief 块中的一段区间（以元素计）.
+typedef struct MeshArenaRange {
+    uint32_t            first;
+    uint32_t            count;
+} MeshArenaRange;
+
+/// @brief 一个大缓冲：主机可见并常驻映射，着色器通过其设备地址读取.
+///
+/// `buffer` 为 VK_NULL_HANDLE 时该块尚未创建或已被释放.
+typedef struct MeshArenaBlock {
+    VkBuffer            buffer;
+    VkDeviceMemory      memory;
+    uint8_t*            pMapped;
+    VkDeviceAddress     address;
+
+    uint32_t            top;                    // 从未分配过的区间的起点
+    uint32_t            allocationCount;        // 为 0 时整个块被回收
+    uint32_t            usedCount;              // 已分配的元素数
+    MeshArenaRange      freeRanges[MESH_ARENA_MAX_FREE_RANGES];     // 按起点排序，相邻区间已合并
+    uint32_t            freeRangeCount;
+} MeshArenaBlock;
+
+/// @brief 同一种元素（顶点或索引）的块.
+typedef struct MeshArenaPool {
+    MeshArenaBlock      blocks[MESH_ARENA_MAX_BLOCKS];
+    uint32_t            blockCount;
+    uint32_t            elementSize;
+    uint32_t            blockCapacity;          // 每块的元素数
+} MeshArenaPool;
+
+/// @brief 网格在网格池中的位置.
+typedef struct MeshAllocation {
+    uint32_t            vertexBlock;
+    uint32_t            indexBlock;
+    uint32_t            firstVertex;
+    uint32_t            firstIndex;             // 即 vkCmdDraw 的 firstVertex（着色器以 gl_VertexIndex 读取索引）
+} MeshAllocation;
+
+/// @brief 顶点拉取网格的存储：所有网格的顶点与索引分别打包进少数几个大缓冲.
+///
+/// 不需要按网格布局创建顶点输入状态，一个管线布局（推送常量中的两个设备地址）适用于所有网格.
+/// 块在首次需要时创建，区间首次适配分配，释放时与相邻的空闲区间合并.
+typedef struct MeshArena {
+    VkPhysicalDevice    physicalDevice;
+    VkDevice            device;
+    bool                enabled;                // 设备启用了 bufferDeviceAddress 特性
+
+    MeshArenaPool       vertices;
+    MeshArenaPool       indices;
+
+    uint64_t            version;                // 每次分配或释放区间时递增
+} MeshArena;
+
+
+/// @brief 初始化网格池（此时还不创建任何缓冲）.
+///
+/// @param enabled 设备是否启用了 bufferDeviceAddress 特性，为 `false` 时所有分配都会失败
+void create_mesh_arena(VkPhysicalDevice physicalDevice, VkDevice device, bool enabled, MeshArena* pArena);
+
+/// @brief 销毁网格池的所有缓冲（调用前需确保 GPU 已空闲）.
+void destroy_mesh_arena(MeshArena* pArena);
+
+/// @brief 为网格分配顶点与索引区间，并把数据拷贝进去（索引被换算为块内的绝对顶点下标）.
+///
+/// @param pIndices 可为 `NULL`，此时生成 0 .. vertexCount - 1 的顺序索引（`indexCount` 需等于 `vertexCount`）
+///
+/// @return 成功时返回 `true`
+bool mesh_arena_allocate(
+    MeshArena*          pArena,
+    const PulledVertex* pVertices,
+    uint32_t            vertexCount,
+    const uint32_t*     pIndices,
+    uint32_t            indexCount,
+    MeshAllocation*     pAllocation
+);
+
+/// @brief 释放网格的区间（调用前需确保 GPU 已不再使用该网格）.
+void mesh_arena_free(
+    MeshArena*              pArena,
+    const MeshAllocation*   pAllocation,
+    uint32_t                vertexCount,
+    uint32_t                indexCount
+);
+
+/// @brief 选出池中应被清空的块：在所有已创建的块中占用最少、且其余块的空闲元素足以容纳其内容的块.
+///
+/// @return 块的索引，池中只有一个块或无法合并时返回 `UINT32_MAX`
+uint32_t mesh_arena_pick_source_block(const MeshArenaPool* pPool);
+
+/// @brief 为网格在已有的块中分配新的区间（不创建新块），并在 CPU 上按新的顶点起点改写索引.
+///
+/// 旧区间保持不变（在途帧仍可能读取），顶点的内容由 mesh_arena_record_copy 在 GPU 上拷贝，
+/// 旧区间在 GPU 完成拷贝后由调用者释放.
+///
+/// @param excludeVertexBlock 不能放入的顶点块（正被清空的块），为 `UINT32_MAX` 时不限制
+/// @param excludeIndexBlock 不能放入的索引块，为 `UINT32_MAX` 时不限制
+///
+/// @return 成功时返回 `true`；其余块放不下时返回 `false`，此时不分配任何区间
+bool mesh_arena_relocate(
+    MeshArena*              pArena,
+    const MeshAllocation*   pSource,
+    uint32_t                vertexCount,
+    uint32_t                indexCount,
+    uint32_t                excludeVertexBlock,
+    uint32_t                excludeIndexBlock,
+    MeshAllocation*         pDestination
+);
+
+/// @brief 在 `commandBuffer` 中录制顶点区间从 `pSource` 到 `pDestination` 的拷贝
+/// （调用者负责之后的传输 -> 着色器读取屏障）.
+void mesh_arena_record_copy(
+    const MeshArena*        pArena,
+    VkCommandBuffer         commandBuffer,
+    const MeshAllocation*   pSource,
+    const MeshAllocation*   pDestination,
+    uint32_t                vertexCount
+);
+
+/// @brief 销毁所有已清空的块的缓冲（调用前需确保 GPU 已不再使用这些块）.
+///
+/// @return 释放的块数
+uint32_t mesh_arena_release_empty_blocks(MeshArena* pArena);
+
+/// @brief 网格绘制时的推送常量.
+static inline MeshPushConstants mesh_arena_push_constants(
+    const MeshArena*        pArena,
+    const MeshAllocation*   pAllocation
+)
+{
+    MeshPushConstants constants = {
+        .vertices   = pArena->vertices.blocks[pAllocation->vertexBlock].address,
+        .indices    = pArena->indices.blocks[pAllocation->indexBlock].address
+    };
+
+    return constants;
+}
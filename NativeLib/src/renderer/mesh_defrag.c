@@ -0,0 +1,144 @@
+#include "mesh_defrag.h"
+
+#include <string.h>
+
+static uint32_t count_blocks(const MeshArenaPool* pPool);
+
+
+void init_mesh_defragmenter(uint64_t frameBudget, MeshDefragmenter* pDefrag)
+{
+    memset(pDefrag, 0, sizeof(MeshDefragmenter));
+
+    pDefrag->frameBudget = frameBudget;
+}
+
+
+void mesh_defrag_set_budget(MeshDefragmenter* pDefrag, uint64_t frameBudget)
+{
+    pDefrag->frameBudget    = frameBudget;
+    pDefrag->idle           = false;
+}
+
+
+uint32_t mesh_defrag_step(
+    MeshDefragmenter*   pDefrag,
+    ResourceTable*      pTable,
+    MeshArena*          pArena,
+    VkCommandBuffer     commandBuffer,
+    uint64_t            serial
+)
+{
+    pDefrag->stats.lastFrameMoves = 0;
+
+    if (pDefrag->frameBudget == 0 || !pArena->enabled)
+        return 0;
+
+    // 1.已清空的块的所有区间都在 GPU 完成使用后才归还，可以直接销毁
+    pDefrag->stats.releasedBlocks += mesh_arena_release_empty_blocks(pArena);
+
+    // 2.选出要清空的块，没有可合并的块或上一次遍历之后网格池没有变化时跳过
+    uint32_t vertexSource   = mesh_arena_pick_source_block(&pArena->vertices);
+    uint32_t indexSource    = mesh_arena_pick_source_block(&pArena->indices);
+    if (vertexSource == UINT32_MAX && indexSource == UINT32_MAX)
+        return 0;
+    if (pDefrag->idle && pDefrag->idleVersion == pArena->version)
+        return 0;
+    pDefrag->idle = false;
+
+    // 3.从上一次停下的槽位继续遍历资源表，搬移引用这两个块的拉取网格，直到用完本帧的预算
+    uint64_t movedBytes = 0;
+    uint32_t moveCount  = 0;
+    uint32_t scanned    = 0;
+    while (scanned < pTable->count && movedBytes < pDefrag->frameBudget)
+    {
+        uint32_t index = pDefrag->cursor < pTable->count ? pDefrag->cursor : 0;
+        pDefrag->cursor = index + 1;
+        scanned++;
+
+        ResourceHandle handle = resource_table_handle_at(pTable, index);
+        if (handle == RESOURCE_INVALID_HANDLE || resource_handle_type(handle) != RESOURCE_TYPE_MESH)
+            continue;
+
+        ResourceData* pData = resource_table_get(pTable, handle, RESOURCE_TYPE_MESH);
+        if (pData == NULL || !mesh_is_pulled(&pData->mesh))
+            continue;
+
+        const MeshResource* pMesh = &pData->mesh;
+        if (pMesh->pulled.vertexBlock != vertexSource && pMesh->pulled.indexBlock != indexSource)
+            continue;
+
+        // 待销毁队列已满时无法送走旧区间，留到之后的帧
+        if (pTable->retiredCount >= pTable->capacity)
+            break;
+
+        ResourceData moved = *pData;
+        if (!mesh_arena_relocate(pArena, &pMesh->pulled, pMesh->vertexCount, pMesh->indexCount,
+                vertexSource, indexSource, &moved.mesh.pulled))
+            continue;
+
+        mesh_arena_record_copy(pArena, commandBuffer, &pMesh->pulled, &moved.mesh.pulled,
+            pMesh->vertexCount);
+
+        movedBytes += (uint64_t)pMesh->vertexCount * sizeof(PulledVertex)
+                    + (uint64_t)pMesh->indexCount * sizeof(uint32_t);
+        moveCount++;
+
+        // 旧区间随被替换的底层对象进入待销毁队列，GPU 完成本帧（含上面的拷贝）后归还
+        resource_table_replace(pTable, handle, &moved, serial);
+    }
+
+    // 完整遍历了一次却没有网格能搬移（其余块的空闲区间过于零碎），等网格池变化后再试
+    if (moveCount == 0 && scanned >= pTable->count)
+    {
+        pDefrag->idle           = true;
+        pDefrag->idleVersion    = pArena->version;
+        return 0;
+    }
+
+    // 4.本帧之后的绘制读取新的顶点区间之前，拷贝需已完成
+    if (moveCount > 0)
+    {
+        VkMemoryBarrier barrier = {};
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+            0,
+            1, &barrier,
+            0, NULL,
+            0, NULL);
+    }
+
+    pDefrag->stats.movedMeshes      += moveCount;
+    pDefrag->stats.movedBytes       += movedBytes;
+    pDefrag->stats.lastFrameMoves   = moveCount;
+
+    return moveCount;
+}
+
+
+void get_mesh_defrag_stats(const MeshDefragmenter* pDefrag, const MeshArena* pArena, MeshDefragStats* pStats)
+{
+    *pStats = pDefrag->stats;
+
+    pStats->frameBudget         = pDefrag->frameBudget;
+    pStats->vertexBlockCount    = count_blocks(&pArena->vertices);
+    pStats->indexBlockCount     = count_blocks(&pArena->indices);
+}
+
+
+/// @brief 池中已创建的块数.
+static uint32_t count_blocks(const MeshArenaPool* pPool)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < pPool->blockCount; i++)
+    {
+        if (pPool->blocks[i].buffer != VK_NULL_HANDLE)
+            count++;
+    }
+
+    return count;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "resource_table.h"
+#include "mesh_arena.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 每帧整理默认最多搬移的字节数（顶点 + 索引）.
+#define MESH_DEFRAG_DEFAULT_FRAME_BUDGET    (1ull * 1024 * 1024)
+
+/// @brief 网格池整理的统计信息，与 C# 的 MeshDefragStats 布局一致.
+typedef struct MeshDefragStats {
+    uint64_t            frameBudget;            // 每帧最多搬移的字节数，为 0 时整理已关闭
+    uint64_t            movedMeshes;            // 累计搬移的网格数
+    uint64_t            movedBytes;             // 累计搬移的字节数
+    uint32_t            releasedBlocks;         // 累计释放的块数
+    uint32_t            lastFrameMoves;         // 上一次整理步骤搬移的网格数
+    uint32_t            vertexBlockCount;       // 当前已创建的顶点块数
+    uint32_t            indexBlockCount;        // 当前已创建的索引块数
+} MeshDefragStats;
+
+/// @brief 网格池的增量整理器.
+///
+/// 每帧选出占用最少、且其内容能放进其余块的顶点块与索引块，把引用它们的拉取网格搬移到其余的块中：
+/// 顶点在本帧的命令缓冲中以 vkCmdCopyBuffer 拷贝，索引在 CPU 上换算到新的顶点起点，
+/// 然后用 resource_table_replace 换上新的位置（句柄不变，旧区间在 GPU 完成本帧后归还）.
+/// 块被清空后在之后的整理步骤中销毁，使长时间运行时网格池的占用随实际的网格量收缩.
+typedef struct MeshDefragmenter {
+    uint64_t            frameBudget;
+    uint32_t            cursor;                 // 下一次从该槽位继续遍历资源表
+    bool                idle;                   // 上一次完整遍历没有搬移任何网格
+    uint64_t            idleVersion;            // 此时网格池的版本，版本不变时不再遍历
+    MeshDefragStats     stats;
+} MeshDefragmenter;
+
+
+/// @brief 初始化整理器.
+///
+/// @param frameBudget 每帧最多搬移的字节数，为 0 时关闭整理
+void init_mesh_defragmenter(uint64_t frameBudget, MeshDefragmenter* pDefrag);
+
+/// @brief 设置每帧最多搬移的字节数（为 0 时关闭整理）.
+void mesh_defrag_set_budget(MeshDefragmenter* pDefrag, uint64_t frameBudget);
+
+/// @brief 执行一步整理：销毁已清空的块，并在预算内搬移网格（每帧开始、资源回收之后调用）.
+///
+/// @param commandBuffer 本帧的命令缓冲，需在任何渲染通道之前调用
+/// @param serial 本帧提交的序号，网格的旧区间在 GPU 完成该提交后归还
+///
+/// @return 本步搬移的网格数
+uint32_t mesh_defrag_step(
+    MeshDefragmenter*   pDefrag,
+    ResourceTable*      pTable,
+    MeshArena*          pArena,
+    VkCommandBuffer     commandBuffer,
+    uint64_t            serial
+);
+
+/// @brief 获取整理的统计信息（含网格池当前的块数）.
+void get_mesh_defrag_stats(const MeshDefragmenter* pDefrag, const MeshArena* pArena, MeshDefragStats* pStats);
@@ -1,18 +1,38 @@
 /// 对外暴露的接口，该接口应该永远不暴露任何具体图形 API 的细节
 
 #include "nativelib_renderer.h"
+#include "../common/trace.h"
 
 static RenderContext* g_context = NULL;
 
 
-EX_API bool rendererInitialize(GLFWwindow* window)
+EX_API bool rendererPreinitialize()
 {
+    if (g_context != NULL)
+        return false;
+
     // 为渲染上下文分配内存
     g_context = new_render_context();
+    if (g_context == NULL)
+        return false;
+
+    return preinitialize_render_context(g_context);
+}
+
+
+EX_API bool rendererInitialize(GLFWwindow* window)
+{
+    // 为渲染上下文分配内存（已预初始化时沿用其上下文）
+    if (g_context == NULL)
+        g_context = new_render_context();
+    if (g_context == NULL)
+        return false;
+
     // 构建渲染上下文
     if (!create_render_context(window, g_context))
     {
         destroy_render_context(g_context);
+        g_context = NULL;
         return false;
     }
 
@@ -26,20 +46,577 @@ EX_API void rendererReady()
 }
 
 
-EX_API void rendererBeginFrame()
+EX_API int rendererAddWindow(GLFWwindow* window)
+{
+    if (g_context == NULL)
+        return -1;
+
+    return add_render_surface(g_context, window);
+}
+
+
+EX_API void rendererRemoveWindow(int surface)
+{
+    if (g_context == NULL)
+        return;
+
+    remove_render_surface(g_context, surface);
+}
+
+
+EX_API bool rendererBeginFrame()
+{
+    if (g_context == NULL)
+        return false;
+
+    return begin_frame(g_context);
+}
+
+
+EX_API void rendererDrawTriangle(int surface)
+{
+    if (g_context == NULL)
+        return;
+
+    draw_triangles(g_context, surface, 1);
+}
+
+
+EX_API void rendererSetStaticPass(int surface, uint32_t triangleCount)
+{
+    if (g_context == NULL)
+        return;
+
+    set_static_pass(g_context, surface, triangleCount);
+}
+
+
+EX_API void rendererDrawStatic(int surface)
+{
+    if (g_context == NULL)
+        return;
+
+    draw_static_pass(g_context, surface);
+}
+
+
+EX_API void* rendererAllocateUniform(uint32_t size, uint32_t* pOffset)
 {
+    *pOffset = UNIFORM_RING_INVALID_OFFSET;
+    if (g_context == NULL || !g_context->frameContext.frameBegun)
+        return NULL;
+
+    void* pData = NULL;
+    *pOffset = uniform_ring_alloc(&g_context->uniformRing, size, &pData);
 
+    return *pOffset != UNIFORM_RING_INVALID_OFFSET ? pData : NULL;
+}
+
+
+EX_API void rendererBindUniform(uint32_t offset)
+{
+    if (g_context == NULL)
+        return;
+
+    bind_uniforms(g_context, offset);
 }
 
 
 EX_API void rendererEndFrame()
 {
+    if (g_context == NULL)
+        return;
+
+    end_frame(g_context);
+}
+
+
+EX_API uint64_t rendererRequestReadback()
+{
+    if (g_context == NULL)
+        return 0;
+
+    if (!g_context->surfaces[0].readbackSupported)
+    {
+        fprintf(stderr, "%s : 主表面的交换链图像不支持作为传输源，无法回读！\n", __func__);
+        return 0;
+    }
+
+    return readback_request(&g_context->readbackRing);
+}
+
+
+EX_API bool rendererMapReadback(uint64_t ticket, ReadbackInfo* pInfo)
+{
+    if (g_context == NULL)
+        return false;
+
+    // 非阻塞：只查询栅栏状态，不等待 GPU
+    uint64_t completedSerial = 
+        poll_completed_serial(g_context->device, &g_context->frameContext);
+
+    return readback_map(&g_context->readbackRing,
+               g_context->device,
+               ticket,
+               completedSerial,
+               pInfo);
+}
+
+
+EX_API void rendererReleaseReadback(uint64_t ticket)
+{
+    if (g_context == NULL)
+        return;
+
+    readback_release(&g_context->readbackRing, ticket);
+}
+
+
+EX_API uint32_t rendererCreateObject()
+{
+    if (g_context == NULL)
+        return SCENE_INVALID_HANDLE;
+
+    invalidate_static_passes(g_context);
+
+    return scene_create_object(&g_context->scene);
+}
+
+
+EX_API void rendererDestroyObject(uint32_t handle)
+{
+    if (g_context == NULL)
+        return;
+
+    scene_destroy_object(&g_context->scene, handle);
+    invalidate_static_passes(g_context);
+}
+
+
+EX_API bool rendererGetScene(SceneView* pView)
+{
+    if (g_context == NULL)
+        return false;
+
+    *pView = get_scene_view(&g_context->scene);
+
+    return true;
+}
+
+
+EX_API bool rendererSetParent(uint32_t child, uint32_t parent)
+{
+    if (g_context == NULL)
+        return false;
+
+    invalidate_static_passes(g_context);
+
+    return scene_set_parent(&g_context->scene, child, parent);
+}
+
+
+EX_API void rendererUpdateScene(uint32_t begin, uint32_t end)
+{
+    if (g_context == NULL)
+        return;
+
+    scene_update_transforms(&g_context->scene, &g_context->jobs, begin, end);
+}
+
+
+EX_API void rendererMarkSceneDirty(uint32_t begin, uint32_t end)
+{
+    if (g_context == NULL)
+        return;
+
+    scene_mark_dirty(&g_context->scene, begin, end);
+}
+
+
+EX_API bool rendererRunJob(JobFunc func, void* pArg, JobCounter* pCounter)
+{
+    if (g_context == NULL || func == NULL)
+        return false;
+
+    job_system_run(&g_context->jobs, func, pArg, pCounter);
+
+    return true;
+}
+
+
+EX_API void rendererWaitJobs(JobCounter* pCounter)
+{
+    if (g_context == NULL || pCounter == NULL)
+        return;
+
+    job_system_wait(&g_context->jobs, pCounter);
+}
+
+
+EX_API void rendererParallelFor(uint32_t count, uint32_t grain, JobRangeFunc func, void* pArg)
+{
+    if (g_context == NULL)
+    {
+        func(pArg, 0, count);
+        return;
+    }
+
+    job_system_parallel_for(&g_context->jobs, count, grain, func, pArg);
+}
+
+
+EX_API uint32_t rendererGetJobThreadCount()
+{
+    return g_context != NULL ? g_context->jobs.workerCount : 0;
+}
+
+
+EX_API uint64_t rendererCreateBuffer(uint64_t size, uint32_t usage)
+{
+    if (g_context == NULL || g_context->device == VK_NULL_HANDLE || size == 0)
+        return RESOURCE_INVALID_HANDLE;
+
+    VkBufferUsageFlags vkUsage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    if (usage & RENDERER_BUFFER_VERTEX)     vkUsage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    if (usage & RENDERER_BUFFER_INDEX)      vkUsage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    if (usage & RENDERER_BUFFER_STORAGE)    vkUsage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if ((usage & RENDERER_BUFFER_STORAGE) && g_context->bufferDeviceAddress)
+        vkUsage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    if (usage & RENDERER_BUFFER_UNIFORM)    vkUsage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+
+    MemoryCategory category = (usage & (RENDERER_BUFFER_VERTEX | RENDERER_BUFFER_INDEX))
+                            ? MEMORY_CATEGORY_MESH : MEMORY_CATEGORY_BUFFER;
+
+    bool hostVisible    = (usage & (RENDERER_BUFFER_HOST_VISIBLE | RENDERER_BUFFER_DYNAMIC)) != 0;
+    bool deviceLocal    = (usage & RENDERER_BUFFER_DYNAMIC) != 0 && g_context->directWrite;
+
+    // 存储缓冲可能由计算队列写入、图形队列读取，以 CONCURRENT 模式共享，无需转移所有权
+    uint32_t queueFamilies[2];
+    uint32_t queueFamilyCount = (usage & RENDERER_BUFFER_STORAGE)
+                              ? get_shared_queue_families(g_context, queueFamilies) : 0;
+
+    return resource_table_create_buffer(&g_context->resources,
+               g_context->physicalDevice, g_context->device,
+               size, vkUsage, hostVisible, deviceLocal, category,
+               queueFamilyCount, queueFamilies);
+}
+
+
+EX_API bool rendererSupportsDirectWrite()
+{
+    return g_context != NULL && g_context->directWrite;
+}
+
+
+EX_API void* rendererGetBufferData(uint64_t buffer, uint64_t* pSize)
+{
+    if (pSize != NULL)
+        *pSize = 0;
+
+    if (g_context == NULL)
+        return NULL;
+
+    ResourceData* pData = resource_table_get(&g_context->resources, buffer, RESOURCE_TYPE_BUFFER);
+    if (pData == NULL || pData->buffer.pMapped == NULL)
+        return NULL;
+
+    if (pSize != NULL)
+        *pSize = pData->buffer.size;
+
+    return pData->buffer.pMapped;
+}
+
+
+EX_API uint64_t rendererGetBufferAddress(uint64_t buffer)
+{
+    if (g_context == NULL)
+        return 0;
+
+    ResourceData* pData = resource_table_get(&g_context->resources, buffer, RESOURCE_TYPE_BUFFER);
+
+    return pData != NULL ? pData->buffer.address : 0;
+}
+
+
+EX_API uint64_t rendererCreateMesh(uint64_t vertexBuffer, uint64_t indexBuffer,
+    uint32_t vertexCount, uint32_t indexCount)
+{
+    if (g_context == NULL)
+        return RESOURCE_INVALID_HANDLE;
+
+    ResourceTable* pTable = &g_context->resources;
+    if (resource_handle_type(vertexBuffer) != RESOURCE_TYPE_BUFFER
+        || !resource_table_is_alive(pTable, vertexBuffer)
+        || (indexBuffer != RESOURCE_INVALID_HANDLE
+            && (resource_handle_type(indexBuffer) != RESOURCE_TYPE_BUFFER
+                || !resource_table_is_alive(pTable, indexBuffer))))
+    {
+        fprintf(stderr, "%s : 传入了无效参数！顶点 / 索引缓冲句柄无效.\n", __func__);
+        return RESOURCE_INVALID_HANDLE;
+    }
+
+    // 绘制按数量读取缓冲，用途或大小不符时 GPU 会越界读取
+    const ResourceData* pVertexData = resource_table_get(pTable, vertexBuffer, RESOURCE_TYPE_BUFFER);
+    if (pVertexData == NULL || !(pVertexData->buffer.usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+        || (VkDeviceSize)vertexCount * sizeof(PulledVertex) > pVertexData->buffer.size)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！顶点缓冲不是 VERTEX 用途或小于 %u 个顶点.\n",
+            __func__, vertexCount);
+        return RESOURCE_INVALID_HANDLE;
+    }
+
+    if (indexBuffer != RESOURCE_INVALID_HANDLE)
+    {
+        const ResourceData* pIndexData = resource_table_get(pTable, indexBuffer, RESOURCE_TYPE_BUFFER);
+        if (pIndexData == NULL || !(pIndexData->buffer.usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+            || (VkDeviceSize)indexCount * sizeof(uint32_t) > pIndexData->buffer.size)
+        {
+            fprintf(stderr, "%s : 传入了无效参数！索引缓冲不是 INDEX 用途或小于 %u 个索引.\n",
+                __func__, indexCount);
+            return RESOURCE_INVALID_HANDLE;
+        }
+    }
+
+    ResourceData data = {};
+    data.mesh.vertexBuffer  = vertexBuffer;
+    data.mesh.indexBuffer   = indexBuffer;
+    data.mesh.vertexCount   = vertexCount;
+    data.mesh.indexCount    = indexCount;
+
+    ResourceHandle handle = resource_table_insert(pTable, RESOURCE_TYPE_MESH, &data);
+
+    // 网格的缓冲只在绘制时使用，不可映射的设备本地缓冲超出内存预算时可以按最近最少使用的顺序驱逐
+    if (handle != RESOURCE_INVALID_HANDLE)
+    {
+        resource_table_make_streamable(pTable, vertexBuffer);
+        resource_table_make_streamable(pTable, indexBuffer);
+    }
+
+    return handle;
+}
+
+
+EX_API bool rendererSupportsVertexPulling()
+{
+    return g_context != NULL && g_context->meshArena.enabled;
+}
+
+
+EX_API uint64_t rendererCreatePulledMesh(const PulledVertex* pVertices, uint32_t vertexCount,
+    const uint32_t* pIndices, uint32_t indexCount)
+{
+    if (g_context == NULL)
+        return RESOURCE_INVALID_HANDLE;
+
+    ResourceData data = {};
+    data.mesh.vertexCount   = vertexCount;
+    data.mesh.indexCount    = indexCount;
+    if (!mesh_arena_allocate(&g_context->meshArena, pVertices, vertexCount,
+            pIndices, indexCount, &data.mesh.pulled))
+        return RESOURCE_INVALID_HANDLE;
+
+    ResourceHandle handle = resource_table_insert(&g_context->resources, RESOURCE_TYPE_MESH, &data);
+    if (handle == RESOURCE_INVALID_HANDLE)
+        mesh_arena_free(&g_context->meshArena, &data.mesh.pulled, vertexCount, indexCount);
+
+    return handle;
+}
+
+
+EX_API bool rendererIsResourceResident(uint64_t resource)
+{
+    return g_context != NULL && resource_table_is_resident(&g_context->resources, resource);
+}
+
+
+EX_API void rendererDestroyResource(uint64_t resource)
+{
+    if (g_context == NULL)
+        return;
+
+    resource_table_release(&g_context->resources, resource, resource_retire_serial(g_context));
+}
+
+
+EX_API bool rendererIsResourceAlive(uint64_t resource)
+{
+    return g_context != NULL && resource_table_is_alive(&g_context->resources, resource);
+}
+
+
+EX_API uint32_t rendererSubmitDraws(const DrawCommand* pCommands, uint32_t count)
+{
+    if (g_context == NULL || !g_context->frameContext.frameBegun || pCommands == NULL)
+        return 0;
+
+    return draw_queue_push(&g_context->drawQueue, pCommands, count);
+}
+
+
+EX_API void rendererFlushDraws()
+{
+    if (g_context == NULL)
+        return;
+
+    flush_draw_queue(g_context);
+}
+
+
+EX_API uint64_t rendererCreateComputePipeline(const uint32_t* pCode, uint64_t codeSize)
+{
+    if (g_context == NULL || g_context->device == VK_NULL_HANDLE)
+        return RESOURCE_INVALID_HANDLE;
+
+    return create_compute_pipeline(g_context, pCode, (size_t)codeSize);
+}
+
+
+EX_API bool rendererBeginComputePass()
+{
+    if (g_context == NULL)
+        return false;
+
+    return begin_compute_pass(g_context) != VK_NULL_HANDLE;
+}
+
+
+EX_API bool rendererDispatch(uint64_t pipeline, const void* pConstants, uint32_t constantSize,
+    uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    if (g_context == NULL)
+        return false;
+
+    return dispatch_compute(g_context, pipeline, pConstants, constantSize,
+               groupCountX, groupCountY, groupCountZ);
+}
+
+
+EX_API bool rendererEndComputePass(uint32_t waitStages)
+{
+    if (g_context == NULL)
+        return false;
+
+    VkPipelineStageFlags stages = 0;
+    if (waitStages & RENDERER_COMPUTE_WAIT_DRAW_INDIRECT)   stages |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+    if (waitStages & RENDERER_COMPUTE_WAIT_VERTEX_INPUT)    stages |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    if (waitStages & RENDERER_COMPUTE_WAIT_VERTEX_SHADER)   stages |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+    if (waitStages & RENDERER_COMPUTE_WAIT_FRAGMENT_SHADER) stages |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    if (stages == 0)
+        stages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    return end_compute_pass(g_context, stages);
+}
+
+
+EX_API bool rendererGetDrawQueueStats(DrawQueueStats* pStats)
+{
+    if (g_context == NULL)
+        return false;
+
+    *pStats = g_context->drawQueue.stats;
+
+    return true;
+}
+
+
+EX_API void rendererSetFrameRateLimit(double framesPerSecond)
+{
+    if (g_context == NULL)
+        return;
+
+    frame_limiter_set_rate(&g_context->frameLimiter, framesPerSecond);
+}
+
+
+EX_API bool rendererGetFrameLimiterStats(FrameLimiterStats* pStats)
+{
+    if (g_context == NULL)
+        return false;
+
+    *pStats = g_context->frameLimiter.stats;
+
+    return true;
+}
+
+
+EX_API bool rendererGetMemoryBudget(MemoryBudgetReport* pReport)
+{
+    if (g_context == NULL || g_context->device == VK_NULL_HANDLE)
+        return false;
+
+    get_memory_budget_report(pReport);
+
+    return true;
+}
+
+
+EX_API void rendererSetMeshDefragBudget(uint64_t bytesPerFrame)
+{
+    if (g_context == NULL)
+        return;
+
+    mesh_defrag_set_budget(&g_context->meshDefrag, bytesPerFrame);
+}
+
+
+EX_API bool rendererGetMeshDefragStats(MeshDefragStats* pStats)
+{
+    if (g_context == NULL)
+        return false;
+
+    get_mesh_defrag_stats(&g_context->meshDefrag, &g_context->meshArena, pStats);
+
+    return true;
+}
+
+
+EX_API void rendererSetTracing(bool enabled)
+{
+    trace_set_enabled(enabled);
+}
+
+
+EX_API bool rendererIsTracing()
+{
+    return trace_is_enabled();
+}
+
+
+EX_API bool rendererCaptureTrace(const char* path, double seconds)
+{
+    if (path == NULL)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！\n", __func__);
+        return false;
+    }
+
+    return trace_capture(path, seconds);
+}
+
+
+EX_API const RendererFrameApi* rendererGetFrameApi()
+{
+    static const RendererFrameApi api = {
+        .size                   = sizeof(RendererFrameApi),
+        .beginFrame             = rendererBeginFrame,
+        .drawTriangle           = rendererDrawTriangle,
+        .drawStatic             = rendererDrawStatic,
+        .allocateUniform        = rendererAllocateUniform,
+        .bindUniform            = rendererBindUniform,
+        .submitDraws            = rendererSubmitDraws,
+        .flushDraws             = rendererFlushDraws,
+        .endFrame               = rendererEndFrame,
+        .getDrawQueueStats      = rendererGetDrawQueueStats,
+        .getFrameLimiterStats   = rendererGetFrameLimiterStats
+    };
 
+    return &api;
 }
 
 
 EX_API void rendererRelease()
 {
     destroy_render_context(g_context);
+    g_context = NULL;
 }
 
@@ -4,19 +4,349 @@
 #include "render_context.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <GLFW/glfw3.h>
 
 
+/// @brief 在工作线程上开始渲染器的预初始化（创建 Vulkan 实例、读取管线缓存文件），
+/// 使其与窗口创建重叠.
+///
+/// 可选，需在 GLFW 初始化之后、rendererInitialize 之前调用.
+///
+/// @return 成功开始预初始化时返回 `true`
+EX_API bool rendererPreinitialize();
+
+
 EX_API bool rendererInitialize(GLFWwindow* window);
 
 
 EX_API void rendererReady();
 
 
-EX_API void rendererBeginFrame();
+/// @brief 为另一个窗口创建交换链，与 rendererInitialize 的窗口共享同一个设备.
+///
+/// @return 表面编号（rendererInitialize 的窗口为 0），失败时返回 -1
+EX_API int rendererAddWindow(GLFWwindow* window);
+
+
+/// @brief 销毁由 rendererAddWindow 创建的表面（需在销毁窗口之前调用）.
+EX_API void rendererRemoveWindow(int surface);
+
+
+/// @brief 开始一帧.
+///
+/// @return 成功开始一帧时返回 `true`，否则本次循环应跳过渲染且不调用 rendererEndFrame
+EX_API bool rendererBeginFrame();
+
+
+/// @brief 在当前帧中向给定表面绘制内置的三角形（需在 rendererBeginFrame 与
+/// rendererEndFrame 之间调用，同一帧中对各表面的绘制需按表面分组）.
+///
+/// @param surface 表面编号（见 rendererAddWindow）
+EX_API void rendererDrawTriangle(int surface);
+
+
+/// @brief 在当前帧的 uniform 环形缓冲中分配 `size` 字节，调用者直接向返回的地址写入数据.
+///
+/// 内存只在当前帧内有效，无需刷新. 内置着色器从开头读取 ObjectUniforms（见 uniform_ring.h）.
+///
+/// @param pOffset 输出参数，接收分配的动态偏移（传给 rendererBindUniform）
+///
+/// @return 映射内存的地址，`size` 过大或当前帧的分区已满时返回 `NULL`
+EX_API void* rendererAllocateUniform(uint32_t size, uint32_t* pOffset);
+
+
+/// @brief 绑定 uniform 数据，之后的绘制从 `offset` 处读取（需在 rendererBeginFrame 与
+/// rendererEndFrame 之间调用）；每帧开始时绑定的是默认的 ObjectUniforms.
+EX_API void rendererBindUniform(uint32_t offset);
 
 
 EX_API void rendererEndFrame();
 
 
+/// @brief 请求回读下一次 rendererEndFrame 所呈现的主表面（编号 0）的交换链图像.
+///
+/// @return 请求编号（ticket），回读槽位已满或交换链图像不支持作为传输源时返回 0
+EX_API uint64_t rendererRequestReadback();
+
+
+/// @brief 非阻塞地查询回读结果.
+///
+/// @param ticket rendererRequestReadback 返回的请求编号
+/// @param pInfo 输出参数，数据就绪时被填充（数据在 rendererReleaseReadback 前一直有效）
+///
+/// @return 数据就绪时返回 `true`
+EX_API bool rendererMapReadback(uint64_t ticket, ReadbackInfo* pInfo);
+
+
+/// @brief 释放回读请求所占用的槽位.
+EX_API void rendererReleaseReadback(uint64_t ticket);
+
+
+/// @brief 在场景中创建一个对象（变换为单位矩阵，可见）.
+///
+/// @return 对象句柄，场景已满或渲染器未初始化时返回 0
+EX_API uint32_t rendererCreateObject();
+
+
+/// @brief 销毁场景中的对象，其句柄随即失效.
+EX_API void rendererDestroyObject(uint32_t handle);
+
+
+/// @brief 获取场景各数组的地址与大小（数组地址在渲染器的生命周期内不变）.
+///
+/// @return 渲染器已初始化时返回 `true`
+EX_API bool rendererGetScene(SceneView* pView);
+
+
+/// @brief 设置对象的父对象（父对象的下标需小于子对象，见 scene_set_parent）.
+///
+/// @param parent 父对象句柄，传入 0 时解除父子关系
+EX_API bool rendererSetParent(uint32_t child, uint32_t parent);
+
+
+/// @brief 由局部平移 / 旋转 / 缩放批量计算场景下标 [begin, end) 的世界矩阵与世界包围球，
+/// 并将其标记为待上传.
+EX_API void rendererUpdateScene(uint32_t begin, uint32_t end);
+
+
+/// @brief 将场景下标范围 [begin, end) 标记为待上传，在下一次 rendererBeginFrame 时上传到 GPU.
+EX_API void rendererMarkSceneDirty(uint32_t begin, uint32_t end);
+
+
+/// @brief 在渲染器的任务系统上提交一个原生任务（需在 rendererPreinitialize 或
+/// rendererInitialize 之后调用）.
+///
+/// @param pCounter 可为 `NULL`，否则需在 rendererWaitJobs 返回前保持有效
+///
+/// @return 渲染器尚未创建时返回 `false`（任务不会执行）
+EX_API bool rendererRunJob(JobFunc func, void* pArg, JobCounter* pCounter);
+
+
+/// @brief 等待计数器归零，期间在调用线程上执行其他任务.
+EX_API void rendererWaitJobs(JobCounter* pCounter);
+
+
+/// @brief 把下标 [0, count) 拆分为任务并行执行，返回时全部完成（渲染器尚未创建时在调用线程上执行）.
+EX_API void rendererParallelFor(uint32_t count, uint32_t grain, JobRangeFunc func, void* pArg);
+
+
+/// @brief 获取任务系统的线程数（含创建渲染器的线程），渲染器尚未创建时返回 0.
+EX_API uint32_t rendererGetJobThreadCount();
+
+
+/// @brief rendererCreateBuffer 的用途标志.
+typedef enum RendererBufferUsage {
+    RENDERER_BUFFER_VERTEX          = 1u << 0,
+    RENDERER_BUFFER_INDEX           = 1u << 1,
+    RENDERER_BUFFER_STORAGE         = 1u << 2,      // 计算着色器可以读写（经 rendererGetBufferAddress），
+                                                    // 使用异步计算时在计算与图形队列间共享
+    RENDERER_BUFFER_UNIFORM         = 1u << 3,
+    RENDERER_BUFFER_HOST_VISIBLE    = 1u << 4,      // 主机可见并常驻映射（否则为设备本地）
+    RENDERER_BUFFER_DYNAMIC         = 1u << 5,      // 每帧由 CPU 就地写入：常驻映射，设备有可主机写入的显存时
+                                                    // 位于显存中（只应顺序写入、不应读取），否则同 HOST_VISIBLE
+} RendererBufferUsage;
+
+
+/// @brief 创建一个缓冲资源.
+///
+/// @param usage RendererBufferUsage 的组合
+///
+/// @return 资源句柄，失败时返回 0
+EX_API uint64_t rendererCreateBuffer(uint64_t size, uint32_t usage);
+
+
+/// @brief 动态缓冲（RENDERER_BUFFER_DYNAMIC）与 uniform 环形缓冲是否位于可主机写入的显存中
+/// （ReBAR、集成显卡或 lavapipe），此时写入动态数据只需一次 memcpy，不经过暂存缓冲.
+EX_API bool rendererSupportsDirectWrite();
+
+
+/// @brief 获取主机可见缓冲的映射地址（句柄过期或缓冲不可映射时返回 `NULL`）.
+///
+/// @param pSize 输出参数，缓冲的字节数（返回 `NULL` 时为 0），可为 `NULL`
+EX_API void* rendererGetBufferData(uint64_t buffer, uint64_t* pSize);
+
+
+/// @brief 获取存储缓冲（RENDERER_BUFFER_STORAGE）的设备地址，作为推送常量传给计算着色器
+/// （GLSL 的 buffer_reference）.
+///
+/// @return 设备地址，句柄过期、缓冲不是存储缓冲或设备不支持 bufferDeviceAddress 时返回 0
+EX_API uint64_t rendererGetBufferAddress(uint64_t buffer);
+
+
+/// @brief 由两个缓冲资源创建网格资源，网格接管两个缓冲的所有权（销毁网格时一并销毁）.
+///
+/// 顶点缓冲的布局与 PulledVertex 相同（位置、颜色各 3 个 float），由表面的顶点输入管线绘制.
+/// 不可映射的设备本地缓冲（存储缓冲除外）超出内存预算时可能被驱逐：句柄仍有效，但使用它们的
+/// 绘制被跳过，需由 rendererIsResourceResident 检查后重新创建；主机可见的缓冲不会被驱逐.
+///
+/// @param indexBuffer 可为 0（非索引绘制），索引为 uint32_t
+///
+/// @return 资源句柄，失败时返回 0
+EX_API uint64_t rendererCreateMesh(uint64_t vertexBuffer, uint64_t indexBuffer,
+    uint32_t vertexCount, uint32_t indexCount);
+
+
+/// @brief 设备是否支持顶点拉取网格（bufferDeviceAddress 特性）.
+EX_API bool rendererSupportsVertexPulling();
+
+
+/// @brief 在网格池中创建一个顶点拉取网格：数据被拷贝进共享的大缓冲，不需要单独的顶点 / 索引缓冲，
+/// 同一对块中的网格共用一个管线与推送常量，索引区间相邻的绘制会被合并.
+///
+/// @param pIndices 可为 `NULL`（此时 `indexCount` 需等于 `vertexCount`，按顶点顺序绘制）
+///
+/// @return 资源句柄，设备不支持或网格池已满时返回 0
+EX_API uint64_t rendererCreatePulledMesh(const PulledVertex* pVertices, uint32_t vertexCount,
+    const uint32_t* pIndices, uint32_t indexCount);
+
+
+/// @brief 资源是否存活且未因超出内存预算被驱逐.
+EX_API bool rendererIsResourceResident(uint64_t resource);
+
+
+/// @brief 销毁资源：句柄立即失效，底层对象在 GPU 完成使用后才被销毁.
+EX_API void rendererDestroyResource(uint64_t resource);
+
+
+/// @brief 句柄是否仍指向一个存活的资源.
+EX_API bool rendererIsResourceAlive(uint64_t resource);
+
+
+/// @brief 把 `count` 条绘制命令加入本帧的绘制队列（需在 rendererBeginFrame 与 rendererEndFrame
+/// 之间调用），命令可以任意顺序提交，录制前按状态排序并消除冗余绑定.
+///
+/// @return 加入的命令数，队列已满时少于 `count`
+EX_API uint32_t rendererSubmitDraws(const DrawCommand* pCommands, uint32_t count);
+
+
+/// @brief 立即排序并录制绘制队列中的命令（可选，rendererEndFrame 会自动调用）.
+EX_API void rendererFlushDraws();
+
+
+/// @brief rendererEndComputePass 的等待阶段：图形工作中首个读取计算结果的阶段.
+typedef enum RendererComputeWait {
+    RENDERER_COMPUTE_WAIT_DRAW_INDIRECT     = 1u << 0,      // 间接绘制参数
+    RENDERER_COMPUTE_WAIT_VERTEX_INPUT      = 1u << 1,      // 顶点 / 索引缓冲
+    RENDERER_COMPUTE_WAIT_VERTEX_SHADER     = 1u << 2,      // 顶点着色器（含顶点拉取）
+    RENDERER_COMPUTE_WAIT_FRAGMENT_SHADER   = 1u << 3,
+} RendererComputeWait;
+
+
+/// @brief 由 SPIR-V 字节码创建计算管线（入口为 main）.
+///
+/// 管线没有描述符集，只有 `COMPUTE_PUSH_CONSTANT_SIZE` 字节的推送常量，缓冲以设备地址
+/// （见 rendererGetBufferAddress）传入.
+///
+/// @param codeSize 字节数，需为 4 的倍数
+///
+/// @return 资源句柄（由 rendererDestroyResource 销毁），失败时返回 0
+EX_API uint64_t rendererCreateComputePipeline(const uint32_t* pCode, uint64_t codeSize);
+
+
+/// @brief 在当前帧中开始计算通道（需在 rendererBeginFrame 之后、本帧的任何绘制之前调用，每帧一次）.
+///
+/// 设备有专用的计算队列族时，计算在该队列上与上一帧的渲染并行执行，此时被计算写入的缓冲
+/// 应按在途帧各备一份.
+///
+/// @return 成功开始时返回 `true`
+EX_API bool rendererBeginComputePass();
+
+
+/// @brief 在计算通道中录制一次调度，相邻的调度之间插入屏障（后者可以读取前者的写入）.
+///
+/// @param pipeline rendererCreateComputePipeline 返回的句柄
+/// @param pConstants 推送常量，`constantSize` 为 0 时可为 `NULL`
+/// @param constantSize 不超过 `COMPUTE_PUSH_CONSTANT_SIZE` 字节
+///
+/// @return 成功录制时返回 `true`
+EX_API bool rendererDispatch(uint64_t pipeline, const void* pConstants, uint32_t constantSize,
+    uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+
+
+/// @brief 结束计算通道，本帧的图形工作在 `waitStages` 阶段之前等待计算完成.
+///
+/// @param waitStages RendererComputeWait 的组合，为 0 时图形工作整体等待
+///
+/// @return 成功时返回 `true`
+EX_API bool rendererEndComputePass(uint32_t waitStages);
+
+
+/// @brief 获取绘制队列上一次录制的统计信息（绘制数与各类绑定数）.
+///
+/// @return 渲染器已初始化时返回 `true`
+EX_API bool rendererGetDrawQueueStats(DrawQueueStats* pStats);
+
+
+/// @brief 设置帧率上限（在 rendererEndFrame 中呈现之前等待），主要用于关闭垂直同步时.
+///
+/// @param framesPerSecond 每秒最多的帧数，为 0 时不限制（默认）
+EX_API void rendererSetFrameRateLimit(double framesPerSecond);
+
+
+/// @brief 获取帧率限制器测得的帧间隔与抖动.
+///
+/// @return 渲染器已初始化时返回 `true`
+EX_API bool rendererGetFrameLimiterStats(FrameLimiterStats* pStats);
+
+
+/// @brief 获取设备内存的预算与用量报告（各堆的预算、各分类的用量与驱逐统计）.
+///
+/// @return 渲染器已初始化时返回 `true`
+EX_API bool rendererGetMemoryBudget(MemoryBudgetReport* pReport);
+
+
+/// @brief 设置网格池整理每帧最多搬移的字节数（默认 `MESH_DEFRAG_DEFAULT_FRAME_BUDGET`）.
+///
+/// @param bytesPerFrame 为 0 时关闭整理（已清空的块也不再释放）
+EX_API void rendererSetMeshDefragBudget(uint64_t bytesPerFrame);
+
+
+/// @brief 获取网格池整理的统计信息（累计搬移量、释放的块数与当前块数）.
+///
+/// @return 渲染器已初始化时返回 `true`
+EX_API bool rendererGetMeshDefragStats(MeshDefragStats* pStats);
+
+
+/// @brief 开启或关闭追踪：记录各阶段的 CPU 区间与 GPU 时间戳区间（覆盖环境变量 `NATIVELIB_TRACE`）.
+///
+/// 可在初始化之前调用，以便记录上下文的构建过程；事件写入固定大小的环，只保留最近的一段时间.
+EX_API void rendererSetTracing(bool enabled);
+
+
+/// @brief 追踪当前是否开启.
+EX_API bool rendererIsTracing();
+
+
+/// @brief 把最近 seconds 秒的追踪事件写为 Chrome Trace Event JSON（可由 Perfetto 打开）.
+///
+/// @param path UTF-8 编码的文件路径
+/// @param seconds 不大于 0 时写出环中的全部事件
+///
+/// @return 是否成功写出
+EX_API bool rendererCaptureTrace(const char* path, double seconds);
+
+
+/// @brief 每帧调用的入口表，C# 以 `delegate* unmanaged` 直接调用，不经过 P/Invoke 的封送存根.
+///
+/// 各函数与同名的导出函数相同；所有参数与返回值都是可直接按位传递的类型（`bool` 为 1 字节）.
+typedef struct RendererFrameApi {
+    uint32_t    size;                                                   // sizeof(RendererFrameApi)
+    bool        (*beginFrame)(void);
+    void        (*drawTriangle)(int surface);
+    void        (*drawStatic)(int surface);
+    void*       (*allocateUniform)(uint32_t size, uint32_t* pOffset);
+    void        (*bindUniform)(uint32_t offset);
+    uint32_t    (*submitDraws)(const DrawCommand* pCommands, uint32_t count);
+    void        (*flushDraws)(void);
+    void        (*endFrame)(void);
+    bool        (*getDrawQueueStats)(DrawQueueStats* pStats);
+    bool        (*getFrameLimiterStats)(FrameLimiterStats* pStats);
+} RendererFrameApi;
+
+
+/// @brief 获取每帧调用的入口表（静态存储，在进程的整个生命周期内有效，可在初始化之前获取）.
+EX_API const RendererFrameApi* rendererGetFrameApi();
+
+
 EX_API void rendererRelease();
\ No newline at end of file
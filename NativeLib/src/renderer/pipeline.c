@@ -0,0 +1,392 @@
+#include "pipeline.h"
+
+#include <string.h>
+
+// 由 xmake 的 utils.glsl2spv 规则（bin2c）生成，内容为逗号分隔的字节
+static _Alignas(uint32_t) const unsigned char triangleVertexShaderCode[] = {
+    #include "triangle.vert.spv.h"
+};
+
+static _Alignas(uint32_t) const unsigned char triangleFragmentShaderCode[] = {
+    #include "triangle.frag.spv.h"
+};
+
+static _Alignas(uint32_t) const unsigned char meshPullVertexShaderCode[] = {
+    #include "mesh_pull.vert.spv.h"
+};
+
+static _Alignas(uint32_t) const unsigned char meshVertexShaderCode[] = {
+    #include "mesh.vert.spv.h"
+};
+
+
+ShaderCode get_triangle_vertex_shader_code(void)
+{
+    ShaderCode code = {
+        .pCode  = (const uint32_t*)triangleVertexShaderCode,
+        .size   = sizeof(triangleVertexShaderCode)
+    };
+
+    return code;
+}
+
+ShaderCode get_triangle_fragment_shader_code(void)
+{
+    ShaderCode code = {
+        .pCode  = (const uint32_t*)triangleFragmentShaderCode,
+        .size   = sizeof(triangleFragmentShaderCode)
+    };
+
+    return code;
+}
+
+
+ShaderCode get_mesh_pull_vertex_shader_code(void)
+{
+    ShaderCode code = {
+        .pCode  = (const uint32_t*)meshPullVertexShaderCode,
+        .size   = sizeof(meshPullVertexShaderCode)
+    };
+
+    return code;
+}
+
+
+ShaderCode get_mesh_vertex_shader_code(void)
+{
+    ShaderCode code = {
+        .pCode  = (const uint32_t*)meshVertexShaderCode,
+        .size   = sizeof(meshVertexShaderCode)
+    };
+
+    return code;
+}
+
+
+VkPipelineLayout createPipelineLayout(
+    VkDevice                        device,
+    uint32_t                        setLayoutCount,
+    const VkDescriptorSetLayout*    pSetLayouts,
+    uint32_t                        pushConstantSize,
+    VkShaderStageFlags              pushConstantStages
+)
+{
+    VkPushConstantRange pushConstantRange = {};
+    pushConstantRange.stageFlags    = pushConstantStages;
+    pushConstantRange.offset        = 0;
+    pushConstantRange.size          = pushConstantSize;
+
+    VkPipelineLayoutCreateInfo createInfo = {};
+    createInfo.sType                    = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    createInfo.setLayoutCount           = setLayoutCount;
+    createInfo.pSetLayouts              = pSetLayouts;
+    createInfo.pushConstantRangeCount   = pushConstantSize > 0 ? 1 : 0;
+    createInfo.pPushConstantRanges      = pushConstantSize > 0 ? &pushConstantRange : NULL;
+
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    VkResult result = vkCreatePipelineLayout(device, &createInfo, get_vulkan_allocator(), &pipelineLayout);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkPipelineLayout! Error Code(VkResult): %d\n", result);
+
+        return VK_NULL_HANDLE;
+    }
+
+    return pipelineLayout;
+}
+
+
+void destroyPipelineLayout(VkDevice device, VkPipelineLayout pipelineLayout)
+{
+    vkDestroyPipelineLayout(device, pipelineLayout, get_vulkan_allocator());
+
+    fprintf(stdout, 
+        ESC_LTALIC "%s %s " ESC_RESET
+        ESC_FCOLOR_BRIGHT_MAGENTA "调用了 vkDestroyPipelineLayout！\n" ESC_RESET,
+        __DATE__, __TIME__);
+}
+
+
+/// @brief 所有图形管线共用的固定功能状态（结构体之间的指针指向其自身的成员，初始化后不能复制）.
+typedef struct FixedFunctionState {
+    VkPipelineVertexInputStateCreateInfo    vertexInput;
+    VkPipelineInputAssemblyStateCreateInfo  inputAssembly;
+    VkPipelineViewportStateCreateInfo       viewportState;
+    VkPipelineRasterizationStateCreateInfo  rasterizer;
+    VkPipelineMultisampleStateCreateInfo    multisampling;
+    VkPipelineColorBlendAttachmentState     colorBlendAttachment;
+    VkPipelineColorBlendStateCreateInfo     colorBlending;
+    VkPipelineDynamicStateCreateInfo        dynamicState;
+} FixedFunctionState;
+
+static const VkDynamicState dynamicStates[] = {
+    VK_DYNAMIC_STATE_VIEWPORT,
+    VK_DYNAMIC_STATE_SCISSOR
+};
+
+// 经典网格的顶点输入：绑定 0 逐顶点，位置 vec3 与颜色 vec3（即 PulledVertex 的布局）
+static const VkVertexInputBindingDescription meshVertexBinding = {
+    .binding    = 0,
+    .stride     = 6 * sizeof(float),
+    .inputRate  = VK_VERTEX_INPUT_RATE_VERTEX
+};
+
+static const VkVertexInputAttributeDescription meshVertexAttributes[] = {
+    { .location = 0, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = 0 },
+    { .location = 1, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = 3 * sizeof(float) }
+};
+
+static void init_fixed_function_state(FixedFunctionState* pState);
+static VkPipelineShaderStageCreateInfo get_shader_stage(VkShaderStageFlagBits stage, VkShaderModule module);
+static VkPipeline create_graphics_pipeline(
+    VkDevice                            device,
+    VkPipelineCache                     pipelineCache,
+    const VkGraphicsPipelineCreateInfo* pCreateInfo
+);
+
+
+VkPipeline createGraphicsPipeline(
+    VkDevice            device,
+    VkPipelineCache     pipelineCache,
+    VkPipelineLayout    layout,
+    VkRenderPass        renderPass,
+    VkShaderModule      vertexShader,
+    VkShaderModule      fragmentShader,
+    bool                meshVertexInput
+)
+{
+    // 1.着色器阶段
+    VkPipelineShaderStageCreateInfo shaderStages[2] = {
+        get_shader_stage(VK_SHADER_STAGE_VERTEX_BIT, vertexShader),
+        get_shader_stage(VK_SHADER_STAGE_FRAGMENT_BIT, fragmentShader)
+    };
+
+    // 2.固定功能状态
+    FixedFunctionState state;
+    init_fixed_function_state(&state);
+
+    if (meshVertexInput)
+    {
+        state.vertexInput.vertexBindingDescriptionCount     = 1;
+        state.vertexInput.pVertexBindingDescriptions        = &meshVertexBinding;
+        state.vertexInput.vertexAttributeDescriptionCount   =
+            sizeof(meshVertexAttributes) / sizeof(meshVertexAttributes[0]);
+        state.vertexInput.pVertexAttributeDescriptions      = meshVertexAttributes;
+    }
+
+    // 3.创建图形管线
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType                = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.stageCount           = 2;
+    createInfo.pStages              = shaderStages;
+    createInfo.pVertexInputState    = &state.vertexInput;
+    createInfo.pInputAssemblyState  = &state.inputAssembly;
+    createInfo.pViewportState       = &state.viewportState;
+    createInfo.pRasterizationState  = &state.rasterizer;
+    createInfo.pMultisampleState    = &state.multisampling;
+    createInfo.pColorBlendState     = &state.colorBlending;
+    createInfo.pDynamicState        = &state.dynamicState;
+    createInfo.layout               = layout;
+    createInfo.renderPass           = renderPass;
+    createInfo.subpass              = 0;
+
+    return create_graphics_pipeline(device, pipelineCache, &createInfo);
+}
+
+
+VkPipeline createPipelineLibraryPart(
+    VkDevice                            device,
+    VkPipelineCache                     pipelineCache,
+    VkGraphicsPipelineLibraryFlagsEXT   part,
+    VkPipelineLayout                    layout,
+    VkRenderPass                        renderPass,
+    VkShaderModule                      shader
+)
+{
+    FixedFunctionState state;
+    init_fixed_function_state(&state);
+
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {};
+    libraryInfo.sType   = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    libraryInfo.flags   = part;
+
+    // 保留链接时优化所需的信息，之后才能以 LINK_TIME_OPTIMIZATION 重新链接出优化的管线
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType    = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext    = &libraryInfo;
+    createInfo.flags    = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR
+                        | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+    createInfo.subpass  = 0;
+
+    VkPipelineShaderStageCreateInfo shaderStage = {};
+    switch (part)
+    {
+        case VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT:
+            createInfo.pVertexInputState    = &state.vertexInput;
+            createInfo.pInputAssemblyState  = &state.inputAssembly;
+            break;
+
+        case VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT:
+            shaderStage = get_shader_stage(VK_SHADER_STAGE_VERTEX_BIT, shader);
+            createInfo.stageCount           = 1;
+            createInfo.pStages              = &shaderStage;
+            createInfo.pViewportState       = &state.viewportState;
+            createInfo.pRasterizationState  = &state.rasterizer;
+            createInfo.pDynamicState        = &state.dynamicState;     // 视口与裁剪矩形属于该部分
+            createInfo.layout               = layout;
+            createInfo.renderPass           = renderPass;
+            break;
+
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT:
+            shaderStage = get_shader_stage(VK_SHADER_STAGE_FRAGMENT_BIT, shader);
+            createInfo.stageCount           = 1;
+            createInfo.pStages              = &shaderStage;
+            createInfo.pMultisampleState    = &state.multisampling;
+            createInfo.layout               = layout;
+            createInfo.renderPass           = renderPass;
+            break;
+
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT:
+            createInfo.pMultisampleState    = &state.multisampling;
+            createInfo.pColorBlendState     = &state.colorBlending;
+            createInfo.renderPass           = renderPass;
+            break;
+
+        default:
+            fprintf(stderr, "%s : 传入了无效参数！未知的管线库部分（%u）.\n", __func__, part);
+            return VK_NULL_HANDLE;
+    }
+
+    return create_graphics_pipeline(device, pipelineCache, &createInfo);
+}
+
+
+VkPipeline linkGraphicsPipeline(
+    VkDevice            device,
+    VkPipelineCache     pipelineCache,
+    VkPipelineLayout    layout,
+    uint32_t            libraryCount,
+    const VkPipeline*   pLibraries,
+    bool                optimize
+)
+{
+    VkPipelineLibraryCreateInfoKHR libraryInfo = {};
+    libraryInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    libraryInfo.libraryCount    = libraryCount;
+    libraryInfo.pLibraries      = pLibraries;
+
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType    = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext    = &libraryInfo;
+    createInfo.flags    = optimize ? VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : 0;
+    createInfo.layout   = layout;
+
+    return create_graphics_pipeline(device, pipelineCache, &createInfo);
+}
+
+
+VkPipeline createComputePipeline(
+    VkDevice            device,
+    VkPipelineCache     pipelineCache,
+    VkPipelineLayout    layout,
+    VkShaderModule      computeShader
+)
+{
+    VkComputePipelineCreateInfo createInfo = {};
+    createInfo.sType    = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    createInfo.stage    = get_shader_stage(VK_SHADER_STAGE_COMPUTE_BIT, computeShader);
+    createInfo.layout   = layout;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult result = vkCreateComputePipelines(device, pipelineCache, 1, &createInfo,
+                          get_vulkan_allocator(), &pipeline);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a compute VkPipeline! Error Code(VkResult): %d\n", result);
+
+        return VK_NULL_HANDLE;
+    }
+
+    return pipeline;
+}
+
+
+void destroyPipeline(VkDevice device, VkPipeline pipeline)
+{
+    vkDestroyPipeline(device, pipeline, get_vulkan_allocator());
+}
+
+
+/// @brief 填充固定功能状态：无顶点输入，三角形列表，视口与裁剪矩形为动态状态，背面剔除，不混合.
+static void init_fixed_function_state(FixedFunctionState* pState)
+{
+    memset(pState, 0, sizeof(FixedFunctionState));
+
+    pState->vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;  // 顶点写在着色器中
+
+    pState->inputAssembly.sType     = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    pState->inputAssembly.topology  = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    pState->viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    pState->viewportState.viewportCount = 1;
+    pState->viewportState.scissorCount  = 1;
+
+    pState->rasterizer.sType        = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    pState->rasterizer.polygonMode  = VK_POLYGON_MODE_FILL;
+    pState->rasterizer.cullMode     = VK_CULL_MODE_BACK_BIT;
+    pState->rasterizer.frontFace    = VK_FRONT_FACE_CLOCKWISE;
+    pState->rasterizer.lineWidth    = 1.0f;
+
+    pState->multisampling.sType                 = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    pState->multisampling.rasterizationSamples  = VK_SAMPLE_COUNT_1_BIT;
+
+    pState->colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT
+                                                | VK_COLOR_COMPONENT_G_BIT
+                                                | VK_COLOR_COMPONENT_B_BIT
+                                                | VK_COLOR_COMPONENT_A_BIT;
+    pState->colorBlendAttachment.blendEnable    = VK_FALSE;
+
+    pState->colorBlending.sType             = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    pState->colorBlending.attachmentCount   = 1;
+    pState->colorBlending.pAttachments      = &pState->colorBlendAttachment;
+
+    pState->dynamicState.sType              = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    pState->dynamicState.dynamicStateCount  = sizeof(dynamicStates) / sizeof(dynamicStates[0]);
+    pState->dynamicState.pDynamicStates     = dynamicStates;
+}
+
+static VkPipelineShaderStageCreateInfo get_shader_stage(VkShaderStageFlagBits stage, VkShaderModule module)
+{
+    VkPipelineShaderStageCreateInfo shaderStage = {};
+    shaderStage.sType   = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStage.stage   = stage;
+    shaderStage.module  = module;
+    shaderStage.pName   = "main";
+
+    return shaderStage;
+}
+
+static VkPipeline create_graphics_pipeline(
+    VkDevice                            device,
+    VkPipelineCache                     pipelineCache,
+    const VkGraphicsPipelineCreateInfo* pCreateInfo
+)
+{
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult result = vkCreateGraphicsPipelines(device, 
+                          pipelineCache, 
+                          1, pCreateInfo, 
+                          get_vulkan_allocator(), 
+                          &pipeline);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a graphics VkPipeline! Error Code(VkResult): %d\n", result);
+
+        return VK_NULL_HANDLE;
+    }
+
+    return pipeline;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "../common/ansi_esc.h"
+#include "vulkan_wrapper.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/// @brief 内置着色器的 SPIR-V 字节码（构建时由 shaders 目录下的 GLSL 编译并嵌入）.
+typedef struct ShaderCode {
+    const uint32_t*     pCode;
+    size_t              size;       // 字节数
+} ShaderCode;
+
+
+/// @brief 获取内置三角形顶点着色器的 SPIR-V 字节码.
+ShaderCode get_triangle_vertex_shader_code(void);
+
+/// @brief 获取内置三角形片段着色器的 SPIR-V 字节码.
+ShaderCode get_triangle_fragment_shader_code(void);
+
+
+/// @brief 获取顶点拉取顶点着色器的 SPIR-V 字节码（需要 bufferDeviceAddress 特性）.
+ShaderCode get_mesh_pull_vertex_shader_code(void);
+
+/// @brief 获取经典网格顶点着色器的 SPIR-V 字节码（由顶点缓冲输入，见 createGraphicsPipeline 的 meshVertexInput）.
+ShaderCode get_mesh_vertex_shader_code(void);
+
+
+/// @brief 创建一个管线布局.
+///
+/// @param setLayoutCount 描述符集布局的数量
+/// @param pSetLayouts 描述符集布局数组（依次对应 set 0, 1, ...），数量为 0 时可以为 `NULL`
+/// @param pushConstantSize 推送常量的字节数，为 0 时不含推送常量
+/// @param pushConstantStages 可以访问推送常量的着色器阶段
+///
+/// @return 返回新创建的 VkPipelineLayout 句柄（当发生错误时返回 `NULL`）
+VkPipelineLayout createPipelineLayout(
+    VkDevice                        device,
+    uint32_t                        setLayoutCount,
+    const VkDescriptorSetLayout*    pSetLayouts,
+    uint32_t                        pushConstantSize,
+    VkShaderStageFlags              pushConstantStages
+);
+
+
+/// @brief 销毁给定的 VkPipelineLayout.
+void destroyPipelineLayout(VkDevice device, VkPipelineLayout pipelineLayout);
+
+
+/// @brief 创建绘制三角形的图形管线（视口与裁剪矩形为动态状态）.
+///
+/// @param pipelineCache 管线缓存，可以为 `NULL`
+/// @param layout 管线布局
+/// @param renderPass 管线要兼容的渲染通道（子通道 0）
+/// @param vertexShader 顶点着色器模块
+/// @param fragmentShader 片段着色器模块
+/// @param meshVertexInput 为 `true` 时从绑定 0 读取 PulledVertex 布局的顶点（位置、颜色各 3 个 float），
+/// 否则无顶点输入（顶点写在着色器中或由着色器拉取）
+///
+/// @return 返回新创建的 VkPipeline 句柄（当发生错误时返回 `NULL`）
+VkPipeline createGraphicsPipeline(
+    VkDevice            device,
+    VkPipelineCache     pipelineCache,
+    VkPipelineLayout    layout,
+    VkRenderPass        renderPass,
+    VkShaderModule      vertexShader,
+    VkShaderModule      fragmentShader,
+    bool                meshVertexInput
+);
+
+
+/// @brief 创建图形管线库的一个部分（与 createGraphicsPipeline 的状态相同，需要 graphicsPipelineLibrary 特性）.
+///
+/// 创建时保留链接时优化的信息，之后既可以快速链接，也可以优化链接.
+///
+/// @param part 顶点输入、预光栅化、片段着色器与片段输出之一（`VK_GRAPHICS_PIPELINE_LIBRARY_*_BIT_EXT`）
+/// @param layout 管线布局，顶点输入与片段输出部分不使用
+/// @param renderPass 管线要兼容的渲染通道（子通道 0），顶点输入部分不使用
+/// @param shader 预光栅化部分的顶点着色器或片段着色器部分的片段着色器，其他部分为 `NULL`
+///
+/// @return 返回新创建的管线库（当发生错误时返回 `NULL`）
+VkPipeline createPipelineLibraryPart(
+    VkDevice                            device,
+    VkPipelineCache                     pipelineCache,
+    VkGraphicsPipelineLibraryFlagsEXT   part,
+    VkPipelineLayout                    layout,
+    VkRenderPass                        renderPass,
+    VkShaderModule                      shader
+);
+
+
+/// @brief 由管线库链接出完整的图形管线.
+///
+/// @param pLibraries 顶点输入、预光栅化、片段着色器与片段输出四个部分
+/// @param optimize 为 `false` 时快速链接（不重新编译，可以立即使用）；为 `true` 时做链接时优化，
+/// 耗时接近 createGraphicsPipeline，但得到的管线与其一样快
+///
+/// @return 返回新创建的 VkPipeline 句柄（当发生错误时返回 `NULL`）
+VkPipeline linkGraphicsPipeline(
+    VkDevice            device,
+    VkPipelineCache     pipelineCache,
+    VkPipelineLayout    layout,
+    uint32_t            libraryCount,
+    const VkPipeline*   pLibraries,
+    bool                optimize
+);
+
+
+/// @brief 创建计算管线.
+///
+/// @param pipelineCache 管线缓存，可以为 `NULL`
+/// @param layout 管线布局
+/// @param computeShader 计算着色器模块（入口为 main）
+///
+/// @return 返回新创建的 VkPipeline 句柄（当发生错误时返回 `NULL`）
+VkPipeline createComputePipeline(
+    VkDevice            device,
+    VkPipelineCache     pipelineCache,
+    VkPipelineLayout    layout,
+    VkShaderModule      computeShader
+);
+
+
+/// @brief 销毁给定的 VkPipeline.
+void destroyPipeline(VkDevice device, VkPipeline pipeline);
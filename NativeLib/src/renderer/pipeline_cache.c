@@ -0,0 +1,166 @@
+#include "pipeline_cache.h"
+
+/// @brief VkPipelineCache 数据的头部（VK_PIPELINE_CACHE_HEADER_VERSION_ONE）.
+typedef struct PipelineCacheHeader {
+    uint32_t    headerSize;
+    uint32_t    headerVersion;
+    uint32_t    vendorID;
+    uint32_t    deviceID;
+    uint8_t     pipelineCacheUUID[VK_UUID_SIZE];
+} PipelineCacheHeader;
+
+static bool is_pipeline_cache_compatible(
+    VkPhysicalDevice    physicalDevice,
+    const void*         pData,
+    size_t              dataSize
+);
+
+
+void read_pipeline_cache_file(const char* path, PipelineCacheData* pCacheData)
+{
+    pCacheData->pData = NULL;
+    pCacheData->size = 0;
+
+    FILE* file = path != NULL ? fopen(path, "rb") : NULL;
+    if (file == NULL)
+        return;
+
+    if (fseek(file, 0, SEEK_END) == 0)
+    {
+        long fileSize = ftell(file);
+        if (fileSize > 0 && fseek(file, 0, SEEK_SET) == 0)
+        {
+            void* pData = malloc((size_t)fileSize);
+            if (pData != NULL && fread(pData, 1, (size_t)fileSize, file) == (size_t)fileSize)
+            {
+                pCacheData->pData = pData;
+                pCacheData->size = (size_t)fileSize;
+            }
+            else
+                free(pData);
+        }
+    }
+
+    fclose(file);
+}
+
+
+void free_pipeline_cache_data(PipelineCacheData* pCacheData)
+{
+    free(pCacheData->pData);
+    pCacheData->pData = NULL;
+    pCacheData->size = 0;
+}
+
+
+VkPipelineCache create_pipeline_cache(
+    VkPhysicalDevice            physicalDevice,
+    VkDevice                    device,
+    const PipelineCacheData*    pCacheData
+)
+{
+    // 1.与当前设备不兼容的数据直接丢弃
+    size_t dataSize = pCacheData != NULL ? pCacheData->size : 0;
+    if (dataSize > 0 && !is_pipeline_cache_compatible(physicalDevice, pCacheData->pData, dataSize))
+    {
+        fprintf(stdout, "%s : 管线缓存文件与当前设备不匹配，将重新生成.\n", __func__);
+        dataSize = 0;
+    }
+
+    // 2.创建管线缓存
+    VkPipelineCacheCreateInfo createInfo = {};
+    createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize  = dataSize;
+    createInfo.pInitialData     = dataSize > 0 ? pCacheData->pData : NULL;
+
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+    VkResult result = vkCreatePipelineCache(device, &createInfo, get_vulkan_allocator(), &pipelineCache);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkPipelineCache! Error Code(VkResult): %d\n", result);
+
+        return VK_NULL_HANDLE;
+    }
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "成功创建了一个 VkPipelineCache（初始数据 %zu 字节）！\n",
+        __DATE__, __TIME__, dataSize);
+
+    return pipelineCache;
+}
+
+
+VkPipelineCache load_pipeline_cache(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    const char*         path
+)
+{
+    PipelineCacheData cacheData;
+    read_pipeline_cache_file(path, &cacheData);
+
+    VkPipelineCache pipelineCache = create_pipeline_cache(physicalDevice, device, &cacheData);
+
+    free_pipeline_cache_data(&cacheData);
+
+    return pipelineCache;
+}
+
+
+bool save_pipeline_cache(VkDevice device, VkPipelineCache pipelineCache, const char* path)
+{
+    if (device == VK_NULL_HANDLE || pipelineCache == VK_NULL_HANDLE || path == NULL)
+        return false;
+
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(device, pipelineCache, &dataSize, NULL) != VK_SUCCESS
+        || dataSize == 0)
+        return false;
+
+    void* pData = malloc(dataSize);
+    if (pData == NULL)
+        return false;
+
+    bool saved = false;
+    if (vkGetPipelineCacheData(device, pipelineCache, &dataSize, pData) == VK_SUCCESS)
+    {
+        FILE* file = fopen(path, "wb");
+        if (file != NULL)
+        {
+            saved = fwrite(pData, 1, dataSize, file) == dataSize;
+            fclose(file);
+        }
+    }
+
+    free(pData);
+
+    if (!saved)
+        fprintf(stderr, "%s : 无法写入管线缓存文件 %s！\n", __func__, path);
+
+    return saved;
+}
+
+
+/// @brief 检查管线缓存数据的头部是否与给定物理设备匹配.
+static bool is_pipeline_cache_compatible(
+    VkPhysicalDevice    physicalDevice,
+    const void*         pData,
+    size_t              dataSize
+)
+{
+    if (dataSize < sizeof(PipelineCacheHeader))
+        return false;
+
+    PipelineCacheHeader header;
+    memcpy(&header, pData, sizeof(header));
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    return header.headerSize >= sizeof(PipelineCacheHeader)
+        && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+        && header.vendorID == properties.vendorID
+        && header.deviceID == properties.deviceID
+        && memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
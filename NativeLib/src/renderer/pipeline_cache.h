@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../common/ansi_esc.h"
+#include "vulkan_allocator.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief 管线缓存文件的默认路径（相对于工作目录）.
+#define PIPELINE_CACHE_FILE_PATH "pipeline_cache.bin"
+
+
+/// @brief 从磁盘读出的管线缓存文件内容.
+typedef struct PipelineCacheData {
+    void*       pData;
+    size_t      size;
+} PipelineCacheData;
+
+
+/// @brief 读取管线缓存文件的全部内容（文件不存在或读取失败时输出空数据）.
+///
+/// 该函数只做文件 I/O、不调用 Vulkan，可在设备创建完成前于工作线程上执行.
+///
+/// @param pCacheData 输出参数，接收文件内容（需调用 free_pipeline_cache_data 释放）
+void read_pipeline_cache_file(const char* path, PipelineCacheData* pCacheData);
+
+/// @brief 释放 read_pipeline_cache_file 读出的数据.
+void free_pipeline_cache_data(PipelineCacheData* pCacheData);
+
+/// @brief 以给定的初始数据创建 VkPipelineCache.
+///
+/// 数据头部与当前物理设备（vendorID / deviceID / pipelineCacheUUID）不匹配时，
+/// 会创建一个空的管线缓存.
+///
+/// @param pCacheData 初始数据，可为 `NULL`
+///
+/// @return 返回新创建的 VkPipelineCache 句柄（当发生错误时返回 `NULL`）
+VkPipelineCache create_pipeline_cache(
+    VkPhysicalDevice            physicalDevice,
+    VkDevice                    device,
+    const PipelineCacheData*    pCacheData
+);
+
+/// @brief 从磁盘读取管线缓存数据并创建 VkPipelineCache.
+///
+/// 文件不存在、读取失败或其头部与当前物理设备（vendorID / deviceID / pipelineCacheUUID）
+/// 不匹配时，会创建一个空的管线缓存.
+///
+/// @param path 缓存文件路径
+///
+/// @return 返回新创建的 VkPipelineCache 句柄（当发生错误时返回 `NULL`）
+VkPipelineCache load_pipeline_cache(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    const char*         path
+);
+
+/// @brief 将管线缓存数据写入磁盘.
+///
+/// @return 写入成功时返回 `true`
+bool save_pipeline_cache(VkDevice device, VkPipelineCache pipelineCache, const char* path);
@@ -0,0 +1,278 @@
+#include "pipeline_library.h"
+
+#include <string.h>
+
+static bool create_library(PipelineLibraryCache* pCache, VkRenderPass renderPass, PipelineLibrary* pLibrary);
+static void destroy_library(VkDevice device, PipelineLibrary* pLibrary);
+static VkPipeline create_shader_part(
+    PipelineLibraryCache*               pCache,
+    VkGraphicsPipelineLibraryFlagsEXT   part,
+    VkRenderPass                        renderPass,
+    ShaderCode                          code
+);
+static void optimized_link_task(void* pArg);
+
+
+void create_pipeline_library_cache(
+    VkDevice                device,
+    VkPipelineCache         pipelineCache,
+    VkPipelineLayout        pipelineLayout,
+    bool                    enabled,
+    bool                    meshPipelines,
+    PipelineLibraryCache*   pCache
+)
+{
+    memset(pCache, 0, sizeof(PipelineLibraryCache));
+
+    pCache->enabled         = enabled;
+    pCache->meshPipelines   = meshPipelines;
+    pCache->device          = device;
+    pCache->pipelineCache   = pipelineCache;
+    pCache->pipelineLayout  = pipelineLayout;
+
+    mutex_init(&pCache->mutex);
+}
+
+
+void destroy_pipeline_library_cache(PipelineLibraryCache* pCache)
+{
+    if (pCache->device == VK_NULL_HANDLE)           // 未初始化
+        return;
+
+    for (uint32_t i = 0; i < pCache->libraryCount; i++)
+        destroy_library(pCache->device, &pCache->libraries[i]);
+
+    mutex_destroy(&pCache->mutex);
+    memset(pCache, 0, sizeof(PipelineLibraryCache));
+}
+
+
+const PipelineLibrary* pipeline_library_get(
+    PipelineLibraryCache*   pCache,
+    VkFormat                colorFormat,
+    VkRenderPass            renderPass
+)
+{
+    if (!pCache->enabled)
+        return NULL;
+
+    mutex_lock(&pCache->mutex);
+
+    PipelineLibrary* pLibrary = NULL;
+    for (uint32_t i = 0; i < pCache->libraryCount && pLibrary == NULL; i++)
+    {
+        if (pCache->libraries[i].colorFormat == colorFormat)
+            pLibrary = &pCache->libraries[i];
+    }
+
+    // 首次使用该格式时创建（持有锁，另一个线程请求同一格式时等待而不是重复编译）
+    if (pLibrary == NULL && pCache->libraryCount >= PIPELINE_LIBRARY_MAX_FORMATS)
+        fprintf(stderr, "%s : 管线库缓存已满（%u 种格式）！\n", __func__, PIPELINE_LIBRARY_MAX_FORMATS);
+    else if (pLibrary == NULL)
+    {
+        pLibrary = &pCache->libraries[pCache->libraryCount];
+        pLibrary->colorFormat = colorFormat;
+        if (create_library(pCache, renderPass, pLibrary))
+            pCache->libraryCount++;
+        else
+        {
+            destroy_library(pCache->device, pLibrary);
+            pLibrary = NULL;
+        }
+    }
+
+    mutex_unlock(&pCache->mutex);
+
+    return pLibrary;
+}
+
+
+bool pipeline_library_fast_link(
+    const PipelineLibraryCache* pCache,
+    const PipelineLibrary*      pLibrary,
+    VkPipeline*                 pTrianglePipeline,
+    VkPipeline*                 pMeshPipeline
+)
+{
+    *pTrianglePipeline  = pipeline_library_link(pCache, pLibrary, pLibrary->triangleVertex, false);
+    *pMeshPipeline      = VK_NULL_HANDLE;
+    if (*pTrianglePipeline == VK_NULL_HANDLE)
+        return false;
+
+    *pMeshPipeline = pipeline_library_link(pCache, pLibrary, pLibrary->meshVertex, false);
+
+    return true;
+}
+
+
+VkPipeline pipeline_library_link(
+    const PipelineLibraryCache* pCache,
+    const PipelineLibrary*      pLibrary,
+    VkPipeline                  vertexPart,
+    bool                        optimize
+)
+{
+    if (vertexPart == VK_NULL_HANDLE)
+        return VK_NULL_HANDLE;
+
+    VkPipeline libraries[] = {
+        pLibrary->vertexInput,
+        vertexPart,
+        pLibrary->fragmentShader,
+        pLibrary->fragmentOutput
+    };
+
+    return linkGraphicsPipeline(pCache->device,
+               pCache->pipelineCache,
+               pCache->pipelineLayout,
+               sizeof(libraries) / sizeof(libraries[0]),
+               libraries,
+               optimize);
+}
+
+
+void pipeline_library_link_async(
+    JobSystem*                  pJobs,
+    const PipelineLibraryCache* pCache,
+    const PipelineLibrary*      pLibrary,
+    PipelineLinkJob*            pJob
+)
+{
+    pJob->pCache            = pCache;
+    pJob->pLibrary          = pLibrary;
+    pJob->trianglePipeline  = VK_NULL_HANDLE;
+    pJob->meshPipeline      = VK_NULL_HANDLE;
+    pJob->pending           = true;
+
+    job_system_run(pJobs, optimized_link_task, pJob, &pJob->counter);
+}
+
+
+bool pipeline_link_job_take(
+    PipelineLinkJob*    pJob,
+    VkPipeline*         pTrianglePipeline,
+    VkPipeline*         pMeshPipeline
+)
+{
+    if (!pJob->pending || !job_counter_done(&pJob->counter))
+        return false;
+
+    *pTrianglePipeline  = pJob->trianglePipeline;
+    *pMeshPipeline      = pJob->meshPipeline;
+
+    pJob->trianglePipeline  = VK_NULL_HANDLE;
+    pJob->meshPipeline      = VK_NULL_HANDLE;
+    pJob->pending           = false;
+
+    return true;
+}
+
+
+void pipeline_link_job_cancel(JobSystem* pJobs, PipelineLinkJob* pJob)
+{
+    if (!pJob->pending)
+        return;
+
+    job_system_wait(pJobs, &pJob->counter);
+
+    if (pJob->trianglePipeline != VK_NULL_HANDLE)
+        destroyPipeline(pJob->pCache->device, pJob->trianglePipeline);
+    if (pJob->meshPipeline != VK_NULL_HANDLE)
+        destroyPipeline(pJob->pCache->device, pJob->meshPipeline);
+
+    pJob->trianglePipeline  = VK_NULL_HANDLE;
+    pJob->meshPipeline      = VK_NULL_HANDLE;
+    pJob->pending           = false;
+}
+
+
+/// @brief 创建一种格式的四个部分（顶点拉取的预光栅化部分创建失败时只是不能链接顶点拉取管线）.
+static bool create_library(PipelineLibraryCache* pCache, VkRenderPass renderPass, PipelineLibrary* pLibrary)
+{
+    pLibrary->vertexInput = createPipelineLibraryPart(pCache->device,
+                                pCache->pipelineCache,
+                                VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+                                VK_NULL_HANDLE,
+                                VK_NULL_HANDLE,
+                                VK_NULL_HANDLE);
+
+    pLibrary->triangleVertex = create_shader_part(pCache,
+                                   VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+                                   renderPass,
+                                   get_triangle_vertex_shader_code());
+
+    if (pCache->meshPipelines)
+        pLibrary->meshVertex = create_shader_part(pCache,
+                                   VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+                                   renderPass,
+                                   get_mesh_pull_vertex_shader_code());
+
+    pLibrary->fragmentShader = create_shader_part(pCache,
+                                   VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+                                   renderPass,
+                                   get_triangle_fragment_shader_code());
+
+    pLibrary->fragmentOutput = createPipelineLibraryPart(pCache->device,
+                                   pCache->pipelineCache,
+                                   VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+                                   VK_NULL_HANDLE,
+                                   renderPass,
+                                   VK_NULL_HANDLE);
+
+    return pLibrary->vertexInput != VK_NULL_HANDLE
+        && pLibrary->triangleVertex != VK_NULL_HANDLE
+        && pLibrary->fragmentShader != VK_NULL_HANDLE
+        && pLibrary->fragmentOutput != VK_NULL_HANDLE;
+}
+
+static void destroy_library(VkDevice device, PipelineLibrary* pLibrary)
+{
+    VkPipeline* parts[] = {
+        &pLibrary->vertexInput,
+        &pLibrary->triangleVertex,
+        &pLibrary->meshVertex,
+        &pLibrary->fragmentShader,
+        &pLibrary->fragmentOutput
+    };
+
+    for (uint32_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++)
+    {
+        if (*parts[i] != VK_NULL_HANDLE)
+            destroyPipeline(device, *parts[i]);
+
+        *parts[i] = VK_NULL_HANDLE;
+    }
+}
+
+/// @brief 由内置着色器创建预光栅化或片段着色器部分（着色器模块在创建后即可销毁）.
+static VkPipeline create_shader_part(
+    PipelineLibraryCache*               pCache,
+    VkGraphicsPipelineLibraryFlagsEXT   part,
+    VkRenderPass                        renderPass,
+    ShaderCode                          code
+)
+{
+    VkShaderModule shader = createShaderModule(pCache->device, code.pCode, code.size);
+    if (shader == VK_NULL_HANDLE)
+        return VK_NULL_HANDLE;
+
+    VkPipeline pipeline = createPipelineLibraryPart(pCache->device,
+                              pCache->pipelineCache,
+                              part,
+                              pCache->pipelineLayout,
+                              renderPass,
+                              shader);
+
+    destroyShaderModule(pCache->device, shader);
+
+    return pipeline;
+}
+
+/// @brief 优化链接任务的入口，只写入 `pJob` 的结果.
+static void optimized_link_task(void* pArg)
+{
+    PipelineLinkJob* pJob = (PipelineLinkJob*)pArg;
+
+    pJob->trianglePipeline  = pipeline_library_link(pJob->pCache, pJob->pLibrary, pJob->pLibrary->triangleVertex, true);
+    pJob->meshPipeline      = pipeline_library_link(pJob->pCache, pJob->pLibrary, pJob->pLibrary->meshVertex, true);
+}
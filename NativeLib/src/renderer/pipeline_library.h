@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../common/job_system.h"
+#include "vulkan_wrapper.h"
+#include "pipeline.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 最多缓存的颜色格式数（每种格式一组管线库部分）.
+#define PIPELINE_LIBRARY_MAX_FORMATS    8
+
+/// @brief 一种颜色格式的管线库部分.
+///
+/// 渲染通道只含一个颜色附件，格式相同的渲染通道彼此兼容，因此各表面（以及重建后的渲染通道）
+/// 按颜色格式共用这些部分.
+typedef struct PipelineLibrary {
+    VkFormat            colorFormat;
+    VkPipeline          vertexInput;
+    VkPipeline          triangleVertex;         // 预光栅化部分：三角形顶点着色器
+    VkPipeline          meshVertex;             // 预光栅化部分：顶点拉取顶点着色器，不支持时为 NULL
+    VkPipeline          fragmentShader;
+    VkPipeline          fragmentOutput;
+} PipelineLibrary;
+
+/// @brief 按颜色格式缓存的管线库部分.
+///
+/// 新的表面管线由这些部分快速链接（不重新编译着色器），随即可以绘制；同时在工作线程上
+/// 做一次链接时优化，完成后替换快速链接的管线.
+///
+/// pipeline_library_get 可以在多个线程上调用（表面管线的创建与启动时的预编译可能同时进行），
+/// 部分创建完成后才对其他线程可见，之后不再改变.
+typedef struct PipelineLibraryCache {
+    bool                enabled;                // 设备启用了 graphicsPipelineLibrary 特性
+    bool                meshPipelines;          // 是否创建顶点拉取的预光栅化部分
+    VkDevice            device;
+    VkPipelineCache     pipelineCache;
+    VkPipelineLayout    pipelineLayout;
+
+    Mutex               mutex;                  // 保护查找与创建
+
+    PipelineLibrary     libraries[PIPELINE_LIBRARY_MAX_FORMATS];
+    uint32_t            libraryCount;
+} PipelineLibraryCache;
+
+/// @brief 一次后台的优化链接.
+///
+/// 由调用者持有（地址在任务完成前不能改变），结果由 pipeline_link_job_take 取走.
+typedef struct PipelineLinkJob {
+    const PipelineLibraryCache* pCache;
+    const PipelineLibrary*      pLibrary;
+    VkPipeline                  trianglePipeline;   // 优化链接的结果，失败时为 NULL
+    VkPipeline                  meshPipeline;
+    JobCounter                  counter;
+    bool                        pending;            // 已提交、结果尚未被取走或丢弃
+} PipelineLinkJob;
+
+
+/// @brief 初始化管线库缓存（此时还不创建任何部分）.
+///
+/// @param enabled 设备是否启用了 graphicsPipelineLibrary 特性，为 `false` 时 pipeline_library_get 总是返回 `NULL`
+/// @param meshPipelines 是否同时为顶点拉取管线创建预光栅化部分
+void create_pipeline_library_cache(
+    VkDevice                device,
+    VkPipelineCache         pipelineCache,
+    VkPipelineLayout        pipelineLayout,
+    bool                    enabled,
+    bool                    meshPipelines,
+    PipelineLibraryCache*   pCache
+);
+
+/// @brief 销毁所有管线库部分（由它们链接出的管线不受影响）.
+void destroy_pipeline_library_cache(PipelineLibraryCache* pCache);
+
+/// @brief 取出颜色格式对应的管线库部分，首次使用该格式时由内置着色器创建.
+///
+/// @param renderPass 格式为 `colorFormat` 的渲染通道，创建部分时使用
+///
+/// @return 管线库部分，未启用、缓存已满或创建失败时返回 `NULL`（此时应改用完整的管线创建）
+const PipelineLibrary* pipeline_library_get(
+    PipelineLibraryCache*   pCache,
+    VkFormat                colorFormat,
+    VkRenderPass            renderPass
+);
+
+/// @brief 快速链接出三角形管线与顶点拉取管线.
+///
+/// @param pMeshPipeline 没有顶点拉取部分或其链接失败时写入 `NULL`
+///
+/// @return 三角形管线链接成功时返回 `true`，否则两个管线都为 `NULL`
+bool pipeline_library_fast_link(
+    const PipelineLibraryCache* pCache,
+    const PipelineLibrary*      pLibrary,
+    VkPipeline*                 pTrianglePipeline,
+    VkPipeline*                 pMeshPipeline
+);
+
+/// @brief 以给定的预光栅化部分（`triangleVertex` 或 `meshVertex`）与其余三个部分链接出完整的管线.
+///
+/// @param optimize 是否做链接时优化
+///
+/// @return 链接出的管线，`vertexPart` 为 `NULL` 或链接失败时返回 `NULL`
+VkPipeline pipeline_library_link(
+    const PipelineLibraryCache* pCache,
+    const PipelineLibrary*      pLibrary,
+    VkPipeline                  vertexPart,
+    bool                        optimize
+);
+
+/// @brief 在工作线程上对同一组部分做链接时优化（`pJob` 上一次的结果需已被取走或丢弃）.
+void pipeline_library_link_async(
+    JobSystem*                  pJobs,
+    const PipelineLibraryCache* pCache,
+    const PipelineLibrary*      pLibrary,
+    PipelineLinkJob*            pJob
+);
+
+/// @brief 若优化链接已完成则取走其结果，不会阻塞.
+///
+/// @return 取走了结果时返回 `true`（链接失败的管线为 `NULL`），尚未完成或没有提交时返回 `false`
+bool pipeline_link_job_take(
+    PipelineLinkJob*    pJob,
+    VkPipeline*         pTrianglePipeline,
+    VkPipeline*         pMeshPipeline
+);
+
+/// @brief 等待优化链接完成并销毁其结果（表面的管线被销毁前调用）.
+void pipeline_link_job_cancel(JobSystem* pJobs, PipelineLinkJob* pJob);
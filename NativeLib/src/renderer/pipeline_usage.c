@@ -0,0 +1,87 @@
+#include "pipeline_usage.h"
+
+#include <string.h>
+
+/// @brief 记录文件的头部，其后紧跟 `count` 个 PipelineKey.
+typedef struct PipelineUsageHeader {
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    count;
+} PipelineUsageHeader;
+
+#define PIPELINE_USAGE_MAGIC        0x55534F50u     // "PSOU"
+#define PIPELINE_USAGE_VERSION      1
+
+
+void read_pipeline_usage_file(const char* path, PipelineUsageLog* pLog)
+{
+    memset(pLog, 0, sizeof(PipelineUsageLog));
+
+    FILE* file = path != NULL ? fopen(path, "rb") : NULL;
+    if (file == NULL)
+        return;
+
+    PipelineUsageHeader header;
+    if (fread(&header, sizeof(header), 1, file) == 1
+        && header.magic == PIPELINE_USAGE_MAGIC
+        && header.version == PIPELINE_USAGE_VERSION
+        && header.count <= PIPELINE_USAGE_MAX_KEYS
+        && fread(pLog->keys, sizeof(PipelineKey), header.count, file) == header.count)
+    {
+        // 丢弃本版本不认识的种类
+        for (uint32_t i = 0; i < header.count; i++)
+        {
+            if (pLog->keys[i].kind < PIPELINE_KIND_COUNT)
+                pLog->keys[pLog->count++] = pLog->keys[i];
+        }
+        pLog->loadedCount = pLog->count;
+    }
+    else
+        memset(pLog, 0, sizeof(PipelineUsageLog));
+
+    fclose(file);
+}
+
+
+void pipeline_usage_record(PipelineUsageLog* pLog, PipelineKind kind, VkFormat colorFormat)
+{
+    for (uint32_t i = 0; i < pLog->count; i++)
+    {
+        if (pLog->keys[i].kind == (uint32_t)kind && pLog->keys[i].colorFormat == (uint32_t)colorFormat)
+            return;
+    }
+
+    if (pLog->count >= PIPELINE_USAGE_MAX_KEYS)
+        return;
+
+    pLog->keys[pLog->count].kind        = (uint32_t)kind;
+    pLog->keys[pLog->count].colorFormat = (uint32_t)colorFormat;
+    pLog->count++;
+}
+
+
+bool save_pipeline_usage_file(const PipelineUsageLog* pLog, const char* path)
+{
+    if (pLog->count == pLog->loadedCount)
+        return true;
+
+    PipelineUsageHeader header = {
+        .magic      = PIPELINE_USAGE_MAGIC,
+        .version    = PIPELINE_USAGE_VERSION,
+        .count      = pLog->count
+    };
+
+    bool saved = false;
+    FILE* file = path != NULL ? fopen(path, "wb") : NULL;
+    if (file != NULL)
+    {
+        saved = fwrite(&header, sizeof(header), 1, file) == 1
+             && fwrite(pLog->keys, sizeof(PipelineKey), pLog->count, file) == pLog->count;
+        fclose(file);
+    }
+
+    if (!saved)
+        fprintf(stderr, "%s : 无法写入管线使用记录文件 %s！\n", __func__, path);
+
+    return saved;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 管线使用记录文件的默认路径（相对于工作目录）.
+#define PIPELINE_USAGE_FILE_PATH    "pipeline_usage.bin"
+/// @brief 最多记录的管线键数.
+#define PIPELINE_USAGE_MAX_KEYS     64
+
+/// @brief 表面管线的种类（决定顶点着色器）.
+typedef enum PipelineKind {
+    PIPELINE_KIND_TRIANGLE = 0,
+    PIPELINE_KIND_MESH_PULL,
+    PIPELINE_KIND_COUNT
+} PipelineKind;
+
+/// @brief 一个管线状态键：其余状态（固定功能状态、管线布局、片段着色器）所有表面管线都相同，
+/// 渲染通道只由颜色格式决定兼容性.
+///
+/// 即记录文件中的一项（8 字节）.
+typedef struct PipelineKey {
+    uint32_t            kind;                   // PipelineKind
+    uint32_t            colorFormat;            // VkFormat
+} PipelineKey;
+
+/// @brief 实际使用过的管线键，按首次使用的顺序排列.
+///
+/// 启动时读出上一次运行的记录并在其后追加，因此顺序在多次运行之间保持不变；
+/// 预编译按该顺序提交，越早用到的管线越先编译完成.
+typedef struct PipelineUsageLog {
+    PipelineKey         keys[PIPELINE_USAGE_MAX_KEYS];
+    uint32_t            count;
+    uint32_t            loadedCount;            // 从文件读出的键数，之后新增的键才需要写回
+} PipelineUsageLog;
+
+
+/// @brief 读取管线使用记录文件（文件不存在、读取失败或格式不符时输出空记录）.
+///
+/// 该函数只做文件 I/O、不调用 Vulkan，可在设备创建完成前于工作线程上执行.
+void read_pipeline_usage_file(const char* path, PipelineUsageLog* pLog);
+
+/// @brief 记录一次管线的使用（已记录过的键不会重复加入）.
+void pipeline_usage_record(PipelineUsageLog* pLog, PipelineKind kind, VkFormat colorFormat);
+
+/// @brief 有新增的键时把记录写入磁盘.
+///
+/// @return 写入成功或无需写入时返回 `true`
+bool save_pipeline_usage_file(const PipelineUsageLog* pLog, const char* path);
@@ -7,7 +7,8 @@ static QueueFamilyIndices init_QueueFamilyIndices()
     QueueFamilyIndices queueFamilyIndices = 
     {
         .graphicsSupport        = -1,   
-        .presentationSupport    = -1
+        .presentationSupport    = -1,
+        .asyncComputeSupport    = -1
     };
 
     return queueFamilyIndices;
@@ -40,8 +41,14 @@ QueueFamilyIndices find_queue_families(
         // 检查其队列 flags
         if (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
             queueFamilyIndices.graphicsSupport = i;
+        else if (queueFamilies[i].queueFlags & VK_QUEUE_COMPUTE_BIT
+            && queueFamilyIndices.asyncComputeSupport < 0)
+            queueFamilyIndices.asyncComputeSupport = i;     // 取第一个，通常即硬件的异步计算引擎
+
+        // 检查其是否支持呈现（无头模式下没有 Surface，不检查）
+        if (surface == VK_NULL_HANDLE)
+            continue;
 
-        // 检查其是否支持呈现
         VkBool32 supportsPresentation = VK_FALSE;
         vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice,
             i,
@@ -78,11 +85,16 @@ bool has_queue_family_supports_both_graphics_and_presentation(
 
         if (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
         {
-            VkBool32 supportsPresentation = VK_FALSE;
-            vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice,
-                i,
-                surface,
-                &supportsPresentation);
+            // 无头模式下没有 Surface，视为支持
+            VkBool32 supportsPresentation = 
+                surface == VK_NULL_HANDLE ? VK_TRUE : VK_FALSE;
+            if (surface != VK_NULL_HANDLE)
+            {
+                vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice,
+                    i,
+                    surface,
+                    &supportsPresentation);
+            }
             
             // 找到符合条件的马上设置传入队列族索引并返回 true
             if (supportsPresentation == VK_TRUE)
@@ -98,5 +110,5 @@ bool has_queue_family_supports_both_graphics_and_presentation(
     if (queueFamilyIndex != NULL)
         *queueFamilyIndex = -1;     // 设为 -1 表未找到
     
-        return false;
+    return false;
 }
\ No newline at end of file
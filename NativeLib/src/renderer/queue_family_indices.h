@@ -1,6 +1,7 @@
 #pragma once
 
-#include <vulkan/vulkan.h>
+#include "vulkan_loader.h"
+
 #include <stdbool.h>
 
 /// @brief 该结构体定义物理设备拥有的队列族类型及其索引, 以作为 选取物理设备 \ 创建队列
@@ -12,6 +13,7 @@
 typedef struct QueueFamilyIndices {
     int graphicsSupport;        // 支持 图形
     int presentationSupport;    // 支持 呈现
+    int asyncComputeSupport;    // 支持 计算但不支持图形（专用于异步计算的队列族）
 } QueueFamilyIndices;
 
 
@@ -0,0 +1,319 @@
+#include "readback.h"
+
+static ReadbackSlot* find_slot(ReadbackRing* pRing, uint64_t ticket);
+static uint32_t get_format_texel_size(VkFormat format);
+static bool ensure_slot_capacity(
+    ReadbackSlot*       pSlot,
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    VkDeviceSize        size
+);
+
+
+uint64_t readback_request(ReadbackRing* pRing)
+{
+    for (uint32_t i = 0; i < READBACK_RING_SIZE; i++)
+    {
+        ReadbackSlot* pSlot = &pRing->slots[i];
+        if (pSlot->state != READBACK_SLOT_FREE)
+            continue;
+
+        pSlot->state    = READBACK_SLOT_PENDING;
+        pSlot->ticket   = ++pRing->nextTicket;
+        pSlot->serial   = 0;
+
+        return pSlot->ticket;
+    }
+
+    return 0;   // 环形缓冲已满
+}
+
+
+void readback_record_copies(
+    ReadbackRing*       pRing,
+    Arena*              pFrameArena,
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    VkCommandBuffer     commandBuffer,
+    VkImage             image,
+    VkImageLayout       layout,
+    VkFormat            format,
+    VkExtent2D          extent,
+    uint64_t            serial
+)
+{
+    uint32_t texelSize = get_format_texel_size(format);
+    if (texelSize == 0)
+    {
+        fprintf(stderr, "%s : 不支持回读该图像格式（%d）！\n", __func__, format);
+        return;
+    }
+
+    uint32_t rowPitch = extent.width * texelSize;
+    VkDeviceSize size = (VkDeviceSize)rowPitch * extent.height;
+
+    // 0.收集本帧要录制拷贝的槽位，所有槽位共用一组布局转换
+    ReadbackSlot** ppSlots = (ReadbackSlot**)arena_alloc(pFrameArena,
+                                 READBACK_RING_SIZE * sizeof(ReadbackSlot*),
+                                 _Alignof(ReadbackSlot*));
+    if (ppSlots == NULL)
+        return;     // 保持 PENDING，下一帧重试
+
+    uint32_t slotCount = 0;
+    for (uint32_t i = 0; i < READBACK_RING_SIZE; i++)
+    {
+        ReadbackSlot* pSlot = &pRing->slots[i];
+        if (pSlot->state != READBACK_SLOT_PENDING)
+            continue;
+
+        if (!ensure_slot_capacity(pSlot, physicalDevice, device, size))
+            continue;   // 保持 PENDING，下一帧重试
+
+        ppSlots[slotCount++] = pSlot;
+    }
+
+    if (slotCount == 0)
+        return;
+
+    VkBufferMemoryBarrier* pHostBarriers = (VkBufferMemoryBarrier*)
+        arena_calloc(pFrameArena, slotCount, sizeof(VkBufferMemoryBarrier));
+    if (pHostBarriers == NULL)
+        return;
+
+    // 1.布局转换：layout -> TRANSFER_SRC
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask                   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.oldLayout                       = layout;
+    barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image                           = image;
+    barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount     = 1;
+    barrier.subresourceRange.layerCount     = 1;
+
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, NULL, 0, NULL, 1, &barrier);
+
+    // 2.拷贝到各槽位的回读缓冲（紧密排列）
+    VkBufferImageCopy region = {};
+    region.bufferOffset                     = 0;
+    region.bufferRowLength                  = 0;
+    region.bufferImageHeight                = 0;
+    region.imageSubresource.aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount      = 1;
+    region.imageExtent.width                = extent.width;
+    region.imageExtent.height               = extent.height;
+    region.imageExtent.depth                = 1;
+
+    for (uint32_t i = 0; i < slotCount; i++)
+    {
+        ReadbackSlot* pSlot = ppSlots[i];
+
+        vkCmdCopyImageToBuffer(commandBuffer,
+            image,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            pSlot->buffer,
+            1, &region);
+
+        VkBufferMemoryBarrier* pHostBarrier = &pHostBarriers[i];
+        pHostBarrier->sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        pHostBarrier->srcAccessMask         = VK_ACCESS_TRANSFER_WRITE_BIT;
+        pHostBarrier->dstAccessMask         = VK_ACCESS_HOST_READ_BIT;
+        pHostBarrier->srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+        pHostBarrier->dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+        pHostBarrier->buffer                = pSlot->buffer;
+        pHostBarrier->offset                = 0;
+        pHostBarrier->size                  = VK_WHOLE_SIZE;
+
+        pSlot->state    = READBACK_SLOT_IN_FLIGHT;
+        pSlot->serial   = serial;
+        pSlot->width    = extent.width;
+        pSlot->height   = extent.height;
+        pSlot->rowPitch = rowPitch;
+        pSlot->format   = format;
+    }
+
+    // 3.布局转换：TRANSFER_SRC -> layout，并让主机可以读取所有回读缓冲
+    barrier.srcAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.dstAccessMask   = 0;
+    barrier.oldLayout       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.newLayout       = layout;
+
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+        0, 0, NULL, slotCount, pHostBarriers, 1, &barrier);
+}
+
+
+bool readback_map(
+    ReadbackRing*   pRing,
+    VkDevice        device,
+    uint64_t        ticket,
+    uint64_t        completedSerial,
+    ReadbackInfo*   pInfo
+)
+{
+    ReadbackSlot* pSlot = find_slot(pRing, ticket);
+    if (pSlot == NULL || pInfo == NULL)
+        return false;
+
+    if (pSlot->state == READBACK_SLOT_IN_FLIGHT && pSlot->serial <= completedSerial)
+    {
+        // 非一致性内存需要先使主机缓存失效
+        if (!pSlot->coherent)
+        {
+            VkMappedMemoryRange range = {};
+            range.sType     = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+            range.memory    = pSlot->memory;
+            range.offset    = 0;
+            range.size      = VK_WHOLE_SIZE;
+            vkInvalidateMappedMemoryRanges(device, 1, &range);
+        }
+
+        pSlot->state = READBACK_SLOT_READY;
+    }
+
+    if (pSlot->state != READBACK_SLOT_READY)
+        return false;
+
+    pInfo->pData    = pSlot->pMapped;
+    pInfo->size     = (uint64_t)pSlot->rowPitch * pSlot->height;
+    pInfo->width    = pSlot->width;
+    pInfo->height   = pSlot->height;
+    pInfo->rowPitch = pSlot->rowPitch;
+    pInfo->format   = (uint32_t)pSlot->format;
+
+    return true;
+}
+
+
+void readback_release(ReadbackRing* pRing, uint64_t ticket)
+{
+    ReadbackSlot* pSlot = find_slot(pRing, ticket);
+    if (pSlot == NULL)
+        return;
+
+    // 仍在途的槽位不能被复用（GPU 可能仍在写入），需等待其就绪后再释放
+    if (pSlot->state == READBACK_SLOT_IN_FLIGHT)
+    {
+        fprintf(stderr, "%s : 回读请求（%llu）仍在途，无法释放！\n",
+            __func__, (unsigned long long)ticket);
+        return;
+    }
+
+    pSlot->state    = READBACK_SLOT_FREE;
+    pSlot->ticket   = 0;
+}
+
+
+void destroy_readback_ring(VkDevice device, ReadbackRing* pRing)
+{
+    if (device == VK_NULL_HANDLE || pRing == NULL)
+        return;
+
+    for (uint32_t i = 0; i < READBACK_RING_SIZE; i++)
+    {
+        ReadbackSlot* pSlot = &pRing->slots[i];
+
+        if (pSlot->pMapped != NULL)
+            vkUnmapMemory(device, pSlot->memory);
+
+        destroyBuffer(device, pSlot->buffer, pSlot->memory);
+
+        memset(pSlot, 0, sizeof(ReadbackSlot));
+    }
+}
+
+
+static ReadbackSlot* find_slot(ReadbackRing* pRing, uint64_t ticket)
+{
+    if (pRing == NULL || ticket == 0)
+        return NULL;
+
+    for (uint32_t i = 0; i < READBACK_RING_SIZE; i++)
+    {
+        if (pRing->slots[i].ticket == ticket)
+            return &pRing->slots[i];
+    }
+
+    return NULL;
+}
+
+/// @brief 获取常见颜色格式每个像素的字节数.
+///
+/// @return 字节数，不支持的格式返回 0
+static uint32_t get_format_texel_size(VkFormat format)
+{
+    switch (format)
+    {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            return 4;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+/// @brief 确保槽位缓冲容量不小于 `size`，不足时重新创建并常驻映射.
+///
+/// 优先选择 HOST_CACHED 内存（主机端读取更快），不可用时静默回退到 HOST_COHERENT.
+static bool ensure_slot_capacity(
+    ReadbackSlot*       pSlot,
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    VkDeviceSize        size
+)
+{
+    if (pSlot->buffer != VK_NULL_HANDLE && pSlot->capacity >= size)
+        return true;
+
+    if (pSlot->pMapped != NULL)
+        vkUnmapMemory(device, pSlot->memory);
+    destroyBuffer(device, pSlot->buffer, pSlot->memory);
+
+    pSlot->buffer   = VK_NULL_HANDLE;
+    pSlot->memory   = VK_NULL_HANDLE;
+    pSlot->pMapped  = NULL;
+    pSlot->capacity = 0;
+
+    bool created = createHostReadableBuffer(physicalDevice, device, size,
+                       VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                       MEMORY_CATEGORY_STAGING,
+                       0, NULL,
+                       &pSlot->coherent,
+                       &pSlot->buffer, &pSlot->memory);
+    if (!created)
+    {
+        fprintf(stderr, "%s : 无法为回读槽位分配主机可见缓冲！\n", __func__);
+        return false;
+    }
+
+    VkResult result = vkMapMemory(device, pSlot->memory, 0, VK_WHOLE_SIZE, 0,
+                          &pSlot->pMapped);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to map readback memory! Error Code(VkResult): %d\n", result);
+
+        destroyBuffer(device, pSlot->buffer, pSlot->memory);
+        pSlot->buffer = VK_NULL_HANDLE;
+        pSlot->memory = VK_NULL_HANDLE;
+        pSlot->pMapped = NULL;
+
+        return false;
+    }
+
+    pSlot->capacity = size;
+
+    return true;
+}
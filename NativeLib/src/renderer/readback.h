@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../common/ansi_esc.h"
+#include "vulkan_wrapper.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 回读环形缓冲的槽位数量，即同时可以存在的未释放回读请求数.
+#define READBACK_RING_SIZE 3
+
+typedef enum ReadbackSlotState {
+    READBACK_SLOT_FREE = 0,     // 空闲
+    READBACK_SLOT_PENDING,      // 已请求，等待在帧末尾录制拷贝命令
+    READBACK_SLOT_IN_FLIGHT,    // 拷贝命令已提交，等待 GPU 完成
+    READBACK_SLOT_READY         // 拷贝完成，数据可以在主机端读取
+} ReadbackSlotState;
+
+/// @brief 一个回读槽位，持有一块常驻映射的主机可见缓冲.
+typedef struct ReadbackSlot {
+    VkBuffer            buffer;
+    VkDeviceMemory      memory;
+    VkDeviceSize        capacity;
+    void*               pMapped;
+    bool                coherent;       // 内存是否为 HOST_COHERENT
+
+    ReadbackSlotState   state;
+    uint64_t            ticket;         // 请求编号，0 表无效
+    uint64_t            serial;         // 包含拷贝命令的那次提交的序号
+
+    uint32_t            width;
+    uint32_t            height;
+    uint32_t            rowPitch;       // 每行字节数
+    VkFormat            format;
+} ReadbackSlot;
+
+/// @brief 帧回读环形缓冲.
+typedef struct ReadbackRing {
+    ReadbackSlot        slots[READBACK_RING_SIZE];
+    uint64_t            nextTicket;
+} ReadbackRing;
+
+/// @brief 回读结果的描述，按值（blittable）传递给托管层.
+typedef struct ReadbackInfo {
+    const void*         pData;          // 映射后的像素数据首地址
+    uint64_t            size;           // 数据字节数
+    uint32_t            width;
+    uint32_t            height;
+    uint32_t            rowPitch;
+    uint32_t            format;         // VkFormat
+} ReadbackInfo;
+
+
+/// @brief 发起一次回读请求，拷贝会在下一次 EndFrame 时被录制.
+///
+/// @return 请求编号（ticket），环形缓冲已满时返回 0
+uint64_t readback_request(ReadbackRing* pRing);
+
+/// @brief 为所有等待录制的请求录制 "图像 -> 回读缓冲" 的拷贝命令.
+///
+/// 图像在拷贝前后都会被转换回 `layout` 布局，调用者需保证此时图像处于该布局.
+/// 槽位缓冲容量不足时会（在热路径外的首次使用或尺寸变化时）重新分配.
+///
+/// @param pFrameArena 每帧临时 Arena，屏障数组从中分配
+/// @param commandBuffer 处于录制状态的命令缓冲（且不在渲染通道内）
+/// @param image 要回读的图像（交换链图像或离屏图像）
+/// @param layout 图像当前的布局
+/// @param serial 该命令缓冲将要被提交时使用的序号
+void readback_record_copies(
+    ReadbackRing*       pRing,
+    Arena*              pFrameArena,
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    VkCommandBuffer     commandBuffer,
+    VkImage             image,
+    VkImageLayout       layout,
+    VkFormat            format,
+    VkExtent2D          extent,
+    uint64_t            serial
+);
+
+/// @brief 非阻塞地获取回读结果.
+///
+/// @param completedSerial GPU 已确认完成的最大提交序号
+/// @param pInfo 输出参数，数据就绪时被填充
+///
+/// @return 数据就绪时返回 `true`；仍在途或 ticket 无效时返回 `false`
+bool readback_map(
+    ReadbackRing*   pRing,
+    VkDevice        device,
+    uint64_t        ticket,
+    uint64_t        completedSerial,
+    ReadbackInfo*   pInfo
+);
+
+/// @brief 释放一个回读请求所占用的槽位，之后其映射数据不可再被访问.
+void readback_release(ReadbackRing* pRing, uint64_t ticket);
+
+/// @brief 销毁回读环形缓冲中所有槽位的缓冲与内存（调用前需确保 GPU 已空闲）.
+void destroy_readback_ring(VkDevice device, ReadbackRing* pRing);
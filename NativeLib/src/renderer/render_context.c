@@ -1,15 +1,84 @@
 #include "render_context.h"
+#include "../common/trace.h"
+
+/// @brief 渲染通道开始时的清除颜色
+static const VkClearValue clearColor = { .color = { .float32 = {0.0f, 0.0f, 0.0f, 1.0f} } };
+
+static void start_initialize_task(RenderContext* pContext, bool createInstance);
+static void initialize_task(void* pArg);
+static bool create_device(RenderContext* pContext, SurfaceContext* pMainSurface);
+static bool create_context_objects(RenderContext* pContext, SurfaceContext* pMainSurface);
+static bool finish_context_build(RenderContext* pContext, bool built);
+static bool create_pipeline_cache_objects(RenderContext* pContext);
+static void create_pipeline_task(void* pArg);
+static void precompile_recorded_pipelines(RenderContext* pContext, const SurfaceContext* pMainSurface);
+static void precompile_pipeline_task(void* pArg);
+static inline void record_pipeline_use(RenderContext* pContext, const SurfaceContext* pSurface, PipelineKind kind);
+static bool begin_surface_pass(
+    RenderContext*      pContext,
+    SurfaceContext*     pSurface,
+    VkSubpassContents   contents
+);
+static void end_surface_pass(RenderContext* pContext, VkCommandBuffer commandBuffer);
+static void set_surface_viewport(VkCommandBuffer commandBuffer, const SurfaceContext* pSurface);
+static VkCommandBuffer get_static_command_buffer(RenderContext* pContext, SurfaceContext* pSurface);
+static void record_merged_draw(VkCommandBuffer commandBuffer, uint32_t* pFirst, uint32_t* pCount);
+static void abandon_frame(RenderContext* pContext);
 
 
 RenderContext* new_render_context()
 {
-    // 分配堆内存
-    RenderContext* pContext = (RenderContext*)calloc(1, sizeof(RenderContext));
-    if (!pContext) return NULL;
+    // 唯一的一次堆分配，RenderContext 与其子 Arena 都从中分配
+    Arena arena;
+    if (!arena_init(&arena, RENDER_CONTEXT_ARENA_SIZE))
+        return NULL;
+
+    RenderContext* pContext = (RenderContext*)arena_calloc(&arena, 1, sizeof(RenderContext));
+    if (!pContext || !arena_alloc_child(&arena, &pContext->frameArena, FRAME_ARENA_SIZE))
+    {
+        arena_release(&arena);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < MAX_SURFACES; i++)
+    {
+        if (!arena_alloc_child(&arena, &pContext->surfaces[i].swapchainArena,
+                SWAPCHAIN_ARENA_SIZE))
+        {
+            arena_release(&arena);
+            return NULL;
+        }
+    }
+
+    // 任务系统的工作线程在上下文的整个生命周期内常驻
+    if (!create_job_system(JOB_SYSTEM_AUTO_WORKERS, &pContext->jobs))
+    {
+        arena_release(&arena);
+        return NULL;
+    }
+
+    frame_limiter_init(&pContext->frameLimiter);
+    trace_set_thread_name("render");            // 创建上下文的线程即录制每帧的线程
+    pContext->staticPassVersion = 1;            // 0 表示静态通道的命令缓冲尚未录制
+
+    pContext->arena = arena;                    // 分配完毕后再保存，记录其最终的分配位置
 
     return pContext;
 }
 
+bool preinitialize_render_context(RenderContext* pContext)
+{
+    if (pContext->initCreatesInstance || pContext->instance != VK_NULL_HANDLE)
+    {
+        fprintf(stderr, "%s : 渲染上下文已经开始构建！\n", __func__);
+        return false;
+    }
+
+    start_initialize_task(pContext, true);
+
+    return true;
+}
+
 bool create_render_context(GLFWwindow* window, RenderContext* pContext)
 {
     fprintf(stdout, 
@@ -17,48 +86,57 @@ bool create_render_context(GLFWwindow* window, RenderContext* pContext)
         "开始构建渲染上下文...\n",
         __DATE__, __TIME__);
 
-    pContext->window = window;                          // 保存窗口句柄
+    uint64_t traceStart = trace_begin();
 
-    pContext->instance = createInstance();              // 创建 Vk 实例
-    if (pContext->instance == VK_NULL_HANDLE)
-        return false;
+    SurfaceContext* pMainSurface = &pContext->surfaces[0];
+    pMainSurface->window = window;                      // 保存窗口句柄
 
-    pContext->surface = createSurface(pContext->instance, pContext->window); 
-    if (pContext->surface == VK_NULL_HANDLE)            // 创建窗口表面 
-        return false;
-    
-    pContext->physicalDevice = pickPhysicalDevice(pContext->instance, pContext->surface);
-    if (pContext->physicalDevice == VK_NULL_HANDLE)     // 选取物理设备
-        return false;
-    
-    pContext->device = createLogicalDevice(pContext->physicalDevice,    // 创建 Vk 设备
-                           pContext->surface,
-                           &pContext->graphicsQueue,
-                           &pContext->presentationQueue);
-    if (pContext->device == VK_NULL_HANDLE)
+    bool built = create_device(pContext, pMainSurface)             // 创建实例、窗口表面与设备
+              && create_context_objects(pContext, pMainSurface);   // 创建交换链、管线等其余对象
+    built = finish_context_build(pContext, built);
+
+    trace_end("create_render_context", traceStart);
+    if (!built)
         return false;
 
-    pContext->swapchain = createSwapchain(pContext->window,    // 为窗口（表面）创建交换链
-                              pContext->surface,
-                              pContext->physicalDevice,
-                              pContext->device,
-                              &pContext->swapchainImageCount,
-                              &pContext->swapchainImages,
-                              &pContext->swapchainImageFormat,
-                              &pContext->swapchainExtent);
-    if (pContext->swapchain == VK_NULL_HANDLE)
+    fprintf(stdout, 
+        ESC_LTALIC "%s %s " ESC_RESET
+        "渲染上下文构建完毕.\n",
+        __DATE__, __TIME__);
+
+    return true;
+}
+
+bool create_headless_render_context(VkExtent2D extent, RenderContext* pContext)
+{
+    fprintf(stdout, 
+        ESC_LTALIC "%s %s " ESC_RESET
+        "开始构建无头渲染上下文...\n",
+        __DATE__, __TIME__);
+
+    if (extent.width == 0 || extent.height == 0)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！离屏图像大小不能为 0.\n", __func__);
         return false;
+    }
 
-    pContext->swapchainImageViews = createSwapchainImageViews(pContext->device,
-                                        pContext->swapchainImageFormat,       
-                                        pContext->swapchainImageCount,    // 创建交换链的
-                                        pContext->swapchainImages);       // 图形视图
-    if (!pContext->swapchainImageViews)
+    uint64_t traceStart = trace_begin();
+
+    SurfaceContext* pMainSurface = &pContext->surfaces[0];
+    pContext->headless = true;
+    init_offscreen_surface(extent, pMainSurface);
+
+    bool built = create_device(pContext, pMainSurface)             // 创建实例与设备（不需要窗口扩展）
+              && create_context_objects(pContext, pMainSurface);   // 创建离屏图像、管线等其余对象
+    built = finish_context_build(pContext, built);
+
+    trace_end("create_headless_render_context", traceStart);
+    if (!built)
         return false;
 
     fprintf(stdout, 
         ESC_LTALIC "%s %s " ESC_RESET
-        "渲染上下文构建完毕.\n",
+        "无头渲染上下文构建完毕.\n",
         __DATE__, __TIME__);
 
     return true;
@@ -77,8 +155,14 @@ void destroy_render_context(RenderContext* pContext)
         return;
     }
 
+    job_system_wait(&pContext->jobs, &pContext->initJob);  // 预初始化后未构建时，等待其任务
+    free_pipeline_cache_data(&pContext->pipelineCacheData);
+
     if (pContext->instance == VK_NULL_HANDLE)
     {
+        destroy_job_system(&pContext->jobs);
+        frame_limiter_destroy(&pContext->frameLimiter);
+
         fprintf(stdout, 
             "%s : 给定渲染上下文不含有效的 VkInstance 句柄，不会销毁任何内容并退出.\n",
             __func__);
@@ -86,32 +170,64 @@ void destroy_render_context(RenderContext* pContext)
         return;
     }
 
-    // TODO: vkDeviceWaitIdle
+    job_system_wait(&pContext->jobs, &pContext->precompileJob);    // 等待管线预编译
 
-    if (pContext->swapchainImageViews)                             // 销毁交换链图像视图
-        destroySwapchainImageViews(pContext->device,               // 并释放其数组占用的
-            pContext->swapchainImageCount,                         // 内存
-            &pContext->swapchainImageViews);
+    if (pContext->device != VK_NULL_HANDLE)                        // 等待 GPU 完成所有
+        vkDeviceWaitIdle(pContext->device);                        // 在途工作
 
-    if (pContext->swapchain != VK_NULL_HANDLE)                     // 销毁交换链
-        destroySwapchain(pContext->device, pContext->swapchain);
-    
-    if (pContext->swapchainImages)                                 // 释放交换链图像数组
-    {                                                              // 占用的内存
-        free(pContext->swapchainImages);
-        pContext->swapchainImages = NULL;
+    destroy_readback_ring(pContext->device, &pContext->readbackRing);  // 销毁回读缓冲
+
+    destroy_gpu_trace(pContext->device, &pContext->gpuTrace);          // 销毁 GPU 追踪的查询池
+
+    destroy_frame_context(pContext->device, &pContext->frameContext);  // 销毁帧上下文
+
+    destroy_compute_context(pContext->device, &pContext->computeContext);  // 销毁计算上下文
+
+    for (uint32_t i = 0; i < MAX_SURFACES; i++)                    // 销毁所有表面的交换链、
+        destroy_surface_context(pContext, &pContext->surfaces[i]); // 管线与窗口表面
+
+    destroy_pipeline_library_cache(&pContext->pipelineLibraries);  // 销毁管线库部分
+
+    if (pContext->pipelineLayout != VK_NULL_HANDLE)                // 销毁管线布局
+        destroyPipelineLayout(pContext->device, pContext->pipelineLayout);
+
+    if (pContext->computePipelineLayout != VK_NULL_HANDLE)
+        destroyPipelineLayout(pContext->device, pContext->computePipelineLayout);
+
+    destroy_uniform_ring(pContext->device, &pContext->uniformRing);    // 销毁 uniform 环形缓冲
+
+    destroy_scene_store(pContext->device, &pContext->scene);           // 销毁场景存储
+
+    destroy_draw_queue(&pContext->drawQueue);                          // 释放绘制队列
+
+    destroy_resource_table(pContext->device, &pContext->resources);    // 销毁所有句柄资源
+
+    if (pContext->meshArena.device != VK_NULL_HANDLE)                  // 销毁网格池（拉取网格
+        destroy_mesh_arena(&pContext->meshArena);                      // 已随资源表释放区间）
+
+    if (pContext->pipelineCache != VK_NULL_HANDLE)                 // 保存并销毁管线缓存
+    {
+        save_pipeline_cache(pContext->device, pContext->pipelineCache,
+            PIPELINE_CACHE_FILE_PATH);
+        vkDestroyPipelineCache(pContext->device, pContext->pipelineCache, get_vulkan_allocator());
     }
 
+    save_pipeline_usage_file(&pContext->pipelineUsage,             // 写回管线使用记录
+        PIPELINE_USAGE_FILE_PATH);
+
     if (pContext->device != VK_NULL_HANDLE)                        // 销毁 Vk 设备
         destroyLogicalDevice(pContext->device);
-    
-    if (pContext->surface != VK_NULL_HANDLE)                       // 销毁窗口表面
-        destroySurface(pContext->instance, pContext->surface);
 
     destroyInstance(pContext->instance);                           // 销毁 Vk 实例
 
-    free(pContext);                                                // 释放渲染上下文结构体
-    pContext = NULL;                                               // 占用的内存
+    print_vulkan_allocation_stats(stdout);                         // 输出驱动的分配统计
+
+    destroy_job_system(&pContext->jobs);                           // 停止工作线程
+    frame_limiter_destroy(&pContext->frameLimiter);
+
+    Arena arena = pContext->arena;                                 // 释放渲染上下文占用的
+    arena_release(&arena);                                         // 全部内存（含结构体本身）
+    pContext = NULL;
 
     fprintf(stdout, 
         ESC_LTALIC "%s %s " ESC_RESET
@@ -119,4 +235,1343 @@ void destroy_render_context(RenderContext* pContext)
         __DATE__, __TIME__);
 
     return;
-}
\ No newline at end of file
+}
+
+
+int add_render_surface(RenderContext* pContext, GLFWwindow* window)
+{
+    if (pContext->headless || window == NULL || pContext->frameContext.frameBegun)
+    {
+        fprintf(stderr, "%s : 传入了无效参数或当前无法添加表面！\n", __func__);
+        return -1;
+    }
+
+    int surfaceIndex = -1;
+    for (int i = 0; i < MAX_SURFACES && surfaceIndex < 0; i++)
+    {
+        if (!pContext->surfaces[i].active)
+            surfaceIndex = i;
+    }
+    if (surfaceIndex < 0)
+    {
+        fprintf(stderr, "%s : 表面数量已达上限（%d）！\n", __func__, MAX_SURFACES);
+        return -1;
+    }
+
+    SurfaceContext* pSurface = &pContext->surfaces[surfaceIndex];
+    if (!init_window_surface(pContext->instance, window, pSurface))
+        return -1;
+
+    // 设备是为主表面选取的，新窗口的表面必须能被同一个 presentation 队列呈现
+    VkBool32 presentSupport = VK_FALSE;
+    vkGetPhysicalDeviceSurfaceSupportKHR(pContext->physicalDevice,
+        pContext->presentationQueueFamilyIndex, pSurface->surface, &presentSupport);
+
+    if (!presentSupport || !create_surface_objects(pContext, pSurface))
+    {
+        fprintf(stderr, "%s : 无法为窗口创建表面！\n", __func__);
+
+        destroy_surface_context(pContext, pSurface);
+        return -1;
+    }
+
+    pSurface->active = true;
+
+    return surfaceIndex;
+}
+
+
+void remove_render_surface(RenderContext* pContext, int surfaceIndex)
+{
+    if (surfaceIndex < 0 || surfaceIndex >= MAX_SURFACES 
+        || !pContext->surfaces[surfaceIndex].active || pContext->frameContext.frameBegun)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！\n", __func__);
+        return;
+    }
+
+    vkDeviceWaitIdle(pContext->device);
+
+    destroy_surface_context(pContext, &pContext->surfaces[surfaceIndex]);
+    pContext->surfaces[surfaceIndex].staticTriangleCount = 0;  // 槽位复用时不沿用静态通道
+}
+
+
+bool begin_frame(RenderContext* pContext)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+    FrameData* pFrame = current_frame_data(pFrameContext);
+
+    if (pFrameContext->frameBegun)
+    {
+        fprintf(stderr, "%s : 上一帧尚未结束！\n", __func__);
+        return false;
+    }
+
+    // 1.等待该帧上一次的提交执行完毕
+    uint64_t traceStart = trace_begin();
+    vkWaitForFences(pContext->device, 1, &pFrame->inFlightFence, VK_TRUE, UINT64_MAX);
+    trace_end("wait_for_frame_fence", traceStart);
+
+    if (pFrame->serial > pFrameContext->completedSerial)
+        pFrameContext->completedSerial = pFrame->serial;
+
+    frame_collect_gpu_time(pContext->device, pFrameContext);
+    gpu_trace_collect(pContext->device, &pContext->gpuTrace, pFrameContext->currentFrame);
+
+    arena_reset(&pContext->frameArena);         // 每帧的临时数据只在录制当前帧时有效
+
+    uniform_ring_begin_frame(&pContext->uniformRing, pFrameContext->currentFrame);
+
+    resource_table_collect(&pContext->resources,            // 销毁 GPU 已不再使用的资源
+        pContext->device, pFrameContext->completedSerial);
+
+    for (uint32_t i = 0; i < MAX_SURFACES; i++)             // 换上后台优化链接完成的管线
+    {
+        if (pContext->surfaces[i].active)
+            update_surface_pipeline(pContext, &pContext->surfaces[i]);
+    }
+    memory_budget_update(pFrameContext->completedSerial);   // 刷新预算，超出时驱逐可驱逐资源
+
+    // 2.为每个表面获取交换链图像（离屏表面始终使用唯一的离屏图像）
+    traceStart = trace_begin();
+
+    uint32_t acquiredCount = 0;
+    for (uint32_t i = 0; i < MAX_SURFACES; i++)
+    {
+        SurfaceContext* pSurface = &pContext->surfaces[i];
+        pSurface->acquired      = false;
+        pSurface->passRecorded  = false;
+
+        if (!pSurface->active)
+            continue;
+
+        // 上一次重建中途失败的表面先重试重建，仍不完整时本帧跳过（不能在空的交换链上获取图像）
+        if (!surface_render_target_ready(pSurface))
+        {
+            recreate_surface_render_target(pContext, pSurface);
+            if (!surface_render_target_ready(pSurface))
+                continue;
+        }
+
+        if (pSurface->headless)
+        {
+            pSurface->imageIndex = 0;
+        }
+        else
+        {
+            // 最小化的窗口没有可呈现的区域，跳过（也避免每帧都因 OUT_OF_DATE 尝试重建交换链）
+            if (glfwGetWindowAttrib(pSurface->window, GLFW_ICONIFIED))
+                continue;
+
+            VkResult result = vkAcquireNextImageKHR(pContext->device,
+                                  pSurface->swapchain,
+                                  UINT64_MAX,
+                                  pSurface->imageAvailableSemaphores[pFrameContext->currentFrame],
+                                  VK_NULL_HANDLE,
+                                  &pSurface->imageIndex);
+            if (result == VK_ERROR_OUT_OF_DATE_KHR)
+            {
+                recreate_surface_render_target(pContext, pSurface);
+                continue;
+            }
+            if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+            {
+                fprintf(stderr,
+                    "Failed to acquire swapchain image! Error Code(VkResult): %d\n", result);
+                continue;
+            }
+        }
+
+        pSurface->acquired = true;
+        acquiredCount++;
+    }
+
+    trace_end("acquire_images", traceStart);
+
+    if (acquiredCount == 0)
+        return false;
+
+    // 3.开始录制命令缓冲（各表面的渲染通道在首次向其绘制时才开始）
+    vkResetCommandBuffer(pFrame->commandBuffer, 0);
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    VkResult result = vkBeginCommandBuffer(pFrame->commandBuffer, &beginInfo);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to begin recording command buffer! Error Code(VkResult): %d\n",
+            result);
+        abandon_frame(pContext);
+        return false;
+    }
+
+    frame_write_begin_timestamp(pFrameContext);
+    gpu_trace_begin_frame(&pContext->gpuTrace, pFrame->commandBuffer, pFrameContext->currentFrame);
+
+    traceStart = trace_begin();
+    uint32_t uploadScope = gpu_trace_begin(&pContext->gpuTrace, pFrame->commandBuffer, "upload");
+
+    // 4.在所有渲染通道之前上传场景的待上传范围
+    scene_record_upload(&pContext->scene, pFrame->commandBuffer, pFrameContext->currentFrame);
+
+    // 5.在预算内整理网格池（搬移的拷贝同样需在所有渲染通道之前）
+    mesh_defrag_step(&pContext->meshDefrag, &pContext->resources, &pContext->meshArena,
+        pFrame->commandBuffer, resource_retire_serial(pContext));
+
+    gpu_trace_end(&pContext->gpuTrace, pFrame->commandBuffer, uploadScope);
+    trace_end("record_upload", traceStart);
+
+    pContext->pRecordingSurface         = NULL;
+    pContext->computeContext.submitted  = false;
+    pFrameContext->frameBegun           = true;
+
+    // 着色器总会读取 uniform 块，在调用方绑定自己的数据之前使用默认值
+    bind_uniforms(pContext, pContext->uniformRing.defaultOffset);
+
+    return true;
+}
+
+
+void end_frame(RenderContext* pContext)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+    FrameData* pFrame = current_frame_data(pFrameContext);
+
+    if (!pFrameContext->frameBegun)
+    {
+        fprintf(stderr, "%s : 没有已开始的帧！\n", __func__);
+        return;
+    }
+
+    if (pContext->drawQueue.count > 0)                  // 录制本帧仍在排队的绘制
+        flush_draw_queue(pContext);
+
+    pFrameContext->frameBegun = false;
+
+    uint64_t traceStart = trace_begin();
+
+    uint64_t serial = pFrameContext->submittedSerial + 1;
+
+    // 1.先结束未结束的计算通道（视为在最后使用），否则下面的渲染通道无法开始
+    if (pContext->computeContext.recording)
+        end_compute_pass(pContext, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+    // 本帧没有绘制的表面也要录制其渲染通道（清屏并转换至呈现布局），然后结束渲染通道
+    for (uint32_t i = 0; i < MAX_SURFACES; i++)
+    {
+        SurfaceContext* pSurface = &pContext->surfaces[i];
+        if (pSurface->acquired && !pSurface->passRecorded)
+            begin_surface_pass(pContext, pSurface, VK_SUBPASS_CONTENTS_INLINE);
+    }
+
+    if (pContext->pRecordingSurface != NULL)
+        end_surface_pass(pContext, pFrame->commandBuffer);
+
+    // 2.在渲染通道之后录制主表面挂起的回读拷贝（主表面本帧未获取到图像时推迟到下一帧，
+    // 交换链图像不能作为传输源时不录制）
+    SurfaceContext* pMainSurface = &pContext->surfaces[0];
+    if (pMainSurface->acquired && pMainSurface->readbackSupported)
+        readback_record_copies(&pContext->readbackRing,
+            &pContext->frameArena,
+            pContext->physicalDevice,
+            pContext->device,
+            pFrame->commandBuffer,
+            pMainSurface->swapchainImages[pMainSurface->imageIndex],
+            pMainSurface->headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                                   : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+            pMainSurface->swapchainImageFormat,
+            pMainSurface->swapchainExtent,
+            serial);
+
+    frame_write_end_timestamp(pFrameContext);
+    gpu_trace_end_frame(&pContext->gpuTrace, pFrame->commandBuffer);
+
+    VkResult result = vkEndCommandBuffer(pFrame->commandBuffer);
+    trace_end("record_end_frame", traceStart);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to record command buffer! Error Code(VkResult): %d\n", result);
+        abandon_frame(pContext);
+        return;
+    }
+
+    // 3.一次提交：等待所有交换链图像可用后再写入颜色附件，完成后触发各自的 renderFinished
+    // 与栅栏（离屏表面没有要等待或呈现的交换链图像）；提交了异步计算时还要在消费其结果的
+    // 阶段等待计算完成
+    VkSemaphore             waitSemaphores[MAX_SURFACES + 1];
+    VkPipelineStageFlags    waitStages[MAX_SURFACES + 1];
+    VkSemaphore             signalSemaphores[MAX_SURFACES];
+    VkSwapchainKHR          swapchains[MAX_SURFACES];
+    uint32_t                imageIndices[MAX_SURFACES];
+    SurfaceContext*         pPresentSurfaces[MAX_SURFACES];
+    uint32_t                presentCount = 0;
+
+    for (uint32_t i = 0; i < MAX_SURFACES; i++)
+    {
+        SurfaceContext* pSurface = &pContext->surfaces[i];
+        if (!pSurface->acquired || pSurface->headless)
+            continue;
+
+        waitSemaphores[presentCount]    = 
+            pSurface->imageAvailableSemaphores[pFrameContext->currentFrame];
+        waitStages[presentCount]        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        signalSemaphores[presentCount]  = 
+            pSurface->renderFinishedSemaphores[pFrameContext->currentFrame];
+        swapchains[presentCount]        = pSurface->swapchain;
+        imageIndices[presentCount]      = pSurface->imageIndex;
+        pPresentSurfaces[presentCount]  = pSurface;
+        presentCount++;
+    }
+
+    uint32_t waitCount = presentCount;
+    if (pContext->computeContext.submitted)
+    {
+        waitSemaphores[waitCount]   = 
+            pContext->computeContext.finishedSemaphores[pFrameContext->currentFrame];
+        waitStages[waitCount]       = pContext->computeContext.waitStage;
+        waitCount++;
+    }
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount   = waitCount;
+    submitInfo.pWaitSemaphores      = waitSemaphores;
+    submitInfo.pWaitDstStageMask    = waitStages;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &pFrame->commandBuffer;
+    submitInfo.signalSemaphoreCount = presentCount;
+    submitInfo.pSignalSemaphores    = signalSemaphores;
+
+    // 提交之前的时刻是本帧 GPU 开始时刻的下界，用于校准 GPU 时钟
+    traceStart = trace_begin();
+    gpu_trace_submit(&pContext->gpuTrace, frame_limiter_now_ns());
+
+    // 录制成功、确定要提交时才重置栅栏，之前的任何失败都不会让下一次等待永久阻塞
+    vkResetFences(pContext->device, 1, &pFrame->inFlightFence);
+
+    result = vkQueueSubmit(pContext->graphicsQueue, 1, &submitInfo, pFrame->inFlightFence);
+    trace_end("queue_submit", traceStart);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to submit draw command buffer! Error Code(VkResult): %d\n", result);
+        abandon_frame(pContext);
+        return;
+    }
+
+    pFrameContext->submittedSerial  = serial;
+    pFrame->serial                  = serial;
+    pFrameContext->currentFrame     = (pFrameContext->currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+
+    if (presentCount == 0)
+        return;
+
+    // 4.按目标帧率等待（GPU 已在执行本帧），使呈现的间隔稳定
+    traceStart = trace_begin();
+    frame_limiter_wait(&pContext->frameLimiter);
+    trace_end("frame_limiter_wait", traceStart);
+
+    // 5.一次呈现所有交换链，并按各自的结果重建过期的交换链
+    VkResult presentResults[MAX_SURFACES];
+
+    VkPresentInfoKHR presentInfo = {};
+    presentInfo.sType               = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount  = presentCount;
+    presentInfo.pWaitSemaphores     = signalSemaphores;
+    presentInfo.swapchainCount      = presentCount;
+    presentInfo.pSwapchains         = swapchains;
+    presentInfo.pImageIndices       = imageIndices;
+    presentInfo.pResults            = presentResults;
+
+    traceStart = trace_begin();
+    result = vkQueuePresentKHR(pContext->presentationQueue, &presentInfo);
+    trace_end("queue_present", traceStart);
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR)
+        fprintf(stderr,
+            "Failed to present swapchain image! Error Code(VkResult): %d\n", result);
+
+    for (uint32_t i = 0; i < presentCount; i++)
+    {
+        if (presentResults[i] == VK_ERROR_OUT_OF_DATE_KHR || presentResults[i] == VK_SUBOPTIMAL_KHR)
+            recreate_surface_render_target(pContext, pPresentSurfaces[i]);
+    }
+}
+
+
+void draw_triangles(RenderContext* pContext, int surfaceIndex, uint32_t count)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+
+    if (!pFrameContext->frameBegun || count == 0
+        || surfaceIndex < 0 || surfaceIndex >= MAX_SURFACES)
+        return;
+
+    SurfaceContext* pSurface = &pContext->surfaces[surfaceIndex];
+    if (!begin_surface_pass(pContext, pSurface, VK_SUBPASS_CONTENTS_INLINE))
+        return;
+
+    VkCommandBuffer commandBuffer = current_frame_data(pFrameContext)->commandBuffer;
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+        pSurface->trianglePipeline);
+    record_pipeline_use(pContext, pSurface, PIPELINE_KIND_TRIANGLE);
+    vkCmdDraw(commandBuffer, 3 * count, 1, 0, 0);
+}
+
+
+void flush_draw_queue(RenderContext* pContext)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+    DrawQueue* pQueue = &pContext->drawQueue;
+
+    if (!pFrameContext->frameBegun)
+        return;
+
+    uint64_t traceStart = trace_begin();
+
+    DrawQueueStats stats = {};
+
+    // 1.按状态键排序（绘制数较多时在任务系统上并行）
+    draw_queue_sort(pQueue, &pContext->jobs);
+    stats.sortPasses = pQueue->stats.sortPasses;
+
+    VkCommandBuffer commandBuffer = current_frame_data(pFrameContext)->commandBuffer;
+
+    // 2.按顺序录制，记录当前绑定的状态以消除冗余绑定
+    int32_t             currentSurface  = -1;
+    bool                surfaceUsable   = false;
+    VkPipeline          boundPipeline   = VK_NULL_HANDLE;
+    uint32_t            boundOffset     = UNIFORM_RING_INVALID_OFFSET;
+    ResourceHandle      boundMesh       = RESOURCE_INVALID_HANDLE;
+    MeshPushConstants   boundConstants  = {};               // 拉取网格所在的顶点块与索引块
+    uint32_t            mergedFirst     = 0;                // 尚未录制的拉取网格绘制
+    uint32_t            mergedCount     = 0;                // （索引区间相邻的已合并）
+
+    for (uint32_t i = 0; i < pQueue->count; i++)
+    {
+        const DrawCommand* pCommand = &pQueue->pCommands[pQueue->pOrder[i]];
+
+        // 通道（表面）变化：开始其渲染通道，新的渲染通道中重新绑定全部状态
+        if (pCommand->surface != currentSurface)
+        {
+            record_merged_draw(commandBuffer, &mergedFirst, &mergedCount);
+
+            currentSurface  = pCommand->surface;
+            surfaceUsable   = currentSurface >= 0 && currentSurface < MAX_SURFACES
+                && begin_surface_pass(pContext, &pContext->surfaces[currentSurface],
+                       VK_SUBPASS_CONTENTS_INLINE);
+            boundPipeline   = VK_NULL_HANDLE;
+            boundOffset     = UNIFORM_RING_INVALID_OFFSET;
+            boundMesh       = RESOURCE_INVALID_HANDLE;
+            memset(&boundConstants, 0, sizeof(MeshPushConstants));
+        }
+        if (!surfaceUsable)
+        {
+            stats.skippedCount++;
+            continue;
+        }
+
+        // 解析句柄：过期或被驱逐的资源跳过这次绘制
+        const MeshResource* pMesh = NULL;
+        const BufferResource* pVertexBuffer = NULL;
+        const BufferResource* pIndexBuffer = NULL;
+        bool meshUsable = true;
+        if (pCommand->mesh != RESOURCE_INVALID_HANDLE)
+        {
+            ResourceData* pData = resource_table_get(&pContext->resources,
+                                      pCommand->mesh, RESOURCE_TYPE_MESH);
+            pMesh = pData != NULL ? &pData->mesh : NULL;
+            meshUsable = pMesh != NULL;
+
+            if (pMesh != NULL && !mesh_is_pulled(pMesh))
+            {
+                ResourceData* pBufferData = resource_table_get(&pContext->resources,
+                                                pMesh->vertexBuffer, RESOURCE_TYPE_BUFFER);
+                pVertexBuffer = pBufferData != NULL ? &pBufferData->buffer : NULL;
+
+                if (pMesh->indexBuffer != RESOURCE_INVALID_HANDLE)
+                {
+                    pBufferData = resource_table_get(&pContext->resources,
+                                      pMesh->indexBuffer, RESOURCE_TYPE_BUFFER);
+                    pIndexBuffer = pBufferData != NULL ? &pBufferData->buffer : NULL;
+                }
+
+                meshUsable = pVertexBuffer != NULL
+                    && (pMesh->indexBuffer == RESOURCE_INVALID_HANDLE || pIndexBuffer != NULL);
+            }
+        }
+        bool pulled = pMesh != NULL && mesh_is_pulled(pMesh);
+
+        // 拉取网格默认使用顶点拉取管线，经典网格使用顶点输入管线，没有网格时使用三角形管线
+        SurfaceContext* pSurface = &pContext->surfaces[currentSurface];
+        VkPipeline pipeline = pulled ? pSurface->meshPipeline
+                            : pMesh != NULL ? pSurface->vertexPipeline
+                            : pSurface->trianglePipeline;
+
+        if (pipeline == VK_NULL_HANDLE || !meshUsable)
+        {
+            stats.skippedCount++;
+            continue;
+        }
+
+        uint32_t instanceCount = pCommand->instanceCount > 0 ? pCommand->instanceCount : 1;
+
+        // 没有指定 uniform 数据的命令读取默认的 ObjectUniforms
+        uint32_t uniformOffset = pCommand->uniformOffset != UNIFORM_RING_INVALID_OFFSET
+                               ? pCommand->uniformOffset : pContext->uniformRing.defaultOffset;
+
+        // 与上一条拉取网格绘制的状态相同且索引区间相邻时，并入同一次 vkCmdDraw
+        MeshPushConstants constants = pulled
+            ? mesh_arena_push_constants(&pContext->meshArena, &pMesh->pulled) : boundConstants;
+        if (pulled && instanceCount == 1 && mergedCount > 0
+            && pipeline == boundPipeline
+            && uniformOffset == boundOffset
+            && memcmp(&constants, &boundConstants, sizeof(MeshPushConstants)) == 0
+            && pMesh->pulled.firstIndex == mergedFirst + mergedCount)
+        {
+            mergedCount += pMesh->indexCount;
+            stats.drawCount++;
+            stats.mergedDraws++;
+            continue;
+        }
+        record_merged_draw(commandBuffer, &mergedFirst, &mergedCount);
+
+        // 只绑定与上一条绘制不同的状态
+        if (pipeline != boundPipeline)
+        {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            boundPipeline = pipeline;
+            stats.pipelineBinds++;
+
+            if (pipeline == pSurface->trianglePipeline)
+                record_pipeline_use(pContext, pSurface, PIPELINE_KIND_TRIANGLE);
+            else if (pipeline == pSurface->meshPipeline)
+                record_pipeline_use(pContext, pSurface, PIPELINE_KIND_MESH_PULL);
+        }
+
+        if (uniformOffset != boundOffset)
+        {
+            bind_uniforms(pContext, uniformOffset);
+            boundOffset = uniformOffset;
+            stats.uniformBinds++;
+        }
+
+        if (pulled && memcmp(&constants, &boundConstants, sizeof(MeshPushConstants)) != 0)
+        {
+            vkCmdPushConstants(commandBuffer, pContext->pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT,
+                0, sizeof(MeshPushConstants), &constants);
+            boundConstants = constants;
+            stats.meshBinds++;
+        }
+        else if (!pulled && pMesh != NULL && pCommand->mesh != boundMesh)
+        {
+            VkDeviceSize vertexOffset = 0;
+            vkCmdBindVertexBuffers(commandBuffer, 0, 1, &pVertexBuffer->buffer, &vertexOffset);
+            if (pIndexBuffer != NULL)
+                vkCmdBindIndexBuffer(commandBuffer, pIndexBuffer->buffer, 0, VK_INDEX_TYPE_UINT32);
+
+            // 本帧的提交完成之前缓冲不会被驱逐
+            uint64_t serial = resource_retire_serial(pContext);
+            resource_table_touch(&pContext->resources, pMesh->vertexBuffer, serial);
+            resource_table_touch(&pContext->resources, pMesh->indexBuffer, serial);
+
+            boundMesh = pCommand->mesh;
+            stats.meshBinds++;
+        }
+
+        // 拉取网格的 firstVertex 即其索引区间的起点；单实例的先挂起，等待与后续绘制合并
+        if (pulled && instanceCount == 1)
+        {
+            mergedFirst = pMesh->pulled.firstIndex;
+            mergedCount = pMesh->indexCount;
+        }
+        else if (pulled)
+            vkCmdDraw(commandBuffer, pMesh->indexCount, instanceCount, pMesh->pulled.firstIndex, 0);
+        else if (pIndexBuffer != NULL)
+            vkCmdDrawIndexed(commandBuffer, pMesh->indexCount, instanceCount, 0, 0, 0);
+        else
+            vkCmdDraw(commandBuffer, pMesh != NULL ? pMesh->vertexCount : pCommand->vertexCount,
+                instanceCount, 0, 0);
+
+        stats.drawCount++;
+    }
+
+    record_merged_draw(commandBuffer, &mergedFirst, &mergedCount);
+
+    pQueue->stats = stats;
+    draw_queue_reset(pQueue);
+
+    trace_end("flush_draw_queue", traceStart);
+}
+
+
+void set_static_pass(RenderContext* pContext, int surfaceIndex, uint32_t count)
+{
+    if (surfaceIndex < 0 || surfaceIndex >= MAX_SURFACES || pContext->frameContext.frameBegun)
+        return;
+
+    SurfaceContext* pSurface = &pContext->surfaces[surfaceIndex];
+    if (pSurface->staticTriangleCount == count)
+        return;
+
+    pSurface->staticTriangleCount = count;
+    invalidate_static_passes(pContext);
+}
+
+
+void draw_static_pass(RenderContext* pContext, int surfaceIndex)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+
+    if (!pFrameContext->frameBegun || surfaceIndex < 0 || surfaceIndex >= MAX_SURFACES)
+        return;
+
+    SurfaceContext* pSurface = &pContext->surfaces[surfaceIndex];
+    if (pSurface->staticTriangleCount == 0 || !pSurface->acquired || pSurface->passRecorded)
+        return;
+
+    // 先录制（或取出）二级命令缓冲，失败时本帧由 end_frame 照常清屏
+    VkCommandBuffer staticCommandBuffer = get_static_command_buffer(pContext, pSurface);
+    if (staticCommandBuffer == VK_NULL_HANDLE
+        || !begin_surface_pass(pContext, pSurface, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS))
+        return;
+
+    VkCommandBuffer commandBuffer = current_frame_data(pFrameContext)->commandBuffer;
+
+    vkCmdExecuteCommands(commandBuffer, 1, &staticCommandBuffer);
+
+    // 执行二级命令缓冲的渲染通道不能再内联录制，立即结束
+    end_surface_pass(pContext, commandBuffer);
+}
+
+
+void bind_uniforms(RenderContext* pContext, uint32_t dynamicOffset)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+
+    if (!pFrameContext->frameBegun || dynamicOffset == UNIFORM_RING_INVALID_OFFSET)
+        return;
+
+    // 绑定的描述符集在命令缓冲内跨渲染通道保持，布局兼容的管线切换也不会使其失效
+    vkCmdBindDescriptorSets(current_frame_data(pFrameContext)->commandBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        pContext->pipelineLayout,
+        0, 1, &pContext->uniformRing.descriptorSet,
+        1, &dynamicOffset);
+}
+
+
+ResourceHandle create_compute_pipeline(RenderContext* pContext, const uint32_t* pCode, size_t codeSize)
+{
+    if (pCode == NULL || codeSize == 0 || codeSize % sizeof(uint32_t) != 0)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！SPIR-V 字节码为空或长度不是 4 的倍数.\n", __func__);
+        return RESOURCE_INVALID_HANDLE;
+    }
+
+    VkShaderModule shader = createShaderModule(pContext->device, pCode, codeSize);
+    if (shader == VK_NULL_HANDLE)
+        return RESOURCE_INVALID_HANDLE;
+
+    ResourceData data = {};
+    data.pipeline.pipeline = createComputePipeline(pContext->device,
+                                 pContext->pipelineCache,
+                                 pContext->computePipelineLayout,
+                                 shader);
+    destroyShaderModule(pContext->device, shader);
+    if (data.pipeline.pipeline == VK_NULL_HANDLE)
+        return RESOURCE_INVALID_HANDLE;
+
+    ResourceHandle handle = resource_table_insert(&pContext->resources, RESOURCE_TYPE_PIPELINE, &data);
+    if (handle == RESOURCE_INVALID_HANDLE)
+        destroyPipeline(pContext->device, data.pipeline.pipeline);
+
+    return handle;
+}
+
+
+VkCommandBuffer begin_compute_pass(RenderContext* pContext)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+    ComputeContext* pComputeContext = &pContext->computeContext;
+
+    if (!pFrameContext->frameBegun || pComputeContext->recording || pComputeContext->submitted
+        || pContext->pRecordingSurface != NULL)
+    {
+        fprintf(stderr, "%s : 计算通道需在 begin_frame 之后、向任何表面绘制之前开始，"
+            "且每帧只能有一个！\n", __func__);
+        return VK_NULL_HANDLE;
+    }
+
+    pComputeContext->dispatchCount = 0;
+
+    // 退回：直接录制到图形命令缓冲（渲染通道之外），计算的写入需等待之前（含上一次提交）的
+    // 图形读取与本帧上传的写入
+    if (!pComputeContext->async)
+    {
+        VkCommandBuffer commandBuffer = current_frame_data(pFrameContext)->commandBuffer;
+
+        VkMemoryBarrier barrier = {};
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &barrier, 0, NULL, 0, NULL);
+
+        pComputeContext->recording      = true;
+        pComputeContext->commandBuffer  = commandBuffer;
+        return commandBuffer;
+    }
+
+    // 该帧的栅栏已在 begin_frame 中等待过，图形提交又等待了计算信号量，计算命令缓冲必然空闲
+    VkCommandBuffer commandBuffer = pComputeContext->commandBuffers[pFrameContext->currentFrame];
+    vkResetCommandBuffer(commandBuffer, 0);
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    VkResult result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to begin recording command buffer! Error Code(VkResult): %d\n", result);
+        return VK_NULL_HANDLE;
+    }
+
+    pComputeContext->recording      = true;
+    pComputeContext->commandBuffer  = commandBuffer;
+
+    return commandBuffer;
+}
+
+
+bool dispatch_compute(
+    RenderContext*  pContext,
+    ResourceHandle  pipeline,
+    const void*     pConstants,
+    uint32_t        constantSize,
+    uint32_t        groupCountX,
+    uint32_t        groupCountY,
+    uint32_t        groupCountZ
+)
+{
+    ComputeContext* pComputeContext = &pContext->computeContext;
+
+    if (!pComputeContext->recording)
+    {
+        fprintf(stderr, "%s : 没有已开始的计算通道！\n", __func__);
+        return false;
+    }
+
+    if (constantSize > COMPUTE_PUSH_CONSTANT_SIZE || (constantSize > 0 && pConstants == NULL))
+    {
+        fprintf(stderr, "%s : 传入了无效参数！推送常量为空或超过 %u 字节.\n",
+            __func__, COMPUTE_PUSH_CONSTANT_SIZE);
+        return false;
+    }
+
+    ResourceData* pData = resource_table_get(&pContext->resources, pipeline, RESOURCE_TYPE_PIPELINE);
+    if (pData == NULL)
+        return false;
+
+    VkCommandBuffer commandBuffer = pComputeContext->commandBuffer;
+
+    // 前一次调度的写入对本次调度可见
+    if (pComputeContext->dispatchCount > 0)
+    {
+        VkMemoryBarrier barrier = {};
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &barrier, 0, NULL, 0, NULL);
+    }
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pData->pipeline.pipeline);
+    if (constantSize > 0)
+        vkCmdPushConstants(commandBuffer, pContext->computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, constantSize, pConstants);
+    vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+
+    pComputeContext->dispatchCount++;
+
+    return true;
+}
+
+
+bool end_compute_pass(RenderContext* pContext, VkPipelineStageFlags waitStage)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+    ComputeContext* pComputeContext = &pContext->computeContext;
+
+    if (!pComputeContext->recording)
+    {
+        fprintf(stderr, "%s : 没有已开始的计算通道！\n", __func__);
+        return false;
+    }
+    pComputeContext->recording      = false;
+    pComputeContext->commandBuffer  = VK_NULL_HANDLE;
+
+    // 退回：计算着色器的写入对之后 waitStage 阶段的读取可见
+    if (!pComputeContext->async)
+    {
+        VkMemoryBarrier barrier = {};
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT 
+                                | VK_ACCESS_INDIRECT_COMMAND_READ_BIT
+                                | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
+                                | VK_ACCESS_INDEX_READ_BIT
+                                | VK_ACCESS_UNIFORM_READ_BIT;
+
+        vkCmdPipelineBarrier(current_frame_data(pFrameContext)->commandBuffer,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, waitStage,
+            0, 1, &barrier, 0, NULL, 0, NULL);
+
+        return true;
+    }
+
+    // 异步：立即提交，使计算在 CPU 录制图形命令期间就开始执行
+    VkCommandBuffer commandBuffer = pComputeContext->commandBuffers[pFrameContext->currentFrame];
+
+    VkResult result = vkEndCommandBuffer(commandBuffer);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to record command buffer! Error Code(VkResult): %d\n", result);
+        return false;
+    }
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores    = 
+        &pComputeContext->finishedSemaphores[pFrameContext->currentFrame];
+
+    result = vkQueueSubmit(pContext->computeQueue, 1, &submitInfo, VK_NULL_HANDLE);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to submit compute command buffer! Error Code(VkResult): %d\n", result);
+        return false;
+    }
+
+    pComputeContext->submitted = true;
+    pComputeContext->waitStage = waitStage;
+
+    return true;
+}
+
+
+/// @brief 提交初始化任务：读取管线缓存文件，`createInstance` 为 `true` 时还会提前创建
+/// VkInstance（没有工作线程时在等待它的线程上执行）.
+static void start_initialize_task(RenderContext* pContext, bool createInstance)
+{
+    pContext->initCreatesInstance = createInstance;
+
+    job_system_run(&pContext->jobs, initialize_task, pContext, &pContext->initJob);
+}
+
+/// @brief 初始化任务的入口，只写入 `instance`（需要时）与 `pipelineCacheData`.
+static void initialize_task(void* pArg)
+{
+    RenderContext* pContext = (RenderContext*)pArg;
+    uint64_t traceStart = trace_begin();
+
+    if (pContext->initCreatesInstance)
+    {
+        pContext->instance = createInstance(pContext->headless);
+
+        // 枚举物理设备会促使加载器完成各驱动（ICD）的初始化，这是实例创建之外最耗时的部分
+        uint32_t physicalDeviceCount = 0;
+        if (pContext->instance != VK_NULL_HANDLE)
+            vkEnumeratePhysicalDevices(pContext->instance, &physicalDeviceCount, NULL);
+    }
+
+    read_pipeline_cache_file(PIPELINE_CACHE_FILE_PATH, &pContext->pipelineCacheData);
+    read_pipeline_usage_file(PIPELINE_USAGE_FILE_PATH, &pContext->pipelineUsage);
+
+    trace_end("initialize_task", traceStart);
+}
+
+/// @brief 创建（或等待预初始化创建的）VkInstance，然后创建主表面的窗口表面、选取物理设备
+/// 并创建逻辑设备.
+///
+/// 未预初始化时，管线缓存文件在任务系统上读取，与实例及设备的创建重叠.
+static bool create_device(RenderContext* pContext, SurfaceContext* pMainSurface)
+{
+    if (pContext->initCreatesInstance)
+        job_system_wait(&pContext->jobs, &pContext->initJob);  // 等待预初始化完成
+    else
+    {
+        start_initialize_task(pContext, false);
+        pContext->instance = createInstance(pContext->headless);
+    }
+
+    if (pContext->instance == VK_NULL_HANDLE)           // 创建 Vk 实例
+        return false;
+
+    pMainSurface->active = true;
+    if (!pContext->headless 
+        && !init_window_surface(pContext->instance, pMainSurface->window, pMainSurface))
+        return false;                                   // 创建窗口表面 
+
+    pContext->physicalDevice = pickPhysicalDevice(pContext->instance,
+                                   pMainSurface->surface,
+                                   &pContext->frameArena);
+    if (pContext->physicalDevice == VK_NULL_HANDLE)     // 选取物理设备
+        return false;
+    
+    pContext->device = createLogicalDevice(pContext->physicalDevice,    // 创建 Vk 设备
+                           pMainSurface->surface,
+                           &pContext->graphicsQueue,
+                           &pContext->presentationQueue,
+                           &pContext->graphicsQueueFamilyIndex,
+                           &pContext->presentationQueueFamilyIndex,
+                           &pContext->computeQueue,
+                           &pContext->computeQueueFamilyIndex);
+    if (pContext->device == VK_NULL_HANDLE)
+        return false;
+
+    pContext->bufferDeviceAddress = isBufferDeviceAddressSupported(pContext->physicalDevice);
+    pContext->graphicsPipelineLibrary = isGraphicsPipelineLibrarySupported(pContext->physicalDevice);
+    pContext->directWrite = getHostVisibleDeviceLocalHeapSize(pContext->physicalDevice)
+                         >= DIRECT_WRITE_MIN_HEAP_SIZE;
+    if (pContext->directWrite)
+        fprintf(stdout,
+            ESC_LTALIC "%s %s " ESC_RESET "设备有可主机写入的显存，动态数据将直接写入显存！\n",
+            __DATE__, __TIME__);
+
+    init_memory_budget(pContext->physicalDevice);      // 之后的设备内存分配都计入预算
+
+    return true;
+}
+
+/// @brief 在设备创建完成后构建其余的上下文对象.
+///
+/// 图形管线只依赖管线缓存、管线布局与渲染通道，渲染通道又只依赖图像格式：先创建这三者，
+/// 再把管线创建（驱动编译着色器）交给任务系统，同时在当前线程上创建交换链（离屏图像）、
+/// 帧缓冲与帧上下文.
+static bool create_context_objects(RenderContext* pContext, SurfaceContext* pMainSurface)
+{
+    job_system_wait(&pContext->jobs, &pContext->initJob);  // 等待管线缓存文件读取完毕
+
+    if (!create_pipeline_cache_objects(pContext))       // 创建管线缓存、uniform 环形缓冲与管线布局
+        return false;
+
+    if (!create_surface_render_pass(pContext, pMainSurface))       // 创建渲染通道
+        return false;
+
+    job_system_run(&pContext->jobs, create_pipeline_task,          // 在工作线程上创建图形管线
+        pContext, &pContext->pipelineJob);
+
+    precompile_recorded_pipelines(pContext, pMainSurface);         // 在工作线程上预编译上次用过的管线
+
+    if (!create_surface_render_target(pContext, pMainSurface))     // 创建交换链（离屏图像）、
+        return false;                                              // 图像视图与帧缓冲
+
+    if (!create_surface_sync_objects(pContext, pMainSurface))      // 创建交换链的信号量
+        return false;
+
+    if (!create_scene_store(pContext->physicalDevice,       // 创建场景存储
+            pContext->device,
+            SCENE_STORE_CAPACITY,
+            &pContext->scene))
+        return false;
+
+    if (!create_resource_table(RESOURCE_TABLE_CAPACITY, &pContext->resources))  // 创建资源表
+        return false;
+
+    create_mesh_arena(pContext->physicalDevice,             // 初始化网格池（其缓冲在首次
+        pContext->device,                                   // 创建拉取网格时才分配）
+        pContext->bufferDeviceAddress,
+        &pContext->meshArena);
+    pContext->resources.pMeshArena  = &pContext->meshArena;
+    pContext->resources.device      = pContext->device;
+    init_mesh_defragmenter(MESH_DEFRAG_DEFAULT_FRAME_BUDGET, &pContext->meshDefrag);
+
+    if (!create_draw_queue(DRAW_QUEUE_CAPACITY, &pContext->drawQueue))          // 创建绘制队列
+        return false;
+
+    if (!create_frame_context(pContext->physicalDevice,     // 创建命令池、命令缓冲
+            pContext->device,                               // 与每帧的栅栏
+            pContext->graphicsQueueFamilyIndex,
+            &pContext->frameContext))
+        return false;
+
+    create_gpu_trace(pContext->device,                      // 创建 GPU 追踪的查询池
+        &pContext->frameContext,                            // （不支持时间戳时不创建）
+        &pContext->gpuTrace);
+
+    return create_compute_context(pContext->device,         // 创建计算命令缓冲与
+               pContext->computeQueueFamilyIndex,           // 跨队列信号量
+               pContext->graphicsQueueFamilyIndex,
+               &pContext->computeContext);
+}
+
+/// @brief 等待构建期间提交的任务完成并释放临时数据（出错提前返回时也必须调用，
+/// 之后才能安全地销毁上下文）.
+///
+/// @return `built` 为 `true` 且图形管线创建成功时返回 `true`
+static bool finish_context_build(RenderContext* pContext, bool built)
+{
+    job_system_wait(&pContext->jobs, &pContext->initJob);
+    job_system_wait(&pContext->jobs, &pContext->pipelineJob);
+
+    free_pipeline_cache_data(&pContext->pipelineCacheData);
+
+    return built && pContext->surfaces[0].trianglePipeline != VK_NULL_HANDLE;
+}
+
+/// @brief 由工作线程读出的文件内容创建管线缓存（随后释放该内容），并创建 uniform 环形缓冲
+/// 与引用其描述符集布局的管线布局.
+static bool create_pipeline_cache_objects(RenderContext* pContext)
+{
+    pContext->pipelineCache = create_pipeline_cache(pContext->physicalDevice,
+                                  pContext->device,
+                                  &pContext->pipelineCacheData);
+    free_pipeline_cache_data(&pContext->pipelineCacheData);
+    if (pContext->pipelineCache == VK_NULL_HANDLE)
+        return false;
+
+    if (!create_uniform_ring(pContext->physicalDevice, pContext->device, pContext->directWrite,
+            &pContext->uniformRing))
+        return false;
+
+    pContext->pipelineLayout = createPipelineLayout(pContext->device,
+                                   1, &pContext->uniformRing.setLayout,
+                                   sizeof(MeshPushConstants),
+                                   VK_SHADER_STAGE_VERTEX_BIT);
+    if (pContext->pipelineLayout == VK_NULL_HANDLE)
+        return false;
+
+    pContext->computePipelineLayout = createPipelineLayout(pContext->device,
+                                          0, NULL,
+                                          COMPUTE_PUSH_CONSTANT_SIZE,
+                                          VK_SHADER_STAGE_COMPUTE_BIT);
+    if (pContext->computePipelineLayout == VK_NULL_HANDLE)
+        return false;
+
+    create_pipeline_library_cache(pContext->device,     // 管线库部分在首次创建表面管线时才编译
+        pContext->pipelineCache,
+        pContext->pipelineLayout,
+        pContext->graphicsPipelineLibrary,
+        pContext->bufferDeviceAddress,
+        &pContext->pipelineLibraries);
+
+    return true;
+}
+
+/// @brief 图形管线任务的入口，只写入主表面的 `trianglePipeline`（失败时保持为 `NULL`）.
+static void create_pipeline_task(void* pArg)
+{
+    RenderContext* pContext = (RenderContext*)pArg;
+    uint64_t traceStart = trace_begin();
+
+    create_surface_pipeline(pContext, &pContext->surfaces[0]);
+
+    trace_end("create_surface_pipeline", traceStart);
+}
+
+/// @brief 一个预编译任务的参数.
+typedef struct PrecompileTask {
+    RenderContext*      pContext;
+    PipelineKey         key;
+} PrecompileTask;
+
+/// @brief 按首次使用的顺序提交上一次运行记录的管线的预编译.
+///
+/// 任务经由先进先出的外部队列提交（创建者线程自己的队列后进先出），无论由哪个线程取出，
+/// 越早用到的管线越先开始编译. 主表面格式的管线正由 create_pipeline_task 创建，跳过.
+static void precompile_recorded_pipelines(RenderContext* pContext, const SurfaceContext* pMainSurface)
+{
+    const PipelineUsageLog* pUsage = &pContext->pipelineUsage;
+    if (pUsage->count == 0)
+        return;
+
+    PrecompileTask* pTasks = (PrecompileTask*)arena_calloc(&pContext->arena,
+                                 pUsage->count, sizeof(PrecompileTask));
+    if (pTasks == NULL)
+        return;
+
+    JobDecl decls[PIPELINE_USAGE_MAX_KEYS];
+    uint32_t taskCount = 0;
+    for (uint32_t i = 0; i < pUsage->count; i++)
+    {
+        if (pUsage->keys[i].colorFormat == (uint32_t)pMainSurface->swapchainImageFormat)
+            continue;
+
+        pTasks[taskCount].pContext  = pContext;
+        pTasks[taskCount].key       = pUsage->keys[i];
+        decls[taskCount].func       = precompile_pipeline_task;
+        decls[taskCount].pArg       = &pTasks[taskCount];
+        taskCount++;
+    }
+
+    if (taskCount > 0)
+        job_system_run_batch_ordered(&pContext->jobs, decls, taskCount, &pContext->precompileJob);
+}
+
+/// @brief 预编译任务的入口.
+static void precompile_pipeline_task(void* pArg)
+{
+    PrecompileTask* pTask = (PrecompileTask*)pArg;
+    uint64_t traceStart = trace_begin();
+
+    precompile_surface_pipeline(pTask->pContext, &pTask->key);
+
+    trace_end("precompile_pipeline", traceStart);
+}
+
+/// @brief 记录表面管线的一次使用（只在录制命令的线程上调用）.
+static inline void record_pipeline_use(RenderContext* pContext, const SurfaceContext* pSurface, PipelineKind kind)
+{
+    pipeline_usage_record(&pContext->pipelineUsage, kind, pSurface->swapchainImageFormat);
+}
+
+/// @brief 使给定表面的渲染通道成为当前录制的渲染通道（结束上一个表面的渲染通道），
+/// 并设置视口与裁剪矩形.
+///
+/// @param contents 为 `VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS` 时渲染通道只能执行二级
+/// 命令缓冲（视口与裁剪矩形由二级命令缓冲自行设置）
+///
+/// @return 该表面本帧可以绘制时返回 `true`；表面未获取到图像，或其渲染通道本帧已经录制
+/// 并结束（再次开始会重新清屏）时返回 `false`
+static bool begin_surface_pass(
+    RenderContext*      pContext,
+    SurfaceContext*     pSurface,
+    VkSubpassContents   contents
+)
+{
+    if (!pSurface->acquired)
+        return false;
+
+    if (pContext->computeContext.recording)
+    {
+        fprintf(stderr, "%s : 计算通道尚未结束！\n", __func__);
+        return false;
+    }
+
+    if (pContext->pRecordingSurface == pSurface)
+        return true;
+
+    if (pSurface->passRecorded)
+    {
+        fprintf(stderr, "%s : 该表面的渲染通道本帧已经录制，同一帧中的绘制需按表面分组！\n",
+            __func__);
+        return false;
+    }
+
+    VkCommandBuffer commandBuffer = current_frame_data(&pContext->frameContext)->commandBuffer;
+
+    if (pContext->pRecordingSurface != NULL)
+        end_surface_pass(pContext, commandBuffer);
+
+    // 1.开始渲染通道
+    VkRenderPassBeginInfo renderPassInfo = {};
+    renderPassInfo.sType                = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass           = pSurface->renderPass;
+    renderPassInfo.framebuffer          = pSurface->swapchainFramebuffers[pSurface->imageIndex];
+    renderPassInfo.renderArea.offset    = (VkOffset2D){0, 0};
+    renderPassInfo.renderArea.extent    = pSurface->swapchainExtent;
+    renderPassInfo.clearValueCount      = 1;
+    renderPassInfo.pClearValues         = &clearColor;
+
+    pContext->passTraceScope = gpu_trace_begin(&pContext->gpuTrace, commandBuffer, "render pass");
+    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
+
+    // 2.视口与裁剪矩形为管线的动态状态
+    if (contents == VK_SUBPASS_CONTENTS_INLINE)
+        set_surface_viewport(commandBuffer, pSurface);
+
+    pContext->pRecordingSurface = pSurface;
+    pSurface->passRecorded      = true;
+
+    return true;
+}
+
+/// @brief 结束当前录制的渲染通道及其 GPU 追踪区间.
+static void end_surface_pass(RenderContext* pContext, VkCommandBuffer commandBuffer)
+{
+    vkCmdEndRenderPass(commandBuffer);
+    gpu_trace_end(&pContext->gpuTrace, commandBuffer, pContext->passTraceScope);
+
+    pContext->pRecordingSurface = NULL;
+}
+
+/// @brief 把视口与裁剪矩形设置为表面的整个渲染区域.
+static void set_surface_viewport(VkCommandBuffer commandBuffer, const SurfaceContext* pSurface)
+{
+    VkViewport viewport = {};
+    viewport.x          = 0.0f;
+    viewport.y          = 0.0f;
+    viewport.width      = (float)pSurface->swapchainExtent.width;
+    viewport.height     = (float)pSurface->swapchainExtent.height;
+    viewport.minDepth   = 0.0f;
+    viewport.maxDepth   = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor = {};
+    scissor.offset  = (VkOffset2D){0, 0};
+    scissor.extent  = pSurface->swapchainExtent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+}
+
+/// @brief 获取当前帧、当前交换链图像的静态通道二级命令缓冲，版本过期时重新录制.
+///
+/// 当前帧的栅栏已在 begin_frame 中等待，因此该帧槽位的命令缓冲不会仍在执行，可以直接重新录制.
+///
+/// @return 命令缓冲，分配或录制失败时返回 `NULL`
+static VkCommandBuffer get_static_command_buffer(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+
+    // 1.首次使用时为每个（在途帧, 交换链图像）分配一个二级命令缓冲
+    uint32_t bufferCount = MAX_FRAMES_IN_FLIGHT * pSurface->swapchainImageCount;
+    if (pSurface->staticCommandBuffers == NULL)
+    {
+        VkCommandBuffer* pBuffers = (VkCommandBuffer*)arena_calloc(&pSurface->swapchainArena,
+                                        bufferCount, sizeof(VkCommandBuffer));
+        uint64_t* pVersions = (uint64_t*)arena_calloc(&pSurface->swapchainArena,
+                                  bufferCount, sizeof(uint64_t));
+        if (pBuffers == NULL || pVersions == NULL)
+            return VK_NULL_HANDLE;
+
+        VkCommandBufferAllocateInfo allocateInfo = {};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool        = pFrameContext->commandPool;
+        allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = bufferCount;
+
+        VkResult result = vkAllocateCommandBuffers(pContext->device, &allocateInfo, pBuffers);
+        if (result != VK_SUCCESS)
+        {
+            fprintf(stderr,
+                "Failed to allocate secondary command buffers! Error Code(VkResult): %d\n", result);
+            return VK_NULL_HANDLE;
+        }
+
+        pSurface->staticCommandBuffers  = pBuffers;
+        pSurface->staticVersions        = pVersions;
+    }
+
+    uint32_t slot = pFrameContext->currentFrame * pSurface->swapchainImageCount + pSurface->imageIndex;
+    VkCommandBuffer commandBuffer = pSurface->staticCommandBuffers[slot];
+    if (pSurface->staticVersions[slot] == pContext->staticPassVersion)
+        return commandBuffer;
+
+    // 2.版本过期：在渲染通道内继续录制（指定帧缓冲，驱动可据此优化）
+    VkCommandBufferInheritanceInfo inheritanceInfo = {};
+    inheritanceInfo.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass  = pSurface->renderPass;
+    inheritanceInfo.subpass     = 0;
+    inheritanceInfo.framebuffer = pSurface->swapchainFramebuffers[pSurface->imageIndex];
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo  = &inheritanceInfo;
+
+    VkResult result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to begin recording a secondary command buffer! Error Code(VkResult): %d\n", result);
+        return VK_NULL_HANDLE;
+    }
+
+    set_surface_viewport(commandBuffer, pSurface);  // 动态状态与描述符集不会从主命令缓冲继承
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+        pContext->pipelineLayout,
+        0, 1, &pContext->uniformRing.descriptorSet,
+        1, &pContext->uniformRing.defaultOffset);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pSurface->trianglePipeline);
+    record_pipeline_use(pContext, pSurface, PIPELINE_KIND_TRIANGLE);
+    vkCmdDraw(commandBuffer, 3 * pSurface->staticTriangleCount, 1, 0, 0);
+
+    result = vkEndCommandBuffer(commandBuffer);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to record a secondary command buffer! Error Code(VkResult): %d\n", result);
+        return VK_NULL_HANDLE;
+    }
+
+    pSurface->staticVersions[slot] = pContext->staticPassVersion;
+
+    return commandBuffer;
+}
+
+
+/// @brief 录制挂起的拉取网格绘制（若有），然后清空.
+static void record_merged_draw(VkCommandBuffer commandBuffer, uint32_t* pFirst, uint32_t* pCount)
+{
+    if (*pCount == 0)
+        return;
+
+    vkCmdDraw(commandBuffer, *pCount, 1, *pFirst, 0);
+    *pCount = 0;
+}
+
+
+/// @brief 放弃录制或提交失败的一帧：提交一个空批次，等待本帧获取图像（及异步计算）的信号量
+/// 并触发该帧的栅栏，使信号量回到未触发状态、下一次等待栅栏不会永久阻塞.
+static void abandon_frame(RenderContext* pContext)
+{
+    FrameContext* pFrameContext = &pContext->frameContext;
+    FrameData* pFrame = current_frame_data(pFrameContext);
+
+    VkSemaphore             waitSemaphores[MAX_SURFACES + 1];
+    VkPipelineStageFlags    waitStages[MAX_SURFACES + 1];
+    uint32_t                waitCount = 0;
+
+    for (uint32_t i = 0; i < MAX_SURFACES; i++)
+    {
+        SurfaceContext* pSurface = &pContext->surfaces[i];
+        if (!pSurface->acquired)
+            continue;
+
+        pSurface->acquired = false;
+        if (pSurface->headless)
+            continue;
+
+        waitSemaphores[waitCount]   = pSurface->imageAvailableSemaphores[pFrameContext->currentFrame];
+        waitStages[waitCount]       = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        waitCount++;
+    }
+
+    if (pContext->computeContext.submitted)
+    {
+        waitSemaphores[waitCount]   = 
+            pContext->computeContext.finishedSemaphores[pFrameContext->currentFrame];
+        waitStages[waitCount]       = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        waitCount++;
+        pContext->computeContext.submitted = false;
+    }
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount   = waitCount;
+    submitInfo.pWaitSemaphores      = waitSemaphores;
+    submitInfo.pWaitDstStageMask    = waitStages;
+
+    vkResetFences(pContext->device, 1, &pFrame->inFlightFence);
+
+    VkResult result = vkQueueSubmit(pContext->graphicsQueue, 1, &submitInfo, pFrame->inFlightFence);
+    if (result != VK_SUCCESS)
+        fprintf(stderr,
+            "Failed to submit an empty batch for the abandoned frame! Error Code(VkResult): %d\n", result);
+}
@@ -1,33 +1,99 @@
 #pragma once
 
 #include "../common/ansi_esc.h"
+#include "../common/arena.h"
+#include "../common/frame_limiter.h"
+#include "../common/job_system.h"
 #include "vulkan_wrapper.h"
+#include "frame_context.h"
+#include "readback.h"
+#include "pipeline.h"
+#include "pipeline_cache.h"
+#include "surface_context.h"
+#include "compute_context.h"
+#include "uniform_ring.h"
+#include "scene_store.h"
+#include "resource_table.h"
+#include "draw_queue.h"
+#include "mesh_defrag.h"
+#include "gpu_trace.h"
+#include "vulkan_loader.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <GLFW/glfw3.h>
-#include <vulkan/vulkan.h>
+
+/// @brief 渲染上下文 Arena 的容量（RenderContext 自身、帧 Arena 与每个表面的交换链 Arena
+/// 均从中分配）.
+#define RENDER_CONTEXT_ARENA_SIZE   (256 * 1024)
+/// @brief 每帧临时 Arena 的容量（屏障数组等只在录制当前帧时使用的数据）.
+#define FRAME_ARENA_SIZE            (64 * 1024)
+/// @brief DEVICE_LOCAL | HOST_VISIBLE 的堆不小于该大小时，动态数据直接写入显存.
+///
+/// 未开启 ReBAR 的独立显卡也有这类堆，但只有 256 MiB 的 BAR 窗口，不足以容纳所有动态数据.
+#define DIRECT_WRITE_MIN_HEAP_SIZE  (512ull * 1024 * 1024)
 
 /// @brief 渲染上下文结构体，使用 new_render_context 获取一个该结构体句柄.
+///
+/// 渲染上下文即共享的设备上下文：实例、设备、队列、管线缓存与布局、命令缓冲与栅栏
+/// 只有一份，每个窗口（表面）各自拥有一个 SurfaceContext（交换链、渲染通道、帧缓冲与管线）.
+///
+/// 上下文只有一次堆分配：RenderContext 自身及其所有数组都来自 `arena`.
 typedef struct RenderContext {
-    GLFWwindow*         window;
+    Arena               arena;                      // 上下文生命周期的 Arena
+    Arena               frameArena;                 // 每次 begin_frame 时整体重置
+
+    bool                headless;                   // 无头模式：渲染到离屏图像，不呈现
 
     VkInstance          instance;
-    VkSurfaceKHR        surface;
     
     VkPhysicalDevice    physicalDevice;
     VkDevice            device;
     VkQueue             graphicsQueue;
     VkQueue             presentationQueue;
+    uint32_t            graphicsQueueFamilyIndex;
+    uint32_t            presentationQueueFamilyIndex;
+    VkQueue             computeQueue;               // 没有专用计算队列族时即 graphicsQueue
+    uint32_t            computeQueueFamilyIndex;
+    bool                bufferDeviceAddress;        // 设备启用了 bufferDeviceAddress 特性（顶点拉取路径可用）
+    bool                graphicsPipelineLibrary;    // 设备启用了 graphicsPipelineLibrary 特性（表面管线快速链接）
+    bool                directWrite;                // 有足够大的 DEVICE_LOCAL | HOST_VISIBLE 内存（ReBAR / 统一内存），
+                                                    // 动态缓冲与 uniform 环形缓冲由 CPU 直接写入显存
+
+    VkPipelineCache     pipelineCache;
+    VkPipelineLayout    pipelineLayout;             // set 0 为 uniform 环形缓冲，推送常量为 MeshPushConstants
+    VkPipelineLayout    computePipelineLayout;      // 计算管线共用：没有描述符集，COMPUTE_PUSH_CONSTANT_SIZE 字节的推送常量
+    PipelineLibraryCache pipelineLibraries;         // 按颜色格式缓存的管线库部分
+    PipelineUsageLog    pipelineUsage;              // 实际绑定过的表面管线，销毁时写回记录文件
+    UniformRing         uniformRing;
+    SceneStore          scene;                      // 每帧开始时上传其待上传范围
+    ResourceTable       resources;                  // 以句柄交给 C# 的缓冲、计算管线与网格
+    MeshArena           meshArena;                  // 顶点拉取网格的顶点与索引
+    MeshDefragmenter    meshDefrag;                 // 每帧在预算内把网格搬移到更少的块中
+    DrawQueue           drawQueue;                  // 本帧排队的绘制，在 end_frame 中排序并录制
+
+    SurfaceContext      surfaces[MAX_SURFACES];     // 槽位 0 为主表面（帧回读的来源）
+    SurfaceContext*     pRecordingSurface;          // 当前帧中正在录制其渲染通道的表面
+    uint32_t            passTraceScope;             // 该渲染通道的 GPU 追踪区间
 
-    VkSwapchainKHR      swapchain;
-    uint32_t            swapchainImageCount;
-    VkImage*            swapchainImages;
-    VkFormat            swapchainImageFormat;
-    VkExtent2D          swapchainExtent;
-    VkImageView*        swapchainImageViews;
+    FrameContext        frameContext;
+    GpuTrace            gpuTrace;                   // 追踪开启时记录每帧各阶段的 GPU 时间戳
+    ComputeContext      computeContext;
+    ReadbackRing        readbackRing;
+
+    uint64_t            staticPassVersion;          // 场景 / 管线 / 交换链变化时递增，使静态通道重新录制
+
+    JobSystem           jobs;                       // 由 new_render_context 创建，各子系统共用
+    FrameLimiter        frameLimiter;               // 在 end_frame 中呈现之前等待
+    JobCounter          precompileJob;              // 预编译上一次运行记录的管线，销毁上下文前等待
+
+    // 以下仅在构建期间使用
+    JobCounter          initJob;                    // 读取管线缓存文件（预初始化时还创建实例）
+    JobCounter          pipelineJob;                // 创建主表面的图形管线，与交换链的创建重叠
+    bool                initCreatesInstance;        // 是否已调用 preinitialize_render_context
+    PipelineCacheData   pipelineCacheData;          // 管线缓存文件内容，创建管线缓存后即释放
 } RenderContext;
 
 
@@ -36,6 +102,15 @@ typedef struct RenderContext {
 /// @return 一个新的 RenderContext 的句柄，发生错误时返回 `NULL`
 RenderContext* new_render_context();
 
+/// @brief 在工作线程上提前创建 VkInstance、促使加载器初始化驱动并读取管线缓存文件，
+/// 使其与窗口的创建重叠.
+///
+/// 需要在 glfwInit 之后调用（窗口扩展的查询依赖于它）；之后的 create_render_context
+/// 会等待其完成并使用其创建的实例.
+///
+/// @return 成功开始预初始化时返回 `true`
+bool preinitialize_render_context(RenderContext* pContext);
+
 /// @brief 给定一个渲染上下文然后对其进行初始化构建.
 ///
 /// @param window 构建渲染上下文需要对应的窗口句柄
@@ -44,6 +119,141 @@ RenderContext* new_render_context();
 /// @return 当构建成功时返回 `true`，若发生错误则会终止构建（相关函数会输出信息）并返回 `false`
 bool create_render_context(GLFWwindow* window, RenderContext* pContext);
 
+/// @brief 以无头模式初始化构建渲染上下文：不创建窗口表面与交换链，而是渲染到一张离屏图像.
+///
+/// 无头模式下 begin_frame / end_frame 不获取也不呈现交换链图像，帧回读照常可用，
+/// 可在没有窗口系统的环境（如 lavapipe）中运行.
+///
+/// @param extent 离屏图像的大小
+/// @param pContext 目标渲染上下文句柄
+///
+/// @return 当构建成功时返回 `true`，否则返回 `false`
+bool create_headless_render_context(VkExtent2D extent, RenderContext* pContext);
+
 /// @brief 给定渲染上下文句柄，销毁其（除了窗口句柄外的）所有上下文对象，同时销毁自身释放内存
 /// @param pContext 要销毁的渲染上下文句柄
-void destroy_render_context(RenderContext* pContext);
\ No newline at end of file
+void destroy_render_context(RenderContext* pContext);
+
+/// @brief 为另一个窗口创建表面（交换链等），与已有的表面共享设备.
+///
+/// 不能在 begin_frame 与 end_frame 之间调用.
+///
+/// @return 表面的槽位索引，没有空闲槽位、presentation 队列不支持该窗口或发生错误时返回 -1
+int add_render_surface(RenderContext* pContext, GLFWwindow* window);
+
+/// @brief 销毁给定槽位的表面（会等待 GPU 空闲，不能在 begin_frame 与 end_frame 之间调用）.
+void remove_render_surface(RenderContext* pContext, int surfaceIndex);
+
+/// @brief 资源在此刻被销毁或替换时，可能使用它的最后一次提交的序号（即下一次提交）.
+static inline uint64_t resource_retire_serial(const RenderContext* pContext)
+{
+    return pContext->frameContext.submittedSerial + 1;
+}
+
+/// @brief 开始一帧：等待该帧的栅栏，为每个表面获取交换链图像并开始录制命令缓冲.
+///
+/// 获取失败（如交换链过期，此时会被重建）的表面在本帧被跳过.
+///
+/// @return 至少有一个表面可以渲染时返回 `true`；否则（或发生错误时）返回 `false`，
+/// 此时不应调用 end_frame
+bool begin_frame(RenderContext* pContext);
+
+/// @brief 结束一帧：为本帧尚未绘制的表面录制清屏，录制挂起的回读拷贝，一次提交全部命令，
+/// 并用一次 vkQueuePresentKHR 呈现所有交换链.
+void end_frame(RenderContext* pContext);
+
+/// @brief 在当前帧中用三角形管线向给定表面绘制 `count` 个三角形（需在 begin_frame 与
+/// end_frame 之间调用），各三角形按顺序在网格中错开（见 triangle.vert）.
+///
+/// 每个表面的渲染通道每帧只录制一次，因此同一帧中对各表面的绘制需按表面分组.
+void draw_triangles(RenderContext* pContext, int surfaceIndex, uint32_t count);
+
+/// @brief 排序并录制本帧绘制队列中的命令，然后清空队列（需在 begin_frame 与 end_frame 之间调用，
+/// end_frame 也会自动调用）.
+///
+/// 命令按状态键排序后依次录制，只在管线、uniform 偏移或网格与上一条绘制不同时才重新绑定.
+/// 各表面的命令被分组录制；本帧已立即绘制并结束渲染通道的表面，其排队的命令被跳过.
+void flush_draw_queue(RenderContext* pContext);
+
+/// @brief 设置表面的静态通道内容（`count` 个三角形），为 0 时取消静态通道.
+///
+/// 不能在 begin_frame 与 end_frame 之间调用.
+void set_static_pass(RenderContext* pContext, int surfaceIndex, uint32_t count);
+
+/// @brief 在当前帧中以预先录制的二级命令缓冲绘制表面的静态通道（需在 begin_frame 与 end_frame
+/// 之间调用，且该表面本帧没有其他绘制）.
+///
+/// 每个（在途帧, 交换链图像）组合各缓存一个二级命令缓冲，只在 invalidate_static_passes
+/// 之后或交换链重建后重新录制，稳定状态下每帧只需开始渲染通道并执行该命令缓冲.
+/// 静态通道中不能使用每帧变化的 uniform 偏移.
+void draw_static_pass(RenderContext* pContext, int surfaceIndex);
+
+/// @brief 使所有表面的静态通道在下一次绘制时重新录制（场景、管线或交换链变化时调用）.
+static inline void invalidate_static_passes(RenderContext* pContext)
+{
+    pContext->staticPassVersion++;
+}
+
+/// @brief 获取计算与图形之间共享的资源的队列族索引（传给 createBuffer）.
+///
+/// @param pIndices 输出参数，至少 2 个元素
+///
+/// @return 队列族数：使用异步计算时为 2，否则为 0（以 EXCLUSIVE 模式创建即可）
+static inline uint32_t get_shared_queue_families(const RenderContext* pContext, uint32_t* pIndices)
+{
+    if (!pContext->computeContext.async)
+        return 0;
+
+    pIndices[0] = pContext->graphicsQueueFamilyIndex;
+    pIndices[1] = pContext->computeQueueFamilyIndex;
+
+    return 2;
+}
+
+/// @brief 由 SPIR-V 字节码创建计算管线并加入资源表（使用 computePipelineLayout）.
+///
+/// @return 管线的句柄，失败时返回 `RESOURCE_INVALID_HANDLE`
+ResourceHandle create_compute_pipeline(RenderContext* pContext, const uint32_t* pCode, size_t codeSize);
+
+/// @brief 在当前帧中开始一个计算通道（需在 begin_frame 之后、向任何表面绘制之前调用）.
+///
+/// @return 录制计算命令用的命令缓冲（有专用计算队列族时属于 compute 队列，否则即该帧的
+/// 图形命令缓冲），无法开始时返回 `NULL`
+VkCommandBuffer begin_compute_pass(RenderContext* pContext);
+
+/// @brief 在当前计算通道中录制一次调度.
+///
+/// 同一通道中相邻的调度之间插入屏障，后一次调度可以读取前一次的写入.
+///
+/// @param pipeline 由 create_compute_pipeline 创建的管线句柄
+/// @param pConstants 推送常量（缓冲以设备地址传入），`constantSize` 为 0 时可为 `NULL`
+/// @param constantSize 推送常量的字节数，不超过 `COMPUTE_PUSH_CONSTANT_SIZE`
+///
+/// @return 成功录制时返回 `true`
+bool dispatch_compute(
+    RenderContext*  pContext,
+    ResourceHandle  pipeline,
+    const void*     pConstants,
+    uint32_t        constantSize,
+    uint32_t        groupCountX,
+    uint32_t        groupCountY,
+    uint32_t        groupCountZ
+);
+
+/// @brief 结束计算通道.
+///
+/// 使用异步计算时立即提交到 compute 队列，本帧的图形提交只在 `waitStage` 阶段等待其完成，
+/// 此前的工作（以及上一帧仍在执行的渲染）与计算并行；否则在图形命令缓冲中插入
+/// 计算写入 -> `waitStage` 读取的管线屏障.
+///
+/// @param waitStage 图形工作中首个读取计算结果的阶段（如 `VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT`、
+/// `VK_PIPELINE_STAGE_VERTEX_INPUT_BIT`）
+///
+/// @return 成功时返回 `true`
+bool end_compute_pass(RenderContext* pContext, VkPipelineStageFlags waitStage);
+
+/// @brief 在当前帧中绑定 uniform 环形缓冲的描述符集（set 0），后续绘制从 `dynamicOffset` 处读取
+/// 其 uniform 数据（需在 begin_frame 与 end_frame 之间调用）.
+///
+/// @param dynamicOffset uniform_ring_alloc / uniform_ring_push 返回的偏移
+void bind_uniforms(RenderContext* pContext, uint32_t dynamicOffset);
@@ -0,0 +1,438 @@
+#include "resource_table.h"
+#include "memory_budget.h"
+
+#include <string.h>
+
+static ResourceSlot* find_slot(const ResourceTable* pTable, ResourceHandle handle);
+static bool retire(
+    ResourceTable*      pTable,
+    ResourceType        type,
+    const ResourceData* pData,
+    uint64_t            serial,
+    uint32_t            slot
+);
+static void destroy_resource_data(
+    ResourceTable*      pTable,
+    VkDevice            device,
+    ResourceType        type,
+    ResourceData*       pData,
+    uint64_t            serial
+);
+static void unregister_streamable(ResourceSlot* pSlot);
+static void evict_streamable(void* pUserData, uint64_t handle);
+
+
+bool create_resource_table(uint32_t capacity, ResourceTable* pTable)
+{
+    memset(pTable, 0, sizeof(ResourceTable));
+
+    if (capacity == 0 || capacity > RESOURCE_HANDLE_INDEX_MASK)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！容量需在 1 到 %u 之间.\n",
+            __func__, RESOURCE_HANDLE_INDEX_MASK);
+        return false;
+    }
+
+    size_t arenaSize = capacity * (sizeof(ResourceSlot) + sizeof(uint32_t) + sizeof(RetiredResource))
+                     + 3 * 64;
+    if (!arena_init(&pTable->arena, arenaSize))
+        return false;
+
+    pTable->capacity    = capacity;
+    pTable->pSlots      = (ResourceSlot*)arena_calloc(&pTable->arena, capacity, sizeof(ResourceSlot));
+    pTable->pFreeList   = (uint32_t*)arena_alloc(&pTable->arena, capacity * sizeof(uint32_t), 64);
+    pTable->pRetired    = (RetiredResource*)arena_alloc(&pTable->arena,
+                              capacity * sizeof(RetiredResource), 64);
+    if (pTable->pSlots == NULL || pTable->pFreeList == NULL || pTable->pRetired == NULL)
+    {
+        arena_release(&pTable->arena);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < capacity; i++)
+        pTable->pSlots[i].generation = 1;
+
+    return true;
+}
+
+
+void destroy_resource_table(VkDevice device, ResourceTable* pTable)
+{
+    if (pTable->pSlots != NULL && device != VK_NULL_HANDLE)
+    {
+        resource_table_collect(pTable, device, UINT64_MAX);
+
+        // 再把所有存活资源送入待销毁队列，再一次性全部销毁（网格的缓冲本身也在表中，跳过网格）
+        for (uint32_t i = 0; i < pTable->count; i++)
+        {
+            ResourceSlot* pSlot = &pTable->pSlots[i];
+            if (pSlot->type != RESOURCE_TYPE_NONE && pSlot->type != RESOURCE_TYPE_MESH
+                && pSlot->resident)
+                retire(pTable, pSlot->type, &pSlot->data, 0, UINT32_MAX);
+        }
+
+        resource_table_collect(pTable, device, UINT64_MAX);
+    }
+
+    arena_release(&pTable->arena);
+    memset(pTable, 0, sizeof(ResourceTable));
+}
+
+
+ResourceHandle resource_table_insert(ResourceTable* pTable, ResourceType type, const ResourceData* pData)
+{
+    uint32_t index;
+    if (pTable->freeCount > 0)
+        index = pTable->pFreeList[--pTable->freeCount];
+    else if (pTable->count < pTable->capacity)
+        index = pTable->count++;
+    else
+    {
+        fprintf(stderr, "%s : 资源表已满（%u）！\n", __func__, pTable->capacity);
+        return RESOURCE_INVALID_HANDLE;
+    }
+
+    ResourceSlot* pSlot = &pTable->pSlots[index];
+    pSlot->data         = *pData;
+    pSlot->type         = type;
+    pSlot->resident     = true;
+    pSlot->streamable   = STREAMABLE_INVALID_HANDLE;
+
+    pTable->liveCounts[type]++;
+
+    return ((ResourceHandle)pSlot->generation << 32)
+         | ((ResourceHandle)type << RESOURCE_HANDLE_INDEX_BITS)
+         | index;
+}
+
+
+ResourceData* resource_table_get(ResourceTable* pTable, ResourceHandle handle, ResourceType type)
+{
+    ResourceSlot* pSlot = find_slot(pTable, handle);
+    if (pSlot == NULL || pSlot->type != type)
+    {
+        if (handle != RESOURCE_INVALID_HANDLE)
+            fprintf(stderr, "%s : 句柄 0x%016llx 已过期或类型不符（需要类型 %d）！\n",
+                __func__, (unsigned long long)handle, type);
+        return NULL;
+    }
+
+    return pSlot->resident ? &pSlot->data : NULL;
+}
+
+
+ResourceHandle resource_table_handle_at(const ResourceTable* pTable, uint32_t index)
+{
+    if (index >= pTable->count || pTable->pSlots[index].type == RESOURCE_TYPE_NONE)
+        return RESOURCE_INVALID_HANDLE;
+
+    const ResourceSlot* pSlot = &pTable->pSlots[index];
+
+    return ((ResourceHandle)pSlot->generation << 32)
+         | ((ResourceHandle)pSlot->type << RESOURCE_HANDLE_INDEX_BITS)
+         | index;
+}
+
+
+bool resource_table_is_alive(const ResourceTable* pTable, ResourceHandle handle)
+{
+    return find_slot(pTable, handle) != NULL;
+}
+
+
+void resource_table_release(ResourceTable* pTable, ResourceHandle handle, uint64_t serial)
+{
+    ResourceSlot* pSlot = find_slot(pTable, handle);
+    if (pSlot == NULL)
+        return;
+
+    uint32_t index = (uint32_t)(handle & RESOURCE_HANDLE_INDEX_MASK);
+
+    // 被驱逐的资源没有底层对象，槽位可以立即回收；待销毁队列已满时资源保持存活
+    if (!pSlot->resident)
+        pTable->pFreeList[pTable->freeCount++] = index;
+    else if (!retire(pTable, pSlot->type, &pSlot->data, serial, index))
+        return;
+
+    unregister_streamable(pSlot);
+
+    pTable->liveCounts[pSlot->type]--;
+
+    // 代数递增使旧句柄立即失效，回绕时跳过 0 以保证句柄永远不等于 RESOURCE_INVALID_HANDLE
+    pSlot->generation   = pSlot->generation + 1 == 0 ? 1 : pSlot->generation + 1;
+    pSlot->type         = RESOURCE_TYPE_NONE;
+    pSlot->resident     = false;
+}
+
+
+bool resource_table_replace(
+    ResourceTable*      pTable,
+    ResourceHandle      handle,
+    const ResourceData* pData,
+    uint64_t            serial
+)
+{
+    ResourceSlot* pSlot = find_slot(pTable, handle);
+    if (pSlot == NULL)
+        return false;
+
+    if (pSlot->resident && !retire(pTable, pSlot->type, &pSlot->data, serial, UINT32_MAX))
+        return false;
+
+    unregister_streamable(pSlot);               // 新对象的内存不同，需重新注册
+
+    pSlot->data     = *pData;
+    pSlot->resident = true;
+
+    return true;
+}
+
+
+void resource_table_evict(ResourceTable* pTable, ResourceHandle handle, uint64_t serial)
+{
+    ResourceSlot* pSlot = find_slot(pTable, handle);
+    if (pSlot == NULL || !pSlot->resident)
+        return;
+
+    if (!retire(pTable, pSlot->type, &pSlot->data, serial, UINT32_MAX))
+        return;
+
+    unregister_streamable(pSlot);
+
+    memset(&pSlot->data, 0, sizeof(ResourceData));
+    pSlot->resident = false;
+}
+
+
+bool resource_table_is_resident(const ResourceTable* pTable, ResourceHandle handle)
+{
+    const ResourceSlot* pSlot = find_slot(pTable, handle);
+
+    return pSlot != NULL && pSlot->resident;
+}
+
+
+bool resource_table_make_streamable(ResourceTable* pTable, ResourceHandle handle)
+{
+    ResourceSlot* pSlot = find_slot(pTable, handle);
+    if (pSlot == NULL || !pSlot->resident || pSlot->type != RESOURCE_TYPE_BUFFER
+        || pSlot->streamable != STREAMABLE_INVALID_HANDLE
+        || pSlot->data.buffer.pMapped != NULL || pSlot->data.buffer.address != 0
+        || !memory_budget_is_device_local(pSlot->data.buffer.memory)
+        || pTable->device == VK_NULL_HANDLE)
+        return false;
+
+    pSlot->streamable = memory_budget_register_streamable(pSlot->data.buffer.memory,
+                            evict_streamable, pTable, handle);
+
+    return pSlot->streamable != STREAMABLE_INVALID_HANDLE;
+}
+
+
+void resource_table_touch(ResourceTable* pTable, ResourceHandle handle, uint64_t serial)
+{
+    ResourceSlot* pSlot = find_slot(pTable, handle);
+    if (pSlot != NULL)
+        memory_budget_touch_streamable(pSlot->streamable, serial);
+}
+
+
+bool resource_table_retire(
+    ResourceTable*      pTable,
+    ResourceType        type,
+    const ResourceData* pData,
+    uint64_t            serial
+)
+{
+    return retire(pTable, type, pData, serial, UINT32_MAX);
+}
+
+
+ResourceHandle resource_table_create_buffer(
+    ResourceTable*          pTable,
+    VkPhysicalDevice        physicalDevice,
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    bool                    hostVisible,
+    bool                    preferDeviceLocal,
+    MemoryCategory          category,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices
+)
+{
+    ResourceData data = {};
+    data.buffer.size    = size;
+    data.buffer.usage   = usage;
+
+    bool created = hostVisible
+        ? createHostWritableBuffer(physicalDevice, device, size, usage, preferDeviceLocal, category,
+              queueFamilyIndexCount, pQueueFamilyIndices, &data.buffer.buffer, &data.buffer.memory)
+        : createBuffer(physicalDevice, device, size, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, category,
+              queueFamilyIndexCount, pQueueFamilyIndices, &data.buffer.buffer, &data.buffer.memory);
+    if (!created)
+        return RESOURCE_INVALID_HANDLE;
+
+    if (hostVisible)
+    {
+        VkResult result = vkMapMemory(device, data.buffer.memory, 0, VK_WHOLE_SIZE, 0,
+                              &data.buffer.pMapped);
+        if (result != VK_SUCCESS)
+        {
+            fprintf(stderr,
+                "Failed to map buffer memory! Error Code(VkResult): %d\n", result);
+            destroyBuffer(device, data.buffer.buffer, data.buffer.memory);
+            return RESOURCE_INVALID_HANDLE;
+        }
+    }
+
+    if (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+        data.buffer.address = getBufferDeviceAddress(device, data.buffer.buffer);
+
+    ResourceHandle handle = resource_table_insert(pTable, RESOURCE_TYPE_BUFFER, &data);
+    if (handle == RESOURCE_INVALID_HANDLE)
+    {
+        if (data.buffer.pMapped != NULL)
+            vkUnmapMemory(device, data.buffer.memory);
+        destroyBuffer(device, data.buffer.buffer, data.buffer.memory);
+    }
+
+    return handle;
+}
+
+
+void resource_table_collect(ResourceTable* pTable, VkDevice device, uint64_t completedSerial)
+{
+    // 销毁网格时会向队列末尾追加其缓冲（序号与网格相同），它们会在同一次遍历中被处理
+    uint32_t i = 0;
+    while (i < pTable->retiredCount)
+    {
+        if (pTable->pRetired[i].serial > completedSerial)
+        {
+            i++;
+            continue;
+        }
+
+        RetiredResource retired = pTable->pRetired[i];
+        pTable->pRetired[i] = pTable->pRetired[--pTable->retiredCount];    // 与末尾交换后删除
+
+        destroy_resource_data(pTable, device, retired.type, &retired.data, retired.serial);
+
+        if (retired.slot != UINT32_MAX)
+            pTable->pFreeList[pTable->freeCount++] = retired.slot;
+    }
+}
+
+
+/// @brief 由句柄找到其槽位，句柄无效、过期或槽位空闲时返回 `NULL`.
+static ResourceSlot* find_slot(const ResourceTable* pTable, ResourceHandle handle)
+{
+    uint32_t index      = (uint32_t)(handle & RESOURCE_HANDLE_INDEX_MASK);
+    uint32_t generation = (uint32_t)(handle >> 32);
+
+    if (handle == RESOURCE_INVALID_HANDLE || index >= pTable->count)
+        return NULL;
+
+    ResourceSlot* pSlot = &pTable->pSlots[index];
+    if (pSlot->generation != generation || pSlot->type == RESOURCE_TYPE_NONE
+        || pSlot->type != resource_handle_type(handle))
+        return NULL;
+
+    return pSlot;
+}
+
+
+/// @brief 把底层对象送入待销毁队列.
+///
+/// @return 队列已满时返回 `false`（此时对象不会被销毁）
+static bool retire(
+    ResourceTable*      pTable,
+    ResourceType        type,
+    const ResourceData* pData,
+    uint64_t            serial,
+    uint32_t            slot
+)
+{
+    if (pTable->retiredCount >= pTable->capacity)
+    {
+        fprintf(stderr, "%s : 待销毁队列已满（%u）！\n", __func__, pTable->capacity);
+        return false;
+    }
+
+    RetiredResource* pRetired = &pTable->pRetired[pTable->retiredCount++];
+    pRetired->data      = *pData;
+    pRetired->type      = type;
+    pRetired->serial    = serial;
+    pRetired->slot      = slot;
+
+    return true;
+}
+
+
+/// @brief 销毁底层对象（网格不直接拥有 Vulkan 对象，而是释放其引用的缓冲资源）.
+static void destroy_resource_data(
+    ResourceTable*      pTable,
+    VkDevice            device,
+    ResourceType        type,
+    ResourceData*       pData,
+    uint64_t            serial
+)
+{
+    switch (type)
+    {
+        case RESOURCE_TYPE_BUFFER:
+            if (pData->buffer.pMapped != NULL)
+                vkUnmapMemory(device, pData->buffer.memory);
+            destroyBuffer(device, pData->buffer.buffer, pData->buffer.memory);
+            break;
+
+        case RESOURCE_TYPE_PIPELINE:
+            if (pData->pipeline.pipeline != VK_NULL_HANDLE)
+                destroyPipeline(device, pData->pipeline.pipeline);
+            break;
+
+        case RESOURCE_TYPE_MESH:
+            if (mesh_is_pulled(&pData->mesh))
+            {
+                if (pTable->pMeshArena != NULL)
+                    mesh_arena_free(pTable->pMeshArena, &pData->mesh.pulled,
+                        pData->mesh.vertexCount, pData->mesh.indexCount);
+                break;
+            }
+            resource_table_release(pTable, pData->mesh.vertexBuffer, serial);
+            resource_table_release(pTable, pData->mesh.indexBuffer, serial);
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/// @brief 注销槽位的可驱逐资源（底层对象被送入待销毁队列或被替换时调用，延迟销毁期间不能再被驱逐）.
+static void unregister_streamable(ResourceSlot* pSlot)
+{
+    if (pSlot->streamable == STREAMABLE_INVALID_HANDLE)
+        return;
+
+    memory_budget_unregister_streamable(pSlot->streamable);
+    pSlot->streamable = STREAMABLE_INVALID_HANDLE;
+}
+
+
+/// @brief 内存预算的驱逐回调：立即销毁资源的底层对象（其最后一次使用已由 GPU 完成），句柄保持有效.
+static void evict_streamable(void* pUserData, uint64_t handle)
+{
+    ResourceTable* pTable = (ResourceTable*)pUserData;
+
+    ResourceSlot* pSlot = find_slot(pTable, handle);
+    if (pSlot == NULL || !pSlot->resident)
+        return;
+
+    pSlot->streamable = STREAMABLE_INVALID_HANDLE;     // 释放内存时由 memory_budget 自动注销
+
+    destroy_resource_data(pTable, pTable->device, pSlot->type, &pSlot->data, 0);
+
+    memset(&pSlot->data, 0, sizeof(ResourceData));
+    pSlot->resident = false;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "../common/arena.h"
+#include "vulkan_wrapper.h"
+#include "pipeline.h"
+#include "mesh_arena.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 渲染上下文中资源表的默认容量（资源数，也是待销毁队列的容量）.
+#define RESOURCE_TABLE_CAPACITY         4096
+/// @brief 句柄低 32 位中槽位索引所占的位数，其上 8 位为资源类型，高 32 位为代数（generation）.
+#define RESOURCE_HANDLE_INDEX_BITS      24
+#define RESOURCE_HANDLE_INDEX_MASK      ((1u << RESOURCE_HANDLE_INDEX_BITS) - 1)
+/// @brief 无效句柄.
+#define RESOURCE_INVALID_HANDLE         0ull
+
+/// @brief 资源句柄：槽位索引 | 类型 << 24 | 代数 << 32，C# 只需持有这个整数.
+typedef uint64_t ResourceHandle;
+
+/// @brief 资源类型，句柄中记录类型，以类型不符的方式使用句柄会被检测出来.
+typedef enum ResourceType {
+    RESOURCE_TYPE_NONE = 0,
+    RESOURCE_TYPE_BUFFER,
+    RESOURCE_TYPE_PIPELINE,
+    RESOURCE_TYPE_MESH,
+    RESOURCE_TYPE_COUNT
+} ResourceType;
+
+/// @brief 缓冲资源（主机可见的缓冲创建时常驻映射）.
+typedef struct BufferResource {
+    VkBuffer            buffer;
+    VkDeviceMemory      memory;
+    VkDeviceSize        size;
+    VkBufferUsageFlags  usage;
+    void*               pMapped;                // 不可映射时为 NULL
+    VkDeviceAddress     address;                // 不可取设备地址时为 0
+} BufferResource;
+
+/// @brief 管线资源（管线布局由渲染上下文共享，不归资源所有）：计算管线，或延迟销毁的被替换的表面管线.
+typedef struct PipelineResource {
+    VkPipeline          pipeline;
+} PipelineResource;
+
+/// @brief 网格资源：引用两个缓冲资源，网格被销毁时一并销毁；或者是网格池中的一个
+/// 顶点拉取网格（此时 vertexBuffer 为 RESOURCE_INVALID_HANDLE）.
+typedef struct MeshResource {
+    ResourceHandle      vertexBuffer;
+    ResourceHandle      indexBuffer;            // 可为 RESOURCE_INVALID_HANDLE（非索引绘制）
+    uint32_t            vertexCount;
+    uint32_t            indexCount;
+    MeshAllocation      pulled;                 // 拉取网格在网格池中的位置
+} MeshResource;
+
+/// @brief 网格是否为网格池中的顶点拉取网格.
+static inline bool mesh_is_pulled(const MeshResource* pMesh)
+{
+    return pMesh->vertexBuffer == RESOURCE_INVALID_HANDLE;
+}
+
+/// @brief 各类资源的底层对象.
+typedef union ResourceData {
+    BufferResource      buffer;
+    PipelineResource    pipeline;
+    MeshResource        mesh;
+} ResourceData;
+
+/// @brief 资源表中的一个槽位.
+typedef struct ResourceSlot {
+    ResourceData        data;
+    ResourceType        type;                   // RESOURCE_TYPE_NONE 表示空闲或等待回收
+    uint32_t            generation;             // 当前代数（从 1 开始），销毁时递增使旧句柄失效
+    bool                resident;               // 底层对象是否存在（被驱逐后为 false，句柄仍有效）
+    uint32_t            streamable;             // 注册为可驱逐资源时 memory_budget 的句柄
+} ResourceSlot;
+
+/// @brief 等待 GPU 完成后才能销毁的底层对象.
+typedef struct RetiredResource {
+    ResourceData        data;
+    ResourceType        type;
+    uint64_t            serial;                 // GPU 完成该序号的提交后即可销毁
+    uint32_t            slot;                   // 销毁后回收的槽位，仅替换底层对象时为 UINT32_MAX
+} RetiredResource;
+
+/// @brief 以 "索引 + 代数" 句柄访问 GPU 资源的表.
+///
+/// 查找为 O(1)：由句柄取出槽位，比较类型与代数即可判断句柄是否过期. 销毁不是立即的：
+/// 底层对象连同其最后可能被使用的提交序号进入待销毁队列，GPU 完成该提交后由
+/// resource_table_collect 销毁，槽位在此之后才会被复用.
+///
+/// 底层对象可以被替换（重新分配、搬移）或驱逐而不改变句柄，持有句柄的一方不受影响.
+typedef struct ResourceTable {
+    Arena               arena;                  // 槽位、空闲栈与待销毁队列的唯一一次分配
+    uint32_t            capacity;
+    uint32_t            count;                  // 曾使用过的最大槽位数
+
+    ResourceSlot*       pSlots;
+    uint32_t*           pFreeList;              // 空闲槽位栈
+    uint32_t            freeCount;
+
+    RetiredResource*    pRetired;               // 待销毁队列（无序）
+    uint32_t            retiredCount;
+
+    uint32_t            liveCounts[RESOURCE_TYPE_COUNT];
+
+    MeshArena*          pMeshArena;             // 拉取网格被销毁时向其归还区间，可为 NULL
+    VkDevice            device;                 // 超出内存预算时立即销毁被驱逐的资源
+} ResourceTable;
+
+
+/// @brief 创建资源表.
+///
+/// @param capacity 最大资源数（不超过 `RESOURCE_HANDLE_INDEX_MASK`）
+///
+/// @return 成功时返回 `true`
+bool create_resource_table(uint32_t capacity, ResourceTable* pTable);
+
+/// @brief 销毁表中所有资源与待销毁的对象，并释放表的内存（调用前需确保 GPU 已空闲）.
+void destroy_resource_table(VkDevice device, ResourceTable* pTable);
+
+/// @brief 把已创建的底层对象加入资源表，之后由资源表负责销毁.
+///
+/// @return 新资源的句柄，表已满时返回 `RESOURCE_INVALID_HANDLE`（此时底层对象仍归调用者）
+ResourceHandle resource_table_insert(ResourceTable* pTable, ResourceType type, const ResourceData* pData);
+
+/// @brief 由句柄查找资源.
+///
+/// @return 资源的底层对象，句柄过期、类型不符或资源已被驱逐时返回 `NULL`
+ResourceData* resource_table_get(ResourceTable* pTable, ResourceHandle handle, ResourceType type);
+
+/// @brief 取得槽位 `index` 中存活资源的句柄（用于遍历资源表）.
+///
+/// @return 槽位空闲或等待回收时返回 `RESOURCE_INVALID_HANDLE`
+ResourceHandle resource_table_handle_at(const ResourceTable* pTable, uint32_t index);
+
+/// @brief 句柄是否仍指向一个存活的资源（被驱逐的资源也算存活）.
+bool resource_table_is_alive(const ResourceTable* pTable, ResourceHandle handle);
+
+/// @brief 销毁资源：句柄立即失效，底层对象在 GPU 完成序号为 `serial` 的提交后销毁.
+///
+/// @param serial 可能使用该资源的最后一次提交的序号（一般为下一次提交的序号）
+void resource_table_release(ResourceTable* pTable, ResourceHandle handle, uint64_t serial);
+
+/// @brief 替换资源的底层对象（如重新分配或搬移），句柄保持有效，旧对象延迟销毁.
+///
+/// @return 成功时返回 `true`；句柄无效时返回 `false`，此时新对象仍归调用者
+bool resource_table_replace(
+    ResourceTable*      pTable,
+    ResourceHandle      handle,
+    const ResourceData* pData,
+    uint64_t            serial
+);
+
+/// @brief 驱逐资源的底层对象以释放内存，句柄保持有效，之后可用 resource_table_replace 重新加载.
+void resource_table_evict(ResourceTable* pTable, ResourceHandle handle, uint64_t serial);
+
+/// @brief 资源是否存活且未被驱逐.
+bool resource_table_is_resident(const ResourceTable* pTable, ResourceHandle handle);
+
+/// @brief 把设备本地的缓冲注册为可驱逐资源：超出内存预算时按最近最少使用的顺序被驱逐
+/// （立即销毁，句柄保持有效）.
+///
+/// 只接受不可映射、不可取设备地址的设备本地缓冲：映射的缓冲可能仍被主机引用且没有重新加载的来源，
+/// 可取设备地址的缓冲其访问无法被跟踪，系统内存中的缓冲被驱逐也不能缓解显存压力.
+///
+/// @return 成功注册时返回 `true`
+bool resource_table_make_streamable(ResourceTable* pTable, ResourceHandle handle);
+
+/// @brief 记录可驱逐资源被序号为 `serial` 的提交使用（每次录制使用它的命令时调用）.
+void resource_table_touch(ResourceTable* pTable, ResourceHandle handle, uint64_t serial);
+
+/// @brief 把不属于任何句柄的底层对象（如被替换的表面管线）送入待销毁队列，
+/// 在 GPU 完成序号为 `serial` 的提交后销毁.
+///
+/// @return 成功时返回 `true`；队列已满时返回 `false`，此时对象仍归调用者
+bool resource_table_retire(
+    ResourceTable*      pTable,
+    ResourceType        type,
+    const ResourceData* pData,
+    uint64_t            serial
+);
+
+/// @brief 创建一个缓冲并加入资源表（主机可见的缓冲常驻映射，否则为设备本地内存）.
+///
+/// @param preferDeviceLocal 主机可见的缓冲是否优先放在可主机写入的显存中（见 createHostWritableBuffer）
+/// @param queueFamilyIndexCount 共享该缓冲的队列族数（见 createBuffer）
+/// @param pQueueFamilyIndices 共享该缓冲的队列族索引
+///
+/// @return 新缓冲的句柄，失败时返回 `RESOURCE_INVALID_HANDLE`
+ResourceHandle resource_table_create_buffer(
+    ResourceTable*          pTable,
+    VkPhysicalDevice        physicalDevice,
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    bool                    hostVisible,
+    bool                    preferDeviceLocal,
+    MemoryCategory          category,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices
+);
+
+/// @brief 销毁 GPU 已完成使用的待销毁对象并回收其槽位（每帧开始时调用）.
+void resource_table_collect(ResourceTable* pTable, VkDevice device, uint64_t completedSerial);
+
+/// @brief 由句柄取出其资源类型.
+static inline ResourceType resource_handle_type(ResourceHandle handle)
+{
+    return (ResourceType)((handle >> RESOURCE_HANDLE_INDEX_BITS) & 0xFF);
+}
@@ -0,0 +1,469 @@
+#include "scene_kernels.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SCENE_KERNELS_X86 1
+#include <immintrin.h>
+
+/// @brief AVX2 实现所在函数的目标属性（其余代码仍按 x86-64 基线编译）
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+
+
+// ---------------------------------------------------------------------------------------
+// 标量实现（所有平台的回退，也用于 SIMD 实现处理不足一组的尾部）
+// ---------------------------------------------------------------------------------------
+
+static void compose_local_scalar(
+    const float*    pPositions,
+    const float*    pRotations,
+    const float*    pScales,
+    float*          pTransforms,
+    uint32_t        count
+)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const float* p = &pPositions[i * 4];
+        const float* q = &pRotations[i * 4];
+        const float* s = &pScales[i * 4];
+        float*       m = &pTransforms[i * 16];
+
+        float xx = q[0] * q[0], yy = q[1] * q[1], zz = q[2] * q[2];
+        float xy = q[0] * q[1], xz = q[0] * q[2], yz = q[1] * q[2];
+        float wx = q[3] * q[0], wy = q[3] * q[1], wz = q[3] * q[2];
+
+        m[0]  = (1.0f - 2.0f * (yy + zz)) * s[0];
+        m[1]  = 2.0f * (xy + wz) * s[0];
+        m[2]  = 2.0f * (xz - wy) * s[0];
+        m[3]  = 0.0f;
+        m[4]  = 2.0f * (xy - wz) * s[1];
+        m[5]  = (1.0f - 2.0f * (xx + zz)) * s[1];
+        m[6]  = 2.0f * (yz + wx) * s[1];
+        m[7]  = 0.0f;
+        m[8]  = 2.0f * (xz + wy) * s[2];
+        m[9]  = 2.0f * (yz - wx) * s[2];
+        m[10] = (1.0f - 2.0f * (xx + yy)) * s[2];
+        m[11] = 0.0f;
+        m[12] = p[0];
+        m[13] = p[1];
+        m[14] = p[2];
+        m[15] = 1.0f;
+    }
+}
+
+
+static void propagate_scalar(float* pTransforms, const uint32_t* pParents, uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; i++)
+    {
+        if (pParents[i] == SCENE_NO_PARENT)
+            continue;
+
+        const float* a = &pTransforms[pParents[i] * 16];
+        float*       b = &pTransforms[i * 16];
+        float        r[16];
+
+        for (int column = 0; column < 4; column++)
+            for (int row = 0; row < 4; row++)
+                r[column * 4 + row] = a[row] * b[column * 4]
+                                    + a[4 + row] * b[column * 4 + 1]
+                                    + a[8 + row] * b[column * 4 + 2]
+                                    + a[12 + row] * b[column * 4 + 3];
+
+        memcpy(b, r, sizeof(r));
+    }
+}
+
+
+static void update_bounds_scalar(
+    const float*    pTransforms,
+    const float*    pLocalBounds,
+    float*          pBounds,
+    uint32_t        count
+)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const float* m = &pTransforms[i * 16];
+        const float* l = &pLocalBounds[i * 4];
+        float*       b = &pBounds[i * 4];
+
+        b[0] = m[0] * l[0] + m[4] * l[1] + m[8] * l[2] + m[12];
+        b[1] = m[1] * l[0] + m[5] * l[1] + m[9] * l[2] + m[13];
+        b[2] = m[2] * l[0] + m[6] * l[1] + m[10] * l[2] + m[14];
+
+        float scale0 = m[0] * m[0] + m[1] * m[1] + m[2] * m[2];
+        float scale1 = m[4] * m[4] + m[5] * m[5] + m[6] * m[6];
+        float scale2 = m[8] * m[8] + m[9] * m[9] + m[10] * m[10];
+        float maxScale = scale0 > scale1 ? scale0 : scale1;
+        maxScale = maxScale > scale2 ? maxScale : scale2;
+
+        b[3] = l[3] * sqrtf(maxScale);
+    }
+}
+
+
+#ifdef SCENE_KERNELS_X86
+
+// ---------------------------------------------------------------------------------------
+// SSE2 实现（x86-64 基线）：合成时 4 个对象一组转置为 SoA，其余逐对象处理
+// ---------------------------------------------------------------------------------------
+
+/// @brief 读取 4 个对象的 float4 并转置为 x / y / z / w 四个分量向量.
+static inline void load_soa_sse2(const float* pVectors, __m128* x, __m128* y, __m128* z, __m128* w)
+{
+    *x = _mm_loadu_ps(&pVectors[0]);
+    *y = _mm_loadu_ps(&pVectors[4]);
+    *z = _mm_loadu_ps(&pVectors[8]);
+    *w = _mm_loadu_ps(&pVectors[12]);
+    _MM_TRANSPOSE4_PS(*x, *y, *z, *w);
+}
+
+/// @brief 把 4 个对象的某一列（分量向量形式）转置回各自矩阵的第 `column` 列.
+static inline void store_column_sse2(float* pTransforms, int column, __m128 x, __m128 y, __m128 z, __m128 w)
+{
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    _mm_storeu_ps(&pTransforms[0 * 16 + column * 4], x);
+    _mm_storeu_ps(&pTransforms[1 * 16 + column * 4], y);
+    _mm_storeu_ps(&pTransforms[2 * 16 + column * 4], z);
+    _mm_storeu_ps(&pTransforms[3 * 16 + column * 4], w);
+}
+
+static void compose_local_sse2(
+    const float*    pPositions,
+    const float*    pRotations,
+    const float*    pScales,
+    float*          pTransforms,
+    uint32_t        count
+)
+{
+    const __m128 one    = _mm_set1_ps(1.0f);
+    const __m128 two    = _mm_set1_ps(2.0f);
+    const __m128 zero   = _mm_setzero_ps();
+
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 qx, qy, qz, qw, px, py, pz, pw, sx, sy, sz, sw;
+        load_soa_sse2(&pRotations[i * 4], &qx, &qy, &qz, &qw);
+        load_soa_sse2(&pPositions[i * 4], &px, &py, &pz, &pw);
+        load_soa_sse2(&pScales[i * 4], &sx, &sy, &sz, &sw);
+
+        __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+        __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+        __m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+        store_column_sse2(&pTransforms[i * 16], 0,
+            _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+            _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+            _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+            zero);
+        store_column_sse2(&pTransforms[i * 16], 1,
+            _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+            _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+            _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+            zero);
+        store_column_sse2(&pTransforms[i * 16], 2,
+            _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+            _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+            _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+            zero);
+        store_column_sse2(&pTransforms[i * 16], 3, px, py, pz, one);
+    }
+
+    compose_local_scalar(&pPositions[i * 4], &pRotations[i * 4], &pScales[i * 4],
+        &pTransforms[i * 16], count - i);
+}
+
+
+static void propagate_sse2(float* pTransforms, const uint32_t* pParents, uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; i++)
+    {
+        if (pParents[i] == SCENE_NO_PARENT)
+            continue;
+
+        const float* a = &pTransforms[pParents[i] * 16];
+        float*       b = &pTransforms[i * 16];
+
+        __m128 a0 = _mm_loadu_ps(&a[0]), a1 = _mm_loadu_ps(&a[4]);
+        __m128 a2 = _mm_loadu_ps(&a[8]), a3 = _mm_loadu_ps(&a[12]);
+
+        // 先读完子矩阵的所有列再写回（就地计算）
+        __m128 columns[4];
+        for (int j = 0; j < 4; j++)
+            columns[j] = _mm_loadu_ps(&b[j * 4]);
+
+        for (int j = 0; j < 4; j++)
+        {
+            __m128 c = columns[j];
+            __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0)));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2))));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm_storeu_ps(&b[j * 4], r);
+        }
+    }
+}
+
+
+static void update_bounds_sse2(
+    const float*    pTransforms,
+    const float*    pLocalBounds,
+    float*          pBounds,
+    uint32_t        count
+)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const float* m = &pTransforms[i * 16];
+
+        __m128 c0 = _mm_loadu_ps(&m[0]), c1 = _mm_loadu_ps(&m[4]);
+        __m128 c2 = _mm_loadu_ps(&m[8]), c3 = _mm_loadu_ps(&m[12]);
+        __m128 l  = _mm_loadu_ps(&pLocalBounds[i * 4]);
+
+        __m128 center = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0))));
+        center = _mm_add_ps(center, _mm_mul_ps(c1, _mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1))));
+        center = _mm_add_ps(center, _mm_mul_ps(c2, _mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2))));
+
+        // 三个轴的长度平方：转置后按分量相加，再在各通道间取最大值
+        __m128 s0 = _mm_mul_ps(c0, c0), s1 = _mm_mul_ps(c1, c1);
+        __m128 s2 = _mm_mul_ps(c2, c2), s3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+        __m128 lengths = _mm_add_ps(_mm_add_ps(s0, s1), s2);
+        lengths = _mm_max_ps(lengths, _mm_shuffle_ps(lengths, lengths, _MM_SHUFFLE(1, 0, 3, 2)));
+        lengths = _mm_max_ps(lengths, _mm_shuffle_ps(lengths, lengths, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        __m128 radius = _mm_mul_ps(_mm_sqrt_ps(lengths), _mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)));
+
+        // (cx, cy, cz, r)
+        __m128 zw = _mm_unpackhi_ps(center, radius);
+        _mm_storeu_ps(&pBounds[i * 4], _mm_shuffle_ps(center, zw, _MM_SHUFFLE(1, 0, 1, 0)));
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------
+// AVX2 + FMA 实现：合成时 8 个对象一组（两个 128 位通道各 4 个），矩阵乘法每次处理两列，
+// 包围球每次处理两个对象
+// ---------------------------------------------------------------------------------------
+
+/// @brief 在两个 128 位通道内各自转置 4x4.
+AVX2_TARGET
+static inline void transpose_lanes_avx2(__m256* r0, __m256* r1, __m256* r2, __m256* r3)
+{
+    __m256 t0 = _mm256_unpacklo_ps(*r0, *r1);
+    __m256 t1 = _mm256_unpackhi_ps(*r0, *r1);
+    __m256 t2 = _mm256_unpacklo_ps(*r2, *r3);
+    __m256 t3 = _mm256_unpackhi_ps(*r2, *r3);
+
+    *r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    *r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    *r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    *r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+/// @brief 读取两个 float4 分别放入低、高通道.
+AVX2_TARGET
+static inline __m256 load_pair_avx2(const float* pLow, const float* pHigh)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pLow)), _mm_loadu_ps(pHigh), 1);
+}
+
+/// @brief 把低、高通道分别写入两个 float4.
+AVX2_TARGET
+static inline void store_pair_avx2(float* pLow, float* pHigh, __m256 value)
+{
+    _mm_storeu_ps(pLow, _mm256_castps256_ps128(value));
+    _mm_storeu_ps(pHigh, _mm256_extractf128_ps(value, 1));
+}
+
+/// @brief 读取 8 个对象的 float4 并转置为分量向量（低通道为前 4 个对象，高通道为后 4 个）.
+AVX2_TARGET
+static inline void load_soa_avx2(const float* pVectors, __m256* x, __m256* y, __m256* z, __m256* w)
+{
+    *x = load_pair_avx2(&pVectors[0], &pVectors[16]);
+    *y = load_pair_avx2(&pVectors[4], &pVectors[20]);
+    *z = load_pair_avx2(&pVectors[8], &pVectors[24]);
+    *w = load_pair_avx2(&pVectors[12], &pVectors[28]);
+    transpose_lanes_avx2(x, y, z, w);
+}
+
+/// @brief 把 8 个对象的某一列转置回各自矩阵的第 `column` 列.
+AVX2_TARGET
+static inline void store_column_avx2(float* pTransforms, int column, __m256 x, __m256 y, __m256 z, __m256 w)
+{
+    transpose_lanes_avx2(&x, &y, &z, &w);
+    store_pair_avx2(&pTransforms[0 * 16 + column * 4], &pTransforms[4 * 16 + column * 4], x);
+    store_pair_avx2(&pTransforms[1 * 16 + column * 4], &pTransforms[5 * 16 + column * 4], y);
+    store_pair_avx2(&pTransforms[2 * 16 + column * 4], &pTransforms[6 * 16 + column * 4], z);
+    store_pair_avx2(&pTransforms[3 * 16 + column * 4], &pTransforms[7 * 16 + column * 4], w);
+}
+
+AVX2_TARGET
+static void compose_local_avx2(
+    const float*    pPositions,
+    const float*    pRotations,
+    const float*    pScales,
+    float*          pTransforms,
+    uint32_t        count
+)
+{
+    const __m256 one    = _mm256_set1_ps(1.0f);
+    const __m256 two    = _mm256_set1_ps(2.0f);
+    const __m256 zero   = _mm256_setzero_ps();
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 qx, qy, qz, qw, px, py, pz, pw, sx, sy, sz, sw;
+        load_soa_avx2(&pRotations[i * 4], &qx, &qy, &qz, &qw);
+        load_soa_avx2(&pPositions[i * 4], &px, &py, &pz, &pw);
+        load_soa_avx2(&pScales[i * 4], &sx, &sy, &sz, &sw);
+
+        __m256 xx = _mm256_mul_ps(qx, qx), yy = _mm256_mul_ps(qy, qy), zz = _mm256_mul_ps(qz, qz);
+        __m256 xy = _mm256_mul_ps(qx, qy), xz = _mm256_mul_ps(qx, qz), yz = _mm256_mul_ps(qy, qz);
+        __m256 wx = _mm256_mul_ps(qw, qx), wy = _mm256_mul_ps(qw, qy), wz = _mm256_mul_ps(qw, qz);
+
+        store_column_avx2(&pTransforms[i * 16], 0,
+            _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(yy, zz), one), sx),
+            _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx),
+            _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx),
+            zero);
+        store_column_avx2(&pTransforms[i * 16], 1,
+            _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy),
+            _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one), sy),
+            _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy),
+            zero);
+        store_column_avx2(&pTransforms[i * 16], 2,
+            _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz),
+            _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz),
+            _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, yy), one), sz),
+            zero);
+        store_column_avx2(&pTransforms[i * 16], 3, px, py, pz, one);
+    }
+
+    compose_local_scalar(&pPositions[i * 4], &pRotations[i * 4], &pScales[i * 4],
+        &pTransforms[i * 16], count - i);
+}
+
+
+AVX2_TARGET
+static void propagate_avx2(float* pTransforms, const uint32_t* pParents, uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; i++)
+    {
+        if (pParents[i] == SCENE_NO_PARENT)
+            continue;
+
+        const float* a = &pTransforms[pParents[i] * 16];
+        float*       b = &pTransforms[i * 16];
+
+        // 父矩阵的每一列复制到两个通道，子矩阵两列一组
+        __m256 a0 = _mm256_broadcast_ps((const __m128*)&a[0]);
+        __m256 a1 = _mm256_broadcast_ps((const __m128*)&a[4]);
+        __m256 a2 = _mm256_broadcast_ps((const __m128*)&a[8]);
+        __m256 a3 = _mm256_broadcast_ps((const __m128*)&a[12]);
+
+        __m256 b01 = _mm256_loadu_ps(&b[0]);
+        __m256 b23 = _mm256_loadu_ps(&b[8]);
+
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, _MM_SHUFFLE(0, 0, 0, 0)));
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, _MM_SHUFFLE(0, 0, 0, 0)));
+        r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, _MM_SHUFFLE(1, 1, 1, 1)), r01);
+        r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, _MM_SHUFFLE(1, 1, 1, 1)), r23);
+        r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, _MM_SHUFFLE(2, 2, 2, 2)), r01);
+        r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, _MM_SHUFFLE(2, 2, 2, 2)), r23);
+        r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, _MM_SHUFFLE(3, 3, 3, 3)), r01);
+        r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, _MM_SHUFFLE(3, 3, 3, 3)), r23);
+
+        _mm256_storeu_ps(&b[0], r01);
+        _mm256_storeu_ps(&b[8], r23);
+    }
+}
+
+
+AVX2_TARGET
+static void update_bounds_avx2(
+    const float*    pTransforms,
+    const float*    pLocalBounds,
+    float*          pBounds,
+    uint32_t        count
+)
+{
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        // 低通道为对象 i，高通道为对象 i + 1
+        const float* m = &pTransforms[i * 16];
+
+        __m256 c0 = load_pair_avx2(&m[0], &m[16]);
+        __m256 c1 = load_pair_avx2(&m[4], &m[20]);
+        __m256 c2 = load_pair_avx2(&m[8], &m[24]);
+        __m256 c3 = load_pair_avx2(&m[12], &m[28]);
+        __m256 l  = _mm256_loadu_ps(&pLocalBounds[i * 4]);
+
+        __m256 center = _mm256_fmadd_ps(c0, _mm256_permute_ps(l, _MM_SHUFFLE(0, 0, 0, 0)), c3);
+        center = _mm256_fmadd_ps(c1, _mm256_permute_ps(l, _MM_SHUFFLE(1, 1, 1, 1)), center);
+        center = _mm256_fmadd_ps(c2, _mm256_permute_ps(l, _MM_SHUFFLE(2, 2, 2, 2)), center);
+
+        __m256 s0 = _mm256_mul_ps(c0, c0), s1 = _mm256_mul_ps(c1, c1);
+        __m256 s2 = _mm256_mul_ps(c2, c2), s3 = _mm256_setzero_ps();
+        transpose_lanes_avx2(&s0, &s1, &s2, &s3);
+        __m256 lengths = _mm256_add_ps(_mm256_add_ps(s0, s1), s2);
+        lengths = _mm256_max_ps(lengths, _mm256_permute_ps(lengths, _MM_SHUFFLE(1, 0, 3, 2)));
+        lengths = _mm256_max_ps(lengths, _mm256_permute_ps(lengths, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        __m256 radius = _mm256_mul_ps(_mm256_sqrt_ps(lengths),
+                            _mm256_permute_ps(l, _MM_SHUFFLE(3, 3, 3, 3)));
+
+        __m256 zw = _mm256_unpackhi_ps(center, radius);
+        _mm256_storeu_ps(&pBounds[i * 4], _mm256_shuffle_ps(center, zw, _MM_SHUFFLE(1, 0, 1, 0)));
+    }
+
+    update_bounds_sse2(&pTransforms[i * 16], &pLocalBounds[i * 4], &pBounds[i * 4], count - i);
+}
+
+#endif // SCENE_KERNELS_X86
+
+
+static const SceneKernels scalarKernels = {
+    .level          = SIMD_LEVEL_SCALAR,
+    .composeLocal   = compose_local_scalar,
+    .propagate      = propagate_scalar,
+    .updateBounds   = update_bounds_scalar,
+};
+
+#ifdef SCENE_KERNELS_X86
+static const SceneKernels sse2Kernels = {
+    .level          = SIMD_LEVEL_SSE2,
+    .composeLocal   = compose_local_sse2,
+    .propagate      = propagate_sse2,
+    .updateBounds   = update_bounds_sse2,
+};
+
+static const SceneKernels avx2Kernels = {
+    .level          = SIMD_LEVEL_AVX2,
+    .composeLocal   = compose_local_avx2,
+    .propagate      = propagate_avx2,
+    .updateBounds   = update_bounds_avx2,
+};
+#endif
+
+
+const SceneKernels* get_scene_kernels(void)
+{
+#ifdef SCENE_KERNELS_X86
+    switch (get_simd_level())
+    {
+        case SIMD_LEVEL_AVX2:   return &avx2Kernels;
+        case SIMD_LEVEL_SSE2:   return &sse2Kernels;
+        default:                break;
+    }
+#endif
+
+    return &scalarKernels;
+}
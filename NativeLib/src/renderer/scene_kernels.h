@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../common/cpu_features.h"
+
+#include <stdint.h>
+
+/// @brief 没有父对象.
+#define SCENE_NO_PARENT UINT32_MAX
+
+/// @brief 场景变换与包围体的批处理内核，按运行时检测到的 SIMD 级别选择实现.
+///
+/// 所有内核都只处理调用者给定的连续下标范围，互不重叠的范围可以在多个线程上并行处理
+/// （propagate 除外，见其说明）. 向量均按 float4 排列，矩阵为列主序 4x4.
+typedef struct SceneKernels {
+    SimdLevel   level;
+
+    /// @brief 由平移、旋转（单位四元数 xyzw）与缩放合成 `count` 个局部矩阵.
+    void (*composeLocal)(
+        const float*    pPositions,
+        const float*    pRotations,
+        const float*    pScales,
+        float*          pTransforms,
+        uint32_t        count
+    );
+
+    /// @brief 对下标 [begin, end) 中有父对象者，就地计算 `parent * local` 得到世界矩阵.
+    ///
+    /// 要求父对象的下标总小于子对象，这样顺序处理时父对象的世界矩阵已经就绪；拆分到多个
+    /// 线程时，每个范围的父对象必须已被先前的范围处理完.
+    void (*propagate)(
+        float*          pTransforms,
+        const uint32_t* pParents,
+        uint32_t        begin,
+        uint32_t        end
+    );
+
+    /// @brief 把 `count` 个局部包围球（中心 xyz + 半径）变换为世界包围球，半径按最大轴向缩放放大.
+    void (*updateBounds)(
+        const float*    pTransforms,
+        const float*    pLocalBounds,
+        float*          pBounds,
+        uint32_t        count
+    );
+} SceneKernels;
+
+
+/// @brief 获取当前 CPU 上最快的内核实现（见 get_simd_level）.
+const SceneKernels* get_scene_kernels(void);
@@ -0,0 +1,389 @@
+#include "scene_store.h"
+
+/// @brief 各数组的起始地址按缓存行对齐
+#define SCENE_ARRAY_ALIGNMENT 64
+/// @brief 并行更新时每个任务至少处理的对象数
+#define SCENE_UPDATE_GRAIN 1024
+
+static const float identityTransform[SCENE_TRANSFORM_FLOATS] = {
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f,
+};
+
+static const float identityRotation[4]  = { 0.0f, 0.0f, 0.0f, 1.0f };
+static const float identityScale[4]     = { 1.0f, 1.0f, 1.0f, 0.0f };
+
+static VkDeviceSize scene_gpu_size(const SceneStore* pScene);
+static void compose_local_range(void* pArg, uint32_t begin, uint32_t end);
+static void update_bounds_range(void* pArg, uint32_t begin, uint32_t end);
+
+/// @brief 并行更新时各区间任务共享的参数.
+typedef struct SceneUpdateArgs {
+    SceneStore*         pScene;
+    const SceneKernels* pKernels;
+    uint32_t            base;                   // 区间下标相对于的起始下标
+} SceneUpdateArgs;
+
+
+bool create_scene_store(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            capacity,
+    SceneStore*         pScene
+)
+{
+    memset(pScene, 0, sizeof(SceneStore));
+
+    if (capacity == 0 || capacity > SCENE_HANDLE_INDEX_MASK)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！容量需在 1 到 %u 之间.\n",
+            __func__, SCENE_HANDLE_INDEX_MASK);
+        return false;
+    }
+
+    // 1.所有数组来自同一次分配
+    size_t floatsPerObject = SCENE_TRANSFORM_FLOATS + SCENE_BOUNDS_FLOATS + 4 * 4;
+    size_t arenaSize = capacity * (floatsPerObject * sizeof(float) + 6 * sizeof(uint32_t))
+                     + 12 * SCENE_ARRAY_ALIGNMENT;
+    if (!arena_init(&pScene->arena, arenaSize))
+        return false;
+
+    pScene->capacity        = capacity;
+    pScene->pTransforms     = (float*)arena_alloc(&pScene->arena,
+                                  capacity * SCENE_TRANSFORM_FLOATS * sizeof(float), SCENE_ARRAY_ALIGNMENT);
+    pScene->pBounds         = (float*)arena_alloc(&pScene->arena,
+                                  capacity * SCENE_BOUNDS_FLOATS * sizeof(float), SCENE_ARRAY_ALIGNMENT);
+    pScene->pPositions      = (float*)arena_alloc(&pScene->arena,
+                                  capacity * 4 * sizeof(float), SCENE_ARRAY_ALIGNMENT);
+    pScene->pRotations      = (float*)arena_alloc(&pScene->arena,
+                                  capacity * 4 * sizeof(float), SCENE_ARRAY_ALIGNMENT);
+    pScene->pScales         = (float*)arena_alloc(&pScene->arena,
+                                  capacity * 4 * sizeof(float), SCENE_ARRAY_ALIGNMENT);
+    pScene->pLocalBounds    = (float*)arena_alloc(&pScene->arena,
+                                  capacity * 4 * sizeof(float), SCENE_ARRAY_ALIGNMENT);
+    pScene->pParents        = (uint32_t*)arena_alloc(&pScene->arena,
+                                  capacity * sizeof(uint32_t), SCENE_ARRAY_ALIGNMENT);
+    pScene->pMeshIds        = (uint32_t*)arena_alloc(&pScene->arena,
+                                  capacity * sizeof(uint32_t), SCENE_ARRAY_ALIGNMENT);
+    pScene->pMaterialIds    = (uint32_t*)arena_alloc(&pScene->arena,
+                                  capacity * sizeof(uint32_t), SCENE_ARRAY_ALIGNMENT);
+    pScene->pFlags          = (uint32_t*)arena_alloc(&pScene->arena,
+                                  capacity * sizeof(uint32_t), SCENE_ARRAY_ALIGNMENT);
+    pScene->pGenerations    = (uint32_t*)arena_alloc(&pScene->arena,
+                                  capacity * sizeof(uint32_t), SCENE_ARRAY_ALIGNMENT);
+    pScene->pFreeList       = (uint32_t*)arena_alloc(&pScene->arena,
+                                  capacity * sizeof(uint32_t), SCENE_ARRAY_ALIGNMENT);
+    if (pScene->pFreeList == NULL)
+    {
+        destroy_scene_store(device, pScene);
+        return false;
+    }
+
+    memset(pScene->pFlags, 0, capacity * sizeof(uint32_t));
+    for (uint32_t i = 0; i < capacity; i++)
+        pScene->pGenerations[i] = 1;
+
+    // 2.GPU 缓冲与每帧一份的暂存分区
+    VkDeviceSize gpuSize = scene_gpu_size(pScene);
+
+    if (!createBuffer(physicalDevice, device, gpuSize,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            MEMORY_CATEGORY_BUFFER,
+            0, NULL,
+            &pScene->gpuBuffer, &pScene->gpuMemory)
+        || !createBuffer(physicalDevice, device, gpuSize * MAX_FRAMES_IN_FLIGHT,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            MEMORY_CATEGORY_STAGING,
+            0, NULL,
+            &pScene->stagingBuffer, &pScene->stagingMemory))
+    {
+        destroy_scene_store(device, pScene);
+        return false;
+    }
+
+    VkResult result = vkMapMemory(device, pScene->stagingMemory, 0, VK_WHOLE_SIZE, 0,
+                          (void**)&pScene->pStagingData);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr, "Failed to map scene staging memory! Error Code(VkResult): %d\n", result);
+
+        destroy_scene_store(device, pScene);
+        return false;
+    }
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "成功创建了场景存储（容量 %u 个对象）！\n",
+        __DATE__, __TIME__, capacity);
+
+    return true;
+}
+
+
+void destroy_scene_store(VkDevice device, SceneStore* pScene)
+{
+    if (pScene == NULL)
+        return;
+
+    if (device != VK_NULL_HANDLE)
+    {
+        if (pScene->pStagingData != NULL)
+            vkUnmapMemory(device, pScene->stagingMemory);
+
+        destroyBuffer(device, pScene->stagingBuffer, pScene->stagingMemory);
+        destroyBuffer(device, pScene->gpuBuffer, pScene->gpuMemory);
+    }
+
+    arena_release(&pScene->arena);
+
+    memset(pScene, 0, sizeof(SceneStore));
+}
+
+
+uint32_t scene_create_object(SceneStore* pScene)
+{
+    // 优先复用空闲槽位，使存活对象尽量紧凑
+    uint32_t index;
+    if (pScene->freeCount > 0)
+        index = pScene->pFreeList[--pScene->freeCount];
+    else if (pScene->count < pScene->capacity)
+        index = pScene->count++;
+    else
+        return SCENE_INVALID_HANDLE;
+
+    memcpy(&pScene->pTransforms[index * SCENE_TRANSFORM_FLOATS], identityTransform,
+        sizeof(identityTransform));
+    memset(&pScene->pBounds[index * SCENE_BOUNDS_FLOATS], 0, SCENE_BOUNDS_FLOATS * sizeof(float));
+    memset(&pScene->pPositions[index * 4], 0, 4 * sizeof(float));
+    memcpy(&pScene->pRotations[index * 4], identityRotation, sizeof(identityRotation));
+    memcpy(&pScene->pScales[index * 4], identityScale, sizeof(identityScale));
+    memset(&pScene->pLocalBounds[index * 4], 0, 4 * sizeof(float));
+    pScene->pParents[index]     = SCENE_NO_PARENT;
+    pScene->pMeshIds[index]     = 0;
+    pScene->pMaterialIds[index] = 0;
+    pScene->pFlags[index]       = SCENE_OBJECT_ALIVE | SCENE_OBJECT_VISIBLE;
+
+    scene_mark_dirty(pScene, index, index + 1);
+
+    return (pScene->pGenerations[index] << SCENE_HANDLE_INDEX_BITS) | index;
+}
+
+
+void scene_destroy_object(SceneStore* pScene, uint32_t handle)
+{
+    int index = scene_object_index(pScene, handle);
+    if (index < 0)
+        return;
+
+    pScene->pFlags[index] = 0;
+
+    // 代数递增使旧句柄失效，回绕时跳过 0 以保证句柄永远不等于 SCENE_INVALID_HANDLE
+    uint32_t generation = (pScene->pGenerations[index] + 1) & (UINT32_MAX >> SCENE_HANDLE_INDEX_BITS);
+    pScene->pGenerations[index] = generation == 0 ? 1 : generation;
+
+    pScene->pFreeList[pScene->freeCount++] = (uint32_t)index;
+
+    // 子对象的下标都更大，只需向后查找
+    for (uint32_t i = (uint32_t)index + 1; i < pScene->count; i++)
+    {
+        if (pScene->pParents[i] == (uint32_t)index)
+            pScene->pParents[i] = SCENE_NO_PARENT;
+    }
+}
+
+
+bool scene_set_parent(SceneStore* pScene, uint32_t child, uint32_t parent)
+{
+    int childIndex = scene_object_index(pScene, child);
+    if (childIndex < 0)
+        return false;
+
+    if (parent == SCENE_INVALID_HANDLE)
+    {
+        pScene->pParents[childIndex] = SCENE_NO_PARENT;
+        return true;
+    }
+
+    int parentIndex = scene_object_index(pScene, parent);
+    if (parentIndex < 0 || parentIndex >= childIndex)
+    {
+        fprintf(stderr, "%s : 父对象无效或其下标（%d）不小于子对象（%d）！\n",
+            __func__, parentIndex, childIndex);
+        return false;
+    }
+
+    pScene->pParents[childIndex] = (uint32_t)parentIndex;
+
+    return true;
+}
+
+
+void scene_update_transforms(SceneStore* pScene, JobSystem* pJobs, uint32_t begin, uint32_t end)
+{
+    if (end > pScene->count)
+        end = pScene->count;
+    if (begin >= end)
+        return;
+
+    SceneUpdateArgs args = {
+        .pScene     = pScene,
+        .pKernels   = get_scene_kernels(),
+        .base       = begin,
+    };
+    uint32_t count = end - begin;
+
+    // 三遍线性扫描：局部矩阵 -> 按层级就地乘上父矩阵 -> 包围球
+    if (pJobs != NULL)
+        job_system_parallel_for(pJobs, count, SCENE_UPDATE_GRAIN, compose_local_range, &args);
+    else
+        compose_local_range(&args, 0, count);
+
+    args.pKernels->propagate(pScene->pTransforms, pScene->pParents, begin, end);
+
+    if (pJobs != NULL)
+        job_system_parallel_for(pJobs, count, SCENE_UPDATE_GRAIN, update_bounds_range, &args);
+    else
+        update_bounds_range(&args, 0, count);
+
+    scene_mark_dirty(pScene, begin, end);
+}
+
+
+int scene_object_index(const SceneStore* pScene, uint32_t handle)
+{
+    uint32_t index = handle & SCENE_HANDLE_INDEX_MASK;
+
+    if (handle == SCENE_INVALID_HANDLE || index >= pScene->count
+        || (pScene->pFlags[index] & SCENE_OBJECT_ALIVE) == 0
+        || pScene->pGenerations[index] != handle >> SCENE_HANDLE_INDEX_BITS)
+        return -1;
+
+    return (int)index;
+}
+
+
+SceneView get_scene_view(const SceneStore* pScene)
+{
+    SceneView view = {
+        .pTransforms    = pScene->pTransforms,
+        .pBounds        = pScene->pBounds,
+        .pPositions     = pScene->pPositions,
+        .pRotations     = pScene->pRotations,
+        .pScales        = pScene->pScales,
+        .pLocalBounds   = pScene->pLocalBounds,
+        .pParents       = pScene->pParents,
+        .pMeshIds       = pScene->pMeshIds,
+        .pMaterialIds   = pScene->pMaterialIds,
+        .pFlags         = pScene->pFlags,
+        .capacity       = pScene->capacity,
+        .count          = pScene->count,
+    };
+
+    return view;
+}
+
+
+void scene_mark_dirty(SceneStore* pScene, uint32_t begin, uint32_t end)
+{
+    if (end > pScene->count)
+        end = pScene->count;
+    if (begin >= end)
+        return;
+
+    if (pScene->dirtyBegin >= pScene->dirtyEnd)
+    {
+        pScene->dirtyBegin  = begin;
+        pScene->dirtyEnd    = end;
+        return;
+    }
+
+    if (begin < pScene->dirtyBegin)
+        pScene->dirtyBegin = begin;
+    if (end > pScene->dirtyEnd)
+        pScene->dirtyEnd = end;
+}
+
+
+void scene_record_upload(SceneStore* pScene, VkCommandBuffer commandBuffer, uint32_t frameIndex)
+{
+    if (pScene->dirtyBegin >= pScene->dirtyEnd || pScene->pStagingData == NULL)
+        return;
+
+    uint32_t begin = pScene->dirtyBegin;
+    uint32_t count = pScene->dirtyEnd - pScene->dirtyBegin;
+    pScene->dirtyBegin = pScene->dirtyEnd = 0;
+
+    // 1.两段连续内存的线性拷贝：变换与包围球，暂存分区与 GPU 缓冲的布局相同
+    VkDeviceSize boundsBase     = (VkDeviceSize)pScene->capacity * SCENE_TRANSFORM_FLOATS * sizeof(float);
+    VkDeviceSize stagingBase    = scene_gpu_size(pScene) * frameIndex;
+
+    VkBufferCopy regions[2] = {};
+    regions[0].srcOffset    = stagingBase + (VkDeviceSize)begin * SCENE_TRANSFORM_FLOATS * sizeof(float);
+    regions[0].dstOffset    = (VkDeviceSize)begin * SCENE_TRANSFORM_FLOATS * sizeof(float);
+    regions[0].size         = (VkDeviceSize)count * SCENE_TRANSFORM_FLOATS * sizeof(float);
+    regions[1].srcOffset    = stagingBase + boundsBase + (VkDeviceSize)begin * SCENE_BOUNDS_FLOATS * sizeof(float);
+    regions[1].dstOffset    = boundsBase + (VkDeviceSize)begin * SCENE_BOUNDS_FLOATS * sizeof(float);
+    regions[1].size         = (VkDeviceSize)count * SCENE_BOUNDS_FLOATS * sizeof(float);
+
+    memcpy(pScene->pStagingData + regions[0].srcOffset,
+        &pScene->pTransforms[begin * SCENE_TRANSFORM_FLOATS], (size_t)regions[0].size);
+    memcpy(pScene->pStagingData + regions[1].srcOffset,
+        &pScene->pBounds[begin * SCENE_BOUNDS_FLOATS], (size_t)regions[1].size);
+
+    // 2.之前提交（仍可能在途）的帧读完旧数据后才能覆盖（WAR 只需执行依赖）
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, NULL, 0, NULL, 0, NULL);
+
+    vkCmdCopyBuffer(commandBuffer, pScene->stagingBuffer, pScene->gpuBuffer, 2, regions);
+
+    // 3.拷贝结果对之后的着色器读取可见
+    VkBufferMemoryBarrier barrier = {};
+    barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask       = VK_ACCESS_SHADER_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer              = pScene->gpuBuffer;
+    barrier.offset              = 0;
+    barrier.size                = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 0, NULL, 1, &barrier, 0, NULL);
+}
+
+
+/// @brief GPU 缓冲（及每个暂存分区）的字节数.
+static VkDeviceSize scene_gpu_size(const SceneStore* pScene)
+{
+    return (VkDeviceSize)pScene->capacity 
+        * (SCENE_TRANSFORM_FLOATS + SCENE_BOUNDS_FLOATS) * sizeof(float);
+}
+
+
+static void compose_local_range(void* pArg, uint32_t begin, uint32_t end)
+{
+    SceneUpdateArgs* pArgs = (SceneUpdateArgs*)pArg;
+    SceneStore* pScene = pArgs->pScene;
+    uint32_t first = pArgs->base + begin;
+
+    pArgs->pKernels->composeLocal(&pScene->pPositions[first * 4], &pScene->pRotations[first * 4],
+        &pScene->pScales[first * 4], &pScene->pTransforms[first * SCENE_TRANSFORM_FLOATS], end - begin);
+}
+
+
+static void update_bounds_range(void* pArg, uint32_t begin, uint32_t end)
+{
+    SceneUpdateArgs* pArgs = (SceneUpdateArgs*)pArg;
+    SceneStore* pScene = pArgs->pScene;
+    uint32_t first = pArgs->base + begin;
+
+    pArgs->pKernels->updateBounds(&pScene->pTransforms[first * SCENE_TRANSFORM_FLOATS],
+        &pScene->pLocalBounds[first * 4], &pScene->pBounds[first * SCENE_BOUNDS_FLOATS], end - begin);
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "../common/ansi_esc.h"
+#include "../common/arena.h"
+#include "../common/job_system.h"
+#include "vulkan_wrapper.h"
+#include "frame_context.h"
+#include "scene_kernels.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 渲染上下文中场景的默认容量（对象数）.
+#define SCENE_STORE_CAPACITY        4096
+/// @brief 句柄中槽位索引所占的位数，其余高位为代数（generation）.
+#define SCENE_HANDLE_INDEX_BITS     20
+#define SCENE_HANDLE_INDEX_MASK     ((1u << SCENE_HANDLE_INDEX_BITS) - 1)
+/// @brief 无效句柄.
+#define SCENE_INVALID_HANDLE        0u
+
+/// @brief 每个变换矩阵的 float 数（列主序 4x4）.
+#define SCENE_TRANSFORM_FLOATS      16
+/// @brief 每个包围球的 float 数（中心 xyz + 半径）.
+#define SCENE_BOUNDS_FLOATS         4
+
+/// @brief 对象标志位.
+typedef enum SceneObjectFlags {
+    SCENE_OBJECT_ALIVE      = 1u << 0,      // 槽位正在使用（线性遍历时据此跳过空闲槽位）
+    SCENE_OBJECT_VISIBLE    = 1u << 1,      // 参与渲染
+} SceneObjectFlags;
+
+/// @brief 结构体数组（SoA）形式的场景存储.
+///
+/// 每种属性各占一段连续数组（按缓存行对齐），同一对象在各数组中的下标相同. 容量在创建时
+/// 固定，数组地址在其生命周期内不变，C# 可以直接以 Span 读写；句柄由槽位索引与代数组成，
+/// 槽位被回收后旧句柄即失效.
+///
+/// 写入变换或包围球后需用 scene_mark_dirty 标记其下标范围，下一次 scene_record_upload
+/// 只上传该范围到 GPU 缓冲（变换在前、包围球在后的一块存储缓冲）.
+///
+/// 也可以只写入局部的平移 / 旋转 / 缩放与局部包围球，由 scene_update_transforms 批量
+/// 计算世界矩阵（含父子层级）与世界包围球.
+typedef struct SceneStore {
+    Arena               arena;                  // 所有数组的唯一一次分配
+    uint32_t            capacity;
+    uint32_t            count;                  // 曾使用过的最大槽位数（线性遍历的上界）
+
+    float*              pTransforms;            // capacity * SCENE_TRANSFORM_FLOATS
+    float*              pBounds;                // capacity * SCENE_BOUNDS_FLOATS
+    float*              pPositions;             // 局部平移 xyz_（以下均为 capacity * 4）
+    float*              pRotations;             // 局部旋转（单位四元数 xyzw）
+    float*              pScales;                // 局部缩放 xyz_
+    float*              pLocalBounds;           // 局部包围球（中心 xyz + 半径）
+    uint32_t*           pParents;               // 父对象的下标（总小于自身），无父对象为 SCENE_NO_PARENT
+    uint32_t*           pMeshIds;
+    uint32_t*           pMaterialIds;
+    uint32_t*           pFlags;                 // SceneObjectFlags
+    uint32_t*           pGenerations;           // 各槽位的当前代数（从 1 开始）
+
+    uint32_t*           pFreeList;              // 空闲槽位栈
+    uint32_t            freeCount;
+
+    uint32_t            dirtyBegin;             // 待上传的下标范围 [dirtyBegin, dirtyEnd)
+    uint32_t            dirtyEnd;
+
+    VkBuffer            gpuBuffer;              // 设备本地：变换 | 包围球
+    VkDeviceMemory      gpuMemory;
+    VkBuffer            stagingBuffer;          // 主机可见：每个在途帧一份与 gpuBuffer 等大的分区
+    VkDeviceMemory      stagingMemory;
+    unsigned char*      pStagingData;
+} SceneStore;
+
+
+/// @brief 场景各数组的地址与大小，供 C# 以 Span 直接访问.
+typedef struct SceneView {
+    float*              pTransforms;
+    float*              pBounds;
+    float*              pPositions;
+    float*              pRotations;
+    float*              pScales;
+    float*              pLocalBounds;
+    const uint32_t*     pParents;
+    uint32_t*           pMeshIds;
+    uint32_t*           pMaterialIds;
+    uint32_t*           pFlags;
+    uint32_t            capacity;
+    uint32_t            count;
+} SceneView;
+
+
+/// @brief 创建场景存储及其 GPU 缓冲与暂存缓冲.
+///
+/// @param capacity 最大对象数（不超过 `SCENE_HANDLE_INDEX_MASK`）
+///
+/// @return 成功时返回 `true`，失败时已创建的对象会被销毁并返回 `false`
+bool create_scene_store(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            capacity,
+    SceneStore*         pScene
+);
+
+/// @brief 销毁场景存储中的所有对象并释放其内存（调用前需确保 GPU 已空闲）.
+void destroy_scene_store(VkDevice device, SceneStore* pScene);
+
+/// @brief 创建一个对象：变换为单位矩阵（局部缩放为 1、旋转为单位四元数），没有父对象，
+/// 其余属性清零，标志为 ALIVE | VISIBLE.
+///
+/// @return 新对象的句柄，场景已满时返回 `SCENE_INVALID_HANDLE`
+uint32_t scene_create_object(SceneStore* pScene);
+
+/// @brief 销毁给定句柄的对象，回收其槽位（无效句柄会被忽略），其子对象成为根对象.
+void scene_destroy_object(SceneStore* pScene, uint32_t handle);
+
+/// @brief 获取句柄对应的数组下标.
+///
+/// @return 数组下标，句柄无效（或对象已被销毁）时返回 -1
+int scene_object_index(const SceneStore* pScene, uint32_t handle);
+
+/// @brief 设置对象的父对象.
+///
+/// 父对象的下标必须小于子对象（即先于子对象创建且未被回收重用），这样世界矩阵可以按
+/// 下标顺序一次算完.
+///
+/// @param parent 父对象句柄，传入 `SCENE_INVALID_HANDLE` 时解除父子关系
+///
+/// @return 成功时返回 `true`
+bool scene_set_parent(SceneStore* pScene, uint32_t child, uint32_t parent);
+
+/// @brief 由局部平移 / 旋转 / 缩放批量计算下标 [begin, end) 的世界矩阵与世界包围球，并将该
+/// 范围标记为待上传.
+///
+/// 按父对象在前的顺序处理，调用者需保证范围内对象的父对象已经是最新的（通常对整个
+/// [0, count) 调用一次）.
+///
+/// @param pJobs 不为 `NULL` 时，局部矩阵与包围球两遍在任务系统上并行（层级传递仍为顺序执行）
+void scene_update_transforms(SceneStore* pScene, JobSystem* pJobs, uint32_t begin, uint32_t end);
+
+/// @brief 获取场景各数组的地址与大小.
+SceneView get_scene_view(const SceneStore* pScene);
+
+/// @brief 将下标范围 [begin, end) 标记为待上传.
+void scene_mark_dirty(SceneStore* pScene, uint32_t begin, uint32_t end);
+
+/// @brief 将待上传的范围拷贝到 `frameIndex` 帧的暂存分区，并在给定命令缓冲中录制到 GPU
+/// 缓冲的拷贝及前后的管线屏障（需在渲染通道外、等待该帧的栅栏之后调用）.
+void scene_record_upload(SceneStore* pScene, VkCommandBuffer commandBuffer, uint32_t frameIndex);
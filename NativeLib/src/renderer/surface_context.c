@@ -0,0 +1,408 @@
+#include "surface_context.h"
+#include "render_context.h"
+
+/// @brief 无头模式下离屏图像的格式
+static const VkFormat offscreenImageFormat = VK_FORMAT_R8G8B8A8_UNORM;
+
+static void destroy_surface_render_target(RenderContext* pContext, SurfaceContext* pSurface);
+static void destroy_surface_pipeline(RenderContext* pContext, SurfaceContext* pSurface);
+static VkPipeline create_builtin_pipeline(
+    RenderContext*  pContext,
+    VkRenderPass    renderPass,
+    ShaderCode      vertexCode,
+    bool            meshVertexInput
+);
+
+
+bool init_window_surface(VkInstance instance, GLFWwindow* window, SurfaceContext* pSurface)
+{
+    pSurface->window    = window;
+    pSurface->headless  = false;
+    pSurface->surface   = createSurface(instance, window);
+
+    return pSurface->surface != VK_NULL_HANDLE;
+}
+
+
+void init_offscreen_surface(VkExtent2D extent, SurfaceContext* pSurface)
+{
+    pSurface->window    = NULL;
+    pSurface->headless  = true;
+    pSurface->surface   = VK_NULL_HANDLE;
+
+    pSurface->swapchainImageFormat  = offscreenImageFormat;
+    pSurface->swapchainExtent       = extent;
+}
+
+
+bool create_surface_render_pass(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    if (!pSurface->headless && pSurface->swapchain == VK_NULL_HANDLE)
+        pSurface->swapchainImageFormat =                // createSwapchain 会选取同一格式
+            get_optimal_surface_format(pContext->physicalDevice, pSurface->surface).format;
+
+    pSurface->renderPass = createRenderPass(pContext->device,   // 创建渲染通道
+                               pSurface->swapchainImageFormat,
+                               pSurface->headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                                                  : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+    return pSurface->renderPass != VK_NULL_HANDLE;
+}
+
+
+bool create_surface_render_target(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    if (pSurface->headless)
+    {
+        // 离屏图像作为唯一的 "交换链图像"，帧回读与 begin_frame / end_frame 无需区分
+        pSurface->swapchainImages = 
+            (VkImage*)arena_calloc(&pSurface->swapchainArena, 1, sizeof(VkImage));
+        if (!pSurface->swapchainImages)
+            return false;
+
+        if (!createOffscreenImage(pContext->physicalDevice,
+                pContext->device,
+                pSurface->swapchainImageFormat,
+                pSurface->swapchainExtent,
+                &pSurface->swapchainImages[0],
+                &pSurface->offscreenImageMemory))
+            return false;
+
+        pSurface->swapchainImageCount   = 1;
+        pSurface->readbackSupported     = true;
+    }
+    else
+    {
+        pSurface->swapchain = createSwapchain(pSurface->window,    // 为窗口（表面）创建交换链
+                                  pSurface->surface,
+                                  pContext->physicalDevice,
+                                  pContext->device,
+                                  &pSurface->swapchainImageCount,
+                                  &pSurface->swapchainImages,
+                                  &pSurface->swapchainImageFormat,
+                                  &pSurface->swapchainExtent,
+                                  &pSurface->readbackSupported,
+                                  &pSurface->swapchainArena);
+        if (pSurface->swapchain == VK_NULL_HANDLE)
+            return false;
+    }
+
+    pSurface->swapchainImageViews = createSwapchainImageViews(pContext->device,
+                                        pSurface->swapchainImageFormat,       
+                                        pSurface->swapchainImageCount,    // 创建交换链的
+                                        pSurface->swapchainImages,        // 图形视图
+                                        &pSurface->swapchainArena);
+    if (!pSurface->swapchainImageViews)
+        return false;
+
+    pSurface->swapchainFramebuffers = createFramebuffers(pContext->device,
+                                          pSurface->renderPass,
+                                          pSurface->swapchainExtent,
+                                          pSurface->swapchainImageCount,
+                                          pSurface->swapchainImageViews,
+                                          &pSurface->swapchainArena);
+    if (!pSurface->swapchainFramebuffers)
+        return false;
+
+    return true;
+}
+
+
+bool create_surface_pipeline(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    // 1.支持图形管线库时由预编译的部分快速链接，立即可用；优化链接在工作线程上进行
+    const PipelineLibrary* pLibrary = pipeline_library_get(&pContext->pipelineLibraries,
+                                          pSurface->swapchainImageFormat,
+                                          pSurface->renderPass);
+    if (pLibrary != NULL
+        && pipeline_library_fast_link(&pContext->pipelineLibraries, pLibrary,
+               &pSurface->trianglePipeline, &pSurface->meshPipeline))
+    {
+        pipeline_library_link_async(&pContext->jobs, &pContext->pipelineLibraries,
+            pLibrary, &pSurface->linkJob);
+    }
+    else
+    {
+        // 2.否则创建完整的管线；顶点拉取管线创建失败时只是不能绘制拉取网格
+        pSurface->trianglePipeline = create_builtin_pipeline(pContext,
+                                         pSurface->renderPass,
+                                         get_triangle_vertex_shader_code(),
+                                         false);
+
+        if (pContext->bufferDeviceAddress && pSurface->trianglePipeline != VK_NULL_HANDLE)
+            pSurface->meshPipeline = create_builtin_pipeline(pContext,
+                                         pSurface->renderPass,
+                                         get_mesh_pull_vertex_shader_code(),
+                                         false);
+    }
+
+    // 3.经典网格的顶点输入管线不经过管线库，创建失败时只是不能绘制经典网格
+    if (pSurface->trianglePipeline != VK_NULL_HANDLE)
+        pSurface->vertexPipeline = create_builtin_pipeline(pContext,
+                                       pSurface->renderPass,
+                                       get_mesh_vertex_shader_code(),
+                                       true);
+
+    return pSurface->trianglePipeline != VK_NULL_HANDLE;
+}
+
+
+bool precompile_surface_pipeline(RenderContext* pContext, const PipelineKey* pKey)
+{
+    if (pKey->kind == PIPELINE_KIND_MESH_PULL && !pContext->bufferDeviceAddress)
+        return false;
+
+    // 渲染通道的兼容性只取决于颜色格式（最终布局无关），以一个临时渲染通道编译
+    VkFormat colorFormat = (VkFormat)pKey->colorFormat;
+    VkRenderPass renderPass = createRenderPass(pContext->device,
+                                  colorFormat,
+                                  VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    if (renderPass == VK_NULL_HANDLE)
+        return false;
+
+    // 支持图形管线库时准备该格式的部分，并做一次优化链接，使之后后台的优化链接命中管线缓存
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    const PipelineLibrary* pLibrary = pipeline_library_get(&pContext->pipelineLibraries,
+                                          colorFormat, renderPass);
+    if (pLibrary != NULL)
+        pipeline = pipeline_library_link(&pContext->pipelineLibraries, pLibrary,
+                       pKey->kind == PIPELINE_KIND_MESH_PULL ? pLibrary->meshVertex
+                                                             : pLibrary->triangleVertex,
+                       true);
+    else
+        pipeline = create_builtin_pipeline(pContext, renderPass,
+                       pKey->kind == PIPELINE_KIND_MESH_PULL ? get_mesh_pull_vertex_shader_code()
+                                                             : get_triangle_vertex_shader_code(),
+                       false);
+
+    // 编译结果已进入管线缓存，管线本身不再需要
+    if (pipeline != VK_NULL_HANDLE)
+        destroyPipeline(pContext->device, pipeline);
+    destroyRenderPass(pContext->device, renderPass);
+
+    return pipeline != VK_NULL_HANDLE;
+}
+
+
+void update_surface_pipeline(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    VkPipeline trianglePipeline = VK_NULL_HANDLE;
+    VkPipeline meshPipeline     = VK_NULL_HANDLE;
+    if (!pipeline_link_job_take(&pSurface->linkJob, &trianglePipeline, &meshPipeline))
+        return;
+
+    // 优化链接失败的管线保留快速链接的版本
+    VkPipeline* pTargets[]      = { &pSurface->trianglePipeline, &pSurface->meshPipeline };
+    VkPipeline  replacements[]  = { trianglePipeline, meshPipeline };
+    uint64_t serial = resource_retire_serial(pContext);
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        if (replacements[i] == VK_NULL_HANDLE)
+            continue;
+
+        ResourceData retired = {};
+        retired.pipeline.pipeline = *pTargets[i];
+        if (*pTargets[i] != VK_NULL_HANDLE
+            && !resource_table_retire(&pContext->resources, RESOURCE_TYPE_PIPELINE, &retired, serial))
+        {
+            destroyPipeline(pContext->device, replacements[i]);     // 无法延迟销毁旧管线时不替换
+            continue;
+        }
+
+        *pTargets[i] = replacements[i];
+    }
+
+    invalidate_static_passes(pContext);
+}
+
+
+bool create_surface_sync_objects(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    if (pSurface->headless)                             // 离屏图像无需获取与呈现
+        return true;
+
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+    {
+        if (vkCreateSemaphore(pContext->device, &semaphoreInfo, get_vulkan_allocator(),
+                &pSurface->imageAvailableSemaphores[i]) != VK_SUCCESS
+            || vkCreateSemaphore(pContext->device, &semaphoreInfo, get_vulkan_allocator(),
+                &pSurface->renderFinishedSemaphores[i]) != VK_SUCCESS)
+        {
+            fprintf(stderr, "%s : 为帧（%u）创建信号量失败！\n", __func__, i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool create_surface_objects(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    return create_surface_render_pass(pContext, pSurface)
+        && create_surface_render_target(pContext, pSurface)
+        && create_surface_pipeline(pContext, pSurface)
+        && create_surface_sync_objects(pContext, pSurface);
+}
+
+
+void destroy_surface_context(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    if (pContext->device != VK_NULL_HANDLE)
+    {
+        for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        {
+            if (pSurface->imageAvailableSemaphores[i] != VK_NULL_HANDLE)
+                vkDestroySemaphore(pContext->device,
+                    pSurface->imageAvailableSemaphores[i], get_vulkan_allocator());
+            if (pSurface->renderFinishedSemaphores[i] != VK_NULL_HANDLE)
+                vkDestroySemaphore(pContext->device,
+                    pSurface->renderFinishedSemaphores[i], get_vulkan_allocator());
+
+            pSurface->imageAvailableSemaphores[i] = VK_NULL_HANDLE;
+            pSurface->renderFinishedSemaphores[i] = VK_NULL_HANDLE;
+        }
+
+        destroy_surface_pipeline(pContext, pSurface);       // 销毁图形管线
+        destroy_surface_render_target(pContext, pSurface);  // 销毁交换链相关对象
+    }
+
+    if (pSurface->surface != VK_NULL_HANDLE)                // 销毁窗口表面
+        destroySurface(pContext->instance, pSurface->surface);
+
+    pSurface->surface   = VK_NULL_HANDLE;
+    pSurface->window    = NULL;
+    pSurface->acquired  = false;
+    pSurface->active    = false;
+}
+
+
+bool recreate_surface_render_target(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    if (!pSurface->headless)
+    {
+        int width = 0, height = 0;
+        glfwGetFramebufferSize(pSurface->window, &width, &height);
+        if (width == 0 || height == 0)
+            return false;
+    }
+
+    vkDeviceWaitIdle(pContext->device);
+
+    // 渲染通道依赖交换链图像格式，管线依赖渲染通道，一并重建（录制了旧管线的静态通道随之失效）
+    invalidate_static_passes(pContext);
+    destroy_surface_pipeline(pContext, pSurface);
+    destroy_surface_render_target(pContext, pSurface);
+
+    return create_surface_render_pass(pContext, pSurface)
+        && create_surface_render_target(pContext, pSurface)
+        && create_surface_pipeline(pContext, pSurface);
+}
+
+
+/// @brief 销毁交换链（离屏图像）、图像视图、渲染通道与帧缓冲（调用前需确保 GPU 已空闲）.
+static void destroy_surface_render_target(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    if (pSurface->staticCommandBuffers                             // 释放静态通道的二级命令
+        && pContext->frameContext.commandPool != VK_NULL_HANDLE)   // 缓冲（命令池已销毁时
+    {                                                              // 已随之释放）
+        vkFreeCommandBuffers(pContext->device, pContext->frameContext.commandPool,
+            MAX_FRAMES_IN_FLIGHT * pSurface->swapchainImageCount,
+            pSurface->staticCommandBuffers);
+    }
+    pSurface->staticCommandBuffers  = NULL;
+    pSurface->staticVersions        = NULL;
+
+    if (pSurface->swapchainFramebuffers)                           // 销毁帧缓冲
+        destroyFramebuffers(pContext->device,
+            pSurface->swapchainImageCount,
+            &pSurface->swapchainFramebuffers);
+
+    if (pSurface->renderPass != VK_NULL_HANDLE)                    // 销毁渲染通道
+    {
+        destroyRenderPass(pContext->device, pSurface->renderPass);
+        pSurface->renderPass = VK_NULL_HANDLE;
+    }
+
+    if (pSurface->swapchainImageViews)                             // 销毁交换链图像视图
+        destroySwapchainImageViews(pContext->device,               // 并释放其数组占用的
+            pSurface->swapchainImageCount,                         // 内存
+            &pSurface->swapchainImageViews);
+
+    if (pSurface->swapchain != VK_NULL_HANDLE)                     // 销毁交换链
+    {
+        destroySwapchain(pContext->device, pSurface->swapchain);
+        pSurface->swapchain = VK_NULL_HANDLE;
+    }
+
+    if (pSurface->headless && pSurface->swapchainImages)           // 销毁离屏图像
+    {
+        destroyOffscreenImage(pContext->device,
+            pSurface->swapchainImages[0],
+            pSurface->offscreenImageMemory);
+        pSurface->offscreenImageMemory = VK_NULL_HANDLE;
+    }
+    
+    pSurface->swapchainImages       = NULL;
+    pSurface->swapchainImageCount   = 0;
+
+    arena_reset(&pSurface->swapchainArena);                        // 回收所有句柄数组
+}
+
+/// @brief 销毁图形管线（调用前需确保 GPU 已空闲）.
+static void destroy_surface_pipeline(RenderContext* pContext, SurfaceContext* pSurface)
+{
+    pipeline_link_job_cancel(&pContext->jobs, &pSurface->linkJob);    // 等待并丢弃未取走的优化链接
+
+    if (pSurface->trianglePipeline != VK_NULL_HANDLE)
+        destroyPipeline(pContext->device, pSurface->trianglePipeline);
+
+    pSurface->trianglePipeline = VK_NULL_HANDLE;
+
+    if (pSurface->meshPipeline != VK_NULL_HANDLE)
+        destroyPipeline(pContext->device, pSurface->meshPipeline);
+
+    pSurface->meshPipeline = VK_NULL_HANDLE;
+
+    if (pSurface->vertexPipeline != VK_NULL_HANDLE)
+        destroyPipeline(pContext->device, pSurface->vertexPipeline);
+
+    pSurface->vertexPipeline = VK_NULL_HANDLE;
+}
+
+/// @brief 由给定的顶点着色器与内置片段着色器创建完整的图形管线（不经过管线库）.
+static VkPipeline create_builtin_pipeline(
+    RenderContext*  pContext,
+    VkRenderPass    renderPass,
+    ShaderCode      vertexCode,
+    bool            meshVertexInput
+)
+{
+    ShaderCode fragmentCode = get_triangle_fragment_shader_code();
+
+    VkShaderModule vertexShader = 
+        createShaderModule(pContext->device, vertexCode.pCode, vertexCode.size);
+    VkShaderModule fragmentShader = 
+        createShaderModule(pContext->device, fragmentCode.pCode, fragmentCode.size);
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if (vertexShader != VK_NULL_HANDLE && fragmentShader != VK_NULL_HANDLE)
+        pipeline = createGraphicsPipeline(pContext->device,
+                       pContext->pipelineCache,
+                       pContext->pipelineLayout,
+                       renderPass,
+                       vertexShader,
+                       fragmentShader,
+                       meshVertexInput);
+
+    if (vertexShader != VK_NULL_HANDLE)
+        destroyShaderModule(pContext->device, vertexShader);
+    if (fragmentShader != VK_NULL_HANDLE)
+        destroyShaderModule(pContext->device, fragmentShader);
+
+    return pipeline;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../common/ansi_esc.h"
+#include "../common/arena.h"
+#include "vulkan_wrapper.h"
+#include "frame_context.h"
+#include "pipeline.h"
+#include "pipeline_library.h"
+#include "pipeline_usage.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <GLFW/glfw3.h>
+
+/// @brief 一个渲染上下文最多同时管理的表面（窗口或离屏目标）数.
+#define MAX_SURFACES                8
+/// @brief 每个表面的交换链 Arena 的容量（交换链图像、图像视图与帧缓冲的句柄数组）.
+#define SWAPCHAIN_ARENA_SIZE        (16 * 1024)
+
+typedef struct RenderContext RenderContext;
+
+/// @brief 表面上下文：一个窗口（或无头模式下的一张离屏图像）独占的对象.
+///
+/// 实例、设备、管线缓存、命令缓冲与栅栏由所属的 RenderContext 共享，因此 N 个窗口
+/// 只需要 N 条交换链而不是 N 个设备；所有表面在一次提交中录制，在一次
+/// vkQueuePresentKHR 中呈现.
+typedef struct SurfaceContext {
+    Arena               swapchainArena;             // 重建渲染目标时整体重置
+    bool                active;                     // 该槽位是否正在使用
+
+    GLFWwindow*         window;                     // 无头模式下为 `NULL`
+    bool                headless;                   // 渲染到离屏图像，不呈现
+    VkSurfaceKHR        surface;
+
+    VkSwapchainKHR      swapchain;
+    uint32_t            swapchainImageCount;
+    VkImage*            swapchainImages;
+    VkFormat            swapchainImageFormat;
+    VkExtent2D          swapchainExtent;
+    VkImageView*        swapchainImageViews;
+    VkDeviceMemory      offscreenImageMemory;       // 离屏图像（唯一的 "交换链图像"）的内存
+    bool                readbackSupported;          // 渲染目标图像可作为传输源（帧回读需要）
+
+    VkRenderPass        renderPass;
+    VkFramebuffer*      swapchainFramebuffers;
+    VkPipeline          trianglePipeline;
+    VkPipeline          meshPipeline;               // 顶点拉取管线，设备不支持 bufferDeviceAddress 时为 NULL
+    VkPipeline          vertexPipeline;             // 经典网格（顶点缓冲输入）的管线，创建失败时为 NULL
+    PipelineLinkJob     linkJob;                    // 后台优化链接，完成后在 begin_frame 中替换快速链接的管线
+
+    VkSemaphore         imageAvailableSemaphores[MAX_FRAMES_IN_FLIGHT];    // 交换链图像可用
+    VkSemaphore         renderFinishedSemaphores[MAX_FRAMES_IN_FLIGHT];    // 渲染完成，可以呈现
+
+    // 静态通道：每个（在途帧, 交换链图像）一个预先录制的二级命令缓冲，从 swapchainArena 分配，
+    // 随渲染目标一起销毁；录制时的 staticPassVersion 与当前值不同时才重新录制
+    uint32_t            staticTriangleCount;        // 静态通道的内容，为 0 时没有静态通道
+    VkCommandBuffer*    staticCommandBuffers;       // MAX_FRAMES_IN_FLIGHT * swapchainImageCount
+    uint64_t*           staticVersions;             // 各命令缓冲录制时的版本，0 表示尚未录制
+
+    uint32_t            imageIndex;                 // 当前帧获取到的交换链图像索引
+    bool                acquired;                   // 当前帧是否获取到了图像（未获取的表面本帧跳过）
+    bool                passRecorded;               // 当前帧是否已录制了该表面的渲染通道
+} SurfaceContext;
+
+
+/// @brief 为窗口创建 VkSurfaceKHR 并记录窗口句柄（第一个窗口的表面需在选取物理设备前创建）.
+///
+/// @return 成功时返回 `true`
+bool init_window_surface(VkInstance instance, GLFWwindow* window, SurfaceContext* pSurface);
+
+/// @brief 将表面初始化为大小为 `extent` 的离屏目标（无头模式）.
+void init_offscreen_surface(VkExtent2D extent, SurfaceContext* pSurface);
+
+/// @brief 创建表面的渲染通道.
+///
+/// 窗口表面尚未创建交换链时，按 createSwapchain 将会选取的表面格式创建，因此渲染通道
+/// （以及依赖它的图形管线）可以先于交换链创建.
+bool create_surface_render_pass(RenderContext* pContext, SurfaceContext* pSurface);
+
+/// @brief 创建表面的渲染目标（交换链或离屏图像）、图像视图与帧缓冲（需先创建渲染通道）.
+bool create_surface_render_target(RenderContext* pContext, SurfaceContext* pSurface);
+
+/// @brief 由内置着色器创建表面的三角形图形管线（需先创建渲染通道）.
+///
+/// 设备支持图形管线库时，由按颜色格式缓存的管线库部分快速链接（只在首次遇到该格式时编译
+/// 着色器），并在工作线程上开始优化链接；否则创建完整的管线.
+/// 经典网格的顶点输入管线总是创建完整的管线.
+///
+/// 只写入表面的管线，可以在工作线程上与 create_surface_render_target 并行执行.
+bool create_surface_pipeline(RenderContext* pContext, SurfaceContext* pSurface);
+
+/// @brief 预编译给定键的表面管线并立即销毁，只为填充管线缓存（及管线库部分），
+/// 使之后创建同样的管线时不必编译着色器.
+///
+/// 可以在工作线程上与表面管线的创建并行执行.
+///
+/// @return 编译成功时返回 `true`
+bool precompile_surface_pipeline(RenderContext* pContext, const PipelineKey* pKey);
+
+/// @brief 后台的优化链接已完成时，用其结果替换快速链接的管线（每帧开始、录制之前调用）.
+///
+/// 被替换的管线在 GPU 完成当前在途的提交后才销毁，录制了它们的静态通道随之失效.
+void update_surface_pipeline(RenderContext* pContext, SurfaceContext* pSurface);
+
+/// @brief 创建表面每个在途帧的图像可用 / 渲染完成信号量.
+bool create_surface_sync_objects(RenderContext* pContext, SurfaceContext* pSurface);
+
+/// @brief 依次创建渲染通道、渲染目标、图形管线与同步对象.
+///
+/// @return 成功时返回 `true`（失败时已创建的对象由 destroy_surface_context 销毁）
+bool create_surface_objects(RenderContext* pContext, SurfaceContext* pSurface);
+
+/// @brief 销毁表面的所有对象（含 VkSurfaceKHR）并将槽位标记为空闲（调用前需确保 GPU 已空闲）.
+void destroy_surface_context(RenderContext* pContext, SurfaceContext* pSurface);
+
+/// @brief 重建表面的渲染目标及其依赖的渲染通道、帧缓冲与管线.
+///
+/// 窗口被最小化（帧缓冲大小为 0）时不会重建. 中途失败时渲染目标不完整（见
+/// surface_render_target_ready），begin_frame 会跳过该表面并在之后的帧中重试.
+///
+/// @return 重建成功时返回 `true`
+bool recreate_surface_render_target(RenderContext* pContext, SurfaceContext* pSurface);
+
+/// @brief 表面的渲染目标是否完整（重建中途失败时交换链、渲染通道或帧缓冲可能为 `NULL`）.
+static inline bool surface_render_target_ready(const SurfaceContext* pSurface)
+{
+    return pSurface->renderPass != VK_NULL_HANDLE
+        && pSurface->swapchainFramebuffers != NULL
+        && (pSurface->headless || pSurface->swapchain != VK_NULL_HANDLE);
+}
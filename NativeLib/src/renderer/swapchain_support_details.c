@@ -3,7 +3,8 @@
 
 SwapchainSupportDetails query_swapchain_support_details(
     VkPhysicalDevice    physicalDevice,
-    VkSurfaceKHR        surface    
+    VkSurfaceKHR        surface,
+    Arena*              pArena
 )
 {
     // 0.初始化
@@ -25,7 +26,7 @@ SwapchainSupportDetails query_swapchain_support_details(
     if (formatCount)
     {
         supportDetails.formats = (VkSurfaceFormatKHR*)
-            malloc(formatCount * sizeof(VkSurfaceFormatKHR));
+            arena_calloc(pArena, formatCount, sizeof(VkSurfaceFormatKHR));
 
         vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, 
             surface, 
@@ -51,7 +52,7 @@ SwapchainSupportDetails query_swapchain_support_details(
     if (presentModeCount)
     {
         supportDetails.presentModes = (VkPresentModeKHR*)
-            malloc(presentModeCount * sizeof(VkPresentModeKHR));
+            arena_calloc(pArena, presentModeCount, sizeof(VkPresentModeKHR));
 
         vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, 
         surface, 
@@ -70,24 +71,6 @@ SwapchainSupportDetails query_swapchain_support_details(
     return supportDetails;
 }
 
-void free_swapchain_support_details(SwapchainSupportDetails* pStructure)
-{
-    if(pStructure == NULL)
-        return;
-
-    if (pStructure->formats != NULL)
-    {
-        free(pStructure->formats);
-        pStructure->formats = NULL;
-    }
-
-    if (pStructure->presentModes != NULL)
-    {
-        free(pStructure->presentModes);
-        pStructure->presentModes = NULL;
-    }
-}
-
 VkSurfaceFormatKHR get_optimal_surface_format(
     VkPhysicalDevice    physicalDevice,
     VkSurfaceKHR        surface
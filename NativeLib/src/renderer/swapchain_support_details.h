@@ -1,19 +1,19 @@
 #pragma once
 
 #include "../common/ansi_esc.h"
+#include "../common/arena.h"
+#include "vulkan_loader.h"
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
-#include <vulkan/vulkan.h>
 #include <GLFW/glfw3.h>
 
 /// @brief 该结构体定义物理设备对一个 Surface 的支持细节，以作为 选取物理设备 \ 创建交换链
 /// 时的重要依据.
 /// 
-/// 通过调用 query_swapchain_support_details 函数来获取一个该结构体.
-/// 
-/// 通过调用 free_swapchain_support_details 函数来释放一个该结构体的内存.
+/// 通过调用 query_swapchain_support_details 函数来获取一个该结构体，其数组从调用者给定的
+/// Arena 分配，随 Arena 的重置回收.
 typedef struct SwapchainSupportDetails {
     VkSurfaceCapabilitiesKHR    capabilities;
     VkSurfaceFormatKHR*         formats;
@@ -21,20 +21,18 @@ typedef struct SwapchainSupportDetails {
 } SwapchainSupportDetails;
 
 
-/// @brief （该函数进行了 malloc，别忘了调用 free_swapchain_support_details 函数）
+/// @brief 查询物理设备对给定 Surface 的支持细节，并将相关信息填充至一个
+/// `SwapchainSupportDetails` 结构体并返回.
 ///
-/// 查询物理设备对给定 Surface 的支持细节，并将相关信息填充至一个 `SwapchainSupportDetails`
-/// 结构体并返回.
+/// @param pArena 结构体内的数组从该 Arena 分配（调用者可用 arena_mark / arena_reset_to 回收）
 ///
 /// @return 填充后的 `SwapchainSupportDetails` 结构体.
 SwapchainSupportDetails query_swapchain_support_details(
     VkPhysicalDevice    physicalDevice,
-    VkSurfaceKHR        surface    
+    VkSurfaceKHR        surface,
+    Arena*              pArena
 );
 
-/// @brief 释放结构体内按堆分配的内存.
-void free_swapchain_support_details(SwapchainSupportDetails* pStructure);
-
 /// @brief 给定物理设备查询 Surface Formats 并从中尝试选择最理想的 Surface 格式并返回.
 /// 
 /// @return Surface 格式 `B8G8R8A8_SRGB & SRGB_NONLINEAR_KHR`，当该格式不支持时，返回
@@ -0,0 +1,205 @@
+#include "uniform_ring.h"
+
+static bool create_uniform_ring_descriptors(VkDevice device, UniformRing* pRing);
+
+
+bool create_uniform_ring(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    bool                deviceLocal,
+    UniformRing*        pRing
+)
+{
+    memset(pRing, 0, sizeof(UniformRing));
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    pRing->alignment = properties.limits.minUniformBufferOffsetAlignment;
+    if (pRing->alignment == 0)
+        pRing->alignment = 1;
+
+    pRing->range = UNIFORM_RING_MAX_ALLOCATION;
+    if (pRing->range > properties.limits.maxUniformBufferRange)
+        pRing->range = properties.limits.maxUniformBufferRange;
+
+    // 1.缓冲末尾多留一个描述符范围，最后一次分配的 偏移 + range 也不会越界；
+    // 这段同时存放默认的 ObjectUniforms（分区大小是任何对齐要求的倍数）
+    VkDeviceSize size = (VkDeviceSize)UNIFORM_RING_FRAME_SIZE * MAX_FRAMES_IN_FLIGHT + pRing->range;
+    pRing->defaultOffset = UNIFORM_RING_FRAME_SIZE * MAX_FRAMES_IN_FLIGHT;
+
+    if (!createHostWritableBuffer(physicalDevice, device, size,
+            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+            deviceLocal,
+            MEMORY_CATEGORY_BUFFER,
+            0, NULL,
+            &pRing->buffer, &pRing->memory))
+        return false;
+
+    // 2.常驻映射
+    VkResult result = vkMapMemory(device, pRing->memory, 0, VK_WHOLE_SIZE, 0,
+                          (void**)&pRing->pMapped);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr, "Failed to map uniform ring memory! Error Code(VkResult): %d\n", result);
+
+        destroy_uniform_ring(device, pRing);
+        return false;
+    }
+
+    const ObjectUniforms defaults = {
+        .offset = { 0.0f, 0.0f, 0.0f, 0.0f },
+        .color  = { 1.0f, 1.0f, 1.0f, 1.0f }
+    };
+    memset(pRing->pMapped + pRing->defaultOffset, 0, pRing->range);
+    memcpy(pRing->pMapped + pRing->defaultOffset, &defaults, sizeof(ObjectUniforms));
+
+    // 3.描述符
+    if (!create_uniform_ring_descriptors(device, pRing))
+    {
+        destroy_uniform_ring(device, pRing);
+        return false;
+    }
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET
+        "成功创建了 uniform 环形缓冲（每帧 %d 字节，对齐 %llu 字节）！\n",
+        __DATE__, __TIME__, UNIFORM_RING_FRAME_SIZE, (unsigned long long)pRing->alignment);
+
+    return true;
+}
+
+
+void destroy_uniform_ring(VkDevice device, UniformRing* pRing)
+{
+    if (device == VK_NULL_HANDLE || pRing == NULL)
+        return;
+
+    // 描述符集随描述符池一并释放
+    if (pRing->descriptorPool != VK_NULL_HANDLE)
+        vkDestroyDescriptorPool(device, pRing->descriptorPool, get_vulkan_allocator());
+    if (pRing->setLayout != VK_NULL_HANDLE)
+        vkDestroyDescriptorSetLayout(device, pRing->setLayout, get_vulkan_allocator());
+
+    if (pRing->pMapped != NULL)
+        vkUnmapMemory(device, pRing->memory);
+
+    destroyBuffer(device, pRing->buffer, pRing->memory);
+
+    memset(pRing, 0, sizeof(UniformRing));
+}
+
+
+void uniform_ring_begin_frame(UniformRing* pRing, uint32_t frameIndex)
+{
+    pRing->frameIndex   = frameIndex;
+    pRing->frameOffset  = 0;
+}
+
+
+uint32_t uniform_ring_alloc(UniformRing* pRing, uint32_t size, void** ppData)
+{
+    if (pRing->pMapped == NULL || size == 0 || size > pRing->range)
+        return UNIFORM_RING_INVALID_OFFSET;
+
+    VkDeviceSize offset = (pRing->frameOffset + pRing->alignment - 1) 
+                        / pRing->alignment * pRing->alignment;
+    if (offset + size > UNIFORM_RING_FRAME_SIZE)
+        return UNIFORM_RING_INVALID_OFFSET;
+
+    pRing->frameOffset = offset + size;
+
+    VkDeviceSize ringOffset = (VkDeviceSize)pRing->frameIndex * UNIFORM_RING_FRAME_SIZE + offset;
+    *ppData = pRing->pMapped + ringOffset;
+
+    return (uint32_t)ringOffset;
+}
+
+
+uint32_t uniform_ring_push(UniformRing* pRing, const void* pData, uint32_t size)
+{
+    void* pDst = NULL;
+    uint32_t offset = uniform_ring_alloc(pRing, size, &pDst);
+    if (offset != UNIFORM_RING_INVALID_OFFSET)
+        memcpy(pDst, pData, size);
+
+    return offset;
+}
+
+
+/// @brief 创建引用整块环形缓冲的动态 uniform 描述符（set 0，binding 0，所有图形阶段可见）.
+static bool create_uniform_ring_descriptors(VkDevice device, UniformRing* pRing)
+{
+    // 1.描述符集布局
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding         = 0;
+    binding.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    binding.descriptorCount = 1;
+    binding.stageFlags      = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings    = &binding;
+
+    VkResult result = vkCreateDescriptorSetLayout(device, &layoutInfo, get_vulkan_allocator(),
+                          &pRing->setLayout);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkDescriptorSetLayout! Error Code(VkResult): %d\n", result);
+        return false;
+    }
+
+    // 2.只容纳这一个描述符集的描述符池
+    VkDescriptorPoolSize poolSize = {};
+    poolSize.type               = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSize.descriptorCount    = 1;
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets        = 1;
+    poolInfo.poolSizeCount  = 1;
+    poolInfo.pPoolSizes     = &poolSize;
+
+    result = vkCreateDescriptorPool(device, &poolInfo, get_vulkan_allocator(),
+                 &pRing->descriptorPool);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkDescriptorPool! Error Code(VkResult): %d\n", result);
+        return false;
+    }
+
+    // 3.分配并写入描述符集，之后不再更新，只改变动态偏移
+    VkDescriptorSetAllocateInfo allocateInfo = {};
+    allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool     = pRing->descriptorPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts        = &pRing->setLayout;
+
+    result = vkAllocateDescriptorSets(device, &allocateInfo, &pRing->descriptorSet);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to allocate a VkDescriptorSet! Error Code(VkResult): %d\n", result);
+        return false;
+    }
+
+    VkDescriptorBufferInfo bufferInfo = {};
+    bufferInfo.buffer   = pRing->buffer;
+    bufferInfo.offset   = 0;
+    bufferInfo.range    = pRing->range;
+
+    VkWriteDescriptorSet write = {};
+    write.sType             = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet            = pRing->descriptorSet;
+    write.dstBinding        = 0;
+    write.descriptorCount   = 1;
+    write.descriptorType    = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    write.pBufferInfo       = &bufferInfo;
+
+    vkUpdateDescriptorSets(device, 1, &write, 0, NULL);
+
+    return true;
+}
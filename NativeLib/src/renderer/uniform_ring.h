@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../common/ansi_esc.h"
+#include "vulkan_wrapper.h"
+#include "frame_context.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief 每个在途帧在环形缓冲中占用的字节数.
+#define UNIFORM_RING_FRAME_SIZE     (256 * 1024)
+/// @brief 单次分配的最大字节数，也是动态 uniform 描述符的范围（range）.
+#define UNIFORM_RING_MAX_ALLOCATION 1024
+/// @brief 分配失败时返回的无效偏移.
+#define UNIFORM_RING_INVALID_OFFSET UINT32_MAX
+
+/// @brief 内置着色器读取的每个对象的 uniform 块（set 0，binding 0），与 shaders/*.vert 中的
+/// ObjectUniforms 一致. 自定义的 uniform 数据需以该结构开头.
+typedef struct ObjectUniforms {
+    float               offset[4];              // 裁剪空间中的平移（xyz）
+    float               color[4];               // 与顶点颜色相乘（rgb）
+} ObjectUniforms;
+
+/// @brief 每帧的 uniform 环形缓冲.
+///
+/// 一块常驻映射的主机可见缓冲（设备支持时位于显存中）按在途帧数分区，每帧从自己的分区中线性分配，分配按
+/// `minUniformBufferOffsetAlignment` 对齐. 整块缓冲只由一个 `UNIFORM_BUFFER_DYNAMIC`
+/// 描述符（set 0，binding 0）引用，因此每个对象的常量更新只需一次 memcpy 与一个动态偏移，
+/// 而不需要新的缓冲或描述符写入.
+typedef struct UniformRing {
+    VkBuffer                buffer;
+    VkDeviceMemory          memory;
+    uint8_t*                pMapped;
+    VkDeviceSize            alignment;          // minUniformBufferOffsetAlignment
+    VkDeviceSize            range;              // 描述符范围（单次分配的上限）
+
+    uint32_t                frameIndex;         // 当前帧的分区
+    VkDeviceSize            frameOffset;        // 当前帧分区内已分配的字节数
+    uint32_t                defaultOffset;      // 所有分区之后常驻的默认 ObjectUniforms（不平移、颜色不变）
+
+    VkDescriptorSetLayout   setLayout;
+    VkDescriptorPool        descriptorPool;
+    VkDescriptorSet         descriptorSet;
+} UniformRing;
+
+
+/// @brief 创建 uniform 环形缓冲及其描述符集布局、描述符池与描述符集.
+///
+/// @param deviceLocal 是否优先放在可主机写入的显存中（见 createHostWritableBuffer）
+///
+/// @return 成功时返回 `true`，失败时已创建的对象会被销毁并返回 `false`
+bool create_uniform_ring(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    bool                deviceLocal,
+    UniformRing*        pRing
+);
+
+/// @brief 销毁 uniform 环形缓冲中的所有对象（调用前需确保 GPU 已空闲）.
+void destroy_uniform_ring(VkDevice device, UniformRing* pRing);
+
+/// @brief 切换到给定帧的分区并将其清空（只能在等待该帧的栅栏之后调用）.
+void uniform_ring_begin_frame(UniformRing* pRing, uint32_t frameIndex);
+
+/// @brief 在当前帧的分区中分配 `size` 字节.
+///
+/// @param ppData 输出参数，接收分配到的映射内存地址（数据只需写入，无需刷新）
+///
+/// @return 分配的动态偏移（用于 vkCmdBindDescriptorSets），`size` 超过
+/// `UNIFORM_RING_MAX_ALLOCATION` 或当前帧分区已满时返回 `UNIFORM_RING_INVALID_OFFSET`
+uint32_t uniform_ring_alloc(UniformRing* pRing, uint32_t size, void** ppData);
+
+/// @brief 将给定数据拷贝到当前帧的分区中.
+///
+/// @return 同 uniform_ring_alloc
+uint32_t uniform_ring_push(UniformRing* pRing, const void* pData, uint32_t size);
@@ -0,0 +1,315 @@
+#include "upload_context.h"
+#include "../common/trace.h"
+
+static bool submit_staging_copy(
+    VkDevice            device,
+    VkQueue             queue,
+    UploadContext*      pUploadContext,
+    VkBuffer            dstBuffer,
+    VkDeviceSize        dstOffset,
+    VkDeviceSize        size
+);
+static void create_timestamp_query_pool(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            queueFamilyIndex,
+    UploadContext*      pUploadContext
+);
+
+
+bool create_upload_context(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            queueFamilyIndex,
+    UploadContext*      pUploadContext
+)
+{
+    if (device == VK_NULL_HANDLE || pUploadContext == NULL)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！无法创建上传上下文.\n", __func__);
+
+        return false;
+    }
+
+    memset(pUploadContext, 0, sizeof(UploadContext));
+    pUploadContext->lastGpuTimeMs = -1.0;
+
+    // 1.命令池与命令缓冲
+    pUploadContext->commandPool = createCommandPool(device, queueFamilyIndex);
+    if (pUploadContext->commandPool == VK_NULL_HANDLE)
+        return false;
+
+    VkCommandBufferAllocateInfo allocateInfo = {};
+    allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocateInfo.commandPool        = pUploadContext->commandPool;
+    allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = 1;
+
+    VkResult result = vkAllocateCommandBuffers(device, &allocateInfo,
+                          &pUploadContext->commandBuffer);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to allocate a VkCommandBuffer! Error Code(VkResult): %d\n", result);
+
+        destroy_upload_context(device, pUploadContext);
+        return false;
+    }
+
+    // 2.栅栏
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    result = vkCreateFence(device, &fenceInfo, get_vulkan_allocator(), &pUploadContext->fence);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkFence! Error Code(VkResult): %d\n", result);
+
+        destroy_upload_context(device, pUploadContext);
+        return false;
+    }
+
+    // 3.持久映射的暂存缓冲
+    if (!createBuffer(physicalDevice, device,
+            UPLOAD_STAGING_BUFFER_SIZE,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            MEMORY_CATEGORY_STAGING,
+            0, NULL,
+            &pUploadContext->stagingBuffer,
+            &pUploadContext->stagingMemory))
+    {
+        destroy_upload_context(device, pUploadContext);
+        return false;
+    }
+
+    result = vkMapMemory(device, pUploadContext->stagingMemory, 0, VK_WHOLE_SIZE, 0,
+                 &pUploadContext->pStagingData);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to map staging memory! Error Code(VkResult): %d\n", result);
+
+        pUploadContext->pStagingData = NULL;
+        destroy_upload_context(device, pUploadContext);
+        return false;
+    }
+
+    // 4.时间戳查询池（可选）
+    create_timestamp_query_pool(physicalDevice, device, queueFamilyIndex, pUploadContext);
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "成功创建了上传上下文！\n",
+        __DATE__, __TIME__);
+
+    return true;
+}
+
+
+void destroy_upload_context(VkDevice device, UploadContext* pUploadContext)
+{
+    if (device == VK_NULL_HANDLE || pUploadContext == NULL)
+        return;
+
+    if (pUploadContext->pStagingData != NULL)
+        vkUnmapMemory(device, pUploadContext->stagingMemory);
+    pUploadContext->pStagingData = NULL;
+
+    destroyBuffer(device, pUploadContext->stagingBuffer, pUploadContext->stagingMemory);
+    pUploadContext->stagingBuffer = VK_NULL_HANDLE;
+    pUploadContext->stagingMemory = VK_NULL_HANDLE;
+
+    if (pUploadContext->timestampQueryPool != VK_NULL_HANDLE)
+        vkDestroyQueryPool(device, pUploadContext->timestampQueryPool, get_vulkan_allocator());
+    pUploadContext->timestampQueryPool = VK_NULL_HANDLE;
+
+    if (pUploadContext->fence != VK_NULL_HANDLE)
+        vkDestroyFence(device, pUploadContext->fence, get_vulkan_allocator());
+    pUploadContext->fence = VK_NULL_HANDLE;
+
+    // 命令缓冲随命令池一并释放
+    if (pUploadContext->commandPool != VK_NULL_HANDLE)
+        destroyCommandPool(device, pUploadContext->commandPool);
+    pUploadContext->commandPool     = VK_NULL_HANDLE;
+    pUploadContext->commandBuffer   = VK_NULL_HANDLE;
+}
+
+
+bool upload_to_buffer(
+    VkDevice            device,
+    VkQueue             queue,
+    UploadContext*      pUploadContext,
+    VkBuffer            dstBuffer,
+    VkDeviceSize        dstOffset,
+    const void*         pData,
+    VkDeviceSize        size
+)
+{
+    if (pUploadContext == NULL || pUploadContext->pStagingData == NULL
+        || dstBuffer == VK_NULL_HANDLE || (pData == NULL && size > 0))
+    {
+        fprintf(stderr, "%s : 传入了无效参数！\n", __func__);
+        return false;
+    }
+
+    double gpuTimeMs = pUploadContext->timestampQueryPool != VK_NULL_HANDLE ? 0.0 : -1.0;
+
+    const unsigned char* pBytes = (const unsigned char*)pData;
+    VkDeviceSize uploaded = 0;
+    while (uploaded < size)
+    {
+        VkDeviceSize chunkSize = size - uploaded;
+        if (chunkSize > UPLOAD_STAGING_BUFFER_SIZE)
+            chunkSize = UPLOAD_STAGING_BUFFER_SIZE;
+
+        memcpy(pUploadContext->pStagingData, pBytes + uploaded, (size_t)chunkSize);
+
+        uint64_t traceStart = trace_begin();
+        bool copied = submit_staging_copy(device, queue, pUploadContext,
+                          dstBuffer, dstOffset + uploaded, chunkSize);
+        trace_end("upload_staging_copy", traceStart);
+        if (!copied)
+            return false;
+
+        if (gpuTimeMs >= 0.0 && pUploadContext->lastGpuTimeMs >= 0.0)
+            gpuTimeMs += pUploadContext->lastGpuTimeMs;
+
+        uploaded += chunkSize;
+    }
+
+    pUploadContext->lastGpuTimeMs = gpuTimeMs;
+
+    return true;
+}
+
+
+/// @brief 录制并提交一次暂存缓冲到目标缓冲的拷贝，等待其完成并读取其 GPU 耗时.
+static bool submit_staging_copy(
+    VkDevice            device,
+    VkQueue             queue,
+    UploadContext*      pUploadContext,
+    VkBuffer            dstBuffer,
+    VkDeviceSize        dstOffset,
+    VkDeviceSize        size
+)
+{
+    VkCommandBuffer commandBuffer = pUploadContext->commandBuffer;
+    vkResetCommandBuffer(commandBuffer, 0);
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    VkResult result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to begin recording command buffer! Error Code(VkResult): %d\n",
+            result);
+        return false;
+    }
+
+    if (pUploadContext->timestampQueryPool != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(commandBuffer, pUploadContext->timestampQueryPool, 0, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            pUploadContext->timestampQueryPool, 0);
+    }
+
+    VkBufferCopy region = {};
+    region.srcOffset    = 0;
+    region.dstOffset    = dstOffset;
+    region.size         = size;
+
+    vkCmdCopyBuffer(commandBuffer, pUploadContext->stagingBuffer, dstBuffer, 1, &region);
+
+    if (pUploadContext->timestampQueryPool != VK_NULL_HANDLE)
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            pUploadContext->timestampQueryPool, 1);
+
+    result = vkEndCommandBuffer(commandBuffer);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to record command buffer! Error Code(VkResult): %d\n", result);
+        return false;
+    }
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pCommandBuffers      = &commandBuffer;
+
+    vkResetFences(device, 1, &pUploadContext->fence);
+
+    result = vkQueueSubmit(queue, 1, &submitInfo, pUploadContext->fence);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to submit upload command buffer! Error Code(VkResult): %d\n", result);
+        return false;
+    }
+
+    vkWaitForFences(device, 1, &pUploadContext->fence, VK_TRUE, UINT64_MAX);
+
+    pUploadContext->lastGpuTimeMs = -1.0;
+    if (pUploadContext->timestampQueryPool != VK_NULL_HANDLE)
+    {
+        uint64_t timestamps[2] = {0, 0};
+        result = vkGetQueryPoolResults(device, pUploadContext->timestampQueryPool, 0, 2,
+                     sizeof(timestamps), timestamps, sizeof(uint64_t),
+                     VK_QUERY_RESULT_64_BIT);
+        if (result == VK_SUCCESS)
+        {
+            uint64_t ticks = (timestamps[1] - timestamps[0]) & pUploadContext->timestampMask;
+            pUploadContext->lastGpuTimeMs = 
+                (double)ticks * pUploadContext->timestampPeriod * 1e-6;
+        }
+    }
+
+    return true;
+}
+
+
+/// @brief 当队列族支持时间戳时创建 2 个时间戳查询，否则不创建（不视为错误）.
+static void create_timestamp_query_pool(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            queueFamilyIndex,
+    UploadContext*      pUploadContext
+)
+{
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, NULL);
+
+    VkQueueFamilyProperties queueFamilies[queueFamilyCount];
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice,
+        &queueFamilyCount,
+        queueFamilies);
+
+    if (queueFamilyIndex >= queueFamilyCount
+        || queueFamilies[queueFamilyIndex].timestampValidBits == 0
+        || properties.limits.timestampPeriod <= 0.0f)
+        return;
+
+    VkQueryPoolCreateInfo createInfo = {};
+    createInfo.sType        = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType    = VK_QUERY_TYPE_TIMESTAMP;
+    createInfo.queryCount   = 2;
+
+    if (vkCreateQueryPool(device, &createInfo, get_vulkan_allocator(),
+            &pUploadContext->timestampQueryPool) != VK_SUCCESS)
+    {
+        pUploadContext->timestampQueryPool = VK_NULL_HANDLE;
+        return;
+    }
+
+    uint32_t validBits = queueFamilies[queueFamilyIndex].timestampValidBits;
+
+    pUploadContext->timestampPeriod = properties.limits.timestampPeriod;
+    pUploadContext->timestampMask   = validBits >= 64 ? UINT64_MAX : (1ull << validBits) - 1;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../common/ansi_esc.h"
+#include "vulkan_wrapper.h"
+#include "vulkan_loader.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/// @brief 暂存缓冲的大小，超过该大小的上传会被拆分为多次拷贝.
+#define UPLOAD_STAGING_BUFFER_SIZE (4ull * 1024 * 1024)
+
+/// @brief 上传上下文，通过一块持久映射的暂存缓冲把 CPU 数据拷贝到设备本地缓冲.
+typedef struct UploadContext {
+    VkCommandPool       commandPool;
+    VkCommandBuffer     commandBuffer;
+    VkFence             fence;
+
+    VkBuffer            stagingBuffer;
+    VkDeviceMemory      stagingMemory;
+    void*               pStagingData;               // 暂存缓冲的持久映射地址
+
+    VkQueryPool         timestampQueryPool;         // 2 个时间戳（开始 / 结束），不支持时为 NULL
+    float               timestampPeriod;
+    uint64_t            timestampMask;
+    double              lastGpuTimeMs;              // 最近一次上传的 GPU 耗时总和，< 0 表未知
+} UploadContext;
+
+
+/// @brief 创建上传上下文：命令池、命令缓冲、栅栏与暂存缓冲.
+///
+/// @param queueFamilyIndex 执行拷贝的队列族索引（一般为 graphics 队列族）
+///
+/// @return 成功时返回 `true`，失败时已创建的对象会被销毁并返回 `false`
+bool create_upload_context(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    uint32_t            queueFamilyIndex,
+    UploadContext*      pUploadContext
+);
+
+/// @brief 销毁上传上下文中的所有对象（调用前需确保 GPU 已空闲）.
+void destroy_upload_context(VkDevice device, UploadContext* pUploadContext);
+
+/// @brief 把数据上传到目标缓冲的指定偏移处，阻塞直到拷贝完成.
+///
+/// 目标缓冲需带有 `VK_BUFFER_USAGE_TRANSFER_DST_BIT`，数据大于暂存缓冲时会被分块上传.
+///
+/// @return 成功时返回 `true`
+bool upload_to_buffer(
+    VkDevice            device,
+    VkQueue             queue,
+    UploadContext*      pUploadContext,
+    VkBuffer            dstBuffer,
+    VkDeviceSize        dstOffset,
+    const void*         pData,
+    VkDeviceSize        size
+);
@@ -0,0 +1,211 @@
+#include "vulkan_allocator.h"
+
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief 每次分配前置的头部，记录原始指针与大小，以支持任意对齐与 pfnReallocation.
+typedef struct AllocationHeader {
+    void*       pRaw;
+    size_t      size;
+} AllocationHeader;
+
+static atomic_uint_fast64_t allocationCount;
+static atomic_uint_fast64_t reallocationCount;
+static atomic_uint_fast64_t freeCount;
+static atomic_uint_fast64_t internalAllocationCount;
+static atomic_uint_fast64_t bytesInUse;
+static atomic_uint_fast64_t peakBytesInUse;
+static atomic_uint_fast64_t scopeAllocationCounts[VULKAN_ALLOCATION_SCOPE_COUNT];
+
+static void* VKAPI_PTR allocation_callback(
+    void*                   pUserData,
+    size_t                  size,
+    size_t                  alignment,
+    VkSystemAllocationScope allocationScope
+);
+static void* VKAPI_PTR reallocation_callback(
+    void*                   pUserData,
+    void*                   pOriginal,
+    size_t                  size,
+    size_t                  alignment,
+    VkSystemAllocationScope allocationScope
+);
+static void VKAPI_PTR free_callback(void* pUserData, void* pMemory);
+static void VKAPI_PTR internal_allocation_callback(
+    void*                       pUserData,
+    size_t                      size,
+    VkInternalAllocationType    allocationType,
+    VkSystemAllocationScope     allocationScope
+);
+static void VKAPI_PTR internal_free_callback(
+    void*                       pUserData,
+    size_t                      size,
+    VkInternalAllocationType    allocationType,
+    VkSystemAllocationScope     allocationScope
+);
+
+static const VkAllocationCallbacks allocationCallbacks = {
+    .pUserData              = NULL,
+    .pfnAllocation          = allocation_callback,
+    .pfnReallocation        = reallocation_callback,
+    .pfnFree                = free_callback,
+    .pfnInternalAllocation  = internal_allocation_callback,
+    .pfnInternalFree        = internal_free_callback
+};
+
+
+const VkAllocationCallbacks* get_vulkan_allocator(void)
+{
+    return &allocationCallbacks;
+}
+
+
+void get_vulkan_allocation_stats(VulkanAllocationStats* pStats)
+{
+    pStats->allocationCount         = atomic_load(&allocationCount);
+    pStats->reallocationCount       = atomic_load(&reallocationCount);
+    pStats->freeCount               = atomic_load(&freeCount);
+    pStats->internalAllocationCount = atomic_load(&internalAllocationCount);
+    pStats->bytesInUse              = atomic_load(&bytesInUse);
+    pStats->peakBytesInUse          = atomic_load(&peakBytesInUse);
+
+    for (int i = 0; i < VULKAN_ALLOCATION_SCOPE_COUNT; i++)
+        pStats->scopeAllocationCounts[i] = atomic_load(&scopeAllocationCounts[i]);
+}
+
+
+void print_vulkan_allocation_stats(FILE* stream)
+{
+    VulkanAllocationStats stats;
+    get_vulkan_allocation_stats(&stats);
+
+    fprintf(stream,
+        "Vulkan 分配统计：分配 %llu 次，重分配 %llu 次，释放 %llu 次，内部分配 %llu 次，"
+        "未释放 %llu 字节（峰值 %llu 字节）\n"
+        "    按作用域：command %llu，object %llu，cache %llu，device %llu，instance %llu\n",
+        (unsigned long long)stats.allocationCount,
+        (unsigned long long)stats.reallocationCount,
+        (unsigned long long)stats.freeCount,
+        (unsigned long long)stats.internalAllocationCount,
+        (unsigned long long)stats.bytesInUse,
+        (unsigned long long)stats.peakBytesInUse,
+        (unsigned long long)stats.scopeAllocationCounts[VK_SYSTEM_ALLOCATION_SCOPE_COMMAND],
+        (unsigned long long)stats.scopeAllocationCounts[VK_SYSTEM_ALLOCATION_SCOPE_OBJECT],
+        (unsigned long long)stats.scopeAllocationCounts[VK_SYSTEM_ALLOCATION_SCOPE_CACHE],
+        (unsigned long long)stats.scopeAllocationCounts[VK_SYSTEM_ALLOCATION_SCOPE_DEVICE],
+        (unsigned long long)stats.scopeAllocationCounts[VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE]);
+}
+
+
+/// @brief 分配 `size` 字节并按 `alignment` 对齐，在返回地址之前写入 AllocationHeader.
+static void* aligned_allocate(size_t size, size_t alignment)
+{
+    if (alignment < alignof(AllocationHeader))
+        alignment = alignof(AllocationHeader);
+
+    void* pRaw = malloc(size + alignment + sizeof(AllocationHeader));
+    if (pRaw == NULL)
+        return NULL;
+
+    uintptr_t start = (uintptr_t)pRaw + sizeof(AllocationHeader);
+    uintptr_t aligned = (start + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+
+    AllocationHeader* pHeader = (AllocationHeader*)aligned - 1;
+    pHeader->pRaw = pRaw;
+    pHeader->size = size;
+
+    uint64_t inUse = atomic_fetch_add(&bytesInUse, size) + size;
+    uint64_t peak = atomic_load(&peakBytesInUse);
+    while (inUse > peak && !atomic_compare_exchange_weak(&peakBytesInUse, &peak, inUse))
+        ;
+
+    return (void*)aligned;
+}
+
+static void aligned_free(void* pMemory)
+{
+    AllocationHeader* pHeader = (AllocationHeader*)pMemory - 1;
+
+    atomic_fetch_sub(&bytesInUse, pHeader->size);
+    free(pHeader->pRaw);
+}
+
+
+static void* VKAPI_PTR allocation_callback(
+    void*                   pUserData,
+    size_t                  size,
+    size_t                  alignment,
+    VkSystemAllocationScope allocationScope
+)
+{
+    atomic_fetch_add(&allocationCount, 1);
+    if ((unsigned)allocationScope < VULKAN_ALLOCATION_SCOPE_COUNT)
+        atomic_fetch_add(&scopeAllocationCounts[allocationScope], 1);
+
+    if (size == 0)
+        return NULL;
+
+    return aligned_allocate(size, alignment);
+}
+
+static void* VKAPI_PTR reallocation_callback(
+    void*                   pUserData,
+    void*                   pOriginal,
+    size_t                  size,
+    size_t                  alignment,
+    VkSystemAllocationScope allocationScope
+)
+{
+    atomic_fetch_add(&reallocationCount, 1);
+
+    if (pOriginal == NULL)
+        return allocation_callback(pUserData, size, alignment, allocationScope);
+
+    if (size == 0)
+    {
+        free_callback(pUserData, pOriginal);
+        return NULL;
+    }
+
+    // 对齐要求可能改变，始终重新分配并拷贝
+    void* pMemory = aligned_allocate(size, alignment);
+    if (pMemory == NULL)
+        return NULL;            // 规范要求失败时保留原内存
+
+    size_t originalSize = ((AllocationHeader*)pOriginal - 1)->size;
+    memcpy(pMemory, pOriginal, originalSize < size ? originalSize : size);
+    aligned_free(pOriginal);
+
+    return pMemory;
+}
+
+static void VKAPI_PTR free_callback(void* pUserData, void* pMemory)
+{
+    if (pMemory == NULL)
+        return;
+
+    atomic_fetch_add(&freeCount, 1);
+    aligned_free(pMemory);
+}
+
+static void VKAPI_PTR internal_allocation_callback(
+    void*                       pUserData,
+    size_t                      size,
+    VkInternalAllocationType    allocationType,
+    VkSystemAllocationScope     allocationScope
+)
+{
+    atomic_fetch_add(&internalAllocationCount, 1);
+}
+
+static void VKAPI_PTR internal_free_callback(
+    void*                       pUserData,
+    size_t                      size,
+    VkInternalAllocationType    allocationType,
+    VkSystemAllocationScope     allocationScope
+)
+{
+}
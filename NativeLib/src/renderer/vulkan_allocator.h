@@ -0,0 +1,32 @@
+#pragma once
+
+#include "vulkan_loader.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief VkSystemAllocationScope 的数量（COMMAND / OBJECT / CACHE / DEVICE / INSTANCE）.
+#define VULKAN_ALLOCATION_SCOPE_COUNT 5
+
+/// @brief 经由 get_vulkan_allocator 的分配回调所统计的驱动内存分配信息.
+typedef struct VulkanAllocationStats {
+    uint64_t    allocationCount;                    // pfnAllocation 调用次数
+    uint64_t    reallocationCount;                  // pfnReallocation 调用次数
+    uint64_t    freeCount;                          // pfnFree 调用次数（不含 NULL）
+    uint64_t    internalAllocationCount;            // 驱动上报的内部分配次数
+    uint64_t    bytesInUse;                         // 当前仍未释放的字节数
+    uint64_t    peakBytesInUse;                     // bytesInUse 的历史最大值
+    uint64_t    scopeAllocationCounts[VULKAN_ALLOCATION_SCOPE_COUNT];  // 按作用域统计的分配次数
+} VulkanAllocationStats;
+
+
+/// @brief 获取渲染器所有 vkCreate* / vkDestroy* / vkAllocateMemory 调用使用的分配回调.
+///
+/// 回调在 C 运行时堆上分配并统计每一次分配，回调本身是线程安全的.
+const VkAllocationCallbacks* get_vulkan_allocator(void);
+
+/// @brief 获取当前的分配统计快照.
+void get_vulkan_allocation_stats(VulkanAllocationStats* pStats);
+
+/// @brief 打印当前的分配统计.
+void print_vulkan_allocation_stats(FILE* stream);
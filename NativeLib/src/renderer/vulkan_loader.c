@@ -0,0 +1,73 @@
+#include "vulkan_loader.h"
+
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#define VULKAN_DEFINE_FUNCTION(name) PFN_##name name = NULL;
+
+PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr = NULL;
+VULKAN_GLOBAL_FUNCTIONS(VULKAN_DEFINE_FUNCTION)
+VULKAN_INSTANCE_FUNCTIONS(VULKAN_DEFINE_FUNCTION)
+VULKAN_DEVICE_FUNCTIONS(VULKAN_DEFINE_FUNCTION)
+
+/// @brief 加载器的模块句柄，在进程的生命周期内保持打开
+static void* vulkanLibrary = NULL;
+
+
+bool load_vulkan_library(void)
+{
+    if (vkGetInstanceProcAddr != NULL)
+        return true;
+
+#ifdef _WIN32
+    vulkanLibrary = (void*)LoadLibraryA("vulkan-1.dll");
+    if (vulkanLibrary != NULL)
+        vkGetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)(void*)
+            GetProcAddress((HMODULE)vulkanLibrary, "vkGetInstanceProcAddr");
+#else
+    vulkanLibrary = dlopen("libvulkan.so.1", RTLD_NOW | RTLD_LOCAL);
+    if (vulkanLibrary == NULL)
+        vulkanLibrary = dlopen("libvulkan.so", RTLD_NOW | RTLD_LOCAL);
+    if (vulkanLibrary != NULL)
+        vkGetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)dlsym(vulkanLibrary, "vkGetInstanceProcAddr");
+#endif
+
+    if (vkGetInstanceProcAddr == NULL)
+    {
+        fprintf(stderr, "%s : 找不到 Vulkan 运行时（加载器）！\n", __func__);
+        return false;
+    }
+
+#define VULKAN_LOAD_GLOBAL(name) name = (PFN_##name)vkGetInstanceProcAddr(VK_NULL_HANDLE, #name);
+    VULKAN_GLOBAL_FUNCTIONS(VULKAN_LOAD_GLOBAL)
+#undef VULKAN_LOAD_GLOBAL
+
+    return vkCreateInstance != NULL;
+}
+
+
+void load_vulkan_instance_functions(VkInstance instance)
+{
+#define VULKAN_LOAD_INSTANCE(name) name = (PFN_##name)vkGetInstanceProcAddr(instance, #name);
+    VULKAN_INSTANCE_FUNCTIONS(VULKAN_LOAD_INSTANCE)
+#undef VULKAN_LOAD_INSTANCE
+}
+
+
+void load_vulkan_device_functions(VkDevice device)
+{
+    // 未启用的扩展（如无头模式下的交换链）得到 NULL，不会被调用
+#define VULKAN_LOAD_DEVICE(name) name = (PFN_##name)vkGetDeviceProcAddr(device, #name);
+    VULKAN_DEVICE_FUNCTIONS(VULKAN_LOAD_DEVICE)
+#undef VULKAN_LOAD_DEVICE
+
+    // Vulkan 1.1 设备上只能通过扩展的名字获取
+    if (vkGetBufferDeviceAddress == NULL)
+        vkGetBufferDeviceAddress = (PFN_vkGetBufferDeviceAddress)
+            vkGetDeviceProcAddr(device, "vkGetBufferDeviceAddressKHR");
+}
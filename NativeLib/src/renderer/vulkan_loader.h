@@ -0,0 +1,138 @@
+#pragma once
+
+// 所有 Vulkan 函数都经由本模块在运行时加载的函数指针调用，不链接 Vulkan 加载器的导出函数
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <vulkan/vulkan.h>
+#include <stdbool.h>
+
+/// @brief 不依赖实例的全局函数（由 vkGetInstanceProcAddr(NULL, ...) 获取）.
+#define VULKAN_GLOBAL_FUNCTIONS(X)                      \
+    X(vkCreateInstance)                                 \
+    X(vkEnumerateInstanceExtensionProperties)           \
+    X(vkEnumerateInstanceLayerProperties)
+
+/// @brief 实例级函数（由 vkGetInstanceProcAddr(instance, ...) 获取）.
+#define VULKAN_INSTANCE_FUNCTIONS(X)                    \
+    X(vkDestroyInstance)                                \
+    X(vkEnumeratePhysicalDevices)                       \
+    X(vkGetPhysicalDeviceProperties)                    \
+    X(vkGetPhysicalDeviceQueueFamilyProperties)         \
+    X(vkGetPhysicalDeviceMemoryProperties)              \
+    X(vkGetPhysicalDeviceMemoryProperties2)             \
+    X(vkGetPhysicalDeviceFeatures2)                     \
+    X(vkEnumerateDeviceExtensionProperties)             \
+    X(vkCreateDevice)                                   \
+    X(vkGetDeviceProcAddr)                              \
+    X(vkDestroySurfaceKHR)                              \
+    X(vkGetPhysicalDeviceSurfaceSupportKHR)             \
+    X(vkGetPhysicalDeviceSurfaceCapabilitiesKHR)        \
+    X(vkGetPhysicalDeviceSurfaceFormatsKHR)             \
+    X(vkGetPhysicalDeviceSurfacePresentModesKHR)
+
+/// @brief 设备级函数（由 vkGetDeviceProcAddr 获取，直接指向驱动，跳过加载器的分派跳板）.
+#define VULKAN_DEVICE_FUNCTIONS(X)                      \
+    X(vkDestroyDevice)                                  \
+    X(vkGetDeviceQueue)                                 \
+    X(vkDeviceWaitIdle)                                 \
+    X(vkQueueSubmit)                                    \
+    X(vkQueuePresentKHR)                                \
+    X(vkCreateSwapchainKHR)                             \
+    X(vkDestroySwapchainKHR)                            \
+    X(vkGetSwapchainImagesKHR)                          \
+    X(vkAcquireNextImageKHR)                            \
+    X(vkAllocateMemory)                                 \
+    X(vkFreeMemory)                                     \
+    X(vkMapMemory)                                      \
+    X(vkUnmapMemory)                                    \
+    X(vkInvalidateMappedMemoryRanges)                   \
+    X(vkCreateBuffer)                                   \
+    X(vkDestroyBuffer)                                  \
+    X(vkGetBufferMemoryRequirements)                    \
+    X(vkGetBufferDeviceAddress)                         \
+    X(vkBindBufferMemory)                               \
+    X(vkCreateImage)                                    \
+    X(vkDestroyImage)                                   \
+    X(vkGetImageMemoryRequirements)                     \
+    X(vkBindImageMemory)                                \
+    X(vkCreateImageView)                                \
+    X(vkDestroyImageView)                               \
+    X(vkCreateRenderPass)                               \
+    X(vkDestroyRenderPass)                              \
+    X(vkCreateFramebuffer)                              \
+    X(vkDestroyFramebuffer)                             \
+    X(vkCreateShaderModule)                             \
+    X(vkDestroyShaderModule)                            \
+    X(vkCreatePipelineCache)                            \
+    X(vkDestroyPipelineCache)                           \
+    X(vkGetPipelineCacheData)                           \
+    X(vkCreatePipelineLayout)                           \
+    X(vkDestroyPipelineLayout)                          \
+    X(vkCreateGraphicsPipelines)                        \
+    X(vkCreateComputePipelines)                         \
+    X(vkDestroyPipeline)                                \
+    X(vkCreateDescriptorSetLayout)                      \
+    X(vkDestroyDescriptorSetLayout)                     \
+    X(vkCreateDescriptorPool)                           \
+    X(vkDestroyDescriptorPool)                          \
+    X(vkAllocateDescriptorSets)                         \
+    X(vkUpdateDescriptorSets)                           \
+    X(vkCreateCommandPool)                              \
+    X(vkDestroyCommandPool)                             \
+    X(vkAllocateCommandBuffers)                         \
+    X(vkBeginCommandBuffer)                             \
+    X(vkEndCommandBuffer)                               \
+    X(vkResetCommandBuffer)                             \
+    X(vkFreeCommandBuffers)                             \
+    X(vkCmdExecuteCommands)                             \
+    X(vkCreateFence)                                    \
+    X(vkDestroyFence)                                   \
+    X(vkWaitForFences)                                  \
+    X(vkResetFences)                                    \
+    X(vkGetFenceStatus)                                 \
+    X(vkCreateSemaphore)                                \
+    X(vkDestroySemaphore)                               \
+    X(vkCreateQueryPool)                                \
+    X(vkDestroyQueryPool)                               \
+    X(vkGetQueryPoolResults)                            \
+    X(vkCmdBeginRenderPass)                             \
+    X(vkCmdEndRenderPass)                               \
+    X(vkCmdBindPipeline)                                \
+    X(vkCmdBindDescriptorSets)                          \
+    X(vkCmdPushConstants)                               \
+    X(vkCmdSetViewport)                                 \
+    X(vkCmdSetScissor)                                  \
+    X(vkCmdDraw)                                        \
+    X(vkCmdDrawIndexed)                                 \
+    X(vkCmdDispatch)                                    \
+    X(vkCmdBindVertexBuffers)                           \
+    X(vkCmdBindIndexBuffer)                             \
+    X(vkCmdPipelineBarrier)                             \
+    X(vkCmdCopyBuffer)                                  \
+    X(vkCmdCopyImageToBuffer)                           \
+    X(vkCmdResetQueryPool)                              \
+    X(vkCmdWriteTimestamp)
+
+#define VULKAN_DECLARE_FUNCTION(name) extern PFN_##name name;
+
+extern PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr;
+VULKAN_GLOBAL_FUNCTIONS(VULKAN_DECLARE_FUNCTION)
+VULKAN_INSTANCE_FUNCTIONS(VULKAN_DECLARE_FUNCTION)
+VULKAN_DEVICE_FUNCTIONS(VULKAN_DECLARE_FUNCTION)
+
+
+/// @brief 在运行时打开系统的 Vulkan 加载器（vulkan-1.dll / libvulkan.so.1）并获取全局函数
+/// （已加载时直接返回）.
+///
+/// @return 找不到 Vulkan 运行时时返回 `false`
+bool load_vulkan_library(void);
+
+/// @brief 获取给定实例的实例级函数，在 vkCreateInstance 成功后调用.
+void load_vulkan_instance_functions(VkInstance instance);
+
+/// @brief 获取给定设备的设备级函数，在 vkCreateDevice 成功后调用.
+///
+/// 函数指针是全局的：同一时刻只支持一个 VkDevice（渲染上下文所有窗口共用一个设备）.
+void load_vulkan_device_functions(VkDevice device);
@@ -14,19 +14,49 @@ static const char* requiredDeviceExtensions[] = {
     VK_KHR_SWAPCHAIN_EXTENSION_NAME
 };
 
+// 设备支持时才启用的扩展
+static const char* optionalDeviceExtensions[] = {
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
+    VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,    // Vulkan 1.2 起为核心功能，仍需启用其特性
+    VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME,
+    VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME
+};
+
 static bool check_instance_layer_properties(void);
 static void check_instance_extension_properties(void);
 static bool check_device_extension_properties(VkPhysicalDevice physicalDevice);
 static bool is_physical_device_suitable(
     VkPhysicalDevice    physicalDevice, 
-    VkSurfaceKHR        surface
+    VkSurfaceKHR        surface,
+    Arena*              pScratch
 );
+static int get_physical_device_type_score(VkPhysicalDevice physicalDevice);
 static void dump_physical_device_properties(VkPhysicalDevice physicalDevice);
+static bool create_buffer_object(
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices,
+    VkBuffer*               pBuffer
+);
+static VkResult allocate_buffer_memory(
+    VkDevice                    device,
+    VkBuffer                    buffer,
+    VkBufferUsageFlags          usage,
+    const VkMemoryRequirements* pRequirements,
+    uint32_t                    memoryTypeIndex,
+    MemoryCategory              category,
+    VkDeviceMemory*             pMemory
+);
 
 
-VkInstance createInstance(void)
+VkInstance createInstance(bool headless)
 {
-    // 0.检查验证层是否开启并可用
+    // 0.在运行时加载 Vulkan 加载器，并检查验证层是否开启并可用
+    if (!load_vulkan_library())
+        return VK_NULL_HANDLE;
+
     if (enableValidationLayers && !check_instance_layer_properties())
     {
         fprintf(stderr, "Validation layers requested, but not available!\n");
@@ -43,13 +73,17 @@ VkInstance createInstance(void)
     appInfo.engineVersion               = VK_MAKE_VERSION(0, 0, 1);
     appInfo.apiVersion                  = VK_API_VERSION_1_3;
 
-    // 1.5.查询所有可用扩展
-    check_instance_extension_properties();
+    // 1.5.查询所有可用扩展（仅用于诊断输出，未开启 VERBOSE 日志时跳过）
+    if (log_enabled(LOG_LEVEL_VERBOSE))
+        check_instance_extension_properties();
 
-    // 2.获取 GLFW 所需扩展的名称标识
+    // 2.获取 GLFW 所需扩展的名称标识（无头模式下不需要任何窗口表面扩展）
     uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+    const char** glfwExtensions = NULL;
+    if (!headless)
+        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
     // 打印
+    if (log_enabled(LOG_LEVEL_VERBOSE))
     {
         fprintf(stdout, "GLFW required instance extensions:\n");
         for (int i = 0; i < glfwExtensionCount; i++)
@@ -78,7 +112,7 @@ VkInstance createInstance(void)
 
     // 4.创建 Vulkan 实例
     VkInstance instance = VK_NULL_HANDLE;
-    VkResult result = vkCreateInstance(&createInfo, NULL, &instance);
+    VkResult result = vkCreateInstance(&createInfo, get_vulkan_allocator(), &instance);
     if (result != VK_SUCCESS)
     {
         fprintf(stderr, 
@@ -87,6 +121,8 @@ VkInstance createInstance(void)
         return VK_NULL_HANDLE;
     }
 
+    load_vulkan_instance_functions(instance);
+
     fprintf(stdout,
         ESC_LTALIC "%s %s " ESC_RESET "成功创建了一个 VkInstance！\n",
         __DATE__, __TIME__);
@@ -94,17 +130,20 @@ VkInstance createInstance(void)
     return instance;
 }
 
-/// @brief 查询对 VkInstance 可用的层并打印出来，并检查请求的层是否可用.
+/// @brief 查询对 VkInstance 可用的层并检查请求的层是否可用（VERBOSE 日志下打印出来）.
 ///
 /// @return 当检查到有请求的层不可用时，该函数会打印相关信息，并返回 `false`
 static bool check_instance_layer_properties(void)
 {
+    bool verbose = log_enabled(LOG_LEVEL_VERBOSE);
+
     uint32_t layerCount = 0;
     vkEnumerateInstanceLayerProperties(&layerCount, NULL);
-    fprintf(stdout,
-        "%s: Found" ESC_FCOLOR_BRIGHT_GREEN " %u " ESC_RESET
-        "available VkInstance layers:\n",
-        __func__, layerCount);
+    if (verbose)
+        fprintf(stdout,
+            "%s: Found" ESC_FCOLOR_BRIGHT_GREEN " %u " ESC_RESET
+            "available VkInstance layers:\n",
+            __func__, layerCount);
     
     if (layerCount < 1)
     {
@@ -117,22 +156,26 @@ static bool check_instance_layer_properties(void)
     VkLayerProperties layers[layerCount];
     vkEnumerateInstanceLayerProperties(&layerCount, layers);
     
-    // 打印全部可用层名
-    for (int i = 0; i < layerCount; i++)
-    {
-        fprintf(stdout,
-            ESC_FCOLOR_BRIGHT_GREEN "    %s\n" ESC_RESET,
-            layers[i].layerName);
-    }
-    // 打印我们请求的层名
-    fprintf(stdout, "Application required validation layers:\n");
-    
     uint32_t requiredValidationLayerCount = 
         sizeof(requiredValidationLayers) / sizeof(requiredValidationLayers[0]);
-    for (int i = 0; i < requiredValidationLayerCount ; i++)
+
+    if (verbose)
     {
-        fprintf(stdout,
-            ESC_FCOLOR_BLUE "    %s\n" ESC_RESET, requiredValidationLayers[i]);
+        // 打印全部可用层名
+        for (int i = 0; i < layerCount; i++)
+        {
+            fprintf(stdout,
+                ESC_FCOLOR_BRIGHT_GREEN "    %s\n" ESC_RESET,
+                layers[i].layerName);
+        }
+        // 打印我们请求的层名
+        fprintf(stdout, "Application required validation layers:\n");
+        
+        for (int i = 0; i < requiredValidationLayerCount ; i++)
+        {
+            fprintf(stdout,
+                ESC_FCOLOR_BLUE "    %s\n" ESC_RESET, requiredValidationLayers[i]);
+        }
     }
 
     // 检查 validationLayer 中的层是否可用
@@ -194,7 +237,7 @@ static void check_instance_extension_properties(void)
 
 void destroyInstance(VkInstance instance)
 {   
-    vkDestroyInstance(instance, NULL);
+    vkDestroyInstance(instance, get_vulkan_allocator());
 
     fprintf(stdout, 
         ESC_LTALIC "%s %s " ESC_RESET
@@ -207,7 +250,7 @@ VkSurfaceKHR createSurface(VkInstance instance, GLFWwindow* window)
 {
     VkSurfaceKHR surface = VK_NULL_HANDLE;
 
-    VkResult result = glfwCreateWindowSurface(instance, window, NULL, &surface);
+    VkResult result = glfwCreateWindowSurface(instance, window, get_vulkan_allocator(), &surface);
     if (result != VK_SUCCESS)
     {
         fprintf(stderr,
@@ -227,7 +270,7 @@ VkSurfaceKHR createSurface(VkInstance instance, GLFWwindow* window)
 
 void destroySurface(VkInstance instance, VkSurfaceKHR surface)
 {
-    vkDestroySurfaceKHR(instance, surface, NULL);
+    vkDestroySurfaceKHR(instance, surface, get_vulkan_allocator());
 
     fprintf(stdout, 
         ESC_LTALIC "%s %s " ESC_RESET
@@ -236,7 +279,11 @@ void destroySurface(VkInstance instance, VkSurfaceKHR surface)
 }
 
 
-VkPhysicalDevice pickPhysicalDevice(VkInstance instance, VkSurfaceKHR surface)
+VkPhysicalDevice pickPhysicalDevice(
+    VkInstance      instance,
+    VkSurfaceKHR    surface,
+    Arena*          pScratch
+)
 {
     // 1.查询可用的物理设备
     uint32_t deviceCount = 0;
@@ -252,14 +299,19 @@ VkPhysicalDevice pickPhysicalDevice(VkInstance instance, VkSurfaceKHR surface)
     VkPhysicalDevice physicalDevices[deviceCount];
     vkEnumeratePhysicalDevices(instance, &deviceCount, physicalDevices);
 
-    // 3.尝试选择可用的显卡
+    // 3.尝试选择可用的显卡，独显优先，其次集显、虚拟设备，最后是 CPU 实现（如 lavapipe）
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    int bestScore = -1;
     for (int i = 0; i < deviceCount; i++)
     {
-        if (is_physical_device_suitable(physicalDevices[i], surface))
+        if (!is_physical_device_suitable(physicalDevices[i], surface, pScratch))
+            continue;
+
+        int score = get_physical_device_type_score(physicalDevices[i]);
+        if (score > bestScore)
         {
+            bestScore = score;
             physicalDevice = physicalDevices[i];
-            break;
         }
     }
 
@@ -274,7 +326,8 @@ VkPhysicalDevice pickPhysicalDevice(VkInstance instance, VkSurfaceKHR surface)
         ESC_LTALIC "%s %s " ESC_RESET "成功选取了一个物理设备！\n",
         __DATE__, __TIME__);
 
-    dump_physical_device_properties(physicalDevice);
+    if (log_enabled(LOG_LEVEL_VERBOSE))
+        dump_physical_device_properties(physicalDevice);
 
     return physicalDevice;
 }
@@ -283,25 +336,31 @@ VkPhysicalDevice pickPhysicalDevice(VkInstance instance, VkSurfaceKHR surface)
 ///
 /// （至于具体要求详见函数）
 ///
+/// @param surface 给定的 Surface 句柄，为 `NULL` 时（无头模式）只检查图形队列支持
+/// @param pScratch 查询交换链支持细节用的临时 Arena（返回前会被回退）
+///
 /// @return `true` 当物理设备符合所有要求时，反之返回 `false`
 static bool is_physical_device_suitable(
     VkPhysicalDevice    physicalDevice, 
-    VkSurfaceKHR        surface
+    VkSurfaceKHR        surface,
+    Arena*              pScratch
 )
 {   
-    VkPhysicalDeviceProperties properties;
-    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
-
-    bool extensionsSupported = check_device_extension_properties(physicalDevice);
-
     QueueFamilyIndices queueFamilyIndices = 
         find_queue_families(physicalDevice, surface);
 
+    if (surface == VK_NULL_HANDLE)
+        return queueFamilyIndices.graphicsSupport >= 0;         // 是否队列支持图形
+
+    bool extensionsSupported = check_device_extension_properties(physicalDevice);
+
     bool swapchainSupported = false;
     if (extensionsSupported)
     {
+        size_t scratchMark = arena_mark(pScratch);
+
         SwapchainSupportDetails swapchainSupportDetails = 
-            query_swapchain_support_details(physicalDevice, surface);
+            query_swapchain_support_details(physicalDevice, surface, pScratch);
 
         if (swapchainSupportDetails.formats != NULL 
             && swapchainSupportDetails.presentModes != NULL)
@@ -309,28 +368,46 @@ static bool is_physical_device_suitable(
             swapchainSupported = true;
         }
 
-        free_swapchain_support_details(&swapchainSupportDetails);
+        arena_reset_to(pScratch, scratchMark);
     }
 
-    return properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU    // 是否独显
-        && extensionsSupported                                  // 是否支持请求的扩展
+    return extensionsSupported                                  // 是否支持请求的扩展
         && queueFamilyIndices.graphicsSupport >= 0              // 是否队列支持图形
         && queueFamilyIndices.presentationSupport >= 0          // 是否队列族支持呈现
         && swapchainSupported;                  // 是否满足给定 Surface 的交换链创建要求
 }
 
-/// @brief 查询给定物理设备可用的扩展并打印出来，并检查请求的扩展是否可用
+/// @brief 按物理设备类型打分，分数越高越优先被选取.
+static int get_physical_device_type_score(VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    switch (properties.deviceType)
+    {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:      return 4;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:    return 3;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:       return 2;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU:               return 1;
+        default:                                        return 0;
+    }
+}
+
+/// @brief 查询给定物理设备可用的扩展并检查请求的扩展是否可用（VERBOSE 日志下打印出来）
 ///
 /// @return 当检查到有请求的扩展不可用时，该函数会打印相关信息，并返回 `false`
 static bool check_device_extension_properties(VkPhysicalDevice physicalDevice)
 {
+    bool verbose = log_enabled(LOG_LEVEL_VERBOSE);
+
     uint32_t extensionCount = 0;
     vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &extensionCount, NULL);
 
-    fprintf(stdout,
-        "%s: Found" ESC_FCOLOR_BRIGHT_GREEN " %u " ESC_RESET
-        "available VkDevice extensions:\n",
-        __func__, extensionCount);
+    if (verbose)
+        fprintf(stdout,
+            "%s: Found" ESC_FCOLOR_BRIGHT_GREEN " %u " ESC_RESET
+            "available VkDevice extensions:\n",
+            __func__, extensionCount);
 
     if (extensionCount < 1)
     {
@@ -346,21 +423,25 @@ static bool check_device_extension_properties(VkPhysicalDevice physicalDevice)
         &extensionCount, 
         extensions);
 
-    for (int i = 0; i < extensionCount; i++)
-    {
-        fprintf(stdout,
-            ESC_FCOLOR_BRIGHT_GREEN "    %s\n" ESC_RESET,
-            extensions[i].extensionName);
-    }
-
-    fprintf(stdout, "Application required device extensions:\n");
-
     uint32_t requiredDeviceExtensionCount = 
         sizeof(requiredDeviceExtensions) / sizeof(requiredDeviceExtensions[0]);
-    for (int i = 0; i < requiredDeviceExtensionCount; i++)
+
+    if (verbose)
     {
-        fprintf(stdout,
-            ESC_FCOLOR_BLUE "    %s\n" ESC_RESET, requiredDeviceExtensions[i]);
+        for (int i = 0; i < extensionCount; i++)
+        {
+            fprintf(stdout,
+                ESC_FCOLOR_BRIGHT_GREEN "    %s\n" ESC_RESET,
+                extensions[i].extensionName);
+        }
+
+        fprintf(stdout, "Application required device extensions:\n");
+
+        for (int i = 0; i < requiredDeviceExtensionCount; i++)
+        {
+            fprintf(stdout,
+                ESC_FCOLOR_BLUE "    %s\n" ESC_RESET, requiredDeviceExtensions[i]);
+        }
     }
 
     bool hasOneNoFound = false;
@@ -392,6 +473,64 @@ static bool check_device_extension_properties(VkPhysicalDevice physicalDevice)
     return !hasOneNoFound;
 }
 
+bool isDeviceExtensionSupported(VkPhysicalDevice physicalDevice, const char* extensionName)
+{
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &extensionCount, NULL);
+    if (extensionCount < 1)
+        return false;
+
+    VkExtensionProperties extensions[extensionCount];
+    vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &extensionCount, extensions);
+
+    for (uint32_t i = 0; i < extensionCount; i++)
+    {
+        if (strcmp(extensionName, extensions[i].extensionName) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+bool isBufferDeviceAddressSupported(VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    if (properties.apiVersion < VK_API_VERSION_1_2
+        && !isDeviceExtensionSupported(physicalDevice, VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME))
+        return false;
+
+    VkPhysicalDeviceBufferDeviceAddressFeatures addressFeatures = {};
+    addressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features = {};
+    features.sType  = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext  = &addressFeatures;
+
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+    return addressFeatures.bufferDeviceAddress == VK_TRUE;
+}
+
+bool isGraphicsPipelineLibrarySupported(VkPhysicalDevice physicalDevice)
+{
+    if (!isDeviceExtensionSupported(physicalDevice, VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME)
+        || !isDeviceExtensionSupported(physicalDevice, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME))
+        return false;
+
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT libraryFeatures = {};
+    libraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+    VkPhysicalDeviceFeatures2 features = {};
+    features.sType  = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext  = &libraryFeatures;
+
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+    return libraryFeatures.graphicsPipelineLibrary == VK_TRUE;
+}
+
 static void dump_physical_device_properties(VkPhysicalDevice physicalDevice)
 {
     VkPhysicalDeviceProperties properties;
@@ -410,7 +549,11 @@ VkDevice createLogicalDevice(
     VkPhysicalDevice    physicalDevice,
     VkSurfaceKHR        surface,
     VkQueue*            graphicsQueue,
-    VkQueue*            presentationQueue
+    VkQueue*            presentationQueue,
+    uint32_t*           pGraphicsQueueFamilyIndex,
+    uint32_t*           pPresentationQueueFamilyIndex,
+    VkQueue*            computeQueue,
+    uint32_t*           pComputeQueueFamilyIndex
 )
 {
     int queueFamilyIndex = -1;
@@ -419,11 +562,14 @@ VkDevice createLogicalDevice(
             surface,
             &queueFamilyIndex);
     
+    // 无头模式下只需要 graphics 队列（presentation 队列与其相同），也不需要交换链扩展
+    bool headless = surface == VK_NULL_HANDLE;
+    
     VkDeviceQueueCreateInfo queueCreateInfo = {};   // 单队列族单队列
 
     VkDeviceQueueCreateInfo queueCreateInfoG = {};  // 双队列族双队列
     VkDeviceQueueCreateInfo queueCreateInfoP = {};  //
-    VkDeviceQueueCreateInfo queueCreateInfos[2];
+    VkDeviceQueueCreateInfo queueCreateInfos[3];
     QueueFamilyIndices queueFamilyIndices = 
                 find_queue_families(physicalDevice, surface);
 
@@ -431,8 +577,21 @@ VkDevice createLogicalDevice(
 
     VkPhysicalDeviceFeatures deviceFeatures = {};
 
-    uint32_t requiredDeviceExtensionCount = 
+    uint32_t requiredDeviceExtensionCount = headless ? 0 :
         sizeof(requiredDeviceExtensions) / sizeof(requiredDeviceExtensions[0]);
+    uint32_t optionalDeviceExtensionCount =
+        sizeof(optionalDeviceExtensions) / sizeof(optionalDeviceExtensions[0]);
+
+    // 必需的扩展之后追加设备支持的可选扩展
+    const char* enabledExtensions[requiredDeviceExtensionCount + optionalDeviceExtensionCount];
+    uint32_t enabledExtensionCount = 0;
+    for (uint32_t i = 0; i < requiredDeviceExtensionCount; i++)
+        enabledExtensions[enabledExtensionCount++] = requiredDeviceExtensions[i];
+    for (uint32_t i = 0; i < optionalDeviceExtensionCount; i++)
+    {
+        if (isDeviceExtensionSupported(physicalDevice, optionalDeviceExtensions[i]))
+            enabledExtensions[enabledExtensionCount++] = optionalDeviceExtensions[i];
+    }
 
     VkDeviceCreateInfo createInfo = {};
 
@@ -452,8 +611,8 @@ VkDevice createLogicalDevice(
         createInfo.pQueueCreateInfos        = &queueCreateInfo;
         createInfo.queueCreateInfoCount     = 1;
         createInfo.pEnabledFeatures         = &deviceFeatures;
-        createInfo.enabledExtensionCount    = requiredDeviceExtensionCount;
-        createInfo.ppEnabledExtensionNames  = requiredDeviceExtensions;
+        createInfo.enabledExtensionCount    = enabledExtensionCount;
+        createInfo.ppEnabledExtensionNames  = enabledExtensions;
     }
     else
     {
@@ -461,15 +620,13 @@ VkDevice createLogicalDevice(
         queueCreateInfoG.sType              = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
         queueCreateInfoG.queueFamilyIndex   = queueFamilyIndices.graphicsSupport;
         queueCreateInfoG.queueCount         = 1;
-        float queuePrioritiesG = 1.0f;
-        queueCreateInfoG.pQueuePriorities   = &queuePrioritiesG;
+        queueCreateInfoG.pQueuePriorities   = &queuePriorities;
 
         // (Presentation)
         queueCreateInfoP.sType              = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
         queueCreateInfoP.queueFamilyIndex   = queueFamilyIndices.presentationSupport;
         queueCreateInfoP.queueCount         = 1;
-        float queuePrioritiesP = 1.0f;
-        queueCreateInfoP.pQueuePriorities   = &queuePrioritiesP;
+        queueCreateInfoP.pQueuePriorities   = &queuePriorities;
 
         queueCreateInfos[0] = queueCreateInfoG;
         queueCreateInfos[1] = queueCreateInfoP;
@@ -481,13 +638,52 @@ VkDevice createLogicalDevice(
         createInfo.pQueueCreateInfos        = queueCreateInfos;
         createInfo.queueCreateInfoCount     = 2;
         createInfo.pEnabledFeatures         = &deviceFeatures;
-        createInfo.enabledExtensionCount    = requiredDeviceExtensionCount;
-        createInfo.ppEnabledExtensionNames  = requiredDeviceExtensions;
+        createInfo.enabledExtensionCount    = enabledExtensionCount;
+        createInfo.ppEnabledExtensionNames  = enabledExtensions;
+    }
+
+    // (Async Compute) 有不支持图形的计算队列族时为其单独创建一个队列，使计算与光栅化并行；
+    // 该队列族恰好也是 presentation 队列族时直接共用其队列
+    int computeFamily = queueFamilyIndices.asyncComputeSupport;
+    bool useAsyncCompute = computeFamily >= 0;
+    VkDeviceQueueCreateInfo queueCreateInfoC = {};
+    if (useAsyncCompute && (useSingleQueue || computeFamily != queueFamilyIndices.presentationSupport))
+    {
+        queueCreateInfoC.sType              = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueCreateInfoC.queueFamilyIndex   = computeFamily;
+        queueCreateInfoC.queueCount         = 1;
+        queueCreateInfoC.pQueuePriorities   = &queuePriorities;
+
+        if (useSingleQueue)
+        {
+            queueCreateInfos[0] = queueCreateInfo;
+            createInfo.pQueueCreateInfos = queueCreateInfos;
+        }
+        queueCreateInfos[createInfo.queueCreateInfoCount++] = queueCreateInfoC;
+    }
+
+    // (Buffer Device Address) 支持时启用，供顶点拉取路径使用
+    VkPhysicalDeviceBufferDeviceAddressFeatures addressFeatures = {};
+    addressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+    if (isBufferDeviceAddressSupported(physicalDevice))
+    {
+        addressFeatures.bufferDeviceAddress = VK_TRUE;
+        createInfo.pNext = &addressFeatures;
+    }
+
+    // (Graphics Pipeline Library) 支持时启用，新的管线先由预编译的部分快速链接
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT libraryFeatures = {};
+    libraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+    if (isGraphicsPipelineLibrarySupported(physicalDevice))
+    {
+        libraryFeatures.graphicsPipelineLibrary = VK_TRUE;
+        libraryFeatures.pNext = (void*)createInfo.pNext;
+        createInfo.pNext = &libraryFeatures;
     }
 
     // 4.创建逻辑设备
     VkDevice device = VK_NULL_HANDLE;
-    VkResult result = vkCreateDevice(physicalDevice, &createInfo, NULL, &device);
+    VkResult result = vkCreateDevice(physicalDevice, &createInfo, get_vulkan_allocator(), &device);
     if (result != VK_SUCCESS)
     {
         fprintf(stderr, 
@@ -496,15 +692,21 @@ VkDevice createLogicalDevice(
         return VK_NULL_HANDLE;
     }
 
+    // 之后所有设备级调用直接进入驱动
+    load_vulkan_device_functions(device);
+
     fprintf(stdout,
         ESC_LTALIC "%s %s " ESC_RESET "成功创建了一个 VkDevice！\n",
         __DATE__, __TIME__);
 
-    // 5.out 参数形式返回创建好的 VkQueue
+    // 5.out 参数形式返回创建好的 VkQueue 及其所属队列族索引
     if (useSingleQueue)
     {
         vkGetDeviceQueue(device, queueFamilyIndex, 0, graphicsQueue);
         vkGetDeviceQueue(device, queueFamilyIndex, 0, presentationQueue);
+
+        *pGraphicsQueueFamilyIndex      = queueFamilyIndex;
+        *pPresentationQueueFamilyIndex  = queueFamilyIndex;
     }
     else
     {
@@ -516,6 +718,9 @@ VkDevice createLogicalDevice(
             queueFamilyIndices.presentationSupport, 
             0, 
             presentationQueue);
+
+        *pGraphicsQueueFamilyIndex      = queueFamilyIndices.graphicsSupport;
+        *pPresentationQueueFamilyIndex  = queueFamilyIndices.presentationSupport;
     }
 
     fprintf(stdout,
@@ -526,19 +731,33 @@ VkDevice createLogicalDevice(
         ESC_LTALIC "%s %s " ESC_RESET "获取了一个 VkQueue (for presentation)\n",
         __DATE__, __TIME__);
 
+    // 没有专用的计算队列族时退回到 graphics 队列
+    *pComputeQueueFamilyIndex = useAsyncCompute ? (uint32_t)computeFamily : *pGraphicsQueueFamilyIndex;
+    vkGetDeviceQueue(device, *pComputeQueueFamilyIndex, 0, computeQueue);
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "获取了一个 VkQueue (for compute)\n",
+        __DATE__, __TIME__);
+
     fprintf(stdout, "Using Single Queue: ");
     if (useSingleQueue)
         fprintf(stdout, "true (Queue Family Index: %d)\n", queueFamilyIndex);
     else
         fprintf(stdout, "false\n");
 
+    fprintf(stdout, "Using Async Compute: ");
+    if (useAsyncCompute)
+        fprintf(stdout, "true (Queue Family Index: %d)\n", computeFamily);
+    else
+        fprintf(stdout, "false\n");
+
     return device;
 }
 
 
 void destroyLogicalDevice(VkDevice device)
 {
-    vkDestroyDevice(device, NULL);
+    vkDestroyDevice(device, get_vulkan_allocator());
 
     fprintf(stdout, 
         ESC_LTALIC "%s %s " ESC_RESET
@@ -555,7 +774,9 @@ VkSwapchainKHR createSwapchain(
     uint32_t*           pSwapchainImageCount,   // 指向 uint32_t 变量的地址，用于输出
     VkImage**           ppSwapchainImages,      // 指向 VkImage 数组的地址，用于输出
     VkFormat*           pSwapchainImageFormat,  // 指向 VkFormat 变量的地址，用于输出
-    VkExtent2D*         pSwapchainExtent        // 指向 VkExtent2D 变量的地址，用于输出
+    VkExtent2D*         pSwapchainExtent,       // 指向 VkExtent2D 变量的地址，用于输出
+    bool*               pTransferSrc,           // 指向 bool 变量的地址，用于输出
+    Arena*              pArena                  // 交换链图像数组从该 Arena 分配
 )
 {
     // 0.检查参数是否有效
@@ -581,9 +802,11 @@ VkSwapchainKHR createSwapchain(
         return VK_NULL_HANDLE;
     }
 
-    // 1.获取交换链支持信息
+    // 1.获取交换链支持信息（临时占用 pArena，创建交换链前回退）
+    size_t arenaMark = arena_mark(pArena);
+
     SwapchainSupportDetails supportDetails = 
-        query_swapchain_support_details(physicalDevice, surface);
+        query_swapchain_support_details(physicalDevice, surface, pArena);
 
     // 2.选择理想的 surface 格式、交换范围、交换链呈现模式和 image 数
     VkSurfaceFormatKHR surfaceFormat =
@@ -612,6 +835,9 @@ VkSwapchainKHR createSwapchain(
 
     createInfo.imageArrayLayers         = 1;
     createInfo.imageUsage               = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    // 若 Surface 支持，则允许交换链图像作为传输源，以便帧回读（readback）拷贝
+    if (supportDetails.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+        createInfo.imageUsage          |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
     createInfo.imageFormat              = surfaceFormat.format;
     createInfo.imageColorSpace          = surfaceFormat.colorSpace;
     createInfo.imageExtent              = extent;
@@ -645,9 +871,11 @@ VkSwapchainKHR createSwapchain(
        createInfo.pQueueFamilyIndices   = pQueueFamilyIndices;
     }
 
+    arena_reset_to(pArena, arenaMark);
+
     // 4.创建交换链
     VkSwapchainKHR swapchain = VK_NULL_HANDLE;
-    VkResult result = vkCreateSwapchainKHR(device, &createInfo, NULL, &swapchain);
+    VkResult result = vkCreateSwapchainKHR(device, &createInfo, get_vulkan_allocator(), &swapchain);
     if (result != VK_SUCCESS)
     {
         fprintf(stderr,
@@ -655,8 +883,6 @@ VkSwapchainKHR createSwapchain(
 
         return VK_NULL_HANDLE;
     }
-    
-    free_swapchain_support_details(&supportDetails);
 
     // 5.处理输出参数（交换链图像句柄数组和其大小、交换链图像格式和范围）
     uint32_t actualImageCount = 0;
@@ -669,15 +895,15 @@ VkSwapchainKHR createSwapchain(
         *pSwapchainImageCount = 0;
         *ppSwapchainImages = NULL;
 
-        vkDestroySwapchainKHR(device, swapchain, NULL);     // 销毁刚刚创建的交换链
+        vkDestroySwapchainKHR(device, swapchain, get_vulkan_allocator());     // 销毁刚刚创建的交换链
 
         return VK_NULL_HANDLE;
     }
 
     *pSwapchainImageCount = actualImageCount;
 
-    // 为交换链图像句柄数组分配内存
-    *ppSwapchainImages = (VkImage*)calloc(actualImageCount, sizeof(VkImage));
+    // 从 pArena 为交换链图像句柄数组分配内存
+    *ppSwapchainImages = (VkImage*)arena_calloc(pArena, actualImageCount, sizeof(VkImage));
     if (*ppSwapchainImages == NULL)
     {
         fprintf(stderr, "%s : 交换链图像句柄数组内存分配失败！函数退出.\n", __func__);
@@ -685,7 +911,7 @@ VkSwapchainKHR createSwapchain(
         *pSwapchainImageCount = 0;
         *ppSwapchainImages = NULL;
 
-        vkDestroySwapchainKHR(device, swapchain, NULL);
+        vkDestroySwapchainKHR(device, swapchain, get_vulkan_allocator());
 
         return VK_NULL_HANDLE;
     }
@@ -700,16 +926,17 @@ VkSwapchainKHR createSwapchain(
             "Failed to get swapchain images! Error Code(VkResult): %d\n", result);
         
         *pSwapchainImageCount = 0;
-        free(*ppSwapchainImages);   // 释放数组内存
+        arena_reset_to(pArena, arenaMark);      // 回退数组占用的内存
         *ppSwapchainImages = NULL;
 
-        vkDestroySwapchainKHR(device, swapchain, NULL);
+        vkDestroySwapchainKHR(device, swapchain, get_vulkan_allocator());
 
         return VK_NULL_HANDLE;
     }
 
     *pSwapchainImageFormat = surfaceFormat.format;
     *pSwapchainExtent = extent;
+    *pTransferSrc = (createInfo.imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0;
 
     fprintf(stdout,
         ESC_LTALIC "%s %s " ESC_RESET "成功创建了一个 VkSwapchainKHR！\n",
@@ -721,7 +948,7 @@ VkSwapchainKHR createSwapchain(
 
 void destroySwapchain(VkDevice device, VkSwapchainKHR swapchain)
 {
-    vkDestroySwapchainKHR(device, swapchain, NULL);
+    vkDestroySwapchainKHR(device, swapchain, get_vulkan_allocator());
 
     fprintf(stdout, 
         ESC_LTALIC "%s %s " ESC_RESET
@@ -734,7 +961,8 @@ VkImageView* createSwapchainImageViews(
     VkDevice        device,
     VkFormat        swapchainImageFormat,
     uint32_t        swapchainImageCount,
-    const VkImage*  pSwapchainImages
+    const VkImage*  pSwapchainImages,
+    Arena*          pArena
 )
 {
     if (device == VK_NULL_HANDLE
@@ -746,9 +974,11 @@ VkImageView* createSwapchainImageViews(
         return NULL;
     }
 
-    // 1.分配交换链图像视图句柄数组
+    // 1.从 pArena 分配交换链图像视图句柄数组
+    size_t arenaMark = arena_mark(pArena);
+
     VkImageView* pSwapchainImageViews = 
-        (VkImageView*)calloc(swapchainImageCount, sizeof(VkImageView));
+        (VkImageView*)arena_calloc(pArena, swapchainImageCount, sizeof(VkImageView));
     if (pSwapchainImageViews == NULL)
     {
         fprintf(stderr, "%s : 交换链图像视图句柄数组内存分配失败！函数退出.\n", __func__);
@@ -778,7 +1008,7 @@ VkImageView* createSwapchainImageViews(
 
         VkResult result = vkCreateImageView(device, 
                               &createInfo, 
-                              NULL, 
+                              get_vulkan_allocator(), 
                               &pSwapchainImageViews[i]);
         if (result != VK_SUCCESS)
         {
@@ -789,9 +1019,9 @@ VkImageView* createSwapchainImageViews(
 
             // 清理已创建的 VkImageView
             for (uint32_t j = 0; j < i; j++)
-                vkDestroyImageView(device, pSwapchainImageViews[j], NULL);
+                vkDestroyImageView(device, pSwapchainImageViews[j], get_vulkan_allocator());
 
-            free(pSwapchainImageViews);   // 释放刚刚分配的数组
+            arena_reset_to(pArena, arenaMark);   // 回退刚刚分配的数组
 
             return NULL;
         }
@@ -819,7 +1049,7 @@ void destroySwapchainImageViews(
     // 遍历数组依次销毁
     for (uint32_t i = 0; i < swapchainImageCount; i++)
     {
-        vkDestroyImageView(device, (*ppSwapchainImageViews)[i], NULL);
+        vkDestroyImageView(device, (*ppSwapchainImageViews)[i], get_vulkan_allocator());
 
         fprintf(stdout,
         ESC_LTALIC "%s %s " ESC_RESET
@@ -827,9 +1057,728 @@ void destroySwapchainImageViews(
         __DATE__, __TIME__, i);
     }
 
-    // 释放数组占用的内存
-    free(*ppSwapchainImageViews);
+    // 数组本身的内存随 Arena 的重置回收
     *ppSwapchainImageViews = NULL;
 
     return;
-}
\ No newline at end of file
+}
+
+
+VkRenderPass createRenderPass(
+    VkDevice        device,
+    VkFormat        colorFormat,
+    VkImageLayout   finalLayout
+)
+{
+    // 1.颜色附件：每帧开始时清除，结束后保留内容并转换至 finalLayout
+    VkAttachmentDescription colorAttachment = {};
+    colorAttachment.format          = colorFormat;
+    colorAttachment.samples         = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp          = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp         = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.stencilStoreOp  = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.initialLayout   = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout     = finalLayout;
+
+    VkAttachmentReference colorAttachmentRef = {};
+    colorAttachmentRef.attachment   = 0;
+    colorAttachmentRef.layout       = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    // 2.子通道
+    VkSubpassDescription subpass = {};
+    subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount    = 1;
+    subpass.pColorAttachments       = &colorAttachmentRef;
+
+    // 3.子通道依赖
+    VkSubpassDependency dependencies[2] = {};
+    // 等待交换链图像被获取（imageAvailable 信号量）以及之前对同一图像的回读拷贝完成后
+    // 再写入颜色附件（无头模式下各帧共用同一张离屏图像）
+    dependencies[0].srcSubpass      = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass      = 0;
+    dependencies[0].srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+                                    | VK_PIPELINE_STAGE_TRANSFER_BIT;
+    dependencies[0].srcAccessMask   = 0;
+    dependencies[0].dstStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[0].dstAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    // 渲染结果（及到 finalLayout 的布局转换）对之后的传输命令可见，供帧回读拷贝
+    dependencies[1].srcSubpass      = 0;
+    dependencies[1].dstSubpass      = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[1].srcAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstStageMask    = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    dependencies[1].dstAccessMask   = VK_ACCESS_TRANSFER_READ_BIT;
+
+    // 4.创建渲染通道
+    VkRenderPassCreateInfo createInfo = {};
+    createInfo.sType                = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    createInfo.attachmentCount      = 1;
+    createInfo.pAttachments         = &colorAttachment;
+    createInfo.subpassCount         = 1;
+    createInfo.pSubpasses           = &subpass;
+    createInfo.dependencyCount      = 2;
+    createInfo.pDependencies        = dependencies;
+
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    VkResult result = vkCreateRenderPass(device, &createInfo, get_vulkan_allocator(), &renderPass);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkRenderPass! Error Code(VkResult): %d\n", result);
+
+        return VK_NULL_HANDLE;
+    }
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "成功创建了一个 VkRenderPass！\n",
+        __DATE__, __TIME__);
+
+    return renderPass;
+}
+
+
+void destroyRenderPass(VkDevice device, VkRenderPass renderPass)
+{
+    vkDestroyRenderPass(device, renderPass, get_vulkan_allocator());
+
+    fprintf(stdout, 
+        ESC_LTALIC "%s %s " ESC_RESET
+        ESC_FCOLOR_BRIGHT_MAGENTA "调用了 vkDestroyRenderPass！\n" ESC_RESET,
+        __DATE__, __TIME__);
+}
+
+
+VkFramebuffer* createFramebuffers(
+    VkDevice            device,
+    VkRenderPass        renderPass,
+    VkExtent2D          extent,
+    uint32_t            imageViewCount,
+    const VkImageView*  pImageViews,
+    Arena*              pArena
+)
+{
+    if (device == VK_NULL_HANDLE
+        || renderPass == VK_NULL_HANDLE
+        || imageViewCount == 0
+        || pImageViews == NULL)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！无法创建帧缓冲.\n", __func__);
+
+        return NULL;
+    }
+
+    // 1.从 pArena 分配帧缓冲句柄数组
+    size_t arenaMark = arena_mark(pArena);
+
+    VkFramebuffer* pFramebuffers = 
+        (VkFramebuffer*)arena_calloc(pArena, imageViewCount, sizeof(VkFramebuffer));
+    if (pFramebuffers == NULL)
+    {
+        fprintf(stderr, "%s : 帧缓冲句柄数组内存分配失败！函数退出.\n", __func__);
+
+        return NULL;
+    }
+
+    // 2.为每一个图像视图创建一个帧缓冲
+    for (uint32_t i = 0; i < imageViewCount; i++)
+    {
+        VkFramebufferCreateInfo createInfo = {};
+        createInfo.sType            = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        createInfo.renderPass       = renderPass;
+        createInfo.attachmentCount  = 1;
+        createInfo.pAttachments     = &pImageViews[i];
+        createInfo.width            = extent.width;
+        createInfo.height           = extent.height;
+        createInfo.layers           = 1;
+
+        VkResult result = vkCreateFramebuffer(device, 
+                              &createInfo, 
+                              get_vulkan_allocator(), 
+                              &pFramebuffers[i]);
+        if (result != VK_SUCCESS)
+        {
+            fprintf(stderr, 
+                "Failed to create VkFramebuffer(%u)! Error Code(VkResult): %d\n",
+                i, result);
+
+            // 清理已创建的 VkFramebuffer
+            for (uint32_t j = 0; j < i; j++)
+                vkDestroyFramebuffer(device, pFramebuffers[j], get_vulkan_allocator());
+
+            arena_reset_to(pArena, arenaMark);
+
+            return NULL;
+        }
+    }
+
+    return pFramebuffers;
+}
+
+
+void destroyFramebuffers(
+    VkDevice            device,
+    uint32_t            framebufferCount,
+    VkFramebuffer**     ppFramebuffers
+)
+{
+    if (device == VK_NULL_HANDLE
+        || framebufferCount == 0
+        || ppFramebuffers == NULL)
+    {
+        fprintf(stderr, "%s : 传入了无效参数！没有销毁任何帧缓冲.\n", __func__);
+
+        return;
+    }
+
+    for (uint32_t i = 0; i < framebufferCount; i++)
+    {
+        vkDestroyFramebuffer(device, (*ppFramebuffers)[i], get_vulkan_allocator());
+
+        fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET
+        ESC_FCOLOR_BRIGHT_MAGENTA "调用了 vkDestroyFramebuffer（s，%u）！\n" ESC_RESET,
+        __DATE__, __TIME__, i);
+    }
+
+    // 数组本身的内存随 Arena 的重置回收
+    *ppFramebuffers = NULL;
+
+    return;
+}
+
+
+VkCommandPool createCommandPool(VkDevice device, uint32_t queueFamilyIndex)
+{
+    VkCommandPoolCreateInfo createInfo = {};
+    createInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    createInfo.flags                = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    createInfo.queueFamilyIndex     = queueFamilyIndex;
+
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    VkResult result = vkCreateCommandPool(device, &createInfo, get_vulkan_allocator(), &commandPool);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkCommandPool! Error Code(VkResult): %d\n", result);
+
+        return VK_NULL_HANDLE;
+    }
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "成功创建了一个 VkCommandPool！\n",
+        __DATE__, __TIME__);
+
+    return commandPool;
+}
+
+
+void destroyCommandPool(VkDevice device, VkCommandPool commandPool)
+{
+    vkDestroyCommandPool(device, commandPool, get_vulkan_allocator());
+
+    fprintf(stdout, 
+        ESC_LTALIC "%s %s " ESC_RESET
+        ESC_FCOLOR_BRIGHT_MAGENTA "调用了 vkDestroyCommandPool！\n" ESC_RESET,
+        __DATE__, __TIME__);
+}
+
+
+int findMemoryType(
+    VkPhysicalDevice        physicalDevice,
+    uint32_t                memoryTypeBits,
+    VkMemoryPropertyFlags   properties
+)
+{
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+    {
+        if ((memoryTypeBits & (1u << i))
+            && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;      // -1 表未找到
+}
+
+
+bool createBuffer(
+    VkPhysicalDevice        physicalDevice,
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    VkMemoryPropertyFlags   properties,
+    MemoryCategory          category,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices,
+    VkBuffer*               pBuffer,
+    VkDeviceMemory*         pMemory
+)
+{
+    if (pBuffer == NULL || pMemory == NULL)
+    {
+        fprintf(stderr, "%s : 函数参数错误！输出参数不能传入 NULL 地址！\n", __func__);
+
+        return false;
+    }
+
+    *pMemory = VK_NULL_HANDLE;
+
+    // 1.创建缓冲
+    if (!create_buffer_object(device, size, usage, queueFamilyIndexCount, pQueueFamilyIndices, pBuffer))
+        return false;
+
+    // 2.查询内存需求并选择内存类型
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, *pBuffer, &requirements);
+
+    int memoryTypeIndex = findMemoryType(physicalDevice,
+                              requirements.memoryTypeBits,
+                              properties);
+    if (memoryTypeIndex < 0)
+    {
+        fprintf(stderr, "%s : 找不到满足要求的内存类型！\n", __func__);
+
+        vkDestroyBuffer(device, *pBuffer, get_vulkan_allocator());
+        *pBuffer = VK_NULL_HANDLE;
+
+        return false;
+    }
+
+    // 3.分配并绑定内存
+    VkResult result = allocate_buffer_memory(device, *pBuffer, usage, &requirements,
+                          (uint32_t)memoryTypeIndex, category, pMemory);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to allocate VkDeviceMemory! Error Code(VkResult): %d\n", result);
+
+        vkDestroyBuffer(device, *pBuffer, get_vulkan_allocator());
+        *pBuffer = VK_NULL_HANDLE;
+
+        return false;
+    }
+
+    return true;
+}
+
+
+bool createHostWritableBuffer(
+    VkPhysicalDevice        physicalDevice,
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    bool                    preferDeviceLocal,
+    MemoryCategory          category,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices,
+    VkBuffer*               pBuffer,
+    VkDeviceMemory*         pMemory
+)
+{
+    const VkMemoryPropertyFlags hostVisible =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    if (pBuffer == NULL || pMemory == NULL)
+    {
+        fprintf(stderr, "%s : 函数参数错误！输出参数不能传入 NULL 地址！\n", __func__);
+
+        return false;
+    }
+
+    *pMemory = VK_NULL_HANDLE;
+
+    // 1.创建缓冲，由其内存需求决定可用的内存类型
+    if (!create_buffer_object(device, size, usage, queueFamilyIndexCount, pQueueFamilyIndices, pBuffer))
+        return false;
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, *pBuffer, &requirements);
+
+    // 2.优先尝试可主机写入的显存：缓冲不能使用这类内存或其已耗尽时静默回退
+    VkResult result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    if (preferDeviceLocal)
+    {
+        int memoryTypeIndex = findMemoryType(physicalDevice, requirements.memoryTypeBits,
+                                  hostVisible | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (memoryTypeIndex >= 0)
+            result = allocate_buffer_memory(device, *pBuffer, usage, &requirements,
+                         (uint32_t)memoryTypeIndex, category, pMemory);
+    }
+
+    // 3.回退到普通的主机可见内存
+    if (result != VK_SUCCESS)
+    {
+        int memoryTypeIndex = findMemoryType(physicalDevice, requirements.memoryTypeBits, hostVisible);
+        if (memoryTypeIndex < 0)
+        {
+            fprintf(stderr, "%s : 找不到满足要求的内存类型！\n", __func__);
+
+            vkDestroyBuffer(device, *pBuffer, get_vulkan_allocator());
+            *pBuffer = VK_NULL_HANDLE;
+
+            return false;
+        }
+
+        result = allocate_buffer_memory(device, *pBuffer, usage, &requirements,
+                     (uint32_t)memoryTypeIndex, category, pMemory);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to allocate VkDeviceMemory! Error Code(VkResult): %d\n", result);
+
+        vkDestroyBuffer(device, *pBuffer, get_vulkan_allocator());
+        *pBuffer = VK_NULL_HANDLE;
+
+        return false;
+    }
+
+    return true;
+}
+
+
+bool createHostReadableBuffer(
+    VkPhysicalDevice        physicalDevice,
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    MemoryCategory          category,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices,
+    bool*                   pCoherent,
+    VkBuffer*               pBuffer,
+    VkDeviceMemory*         pMemory
+)
+{
+    if (pCoherent == NULL || pBuffer == NULL || pMemory == NULL)
+    {
+        fprintf(stderr, "%s : 函数参数错误！输出参数不能传入 NULL 地址！\n", __func__);
+
+        return false;
+    }
+
+    *pMemory = VK_NULL_HANDLE;
+
+    // 1.创建缓冲，由其内存需求决定可用的内存类型
+    if (!create_buffer_object(device, size, usage, queueFamilyIndexCount, pQueueFamilyIndices, pBuffer))
+        return false;
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, *pBuffer, &requirements);
+
+    // 2.优先尝试 HOST_CACHED 内存：缓冲不能使用这类内存或其已耗尽时静默回退
+    VkResult result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    int memoryTypeIndex = findMemoryType(physicalDevice, requirements.memoryTypeBits,
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    if (memoryTypeIndex >= 0)
+        result = allocate_buffer_memory(device, *pBuffer, usage, &requirements,
+                     (uint32_t)memoryTypeIndex, category, pMemory);
+
+    *pCoherent = false;
+
+    // 3.回退到 HOST_COHERENT 内存
+    if (result != VK_SUCCESS)
+    {
+        *pCoherent = true;
+
+        memoryTypeIndex = findMemoryType(physicalDevice, requirements.memoryTypeBits,
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        if (memoryTypeIndex < 0)
+        {
+            fprintf(stderr, "%s : 找不到满足要求的内存类型！\n", __func__);
+
+            vkDestroyBuffer(device, *pBuffer, get_vulkan_allocator());
+            *pBuffer = VK_NULL_HANDLE;
+
+            return false;
+        }
+
+        result = allocate_buffer_memory(device, *pBuffer, usage, &requirements,
+                     (uint32_t)memoryTypeIndex, category, pMemory);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to allocate VkDeviceMemory! Error Code(VkResult): %d\n", result);
+
+        vkDestroyBuffer(device, *pBuffer, get_vulkan_allocator());
+        *pBuffer = VK_NULL_HANDLE;
+
+        return false;
+    }
+
+    return true;
+}
+
+
+VkDeviceSize getHostVisibleDeviceLocalHeapSize(VkPhysicalDevice physicalDevice)
+{
+    const VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+    // 取第一个满足条件的类型（不考虑具体缓冲的 memoryTypeBits，见头文件）
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+    {
+        if ((memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            return memoryProperties.memoryHeaps[memoryProperties.memoryTypes[i].heapIndex].size;
+    }
+
+    return 0;
+}
+
+
+void destroyBuffer(VkDevice device, VkBuffer buffer, VkDeviceMemory memory)
+{
+    if (buffer != VK_NULL_HANDLE)
+        vkDestroyBuffer(device, buffer, get_vulkan_allocator());
+
+    if (memory != VK_NULL_HANDLE)
+    {
+        memory_budget_track_free(memory);
+        vkFreeMemory(device, memory, get_vulkan_allocator());
+    }
+}
+
+
+VkDeviceAddress getBufferDeviceAddress(VkDevice device, VkBuffer buffer)
+{
+    VkBufferDeviceAddressInfo addressInfo = {};
+    addressInfo.sType   = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    addressInfo.buffer  = buffer;
+
+    return vkGetBufferDeviceAddress(device, &addressInfo);
+}
+
+
+
+VkShaderModule createShaderModule(VkDevice device, const uint32_t* pCode, size_t codeSize)
+{
+    VkShaderModuleCreateInfo createInfo = {};
+    createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.codeSize = codeSize;
+    createInfo.pCode    = pCode;
+
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    VkResult result = vkCreateShaderModule(device, &createInfo, get_vulkan_allocator(), &shaderModule);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkShaderModule! Error Code(VkResult): %d\n", result);
+
+        return VK_NULL_HANDLE;
+    }
+
+    return shaderModule;
+}
+
+
+void destroyShaderModule(VkDevice device, VkShaderModule shaderModule)
+{
+    vkDestroyShaderModule(device, shaderModule, get_vulkan_allocator());
+}
+
+
+bool createOffscreenImage(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    VkFormat            format,
+    VkExtent2D          extent,
+    VkImage*            pImage,
+    VkDeviceMemory*     pMemory
+)
+{
+    if (pImage == NULL || pMemory == NULL)
+    {
+        fprintf(stderr, "%s : 函数参数错误！输出参数不能传入 NULL 地址！\n", __func__);
+
+        return false;
+    }
+
+    *pImage  = VK_NULL_HANDLE;
+    *pMemory = VK_NULL_HANDLE;
+
+    // 1.创建图像：作为颜色附件渲染，并可作为传输源被回读
+    VkImageCreateInfo createInfo = {};
+    createInfo.sType            = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    createInfo.imageType        = VK_IMAGE_TYPE_2D;
+    createInfo.format           = format;
+    createInfo.extent.width     = extent.width;
+    createInfo.extent.height    = extent.height;
+    createInfo.extent.depth     = 1;
+    createInfo.mipLevels        = 1;
+    createInfo.arrayLayers      = 1;
+    createInfo.samples          = VK_SAMPLE_COUNT_1_BIT;
+    createInfo.tiling           = VK_IMAGE_TILING_OPTIMAL;
+    createInfo.usage            = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+                                | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    createInfo.sharingMode      = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.initialLayout    = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VkResult result = vkCreateImage(device, &createInfo, get_vulkan_allocator(), pImage);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkImage! Error Code(VkResult): %d\n", result);
+
+        return false;
+    }
+
+    // 2.分配并绑定设备本地内存
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(device, *pImage, &requirements);
+
+    int memoryTypeIndex = findMemoryType(physicalDevice,
+                              requirements.memoryTypeBits,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (memoryTypeIndex < 0)
+    {
+        fprintf(stderr, "%s : 找不到满足要求的内存类型！\n", __func__);
+
+        vkDestroyImage(device, *pImage, get_vulkan_allocator());
+        *pImage = VK_NULL_HANDLE;
+
+        return false;
+    }
+
+    memory_budget_make_room((uint32_t)memoryTypeIndex, requirements.size);
+
+    VkMemoryAllocateInfo allocateInfo = {};
+    allocateInfo.sType              = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.allocationSize     = requirements.size;
+    allocateInfo.memoryTypeIndex    = (uint32_t)memoryTypeIndex;
+
+    result = vkAllocateMemory(device, &allocateInfo, get_vulkan_allocator(), pMemory);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to allocate VkDeviceMemory! Error Code(VkResult): %d\n", result);
+
+        vkDestroyImage(device, *pImage, get_vulkan_allocator());
+        *pImage  = VK_NULL_HANDLE;
+        *pMemory = VK_NULL_HANDLE;
+
+        return false;
+    }
+
+    vkBindImageMemory(device, *pImage, *pMemory, 0);
+
+    memory_budget_track_allocation(*pMemory, (uint32_t)memoryTypeIndex, requirements.size,
+        MEMORY_CATEGORY_RENDER_TARGET);
+
+    fprintf(stdout,
+        ESC_LTALIC "%s %s " ESC_RESET "成功创建了一个离屏图像（%ux%u）！\n",
+        __DATE__, __TIME__, extent.width, extent.height);
+
+    return true;
+}
+
+
+void destroyOffscreenImage(VkDevice device, VkImage image, VkDeviceMemory memory)
+{
+    if (image != VK_NULL_HANDLE)
+        vkDestroyImage(device, image, get_vulkan_allocator());
+
+    if (memory != VK_NULL_HANDLE)
+    {
+        memory_budget_track_free(memory);
+        vkFreeMemory(device, memory, get_vulkan_allocator());
+    }
+
+    fprintf(stdout, 
+        ESC_LTALIC "%s %s " ESC_RESET
+        ESC_FCOLOR_BRIGHT_MAGENTA "调用了 vkDestroyImage（离屏图像）！\n" ESC_RESET,
+        __DATE__, __TIME__);
+}
+
+
+/// @brief 创建一个还未绑定内存的缓冲，队列族的共享方式同 createBuffer.
+static bool create_buffer_object(
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices,
+    VkBuffer*               pBuffer
+)
+{
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType        = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size         = size;
+    createInfo.usage        = usage;
+    createInfo.sharingMode  = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (queueFamilyIndexCount >= 2)             // 在多个队列族间使用，不必转移所有权
+    {
+        createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT;
+        createInfo.queueFamilyIndexCount    = queueFamilyIndexCount;
+        createInfo.pQueueFamilyIndices      = pQueueFamilyIndices;
+    }
+
+    VkResult result = vkCreateBuffer(device, &createInfo, get_vulkan_allocator(), pBuffer);
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr,
+            "Failed to create a VkBuffer! Error Code(VkResult): %d\n", result);
+
+        *pBuffer = VK_NULL_HANDLE;
+
+        return false;
+    }
+
+    return true;
+}
+
+
+/// @brief 从给定的内存类型为缓冲分配并绑定一块独立的内存，计入设备内存预算（不输出错误）.
+///
+/// 分配之前先让内存预算驱逐最久未使用的可驱逐资源.
+///
+/// @return 分配失败时返回对应的 VkResult，此时 `*pMemory` 为 `NULL`
+static VkResult allocate_buffer_memory(
+    VkDevice                    device,
+    VkBuffer                    buffer,
+    VkBufferUsageFlags          usage,
+    const VkMemoryRequirements* pRequirements,
+    uint32_t                    memoryTypeIndex,
+    MemoryCategory              category,
+    VkDeviceMemory*             pMemory
+)
+{
+    memory_budget_make_room(memoryTypeIndex, pRequirements->size);
+
+    // 要取设备地址的缓冲，其内存也需以 DEVICE_ADDRESS 标志分配
+    VkMemoryAllocateFlagsInfo allocateFlags = {};
+    allocateFlags.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    allocateFlags.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+
+    VkMemoryAllocateInfo allocateInfo = {};
+    allocateInfo.sType              = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.pNext              = (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+                                    ? &allocateFlags : NULL;
+    allocateInfo.allocationSize     = pRequirements->size;
+    allocateInfo.memoryTypeIndex    = memoryTypeIndex;
+
+    VkResult result = vkAllocateMemory(device, &allocateInfo, get_vulkan_allocator(), pMemory);
+    if (result != VK_SUCCESS)
+    {
+        *pMemory = VK_NULL_HANDLE;
+
+        return result;
+    }
+
+    vkBindBufferMemory(device, buffer, *pMemory, 0);
+
+    memory_budget_track_allocation(*pMemory, memoryTypeIndex, pRequirements->size, category);
+
+    return VK_SUCCESS;
+}
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "../common/ansi_esc.h"
+#include "../common/arena.h"
+#include "../common/log.h"
+#include "memory_budget.h"
 #include "queue_family_indices.h"
 #include "swapchain_support_details.h"
+#include "vulkan_allocator.h"
+#include "vulkan_loader.h"
 
-#include <vulkan/vulkan.h>
 #include <GLFW/glfw3.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -13,9 +17,11 @@
 
 
 /// @brief 创建 VkInstance，其是程序和 Vulkan 库之间的接口.
+///
+/// @param headless 为 `true` 时不启用 GLFW 所需的窗口表面扩展（无需初始化 GLFW）
 /// 
 /// @return 返回新创建的 VkInstance 句柄（当发生错误时返回 `NULL`）
-VkInstance createInstance(void);
+VkInstance createInstance(bool headless);
 
 
 /// @brief 销毁给定的 VkInstance.
@@ -41,27 +47,60 @@ void destroySurface(VkInstance instance, VkSurfaceKHR surface);
 
 /// @brief 查询可用物理设备并尝试选择可用的显卡作 PhysicalDevice.
 ///
+/// 在所有符合要求的设备中按类型优先选取：独显 > 集显 > 虚拟设备 > CPU 实现.
+///
 /// @param instance 调用该函数需要传入一个有效的 VkInstance 句柄
-/// @param surface 调用该函数需要传入一个有效的 VkSurfaceKHR 句柄
+/// @param surface 调用该函数需要传入一个有效的 VkSurfaceKHR 句柄（无头模式下传入 `NULL`，
+/// 此时只要求设备支持图形队列）
+/// @param pScratch 查询设备支持细节用的临时 Arena（函数返回后其分配位置不变）
 ///
 /// @return 返回一个可用的 PhysicalDevice 句柄（当发生错误时返回 `NULL`）
-VkPhysicalDevice pickPhysicalDevice(VkInstance instance, VkSurfaceKHR surface);
+VkPhysicalDevice pickPhysicalDevice(
+    VkInstance      instance,
+    VkSurfaceKHR    surface,
+    Arena*          pScratch
+);
 
 
 /// @brief 根据给定物理设备创建逻辑设备.
 ///
+/// @param surface 给定 Surface 句柄，无头模式下传入 `NULL`（此时不启用交换链扩展，
+/// presentation 队列即 graphics 队列）
 /// @param graphicsQueue 函数执行成功后，该参数会接收一个新的 VkQueue 句柄（graphics）
 /// @param presentationQueue 函数执行成功后，该参数会接收一个新的 VkQueue 句柄（presentation）
+/// @param pGraphicsQueueFamilyIndex 输出参数，接收 graphics 队列所属的队列族索引
+/// @param pPresentationQueueFamilyIndex 输出参数，接收 presentation 队列所属的队列族索引
+/// @param computeQueue 函数执行成功后，该参数会接收一个新的 VkQueue 句柄（compute）：
+/// 设备有不支持图形的计算队列族时为其上的队列（异步计算），否则即 graphics 队列
+/// @param pComputeQueueFamilyIndex 输出参数，接收 compute 队列所属的队列族索引
 ///
 /// @return 返回新创建的 VkDevice 句柄（当发生错误时返回 `NULL`）
 VkDevice createLogicalDevice(
     VkPhysicalDevice    physicalDevice,
     VkSurfaceKHR        surface,
     VkQueue*            graphicsQueue,
-    VkQueue*            presentationQueue
+    VkQueue*            presentationQueue,
+    uint32_t*           pGraphicsQueueFamilyIndex,
+    uint32_t*           pPresentationQueueFamilyIndex,
+    VkQueue*            computeQueue,
+    uint32_t*           pComputeQueueFamilyIndex
 );
 
 
+/// @brief 检查物理设备是否支持给定的设备扩展.
+bool isDeviceExtensionSupported(VkPhysicalDevice physicalDevice, const char* extensionName);
+
+
+/// @brief 检查物理设备是否支持 bufferDeviceAddress 特性（Vulkan 1.2 或 VK_KHR_buffer_device_address），
+/// 支持时 createLogicalDevice 会启用它.
+bool isBufferDeviceAddressSupported(VkPhysicalDevice physicalDevice);
+
+
+/// @brief 检查物理设备是否支持 graphicsPipelineLibrary 特性（VK_EXT_graphics_pipeline_library），
+/// 支持时 createLogicalDevice 会启用它.
+bool isGraphicsPipelineLibrarySupported(VkPhysicalDevice physicalDevice);
+
+
 /// @brief 销毁给定的 VkDevice.
 void destroyLogicalDevice(VkDevice device);
 
@@ -74,6 +113,8 @@ void destroyLogicalDevice(VkDevice device);
 /// @param device 给定设备句柄
 /// @param pSwapchainImageCount 输出参数，交换链创建后其输出交换链图像句柄数组的大小
 /// @param ppSwapchainImages 输出参数，其输出一个指向交换链图像句柄数组的指针
+/// @param pTransferSrc 输出参数，交换链图像是否可作为传输源（表面不支持时不会启用，此时不能回读）
+/// @param pArena 交换链图像句柄数组从该 Arena 分配（随其重置回收，无需释放）
 ///
 /// @return 返回新创建的 VkSwapchainKHR 句柄（当发生错误时返回 `NULL`）
 VkSwapchainKHR createSwapchain(
@@ -84,7 +125,9 @@ VkSwapchainKHR createSwapchain(
     uint32_t*           pSwapchainImageCount,
     VkImage**           ppSwapchainImages,
     VkFormat*           pSwapchainImageFormat,
-    VkExtent2D*         pSwapchainExtent    
+    VkExtent2D*         pSwapchainExtent,
+    bool*               pTransferSrc,
+    Arena*              pArena
 );
 
 
@@ -101,13 +144,15 @@ void destroySwapchain(VkDevice device, VkSwapchainKHR swapchain);
 /// @param swapchainImageFormat 指定要创建的图像视图的图像格式
 /// @param swapchainImageCount 指定要创建的图像视图的数量
 /// @param pSwapchainImages 调用该函数需要传入对应的交换链图像数组
+/// @param pArena 图像视图数组从该 Arena 分配（随其重置回收，无需释放）
 ///
 /// @return 创建成功后返回一个属于交换链的图像视图数组，失败则返回 `NULL`
 VkImageView* createSwapchainImageViews(
     VkDevice        device,
     VkFormat        swapchainImageFormat,
     uint32_t        swapchainImageCount,
-    const VkImage*  pSwapchainImages
+    const VkImage*  pSwapchainImages,
+    Arena*          pArena
 );
 
 
@@ -116,9 +161,204 @@ VkImageView* createSwapchainImageViews(
 /// @param device 调用该函数需要传入对应的 VkDevice 句柄
 /// @param swapchainImageCount 交换链图像总数
 /// @param ppSwapchainImageViews 要销毁的交换链图像视图的数组的地址
-///（数组本身也会被销毁以释放内存）
+///（数组指针会被置为 `NULL`，其内存随所属 Arena 的重置回收）
 void destroySwapchainImageViews(
     VkDevice        device,
     uint32_t        swapchainImageCount,
     VkImageView**   ppSwapchainImageViews
-);
\ No newline at end of file
+);
+
+
+/// @brief 创建只含一个颜色附件的渲染通道（VkRenderPass）.
+///
+/// 颜色附件在渲染通道开始时被清除，结束后转换至 `finalLayout` 布局.
+///
+/// @param device 调用该函数需要传入一个有效的 VkDevice 句柄
+/// @param colorFormat 颜色附件的格式（一般为交换链图像格式）
+/// @param finalLayout 渲染通道结束后颜色附件的布局（交换链图像为
+/// `VK_IMAGE_LAYOUT_PRESENT_SRC_KHR`，离屏图像为 `VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL`）
+///
+/// @return 返回新创建的 VkRenderPass 句柄（当发生错误时返回 `NULL`）
+VkRenderPass createRenderPass(
+    VkDevice        device,
+    VkFormat        colorFormat,
+    VkImageLayout   finalLayout
+);
+
+
+/// @brief 销毁给定的 VkRenderPass.
+void destroyRenderPass(VkDevice device, VkRenderPass renderPass);
+
+
+/// @brief 为给定的每一个图像视图创建一个帧缓冲（VkFramebuffer）.
+///
+/// @param device 调用该函数需要传入对应的 VkDevice 句柄
+/// @param renderPass 帧缓冲要兼容的渲染通道
+/// @param extent 帧缓冲的大小
+/// @param imageViewCount 图像视图数量（即要创建的帧缓冲数量）
+/// @param pImageViews 图像视图数组
+/// @param pArena 帧缓冲数组从该 Arena 分配（随其重置回收，无需释放）
+///
+/// @return 创建成功后返回一个帧缓冲数组，失败则返回 `NULL`
+VkFramebuffer* createFramebuffers(
+    VkDevice            device,
+    VkRenderPass        renderPass,
+    VkExtent2D          extent,
+    uint32_t            imageViewCount,
+    const VkImageView*  pImageViews,
+    Arena*              pArena
+);
+
+
+/// @brief 销毁所有给定的帧缓冲.
+///
+/// @param ppFramebuffers 要销毁的帧缓冲的数组的地址（数组指针会被置为 `NULL`，
+/// 其内存随所属 Arena 的重置回收）
+void destroyFramebuffers(
+    VkDevice            device,
+    uint32_t            framebufferCount,
+    VkFramebuffer**     ppFramebuffers
+);
+
+
+/// @brief 为给定队列族创建命令池，其命令缓冲可以被单独重置.
+///
+/// @return 返回新创建的 VkCommandPool 句柄（当发生错误时返回 `NULL`）
+VkCommandPool createCommandPool(VkDevice device, uint32_t queueFamilyIndex);
+
+
+/// @brief 销毁给定的 VkCommandPool（其分配的命令缓冲也会一并被释放）.
+void destroyCommandPool(VkDevice device, VkCommandPool commandPool);
+
+
+/// @brief 在物理设备的内存类型中查找满足 `memoryTypeBits` 且具有全部 `properties` 的类型.
+///
+/// @return 内存类型索引，找不到时返回 -1
+int findMemoryType(
+    VkPhysicalDevice        physicalDevice,
+    uint32_t                memoryTypeBits,
+    VkMemoryPropertyFlags   properties
+);
+
+
+/// @brief 创建一个缓冲并为其分配、绑定一块独立的设备内存（计入设备内存预算）.
+///
+/// @param category 内存的用途分类（见 memory_budget.h）
+/// @param queueFamilyIndexCount 共享该缓冲的队列族数，不少于 2 时以 `VK_SHARING_MODE_CONCURRENT`
+/// 在这些队列族间共享（无需转移所有权），否则为 `VK_SHARING_MODE_EXCLUSIVE`
+/// @param pQueueFamilyIndices 共享该缓冲的队列族索引，数量少于 2 时可以为 `NULL`
+/// @param pBuffer 输出参数，接收新创建的 VkBuffer 句柄
+/// @param pMemory 输出参数，接收为其分配的 VkDeviceMemory 句柄
+///
+/// @return 成功时返回 `true`，失败时两个输出参数都会被置为 `NULL` 并返回 `false`
+bool createBuffer(
+    VkPhysicalDevice        physicalDevice,
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    VkMemoryPropertyFlags   properties,
+    MemoryCategory          category,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices,
+    VkBuffer*               pBuffer,
+    VkDeviceMemory*         pMemory
+);
+
+
+/// @brief 创建一个供 CPU 写入的主机可见缓冲（HOST_VISIBLE | HOST_COHERENT）.
+///
+/// `preferDeviceLocal` 时优先放在同时为 DEVICE_LOCAL 的内存中（ReBAR 或统一内存架构），CPU 直接写入
+/// 显存而不需要暂存缓冲与拷贝；缓冲不能使用这类内存或其已耗尽时静默回退到普通的主机可见内存.
+/// 这类内存往往不经过 CPU 缓存，只适合顺序写入，不适合读取.
+/// 队列族的共享方式同 createBuffer.
+///
+/// @return 成功时返回 `true`，失败时两个输出参数都会被置为 `NULL` 并返回 `false`
+bool createHostWritableBuffer(
+    VkPhysicalDevice        physicalDevice,
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    bool                    preferDeviceLocal,
+    MemoryCategory          category,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices,
+    VkBuffer*               pBuffer,
+    VkDeviceMemory*         pMemory
+);
+
+
+/// @brief 创建一个供 CPU 读取 GPU 写入结果的主机可见缓冲（队列族的共享方式同 createBuffer）.
+///
+/// 优先放在 HOST_CACHED 内存中（主机端读取更快），缓冲不能使用这类内存或其已耗尽时静默回退到
+/// HOST_COHERENT 内存.
+///
+/// @param pCoherent 输出参数，接收内存是否按 HOST_COHERENT 选择；为 `false` 时读取前需要
+/// vkInvalidateMappedMemoryRanges
+///
+/// @return 成功时返回 `true`，失败时两个句柄输出参数都会被置为 `NULL` 并返回 `false`
+bool createHostReadableBuffer(
+    VkPhysicalDevice        physicalDevice,
+    VkDevice                device,
+    VkDeviceSize            size,
+    VkBufferUsageFlags      usage,
+    MemoryCategory          category,
+    uint32_t                queueFamilyIndexCount,
+    const uint32_t*         pQueueFamilyIndices,
+    bool*                   pCoherent,
+    VkBuffer*               pBuffer,
+    VkDeviceMemory*         pMemory
+);
+
+
+/// @brief 查询 createHostWritableBuffer 优先使用的 DEVICE_LOCAL | HOST_VISIBLE | HOST_COHERENT
+/// 内存类型所在堆的大小.
+///
+/// 不考虑具体缓冲的 memoryTypeBits（只用于判断设备是否有这类显存），某些用途的缓冲不能使用
+/// 这类内存时，createHostWritableBuffer 会回退到普通的主机可见内存.
+///
+/// @return 堆的字节数，没有这类内存类型时返回 0
+VkDeviceSize getHostVisibleDeviceLocalHeapSize(VkPhysicalDevice physicalDevice);
+
+
+/// @brief 销毁由 createBuffer 创建的缓冲并释放其内存（传入 `NULL` 的句柄会被忽略）.
+void destroyBuffer(VkDevice device, VkBuffer buffer, VkDeviceMemory memory);
+
+
+/// @brief 获取缓冲的设备地址（缓冲需带有 `VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT`，
+/// 由 createBuffer 创建时其内存已按要求分配）.
+VkDeviceAddress getBufferDeviceAddress(VkDevice device, VkBuffer buffer);
+
+
+/// @brief 由 SPIR-V 字节码创建着色器模块.
+///
+/// @param pCode SPIR-V 字节码（需按 4 字节对齐）
+/// @param codeSize 字节码的字节数
+///
+/// @return 返回新创建的 VkShaderModule 句柄（当发生错误时返回 `NULL`）
+VkShaderModule createShaderModule(VkDevice device, const uint32_t* pCode, size_t codeSize);
+
+
+/// @brief 销毁给定的 VkShaderModule.
+void destroyShaderModule(VkDevice device, VkShaderModule shaderModule);
+
+
+/// @brief 创建一个可作为颜色附件与传输源的离屏图像，并为其分配、绑定设备本地内存.
+///
+/// 无头模式下用它代替交换链图像.
+///
+/// @param pImage 输出参数，接收新创建的 VkImage 句柄
+/// @param pMemory 输出参数，接收为其分配的 VkDeviceMemory 句柄
+///
+/// @return 成功时返回 `true`，失败时两个输出参数都会被置为 `NULL` 并返回 `false`
+bool createOffscreenImage(
+    VkPhysicalDevice    physicalDevice,
+    VkDevice            device,
+    VkFormat            format,
+    VkExtent2D          extent,
+    VkImage*            pImage,
+    VkDeviceMemory*     pMemory
+);
+
+
+/// @brief 销毁由 createOffscreenImage 创建的图像并释放其内存.
+void destroyOffscreenImage(VkDevice device, VkImage image, VkDeviceMemory memory);
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "input_ring.h"
+
+#include <string.h>
+
+
+bool input_ring_push(InputRing* pRing, const InputEvent* pEvent)
+{
+    unsigned head = atomic_load_explicit(&pRing->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&pRing->tail, memory_order_acquire);
+
+    if (head - tail >= INPUT_RING_CAPACITY)
+    {
+        atomic_fetch_add_explicit(&pRing->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+
+    pRing->events[head & (INPUT_RING_CAPACITY - 1)] = *pEvent;
+
+    // 先写入事件再发布新的 head
+    atomic_store_explicit(&pRing->head, head + 1, memory_order_release);
+
+    return true;
+}
+
+
+uint32_t input_ring_drain(InputRing* pRing, InputEvent* pEvents)
+{
+    unsigned tail = atomic_load_explicit(&pRing->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&pRing->head, memory_order_acquire);
+
+    uint32_t count = head - tail;
+    if (count == 0)
+        return 0;
+
+    // 已发布的区间在环中最多分为两段
+    uint32_t first  = tail & (INPUT_RING_CAPACITY - 1);
+    uint32_t span   = INPUT_RING_CAPACITY - first < count ? INPUT_RING_CAPACITY - first : count;
+    memcpy(pEvents, &pRing->events[first], span * sizeof(InputEvent));
+    memcpy(pEvents + span, &pRing->events[0], (count - span) * sizeof(InputEvent));
+
+    // 拷贝完成后才归还槽位
+    atomic_store_explicit(&pRing->tail, head, memory_order_release);
+
+    return count;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/// @brief 输入事件环的容量（事件数），需为 2 的幂.
+#define INPUT_RING_CAPACITY     1024
+
+/// @brief 输入事件的种类.
+typedef enum InputEventType {
+    INPUT_EVENT_KEY             = 1,    // code 为 GLFW_KEY_*，action 为 GLFW_PRESS / RELEASE / REPEAT
+    INPUT_EVENT_MOUSE_BUTTON    = 2,    // code 为 GLFW_MOUSE_BUTTON_*，(x, y) 为按下时的光标位置
+    INPUT_EVENT_CURSOR_MOVE     = 3,    // (x, y) 为光标位置（屏幕坐标，相对于窗口客户区左上角）
+    INPUT_EVENT_SCROLL          = 4,    // (x, y) 为滚动偏移
+    INPUT_EVENT_RESIZE          = 5,    // (x, y) 为新的帧缓冲大小（像素）
+    INPUT_EVENT_FOCUS           = 6,    // action 为 1 时获得焦点，为 0 时失去焦点
+} InputEventType;
+
+/// @brief 一个输入事件，与 C# 的 InputEvent 布局一致（56 字节）.
+typedef struct InputEvent {
+    uint32_t            type;           // InputEventType
+    int32_t             code;
+    int32_t             scancode;       // 仅键盘事件
+    int32_t             action;
+    int32_t             mods;           // GLFW_MOD_*
+    uint32_t            reserved;
+    double              x;
+    double              y;
+    double              time;           // glfwGetTime
+    GLFWwindow*         window;         // 事件所属的窗口
+} InputEvent;
+
+/// @brief 单生产者单消费者的输入事件环.
+///
+/// 生产者为 GLFW 的回调（在调用 glfwPollEvents 的线程上），消费者每帧调用一次 input_ring_drain，
+/// 两者不需要加锁. 环满时丢弃新事件并计数，不会阻塞也不会覆盖未读的事件.
+typedef struct InputRing {
+    _Alignas(64) atomic_uint    head;   // 下一个写入位置（只由生产者修改）
+    _Alignas(64) atomic_uint    tail;   // 下一个读取位置（只由消费者修改），与 head 分处不同缓存行
+    _Alignas(64) atomic_uint    dropped;
+    InputEvent                  events[INPUT_RING_CAPACITY];
+} InputRing;
+
+
+/// @brief 加入一个事件（生产者调用）.
+///
+/// @return 环已满、事件被丢弃时返回 `false`
+bool input_ring_push(InputRing* pRing, const InputEvent* pEvent);
+
+/// @brief 取出所有已加入的事件并按顺序拷贝到 `pEvents`（消费者调用）.
+///
+/// @param pEvents 至少能容纳 `INPUT_RING_CAPACITY` 个事件
+///
+/// @return 取出的事件数
+uint32_t input_ring_drain(InputRing* pRing, InputEvent* pEvents);
@@ -3,23 +3,79 @@
 #include "../common/ansi_esc.h"
 
 
-EX_API GLFWwindow* initializeWindow(int width, int height, const char* title)
+/// @brief 由 createWindow 创建的一个窗口的节流状态（GLFW 用户指针指向它）.
+typedef struct WindowSlot {
+    GLFWwindow* window;                         // 为 NULL 时槽位空闲
+    double      lastFrameTime;                  // 上一次允许该窗口的循环渲染的时间点（glfwGetTime）
+} WindowSlot;
+
+static double backgroundFrameInterval   = 0.0;  // 后台帧间隔（秒），为 0 时不限制
+static WindowSlot windowSlots[WINDOWING_MAX_WINDOWS];
+
+static InputRing  inputRing;                    // GLFW 回调写入，drainInputEvents 取出
+static InputEvent drainedEvents[INPUT_RING_CAPACITY];   // drainInputEvents 返回的连续数组
+
+static void install_input_callbacks(GLFWwindow* window);
+static int get_most_active_state(GLFWwindow* window);
+
+
+EX_API bool initializeWindowing(void)
 {
     if (!glfwInit())
     {
         fprintf(stderr, ESC_FCOLOR_BRIGHT_RED "Failed to initialize glfw!" ESC_RESET);
-        return NULL;
+        return false;
     }
         
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
     glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
 
-    return glfwCreateWindow(width, height, title, NULL, NULL);
+    return true;
+}
+
+
+EX_API GLFWwindow* createWindow(int width, int height, const char* title)
+{
+    GLFWwindow* window = glfwCreateWindow(width, height, title, NULL, NULL);
+    if (window == NULL)
+        return NULL;
+
+    install_input_callbacks(window);
+
+    // 槽位已满时窗口仍可使用，只是不参与其他窗口的节流判断
+    for (uint32_t i = 0; i < WINDOWING_MAX_WINDOWS; i++)
+    {
+        if (windowSlots[i].window != NULL)
+            continue;
+
+        windowSlots[i].window           = window;
+        windowSlots[i].lastFrameTime    = 0.0;
+        glfwSetWindowUserPointer(window, &windowSlots[i]);
+        break;
+    }
+
+    return window;
+}
+
+
+EX_API GLFWwindow* initializeWindow(int width, int height, const char* title)
+{
+    if (!initializeWindowing())
+        return NULL;
+
+    return createWindow(width, height, title);
 }
 
 
 EX_API void destroyWindow(GLFWwindow* window)
 {
+    if (window == NULL)
+        return;
+
+    WindowSlot* pSlot = (WindowSlot*)glfwGetWindowUserPointer(window);
+    if (pSlot != NULL)
+        pSlot->window = NULL;
+
     glfwDestroyWindow(window);
 }
 
@@ -36,7 +92,175 @@ EX_API void pollEvents(void)
 }
 
 
+EX_API int getWindowState(GLFWwindow* window)
+{
+    if (glfwGetWindowAttrib(window, GLFW_ICONIFIED))
+        return WINDOW_STATE_MINIMIZED;
+
+    int width = 0, height = 0;
+    glfwGetFramebufferSize(window, &width, &height);
+    if (width == 0 || height == 0)
+        return WINDOW_STATE_MINIMIZED;
+
+    if (!glfwGetWindowAttrib(window, GLFW_FOCUSED))
+        return WINDOW_STATE_BACKGROUND;
+
+    return WINDOW_STATE_ACTIVE;
+}
+
+
+EX_API void setBackgroundFrameRate(double framesPerSecond)
+{
+    backgroundFrameInterval = framesPerSecond > 0.0 ? 1.0 / framesPerSecond : 0.0;
+}
+
+
+EX_API bool waitEventsForFrame(GLFWwindow* window)
+{
+    glfwPollEvents();
+
+    // 1.所有窗口都最小化：阻塞等待事件（超时后重新检查），不渲染
+    while (get_most_active_state(window) == WINDOW_STATE_MINIMIZED)
+    {
+        if (glfwWindowShouldClose(window))
+            return false;
+
+        glfwWaitEventsTimeout(MINIMIZED_WAIT_TIMEOUT);
+    }
+
+    // 2.没有窗口拥有焦点：等待到下一帧的时间点，期间任一窗口获得焦点则立即开始渲染
+    WindowSlot* pSlot = (WindowSlot*)glfwGetWindowUserPointer(window);
+    double lastFrameTime = pSlot != NULL ? pSlot->lastFrameTime : 0.0;
+
+    if (backgroundFrameInterval > 0.0 && pSlot != NULL)
+    {
+        double remaining = lastFrameTime + backgroundFrameInterval - glfwGetTime();
+        while (remaining > 0.0 && get_most_active_state(window) == WINDOW_STATE_BACKGROUND
+                && !glfwWindowShouldClose(window))
+        {
+            glfwWaitEventsTimeout(remaining);
+            remaining = lastFrameTime + backgroundFrameInterval - glfwGetTime();
+        }
+    }
+
+    if (pSlot != NULL)
+        pSlot->lastFrameTime = glfwGetTime();
+
+    return !glfwWindowShouldClose(window) && get_most_active_state(window) != WINDOW_STATE_MINIMIZED;
+}
+
+
+EX_API uint32_t drainInputEvents(const InputEvent** ppEvents)
+{
+    *ppEvents = drainedEvents;
+
+    return input_ring_drain(&inputRing, drainedEvents);
+}
+
+
+EX_API uint32_t getDroppedInputEventCount(void)
+{
+    return atomic_load_explicit(&inputRing.dropped, memory_order_relaxed);
+}
+
+
+EX_API const WindowingFrameApi* getWindowingFrameApi(void)
+{
+    static const WindowingFrameApi api = {
+        .size                   = sizeof(WindowingFrameApi),
+        .waitEventsForFrame     = waitEventsForFrame,
+        .windowShouldClose      = windowShouldClose,
+        .getWindowState         = getWindowState,
+        .drainInputEvents       = drainInputEvents
+    };
+
+    return &api;
+}
+
+
 EX_API void terminate(void)
 {
     glfwTerminate();
-}
\ No newline at end of file
+}
+
+
+static void push_input_event(GLFWwindow* window, InputEventType type, int code, int scancode,
+    int action, int mods, double x, double y)
+{
+    InputEvent event = {};
+    event.type      = type;
+    event.code      = code;
+    event.scancode  = scancode;
+    event.action    = action;
+    event.mods      = mods;
+    event.x         = x;
+    event.y         = y;
+    event.time      = glfwGetTime();
+    event.window    = window;
+
+    input_ring_push(&inputRing, &event);
+}
+
+static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    push_input_event(window, INPUT_EVENT_KEY, key, scancode, action, mods, 0.0, 0.0);
+}
+
+static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
+{
+    double x = 0.0, y = 0.0;
+    glfwGetCursorPos(window, &x, &y);
+
+    push_input_event(window, INPUT_EVENT_MOUSE_BUTTON, button, 0, action, mods, x, y);
+}
+
+static void cursor_position_callback(GLFWwindow* window, double x, double y)
+{
+    push_input_event(window, INPUT_EVENT_CURSOR_MOVE, 0, 0, 0, 0, x, y);
+}
+
+static void scroll_callback(GLFWwindow* window, double x, double y)
+{
+    push_input_event(window, INPUT_EVENT_SCROLL, 0, 0, 0, 0, x, y);
+}
+
+static void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+    push_input_event(window, INPUT_EVENT_RESIZE, 0, 0, 0, 0, (double)width, (double)height);
+}
+
+static void window_focus_callback(GLFWwindow* window, int focused)
+{
+    push_input_event(window, INPUT_EVENT_FOCUS, 0, 0, focused ? 1 : 0, 0, 0.0, 0.0);
+}
+
+/// @brief 为窗口设置把事件写入输入事件环的 GLFW 回调.
+static void install_input_callbacks(GLFWwindow* window)
+{
+    glfwSetKeyCallback(window, key_callback);
+    glfwSetMouseButtonCallback(window, mouse_button_callback);
+    glfwSetCursorPosCallback(window, cursor_position_callback);
+    glfwSetScrollCallback(window, scroll_callback);
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetWindowFocusCallback(window, window_focus_callback);
+}
+
+
+/// @brief 给定窗口与所有由 createWindow 创建的窗口中最活跃的状态（WindowState 的值越小越活跃）.
+static int get_most_active_state(GLFWwindow* window)
+{
+    int state = getWindowState(window);
+
+    for (uint32_t i = 0; i < WINDOWING_MAX_WINDOWS && state != WINDOW_STATE_ACTIVE; i++)
+    {
+        GLFWwindow* other = windowSlots[i].window;
+        if (other == NULL || other == window)
+            continue;
+
+        int otherState = getWindowState(other);
+        if (otherState < state)
+            state = otherState;
+    }
+
+    return state;
+}
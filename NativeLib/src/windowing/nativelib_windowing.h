@@ -1,11 +1,34 @@
 #pragma once
 
 #include "../common/nativelib.h"
+#include "input_ring.h"
 
 #include <GLFW/glfw3.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 
+/// @brief 初始化 GLFW 库并设置窗口提示（不使用客户端 API、不可调整大小）.
+///
+/// 与 createWindow 分开调用时，可以在两者之间开始渲染器的预初始化，使其与窗口创建重叠.
+///
+/// @return 初始化成功时返回 `true`
+EX_API bool initializeWindowing(void);
+
+
+/// @brief 创建一个窗口（需先调用 initializeWindowing）.
+///
+/// 窗口的键盘、鼠标、滚轮、帧缓冲大小与焦点事件会被加入输入事件环，见 drainInputEvents.
+///
+/// @param width 窗口的宽（屏幕坐标系下）
+/// @param height 窗口的高（屏幕坐标系下）
+/// @param title 窗口标题
+///
+/// @return 一个创建好的窗口的句柄，或者 `NULL` 当发生错误时
+EX_API GLFWwindow* createWindow(int width, int height, const char* title);
+
+
 /// @brief 初始化 GLFW 库并创建一个窗口.
 ///
 /// @param width 窗口的宽（屏幕坐标系下）
@@ -36,5 +59,76 @@ EX_API int windowShouldClose(GLFWwindow* window);
 EX_API void pollEvents(void);
 
 
+/// @brief 窗口的活动状态，决定主循环是否需要渲染以及以什么频率渲染.
+typedef enum WindowState {
+    WINDOW_STATE_ACTIVE     = 0,        // 拥有焦点，全速渲染
+    WINDOW_STATE_BACKGROUND = 1,        // 失去焦点但可见，受后台帧率上限约束
+    WINDOW_STATE_MINIMIZED  = 2,        // 最小化或帧缓冲大小为 0，不应渲染
+} WindowState;
+
+/// @brief 参与节流判断的窗口数上限（多个窗口各自作为渲染器的表面时），超出的窗口只按自身判断.
+#define WINDOWING_MAX_WINDOWS   8
+
+/// @brief 最小化时每次等待事件的超时（秒），使关闭标志等状态仍能被及时检查.
+#define MINIMIZED_WAIT_TIMEOUT  0.25
+
+
+/// @brief 查询窗口当前的活动状态.
+///
+/// @param window 给定窗口
+///
+/// @return 一个 `WindowState` 值
+EX_API int getWindowState(GLFWwindow* window);
+
+
+/// @brief 设置窗口失去焦点时的帧率上限.
+///
+/// @param framesPerSecond 每秒最多的帧数，为 0 时不限制（默认）
+EX_API void setBackgroundFrameRate(double framesPerSecond);
+
+
+/// @brief 处理窗口事件，并在窗口不需要全速渲染时让出 CPU.
+///
+/// 一个主循环向多个窗口渲染时，状态按所有由 createWindow 创建的窗口中最活跃的一个判断：
+/// 任一窗口拥有焦点时等同于 pollEvents；都失去焦点且设置了后台帧率上限时，使用 glfwWaitEventsTimeout
+/// 等待到下一帧的时间点（期间到达的事件会立即被处理）；全部最小化时一直等待事件，直到有窗口恢复
+/// 或给定窗口被要求关闭. 帧的时间点按给定窗口分别记录.
+///
+/// @param window 主循环的窗口（其关闭标志结束循环）
+///
+/// @return 本帧是否应当渲染（所有窗口都最小化或给定窗口应当关闭时为 `false`）
+EX_API bool waitEventsForFrame(GLFWwindow* window);
+
+
+/// @brief 取出自上一次调用以来的所有输入事件（每帧在处理窗口事件之后调用一次）.
+///
+/// 事件由 GLFW 回调写入一个固定容量的单生产者单消费者环，本函数把它们拷贝到一块连续的内存中，
+/// 因此每帧只需一次互操作调用，也没有托管分配.
+///
+/// @param ppEvents 输出参数，接收事件数组的地址（在下一次调用前有效）
+///
+/// @return 事件数
+EX_API uint32_t drainInputEvents(const InputEvent** ppEvents);
+
+
+/// @brief 因事件环已满（长时间没有取出事件）而被丢弃的输入事件总数.
+EX_API uint32_t getDroppedInputEventCount(void);
+
+
+/// @brief 每帧调用的窗口入口表，C# 以 `delegate* unmanaged` 直接调用（传入原始的窗口指针，
+/// 不经过 SafeHandle 的引用计数与 P/Invoke 的封送存根）.
+typedef struct WindowingFrameApi {
+    uint32_t    size;                                                   // sizeof(WindowingFrameApi)
+    bool        (*waitEventsForFrame)(GLFWwindow* window);
+    int         (*windowShouldClose)(GLFWwindow* window);
+    int         (*getWindowState)(GLFWwindow* window);
+    uint32_t    (*drainInputEvents)(const InputEvent** ppEvents);
+} WindowingFrameApi;
+
+
+/// @brief 获取每帧调用的窗口入口表（静态存储，在进程的整个生命周期内有效）.
+EX_API const WindowingFrameApi* getWindowingFrameApi(void);
+
+
 /// @brief 终止 GLFW 库.
 EX_API void terminate(void);
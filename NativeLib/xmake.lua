@@ -10,7 +10,8 @@ elseif is_host("linux") then
 end
 
 add_requires("glfw 3.4", {configs = {shared = true}})   -- 必须使用动态库，共享 GLFW 的状态
-add_requires("vulkansdk")
+add_requires("vulkan-headers")                          -- 只需头文件，Vulkan 函数在运行时加载
+add_requires("glslang", {configs = {binaryonly = true}})  -- 构建时把 GLSL 编译为 SPIR-V
 
 set_languages("c11")
 set_warnings("all", "error")
@@ -30,7 +31,36 @@ target("nativelib_renderer")
     set_kind("shared")
     set_prefixname("")
 
-    add_files("src/renderer/*.c")
+    add_rules("utils.glsl2spv", {bin2c = true})         -- 着色器以字节数组嵌入
+    add_files("shaders/*.vert", "shaders/*.frag")
+    add_files("src/common/*.c", "src/renderer/*.c")
 
-    add_packages("vulkansdk", "glfw")
+    add_defines("VK_NO_PROTOTYPES")
+    add_packages("vulkan-headers", "glfw", "glslang")
+
+    if is_plat("linux") then
+        add_syslinks("pthread", "m", "dl")              -- 工作线程、数学库与 dlopen（src/renderer/vulkan_loader.c）
+    end
+target_end()
+
+
+-- 无头渲染器基准测试（用法见 src/benchmark/benchmark.c，xmake run nativelib_benchmark）
+-- 直接编译渲染器源码（共享库只导出 EX_API 接口），并关闭验证层以免影响测量
+target("nativelib_benchmark")
+    set_kind("binary")
+    set_default(false)
+
+    add_undefines("DEBUG")
+    set_optimize("fastest")
+
+    add_rules("utils.glsl2spv", {bin2c = true})
+    add_files("shaders/*.vert", "shaders/*.frag")
+    add_files("src/common/*.c", "src/renderer/*.c", "src/benchmark/*.c")
+
+    add_defines("VK_NO_PROTOTYPES")
+    add_packages("vulkan-headers", "glfw", "glslang")
+
+    if is_plat("linux") then
+        add_syslinks("pthread", "m", "dl")              -- 工作线程、数学库与 dlopen（src/renderer/vulkan_loader.c）
+    end
 target_end()
\ No newline at end of file